@@ -0,0 +1,360 @@
+#include "POBakeBarksCommandlet.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Blueprint/BlueprintSupport.h"
+#include "Containers/Ticker.h"
+#include "Engine/Blueprint.h"
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "PlatformHttp.h"
+#include "POBarkSubsystem.h"
+#include "POBarkTable.h"
+#include "../Claude/POClaudeAPIManager.h"
+#include "../Claude/POClaudePromptBuilder.h"
+#include "../Claude/POClaudeRateLimiter.h"
+#include "../Claude/POClaudeRequestWriter.h"
+#include "../Claude/POClaudeResponseScanner.h"
+#include "../Claude/POClaudeTypes.h"
+#include "../NPC/PONPCCharacter.h"
+#include "../World/POEnvironmentSubsystem.h"
+
+#if !UE_BUILD_SHIPPING
+#include "../Claude/POClaudeMockServer.h"
+#endif
+
+namespace POBakeBarks
+{
+	struct FArchetype
+	{
+		FString Name;
+		FString Personality;
+		uint64 Key = 0;
+	};
+
+	struct FJob
+	{
+		int32 Archetype = 0;
+		EWeatherType Weather = EWeatherType::Clear;
+		EPOTimePeriod Period = EPOTimePeriod::Noon;
+		int32 Attempt = 0;
+	};
+
+	// 시간대별 대표 시각 (EPOTimePeriod 선언 순서와 같아야 함)
+	static constexpr float PeriodHours[POBarkTable::NumPeriods] = { 3.0f, 7.0f, 10.5f, 13.0f, 16.0f, 19.5f, 22.5f };
+
+	static constexpr int32 MaxAttempts = 3;
+
+	static const TCHAR* const BarkInstruction =
+		TEXT("(지나가는 사람에게 들리도록, 지금 날씨와 시간에 어울리는 혼잣말을 한 문장으로만 하세요. 따옴표나 설명 없이 대사만 쓰세요.)");
+
+	// 날씨별 대표 수치 (동적 블록의 날씨 상세 묘사용)
+	static void FillWeather(FClaudeRequestContext& Context, EWeatherType Weather)
+	{
+		Context.WeatherType = UPOEnvironmentSubsystem::WeatherToKorean(Weather);
+		switch (Weather)
+		{
+		case EWeatherType::Cloudy: Context.WindStrength = 0.2f; break;
+		case EWeatherType::Rainy:  Context.RainIntensity = 0.6f; Context.WindStrength = 0.3f; break;
+		case EWeatherType::Snowy:  Context.SnowCoverage = 0.6f; break;
+		case EWeatherType::Stormy: Context.RainIntensity = 0.8f; Context.WindStrength = 0.9f; break;
+		default: break;
+		}
+	}
+
+	static void AddArchetype(const APONPCCharacter* NPC, TArray<FArchetype>& Out)
+	{
+		if (!NPC)
+		{
+			return;
+		}
+
+		const uint64 Key = FPOClaudePromptBuilder::GetArchetypeKey(NPC->NPCName, NPC->NPCPersonality);
+		if (!Out.ContainsByPredicate([Key](const FArchetype& A) { return A.Key == Key; }))
+		{
+			Out.Add({ NPC->NPCName, NPC->NPCPersonality, Key });
+		}
+	}
+
+	// 네이티브 기본값 + APONPCCharacter를 부모로 둔 모든 블루프린트의 CDO
+	static void GatherArchetypes(TArray<FArchetype>& Out)
+	{
+		AddArchetype(GetDefault<APONPCCharacter>(), Out);
+
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.SearchAllAssets(true);
+
+		FARFilter Filter;
+		Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+		Filter.bRecursiveClasses = true;
+
+		TArray<FAssetData> Blueprints;
+		AssetRegistry.GetAssets(Filter, Blueprints);
+
+		const FString NativeParentPath = FObjectPropertyBase::GetExportPath(APONPCCharacter::StaticClass());
+		for (const FAssetData& Asset : Blueprints)
+		{
+			FString ParentPath;
+			FString GeneratedClassPath;
+			if (!Asset.GetTagValue(FBlueprintTags::NativeParentClassPath, ParentPath) || ParentPath != NativeParentPath
+				|| !Asset.GetTagValue(FBlueprintTags::GeneratedClassPath, GeneratedClassPath))
+			{
+				continue;
+			}
+
+			const UClass* Class = LoadObject<UClass>(nullptr, *FPackageName::ExportTextPathToObjectPath(GeneratedClassPath));
+			if (Class && Class->IsChildOf(APONPCCharacter::StaticClass()))
+			{
+				AddArchetype(Class->GetDefaultObject<APONPCCharacter>(), Out);
+			}
+		}
+	}
+
+	// 응답에서 대사 한 줄만 남김 (첫 줄, 앞뒤 공백/따옴표 제거)
+	static FString CleanLine(const FString& Text)
+	{
+		TArray<FString> Lines;
+		Text.ParseIntoArrayLines(Lines, true);
+
+		for (FString& Line : Lines)
+		{
+			Line.TrimStartAndEndInline();
+			Line.TrimCharInline(TEXT('"'), nullptr);
+			Line.TrimStartAndEndInline();
+			if (!Line.IsEmpty())
+			{
+				return MoveTemp(Line);
+			}
+		}
+		return FString();
+	}
+
+	static void TickHttp(float DeltaSeconds)
+	{
+		FHttpModule::Get().GetHttpManager().Tick(DeltaSeconds);
+		FTSTicker::GetCoreTicker().Tick(DeltaSeconds);
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	}
+}
+
+UPOBakeBarksCommandlet::UPOBakeBarksCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UPOBakeBarksCommandlet::Main(const FString& Params)
+{
+	using namespace POBakeBarks;
+
+	int32 Variants = 3;
+	int32 Concurrency = 4;
+	int32 RequestsPerMinute = 50;
+	FString OutPath = UPOBarkSubsystem::GetDefaultTablePath();
+	FParse::Value(*Params, TEXT("Variants="), Variants);
+	FParse::Value(*Params, TEXT("Concurrency="), Concurrency);
+	FParse::Value(*Params, TEXT("RPM="), RequestsPerMinute);
+	FParse::Value(*Params, TEXT("Out="), OutPath);
+	Variants = FMath::Clamp(Variants, 1, 16);
+	Concurrency = FMath::Max(1, Concurrency);
+
+	// 혼잣말은 짧은 한 줄이므로 기본은 라우팅의 빠른 티어(첫 티어). -Model=로 지정 가능
+	const APOClaudeAPIManager* ManagerDefaults = GetDefault<APOClaudeAPIManager>();
+	FString ModelID = ManagerDefaults->ModelID;
+	if (ManagerDefaults->bEnableModelRouting && ManagerDefaults->ModelTiers.Num() > 0 && !ManagerDefaults->ModelTiers[0].ModelID.IsEmpty())
+	{
+		ModelID = ManagerDefaults->ModelTiers[0].ModelID;
+	}
+	FParse::Value(*Params, TEXT("Model="), ModelID);
+
+	FString APIKey;
+	FString EndpointURL = TEXT("https://api.anthropic.com/v1/messages");
+	GConfig->GetString(TEXT("Claude"), TEXT("APIKey"), APIKey, GGameIni);
+	FString ConfigEndpointURL;
+	if (GConfig->GetString(TEXT("Claude"), TEXT("EndpointURL"), ConfigEndpointURL, GGameIni) && !ConfigEndpointURL.IsEmpty())
+	{
+		EndpointURL = ConfigEndpointURL;
+	}
+
+#if !UE_BUILD_SHIPPING
+	if (FParse::Param(*Params, TEXT("Mock")))
+	{
+		FPOClaudeMockServerSettings MockSettings;
+		MockSettings.MedianLatencyMs = 50.0f;
+		if (!FPOClaudeMockServer::Get().Start(MockSettings))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[BakeBarks] 모의 서버를 시작할 수 없습니다."));
+			return 1;
+		}
+		EndpointURL = FPOClaudeMockServer::Get().GetEndpointURL();
+		RequestsPerMinute = 0;
+	}
+#endif
+
+	const FString Domain = FPlatformHttp::GetUrlDomain(EndpointURL);
+	const bool bLoopback = Domain == TEXT("127.0.0.1") || Domain.Equals(TEXT("localhost"), ESearchCase::IgnoreCase);
+	if (APIKey.IsEmpty() && !bLoopback)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeBarks] API 키가 없습니다. DefaultGame.ini [Claude] APIKey를 설정하거나 -Mock으로 실행하세요."));
+		return 1;
+	}
+
+	TArray<FArchetype> Archetypes;
+	GatherArchetypes(Archetypes);
+
+	TArray<FJob> Jobs;
+	for (int32 Archetype = 0; Archetype < Archetypes.Num(); ++Archetype)
+	{
+		for (int32 Weather = 0; Weather < POBarkTable::NumWeathers; ++Weather)
+		{
+			for (int32 Period = 0; Period < POBarkTable::NumPeriods; ++Period)
+			{
+				for (int32 Variant = 0; Variant < Variants; ++Variant)
+				{
+					FJob& Job = Jobs.AddDefaulted_GetRef();
+					Job.Archetype = Archetype;
+					Job.Weather   = static_cast<EWeatherType>(Weather);
+					Job.Period    = static_cast<EPOTimePeriod>(Period);
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[BakeBarks] 아키타입 %d × 날씨 %d × 시간대 %d × 변형 %d = 요청 %d건 (%s, %s)"),
+		Archetypes.Num(), POBarkTable::NumWeathers, POBarkTable::NumPeriods, Variants, Jobs.Num(), *ModelID, *EndpointURL);
+
+	FPOBarkTableBuilder Builder(Variants);
+	FPOClaudePromptBuilder PromptBuilder;
+	FPOClaudeRateLimiter RateLimiter;
+	RateLimiter.Configure(RequestsPerMinute, 0);
+
+	const FString Instruction(BarkInstruction);
+	TArray<uint8> Body;
+
+	int32 NextJob = 0;
+	int32 NumInFlight = 0;
+	int32 NumFailed = 0;
+	int32 NumDuplicates = 0;
+	int32 NumRejected = 0;
+
+	double LastTickTime = FPlatformTime::Seconds();
+	while (NextJob < Jobs.Num() || NumInFlight > 0)
+	{
+		const double Now = FPlatformTime::Seconds();
+
+		while (NextJob < Jobs.Num() && NumInFlight < Concurrency && RateLimiter.GetWaitSeconds(Now, 0) <= 0.0)
+		{
+			const FJob Job = Jobs[NextJob++];
+			const FArchetype& Archetype = Archetypes[Job.Archetype];
+
+			FClaudeRequestContext Context;
+			Context.PlayerMessage  = Instruction;
+			Context.NPCName        = Archetype.Name;
+			Context.NPCPersonality = Archetype.Personality;
+			Context.TimeOfDay      = PeriodHours[static_cast<int32>(Job.Period)];
+			FillWeather(Context, Job.Weather);
+
+			// 대화 요청과 같은 조립 경로 (FPOClaudePromptBuilder::BuildPrompt). 이력/기억이 없으므로 메시지는 지시문 하나
+			FPOClaudePromptParts Prompt;
+			PromptBuilder.BuildPrompt(Context, 0, 0, TConstArrayView<const FString*>(), Prompt);
+			const FPOClaudeMessageView Message{ "user", &Context.PlayerMessage };
+
+			FPOClaudeRequestBodyParams BodyParams;
+			BodyParams.Model         = &ModelID;
+			BodyParams.MaxTokens     = 100;
+			BodyParams.bStream       = false;
+			BodyParams.StaticSystem  = Prompt.StaticSystem;
+			BodyParams.DynamicSystem = &Prompt.DynamicSystem;
+			BodyParams.Messages      = MakeArrayView(&Message, 1);
+			POClaudeRequestWriter::WriteRequestBody(BodyParams, Body);
+
+			TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+			Request->SetURL(EndpointURL);
+			Request->SetVerb(TEXT("POST"));
+			Request->SetHeader(TEXT("Content-Type"),      TEXT("application/json"));
+			Request->SetHeader(TEXT("x-api-key"),         APIKey);
+			Request->SetHeader(TEXT("anthropic-version"), TEXT("2023-06-01"));
+			Request->SetContent(Body);
+			Request->SetTimeout(60.0f);
+
+			Request->OnProcessRequestComplete().BindLambda(
+				[&, Job](FHttpRequestPtr, FHttpResponsePtr Res, bool bConnected)
+				{
+					--NumInFlight;
+
+					const int32 StatusCode = (bConnected && Res.IsValid()) ? Res->GetResponseCode() : 0;
+					FPOClaudeScanResult Scan;
+					if (StatusCode == 200
+						&& POClaudeResponseScanner::Scan(Res->GetContent().GetData(), Res->GetContent().Num(), Scan)
+						&& Scan.bHasText)
+					{
+						// 대사가 남지 않은 응답(따옴표/공백뿐)은 중복이 아니라 거절로 집계
+						const FString Line = CleanLine(Scan.Text);
+						if (Line.IsEmpty())
+						{
+							++NumRejected;
+							UE_LOG(LogTemp, Verbose, TEXT("[BakeBarks] 빈 대사 거절: %s / %s / %s"),
+								*Archetypes[Job.Archetype].Name, *UPOEnvironmentSubsystem::WeatherToKorean(Job.Weather),
+								*UPOEnvironmentSubsystem::TimePeriodToKorean(Job.Period));
+						}
+						else if (!Builder.AddLine(Archetypes[Job.Archetype].Key, Job.Weather, Job.Period, Line))
+						{
+							++NumDuplicates;
+						}
+						return;
+					}
+
+					if (StatusCode == 429)
+					{
+						const FString RetryAfter = Res->GetHeader(TEXT("retry-after"));
+						RateLimiter.BlockUntil(FPlatformTime::Seconds() + (RetryAfter.IsNumeric() ? FCString::Atod(*RetryAfter) : 5.0));
+					}
+
+					if (Job.Attempt + 1 < MaxAttempts)
+					{
+						FJob Retry = Job;
+						++Retry.Attempt;
+						Jobs.Add(Retry);
+					}
+					else
+					{
+						++NumFailed;
+						UE_LOG(LogTemp, Warning, TEXT("[BakeBarks] 실패 (상태 %d): %s / %s / %s"), StatusCode,
+							*Archetypes[Job.Archetype].Name, *UPOEnvironmentSubsystem::WeatherToKorean(Job.Weather),
+							*UPOEnvironmentSubsystem::TimePeriodToKorean(Job.Period));
+					}
+				});
+
+			RateLimiter.Acquire(Now, 0);
+			++NumInFlight;
+			Request->ProcessRequest();
+		}
+
+		const double TickTime = FPlatformTime::Seconds();
+		TickHttp(static_cast<float>(TickTime - LastTickTime));
+		LastTickTime = TickTime;
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+#if !UE_BUILD_SHIPPING
+	FPOClaudeMockServer::Get().Stop();
+#endif
+
+	TArray<uint8> Bytes;
+	Builder.Serialize(Bytes);
+	if (!FFileHelper::SaveArrayToFile(Bytes, *OutPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeBarks] 저장 실패: %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[BakeBarks] %s 저장: 칸 채움 %d줄, 고유 문장 %d, 중복 %d, 거절 %d, 실패 %d, %d bytes"),
+		*OutPath, Builder.GetNumLines(), Builder.GetNumStrings(), NumDuplicates, NumRejected, NumFailed, Bytes.Num());
+	return 0;
+}
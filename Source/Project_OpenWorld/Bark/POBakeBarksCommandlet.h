@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "POBakeBarksCommandlet.generated.h"
+
+/**
+ * NPC 주변 혼잣말(bark) 굽기 커맨드렛
+ * 모든 NPC 아키타입(APONPCCharacter와 그 블루프린트 자식의 이름 + 성격) × 날씨 × 시간대 칸마다
+ * 대화와 같은 시스템 프롬프트(정적 페르소나 블록 + 동적 환경 블록)로 한 줄씩 받아 Barks.bin에 굽는다.
+ *
+ * 실행 예:
+ *   UnrealEditor-Cmd Project_OpenWorld.uproject -run=POBakeBarks [-Variants=3] [-Concurrency=4] [-RPM=50] [-Model=ID] [-Mock] [-Out=경로]
+ * 모델은 기본적으로 APOClaudeAPIManager의 빠른 티어(ModelTiers 첫 항목, 라우팅을 끄면 ModelID)를 쓴다.
+ * -Mock이면 루프백 모의 서버로 파이프라인만 검증한다 (API 키 불필요).
+ */
+UCLASS()
+class UPOBakeBarksCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPOBakeBarksCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
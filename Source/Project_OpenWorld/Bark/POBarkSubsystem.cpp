@@ -0,0 +1,95 @@
+#include "POBarkSubsystem.h"
+#include "Async/MappedFileHandle.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "../Claude/POClaudePromptBuilder.h"
+
+void UPOBarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const FString Path = GetDefaultTablePath();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*Path))
+	{
+		UE_LOG(LogTemp, Log, TEXT("[BarkSubsystem] bark 표가 없습니다 (%s). 주변 혼잣말이 비활성화됩니다."), *Path);
+		return;
+	}
+
+	FOpenMappedResult Mapped = PlatformFile.OpenMappedEx(*Path);
+	if (Mapped.HasValue())
+	{
+		MappedFile = Mapped.StealValue();
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	}
+
+	if (MappedRegion)
+	{
+		Table.Initialize(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+	}
+	else if (FFileHelper::LoadFileToArray(LoadedBytes, *Path))
+	{
+		Table.Initialize(LoadedBytes.GetData(), LoadedBytes.Num());
+	}
+
+	if (Table.IsValid())
+	{
+		UE_LOG(LogTemp, Log, TEXT("[BarkSubsystem] bark 표 로딩 (%s): 아키타입 %d, 문장 %d"),
+			MappedRegion ? TEXT("매핑") : TEXT("복사"), Table.GetNumArchetypes(), Table.GetNumStrings());
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[BarkSubsystem] bark 표 형식이 맞지 않습니다: %s"), *Path);
+		MappedRegion.Reset();
+		MappedFile.Reset();
+		LoadedBytes.Empty();
+	}
+}
+
+void UPOBarkSubsystem::Deinitialize()
+{
+	if (NumBarksServed > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[BarkSubsystem] 주변 혼잣말 %d회 (API 호출 없음)"), NumBarksServed);
+	}
+
+	// 매핑을 풀기 전에 뷰부터 비움
+	Table = FPOBarkTableView();
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	LoadedBytes.Empty();
+
+	Super::Deinitialize();
+}
+
+UPOBarkSubsystem* UPOBarkSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UPOBarkSubsystem>() : nullptr;
+}
+
+FString UPOBarkSubsystem::GetDefaultTablePath()
+{
+	return FPaths::ProjectContentDir() / TEXT("Claude") / TEXT("Barks.bin");
+}
+
+int32 UPOBarkSubsystem::FindArchetype(const FString& NPCName, const FString& NPCPersonality) const
+{
+	return Table.FindArchetype(FPOClaudePromptBuilder::GetArchetypeKey(NPCName, NPCPersonality));
+}
+
+bool UPOBarkSubsystem::GetBark(int32 ArchetypeIndex, EWeatherType Weather, EPOTimePeriod Period, uint32 Seed, FString& OutLine) const
+{
+	if (!Table.GetLine(ArchetypeIndex, Weather, Period, Seed, OutLine))
+	{
+		return false;
+	}
+
+	++NumBarksServed;
+	return true;
+}
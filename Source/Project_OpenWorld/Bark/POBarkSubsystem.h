@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "POBarkTable.h"
+#include "POBarkSubsystem.generated.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * 미리 구워 둔 주변 혼잣말(bark) 표 서비스
+ * 게임 시작 시 Content/Claude/Barks.bin(POBakeBarks 커맨드렛 출력)을 메모리 매핑해 두고,
+ * NPC는 네트워크/JSON 파싱 없이 (아키타입, 날씨, 시간대) 칸에서 바로 한 줄을 꺼낸다.
+ * 매핑이 안 되는 플랫폼에서는 파일을 한 번 통째로 읽어 같은 뷰로 쓴다.
+ */
+UCLASS()
+class PROJECT_OPENWORLD_API UPOBarkSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// 게임 인스턴스에서 서브시스템 가져오기 (없으면 nullptr)
+	static UPOBarkSubsystem* Get(const UObject* WorldContextObject);
+
+	static FString GetDefaultTablePath();
+
+	bool IsLoaded() const { return Table.IsValid(); }
+
+	// NPC 이름 + 성격 → 아키타입 번호 (표에 없으면 INDEX_NONE). BeginPlay에서 한 번만 호출
+	int32 FindArchetype(const FString& NPCName, const FString& NPCPersonality) const;
+
+	// 칸에서 Seed로 한 줄 선택. 빈 칸이면 false
+	bool GetBark(int32 ArchetypeIndex, EWeatherType Weather, EPOTimePeriod Period, uint32 Seed, FString& OutLine) const;
+
+	int32 GetNumBarksServed() const { return NumBarksServed; }
+
+private:
+	FPOBarkTableView Table;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	// 매핑 실패 시 파일 전체 복사본
+	TArray<uint8> LoadedBytes;
+
+	mutable int32 NumBarksServed = 0;
+};
@@ -0,0 +1,193 @@
+#include "POBarkTable.h"
+#include "Algo/BinarySearch.h"
+
+using namespace POBarkTable;
+
+FPOBarkTableBuilder::FPOBarkTableBuilder(int32 InVariantsPerCell)
+	: VariantsPerCell(FMath::Max(1, InVariantsPerCell))
+{
+}
+
+bool FPOBarkTableBuilder::AddLine(uint64 ArchetypeKey, EWeatherType Weather, EPOTimePeriod Period, const FString& Line)
+{
+	const int32 WeatherIndex = static_cast<int32>(Weather);
+	const int32 PeriodIndex  = static_cast<int32>(Period);
+	if (Line.IsEmpty() || WeatherIndex >= NumWeathers || PeriodIndex >= NumPeriods)
+	{
+		return false;
+	}
+
+	TArray<uint32>* ArchetypeCells = Cells.Find(ArchetypeKey);
+	if (!ArchetypeCells)
+	{
+		ArchetypeCells = &Cells.Add(ArchetypeKey);
+		ArchetypeCells->Init(InvalidString, NumWeathers * NumPeriods * VariantsPerCell);
+	}
+
+	// 같은 문장은 표 전체에서 한 번만 저장
+	uint32 StringIndex;
+	if (const uint32* Existing = StringIndices.Find(Line))
+	{
+		StringIndex = *Existing;
+	}
+	else
+	{
+		StringIndex = Strings.Add(Line);
+		StringIndices.Add(Line, StringIndex);
+	}
+
+	uint32* Cell = ArchetypeCells->GetData() + (WeatherIndex * NumPeriods + PeriodIndex) * VariantsPerCell;
+	for (int32 Variant = 0; Variant < VariantsPerCell; ++Variant)
+	{
+		if (Cell[Variant] == StringIndex)
+		{
+			return false;
+		}
+		if (Cell[Variant] == InvalidString)
+		{
+			Cell[Variant] = StringIndex;
+			++NumLines;
+			return true;
+		}
+	}
+	return false;
+}
+
+void FPOBarkTableBuilder::Serialize(TArray<uint8>& OutBytes) const
+{
+	TArray<uint64> SortedKeys;
+	Cells.GetKeys(SortedKeys);
+	SortedKeys.Sort();
+
+	const int32 CellsPerArchetype = NumWeathers * NumPeriods * VariantsPerCell;
+
+	// 문자열 데이터를 먼저 모아 오프셋 계산
+	TArray<uint8> StringBytes;
+	TArray<uint32> StringOffsets;
+	StringOffsets.Reserve(Strings.Num() + 1);
+	for (const FString& String : Strings)
+	{
+		StringOffsets.Add(StringBytes.Num());
+		const FTCHARToUTF8 Converted(*String, String.Len());
+		StringBytes.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+	StringOffsets.Add(StringBytes.Num());
+
+	FHeader Header;
+	Header.Magic               = Magic;
+	Header.Version             = Version;
+	Header.NumArchetypes       = SortedKeys.Num();
+	Header.NumWeathers         = NumWeathers;
+	Header.NumPeriods          = NumPeriods;
+	Header.VariantsPerCell     = VariantsPerCell;
+	Header.NumStrings          = Strings.Num();
+	Header.KeysOffset          = sizeof(FHeader);
+	Header.CellsOffset         = Header.KeysOffset + SortedKeys.Num() * sizeof(uint64);
+	Header.StringOffsetsOffset = Header.CellsOffset + SortedKeys.Num() * CellsPerArchetype * sizeof(uint32);
+	Header.StringDataOffset    = Header.StringOffsetsOffset + StringOffsets.Num() * sizeof(uint32);
+	Header.FileSize            = Header.StringDataOffset + StringBytes.Num();
+
+	OutBytes.Reset(Header.FileSize);
+	OutBytes.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	OutBytes.Append(reinterpret_cast<const uint8*>(SortedKeys.GetData()), SortedKeys.Num() * sizeof(uint64));
+	for (const uint64 Key : SortedKeys)
+	{
+		const TArray<uint32>& ArchetypeCells = Cells.FindChecked(Key);
+		OutBytes.Append(reinterpret_cast<const uint8*>(ArchetypeCells.GetData()), ArchetypeCells.Num() * sizeof(uint32));
+	}
+	OutBytes.Append(reinterpret_cast<const uint8*>(StringOffsets.GetData()), StringOffsets.Num() * sizeof(uint32));
+	OutBytes.Append(StringBytes);
+
+	check(OutBytes.Num() == static_cast<int32>(Header.FileSize));
+}
+
+bool FPOBarkTableView::Initialize(const uint8* InData, int64 InSize)
+{
+	Header = nullptr;
+
+	if (!InData || InSize < static_cast<int64>(sizeof(FHeader)))
+	{
+		return false;
+	}
+
+	const FHeader* Candidate = reinterpret_cast<const FHeader*>(InData);
+	if (Candidate->Magic != Magic || Candidate->Version != Version
+		|| Candidate->NumWeathers != NumWeathers || Candidate->NumPeriods != NumPeriods
+		|| Candidate->VariantsPerCell == 0 || Candidate->FileSize != InSize)
+	{
+		return false;
+	}
+
+	// 구간이 순서대로 붙어 있고 파일 안에 들어오는지 (64비트로 계산해 넘침 방지)
+	const uint64 NumCells = static_cast<uint64>(Candidate->NumArchetypes) * NumWeathers * NumPeriods * Candidate->VariantsPerCell;
+	if (Candidate->KeysOffset != sizeof(FHeader)
+		|| Candidate->CellsOffset != Candidate->KeysOffset + static_cast<uint64>(Candidate->NumArchetypes) * sizeof(uint64)
+		|| Candidate->StringOffsetsOffset != Candidate->CellsOffset + NumCells * sizeof(uint32)
+		|| Candidate->StringDataOffset != Candidate->StringOffsetsOffset + (static_cast<uint64>(Candidate->NumStrings) + 1) * sizeof(uint32)
+		|| Candidate->StringDataOffset > Candidate->FileSize)
+	{
+		return false;
+	}
+
+	const uint32* Offsets = reinterpret_cast<const uint32*>(InData + Candidate->StringOffsetsOffset);
+	if (Offsets[Candidate->NumStrings] != Candidate->FileSize - Candidate->StringDataOffset)
+	{
+		return false;
+	}
+
+	Header        = Candidate;
+	Keys          = reinterpret_cast<const uint64*>(InData + Header->KeysOffset);
+	Cells         = reinterpret_cast<const uint32*>(InData + Header->CellsOffset);
+	StringOffsets = Offsets;
+	StringData    = reinterpret_cast<const ANSICHAR*>(InData + Header->StringDataOffset);
+	return true;
+}
+
+int32 FPOBarkTableView::FindArchetype(uint64 ArchetypeKey) const
+{
+	if (!Header)
+	{
+		return INDEX_NONE;
+	}
+
+	const TConstArrayView<uint64> KeyView(Keys, Header->NumArchetypes);
+	const int32 Index = Algo::LowerBound(KeyView, ArchetypeKey);
+	return (Index < KeyView.Num() && KeyView[Index] == ArchetypeKey) ? Index : INDEX_NONE;
+}
+
+bool FPOBarkTableView::GetLine(int32 ArchetypeIndex, EWeatherType Weather, EPOTimePeriod Period, uint32 Seed, FString& OutLine) const
+{
+	const int32 WeatherIndex = static_cast<int32>(Weather);
+	const int32 PeriodIndex  = static_cast<int32>(Period);
+	if (!Header || ArchetypeIndex < 0 || ArchetypeIndex >= static_cast<int32>(Header->NumArchetypes)
+		|| WeatherIndex >= NumWeathers || PeriodIndex >= NumPeriods)
+	{
+		return false;
+	}
+
+	const uint32 Variants = Header->VariantsPerCell;
+	const uint32* Cell = Cells + ((static_cast<uint64>(ArchetypeIndex) * NumWeathers + WeatherIndex) * NumPeriods + PeriodIndex) * Variants;
+
+	// 변형은 앞에서부터 채워져 있음
+	uint32 NumFilled = 0;
+	while (NumFilled < Variants && Cell[NumFilled] < Header->NumStrings)
+	{
+		++NumFilled;
+	}
+	if (NumFilled == 0)
+	{
+		return false;
+	}
+
+	const uint32 StringIndex = Cell[Seed % NumFilled];
+	const uint32 Begin = StringOffsets[StringIndex];
+	const uint32 End   = StringOffsets[StringIndex + 1];
+	if (End < Begin || End > Header->FileSize - Header->StringDataOffset)
+	{
+		return false;
+	}
+
+	const FUTF8ToTCHAR Converted(StringData + Begin, End - Begin);
+	OutLine = FString(Converted.Length(), Converted.Get());
+	return true;
+}
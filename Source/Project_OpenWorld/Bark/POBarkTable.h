@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../Weather/WeatherTypes.h"
+#include "../World/POEnvironmentTypes.h"
+
+/**
+ * 주변 혼잣말(bark) 문자열 표 파일 형식 (Content/Claude/Barks.bin)
+ *
+ *   [헤더 48B]
+ *   [아키타입 키 uint64 × NumArchetypes]               오름차순 (FPOClaudePromptBuilder::GetArchetypeKey)
+ *   [칸 uint32 × NumArchetypes × 날씨 × 시간대 × 변형]   문자열 번호, 빈 칸은 InvalidString
+ *   [문자열 오프셋 uint32 × (NumStrings + 1)]
+ *   [UTF-8 문자열 데이터]                                 같은 문장은 한 번만 저장
+ *
+ * 읽는 쪽은 파일을 그대로 메모리 매핑해 포인터만 잡으므로 로딩 시 역직렬화/할당이 없다.
+ */
+namespace POBarkTable
+{
+	static constexpr uint32 Magic = 0x4B42504F; // 'POBK'
+	static constexpr uint32 Version = 1;
+
+	static constexpr int32 NumWeathers = 6;
+	static constexpr int32 NumPeriods = 7;
+
+	static constexpr uint32 InvalidString = MAX_uint32;
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 NumArchetypes;
+		uint32 NumWeathers;
+		uint32 NumPeriods;
+		uint32 VariantsPerCell;
+		uint32 NumStrings;
+		uint32 KeysOffset;
+		uint32 CellsOffset;
+		uint32 StringOffsetsOffset;
+		uint32 StringDataOffset;
+		uint32 FileSize;
+	};
+	static_assert(sizeof(FHeader) == 48, "bark 표 헤더 크기가 바뀌면 Version을 올려야 함");
+}
+
+/** 굽기(commandlet)용 bark 표 작성기 */
+class PROJECT_OPENWORLD_API FPOBarkTableBuilder
+{
+public:
+	explicit FPOBarkTableBuilder(int32 InVariantsPerCell);
+
+	// 칸이 가득 찼거나 같은 문장이 이미 있으면 false
+	bool AddLine(uint64 ArchetypeKey, EWeatherType Weather, EPOTimePeriod Period, const FString& Line);
+
+	int32 GetNumStrings() const { return Strings.Num(); }
+	int32 GetNumLines() const { return NumLines; }
+
+	void Serialize(TArray<uint8>& OutBytes) const;
+
+private:
+	int32 VariantsPerCell;
+	int32 NumLines = 0;
+
+	// 아키타입별 칸 (날씨 × 시간대 × 변형, 문자열 번호)
+	TMap<uint64, TArray<uint32>> Cells;
+
+	TArray<FString> Strings;
+	TMap<FString, uint32> StringIndices;
+};
+
+/** 메모리에 올라온(매핑된) bark 표 읽기 전용 뷰. 데이터는 소유하지 않음 */
+class PROJECT_OPENWORLD_API FPOBarkTableView
+{
+public:
+	// 헤더와 구간 크기 검사. 형식이 맞지 않으면 false
+	bool Initialize(const uint8* InData, int64 InSize);
+
+	bool IsValid() const { return Header != nullptr; }
+
+	// 아키타입 키 → 번호 (없으면 INDEX_NONE). NPC는 BeginPlay에서 한 번만 찾아 둠
+	int32 FindArchetype(uint64 ArchetypeKey) const;
+
+	// 칸의 변형 중 Seed로 하나 선택. 빈 칸이면 false
+	bool GetLine(int32 ArchetypeIndex, EWeatherType Weather, EPOTimePeriod Period, uint32 Seed, FString& OutLine) const;
+
+	int32 GetNumArchetypes() const { return Header ? Header->NumArchetypes : 0; }
+	int32 GetNumStrings() const { return Header ? Header->NumStrings : 0; }
+
+private:
+	const POBarkTable::FHeader* Header = nullptr;
+	const uint64* Keys = nullptr;
+	const uint32* Cells = nullptr;
+	const uint32* StringOffsets = nullptr;
+	const ANSICHAR* StringData = nullptr;
+};
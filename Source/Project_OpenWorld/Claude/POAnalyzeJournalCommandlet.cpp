@@ -0,0 +1,240 @@
+#include "POAnalyzeJournalCommandlet.h"
+#include "Misc/Paths.h"
+#include "POClaudeJournal.h"
+
+namespace POAnalyzeJournal
+{
+	static const TCHAR* const SourceNames[] = { TEXT("Http"), TEXT("Local"), TEXT("Cache"), TEXT("LocalIntent") };
+	static_assert(UE_ARRAY_COUNT(SourceNames) == static_cast<SIZE_T>(EPOClaudeJournalSource::Num), "출처 이름 표 갱신 필요");
+
+	struct FSourceStats
+	{
+		int64 NumRecords = 0;
+		int64 NumSuccess = 0;
+		int64 NumCancelled = 0;
+		int64 NumTimedOut = 0;
+
+		// 성공한 응답의 지연 (초)
+		TArray<float> Latencies;
+	};
+
+	struct FNPCStats
+	{
+		FString Name;
+		int64 NumRecords = 0;
+		double TotalLatency = 0.0;
+	};
+
+	// 정렬된 배열의 백분위
+	static float Percentile(const TArray<float>& Sorted, double P)
+	{
+		if (Sorted.Num() == 0)
+		{
+			return 0.0f;
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Index];
+	}
+
+	static void LogLatencies(const TCHAR* Label, TArray<float>& Latencies)
+	{
+		if (Latencies.Num() == 0)
+		{
+			return;
+		}
+
+		Latencies.Sort();
+		UE_LOG(LogTemp, Display, TEXT("[AnalyzeJournal]   %-12s %lld건: p50 %.2fs p90 %.2fs p95 %.2fs p99 %.2fs 최대 %.2fs"),
+			Label, static_cast<int64>(Latencies.Num()),
+			Percentile(Latencies, 0.50), Percentile(Latencies, 0.90), Percentile(Latencies, 0.95), Percentile(Latencies, 0.99),
+			Latencies.Last());
+	}
+}
+
+UPOAnalyzeJournalCommandlet::UPOAnalyzeJournalCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UPOAnalyzeJournalCommandlet::Main(const FString& Params)
+{
+	using namespace POAnalyzeJournal;
+
+	FString Directory = FPaths::ProjectSavedDir() / TEXT("Claude") / TEXT("Journal");
+	int32 TopNPCs = 10;
+	FParse::Value(*Params, TEXT("Dir="), Directory);
+	FParse::Value(*Params, TEXT("Top="), TopNPCs);
+
+	TArray<FString> Paths;
+	FPOClaudeJournalReader::FindFiles(Directory, Paths);
+	if (Paths.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[AnalyzeJournal] 기록 파일이 없습니다: %s"), *Directory);
+		return 1;
+	}
+
+	FSourceStats Sources[static_cast<int32>(EPOClaudeJournalSource::Num)];
+	TMap<int32, TArray<float>> TierLatencies;
+	TMap<uint64, FNPCStats> NPCs;
+
+	// 응답 캐시 대상(이력 없는 요청)의 키 / 모든 모델 요청의 프롬프트 해시
+	TSet<uint64> CacheKeys;
+	int64 NumCacheable = 0;
+	TSet<uint64> PromptHashes;
+	int64 NumPrompts = 0;
+
+	int64 InputTokens = 0;
+	int64 OutputTokens = 0;
+	int64 CacheReadTokens = 0;
+	int64 CacheCreationTokens = 0;
+
+	int64 NumRecords = 0;
+	int64 TotalBytes = 0;
+	int64 TrailingBytes = 0;
+	int64 MinTicks = MAX_int64;
+	int64 MaxTicks = 0;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (const FString& Path : Paths)
+	{
+		FPOClaudeJournalReader Reader;
+		if (!Reader.Open(Path))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[AnalyzeJournal] 읽을 수 없는 파일 건너뜀: %s"), *Path);
+			continue;
+		}
+
+		NumRecords += Reader.ForEach([&](const FPOClaudeJournalRecordView& Record)
+		{
+			const FPOClaudeJournalFixed& Fixed = Record.Fixed;
+			if (Fixed.Source >= static_cast<uint8>(EPOClaudeJournalSource::Num))
+			{
+				return true;
+			}
+
+			MinTicks = FMath::Min(MinTicks, Fixed.Ticks);
+			MaxTicks = FMath::Max(MaxTicks, Fixed.Ticks);
+
+			const bool bSuccess = Record.HasFlag(POClaudeJournalFlags::Success);
+			const EPOClaudeJournalSource Source = Record.GetSource();
+
+			FSourceStats& Stats = Sources[Fixed.Source];
+			++Stats.NumRecords;
+			Stats.NumSuccess += bSuccess ? 1 : 0;
+			Stats.NumCancelled += Record.HasFlag(POClaudeJournalFlags::Cancelled) ? 1 : 0;
+			Stats.NumTimedOut += Record.HasFlag(POClaudeJournalFlags::TimedOut) ? 1 : 0;
+
+			if (bSuccess)
+			{
+				Stats.Latencies.Add(Fixed.LatencySeconds);
+				if (Source == EPOClaudeJournalSource::Http && Fixed.TierIndex >= 0)
+				{
+					TierLatencies.FindOrAdd(Fixed.TierIndex).Add(Fixed.LatencySeconds);
+				}
+			}
+
+			// 캐시/로컬 의도로 답한 요청도 "다시 물었다면" 같은 키였으므로 잠재력 계산에 포함
+			if (Fixed.CacheKey != 0)
+			{
+				++NumCacheable;
+				CacheKeys.Add(Fixed.CacheKey);
+			}
+
+			if (Source != EPOClaudeJournalSource::LocalIntent)
+			{
+				++NumPrompts;
+				PromptHashes.Add(Fixed.PromptHash);
+			}
+
+			InputTokens += Fixed.InputTokens;
+			OutputTokens += Fixed.OutputTokens;
+			CacheReadTokens += Fixed.CacheReadInputTokens;
+			CacheCreationTokens += Fixed.CacheCreationInputTokens;
+
+			FNPCStats& NPC = NPCs.FindOrAdd(Fixed.NPCKey);
+			if (NPC.NumRecords == 0)
+			{
+				const auto Name = StringCast<TCHAR>(Record.NPCName.GetData(), Record.NPCName.Len());
+				NPC.Name = FString(Name.Length(), Name.Get());
+			}
+			++NPC.NumRecords;
+			NPC.TotalLatency += Fixed.LatencySeconds;
+			return true;
+		});
+
+		TotalBytes += Reader.GetSize();
+		TrailingBytes += Reader.GetTrailingBytes();
+	}
+
+	const double ScanSeconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogTemp, Display, TEXT("[AnalyzeJournal] 파일 %d개, %lld건, %.1f MB (잘린 꼬리 %lld bytes), 분석 %.2fs"),
+		Paths.Num(), NumRecords, TotalBytes / (1024.0 * 1024.0), TrailingBytes, ScanSeconds);
+
+	if (NumRecords == 0)
+	{
+		return 0;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[AnalyzeJournal] 기간: %s ~ %s (UTC)"),
+		*FDateTime(MinTicks).ToString(), *FDateTime(MaxTicks).ToString());
+
+	UE_LOG(LogTemp, Display, TEXT("[AnalyzeJournal] 출처별 (성공 / 취소 / 기한 초과) 및 성공 응답 지연:"));
+	for (int32 i = 0; i < static_cast<int32>(EPOClaudeJournalSource::Num); ++i)
+	{
+		FSourceStats& Stats = Sources[i];
+		if (Stats.NumRecords == 0)
+		{
+			continue;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("[AnalyzeJournal]   %-12s %lld건 (%.1f%%): 성공 %lld / 취소 %lld / 기한 초과 %lld"),
+			SourceNames[i], Stats.NumRecords, 100.0 * Stats.NumRecords / NumRecords,
+			Stats.NumSuccess, Stats.NumCancelled, Stats.NumTimedOut);
+		LogLatencies(SourceNames[i], Stats.Latencies);
+	}
+
+	if (TierLatencies.Num() > 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[AnalyzeJournal] 모델 티어별 HTTP 지연:"));
+		TierLatencies.KeySort(TLess<int32>());
+		for (TPair<int32, TArray<float>>& Pair : TierLatencies)
+		{
+			LogLatencies(*FString::Printf(TEXT("티어 %d"), Pair.Key), Pair.Value);
+		}
+	}
+
+	// 같은 키가 두 번째부터는 캐시로 답할 수 있었던 요청 (용량/변형 수 제한이 없다는 가정의 상한)
+	const int64 CacheServed = Sources[static_cast<int32>(EPOClaudeJournalSource::Cache)].NumRecords;
+	UE_LOG(LogTemp, Display, TEXT("[AnalyzeJournal] 응답 캐시: 대상 %lld건, 고유 키 %d → 적중 잠재력 %.1f%% (실제 캐시 응답 %.1f%%)"),
+		NumCacheable, CacheKeys.Num(),
+		NumCacheable > 0 ? 100.0 * (NumCacheable - CacheKeys.Num()) / NumCacheable : 0.0,
+		100.0 * CacheServed / NumRecords);
+
+	UE_LOG(LogTemp, Display, TEXT("[AnalyzeJournal] 동일 프롬프트(이력 포함) 반복: %lld건 중 고유 %d → 재사용 잠재력 %.1f%%"),
+		NumPrompts, PromptHashes.Num(),
+		NumPrompts > 0 ? 100.0 * (NumPrompts - PromptHashes.Num()) / NumPrompts : 0.0);
+
+	const int64 PromptTokens = InputTokens + CacheReadTokens + CacheCreationTokens;
+	UE_LOG(LogTemp, Display, TEXT("[AnalyzeJournal] 토큰: 입력 %lld / 캐시 읽기 %lld / 캐시 기록 %lld / 출력 %lld (프롬프트 캐시 적중률 %.1f%%)"),
+		InputTokens, CacheReadTokens, CacheCreationTokens, OutputTokens,
+		PromptTokens > 0 ? 100.0 * CacheReadTokens / PromptTokens : 0.0);
+
+	TArray<FNPCStats> SortedNPCs;
+	NPCs.GenerateValueArray(SortedNPCs);
+	SortedNPCs.Sort([](const FNPCStats& A, const FNPCStats& B) { return A.NumRecords > B.NumRecords; });
+
+	UE_LOG(LogTemp, Display, TEXT("[AnalyzeJournal] NPC %d명 중 요청 상위 %d:"), SortedNPCs.Num(), FMath::Min(TopNPCs, SortedNPCs.Num()));
+	for (int32 i = 0; i < FMath::Min(TopNPCs, SortedNPCs.Num()); ++i)
+	{
+		const FNPCStats& NPC = SortedNPCs[i];
+		UE_LOG(LogTemp, Display, TEXT("[AnalyzeJournal]   %s: %lld건, 평균 지연 %.2fs"),
+			*NPC.Name, NPC.NumRecords, NPC.TotalLatency / NPC.NumRecords);
+	}
+
+	return 0;
+}
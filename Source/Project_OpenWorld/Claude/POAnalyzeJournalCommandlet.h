@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "POAnalyzeJournalCommandlet.generated.h"
+
+/**
+ * 대화 기록(Saved/Claude/Journal/*.pojl) 오프라인 분석 커맨드렛
+ * 기록 파일을 메모리 매핑으로 훑어 출처별 성공률, 지연 분포(p50/p90/p95/p99), 티어별 지연,
+ * 응답 캐시/동일 프롬프트 재사용 잠재력, 토큰 사용량, NPC별 요청 수를 출력한다.
+ *
+ * 실행 예:
+ *   UnrealEditor-Cmd Project_OpenWorld.uproject -run=POAnalyzeJournal [-Dir=경로] [-Top=10]
+ */
+UCLASS()
+class UPOAnalyzeJournalCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPOAnalyzeJournalCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
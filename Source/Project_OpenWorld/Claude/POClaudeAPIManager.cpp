@@ -2,26 +2,390 @@
 #include "HttpModule.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
-#include "Dom/JsonObject.h"
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
-#include "Serialization/JsonWriter.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
-#include "../Weather/POWeatherSystemManager.h"
-#include "../Weather/WeatherTypes.h"
-#include "../TimeOfDay/POTimeOfDayManager.h"
-#include "../RVT/PORVTManager.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "Misc/Paths.h"
+#include "PlatformHttp.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "POClaudeStreamParser.h"
+#include "POClaudeRequestWriter.h"
+#include "POClaudeResponseScanner.h"
+#include "POClaudeTokenEstimator.h"
+#include "POClaudeLocalBackend.h"
+#include "../World/POEnvironmentSubsystem.h"
+#include "../NPC/PONPCCharacter.h"
+#include "TimerManager.h"
+
+// 스트리밍 요청 1건의 공유 상태 (HTTP 수신 스레드 ↔ 게임 스레드)
+struct FPOClaudeStreamState
+{
+	FCriticalSection Lock;
+	FPOClaudeStreamParser Parser;
+
+	// 게임 스레드 전용: 최종 콜백 이후 늦게 도착한 조각 통지를 버리기 위함
+	bool bCompleted = false;
+
+	// 조각 파싱에 쓴 시간 합계 (Lock 안에서 갱신)
+	double ParseSeconds = 0.0;
+};
+
+// 전송 1회의 구간 시각 (HTTP 스레드/게임 스레드 어디서 기록될지 모르므로 원자적)
+struct FPOClaudeRequestTimeline
+{
+	std::atomic<double> ConnectTime{ 0.0 };
+	std::atomic<double> FirstByteTime{ 0.0 };
+
+	static void MarkOnce(std::atomic<double>& Slot, double Now)
+	{
+		double Expected = 0.0;
+		Slot.compare_exchange_strong(Expected, Now, std::memory_order_relaxed);
+	}
+};
+
+namespace POClaudeAPIManagerTrace
+{
+	// Insights 타이밍 영역 이름 (시작/끝이 같은 이름으로 짝지어짐)
+	static FString GetRegionName(int32 RequestId)
+	{
+		return FString::Printf(TEXT("Claude #%d"), RequestId);
+	}
+}
 
 APOClaudeAPIManager::APOClaudeAPIManager()
 {
 	PrimaryActorTick.bCanEverTick = false;
+
+	LocalIntentHits = TStaticArray<int32, NumLocalIntents>(InPlace, 0);
+	LocalIntentMisses = TStaticArray<int32, NumLocalIntents>(InPlace, 0);
+
+	// 짧은 잡담은 빠른 모델, 긴 질문/깊은 대화/중요 NPC는 큰 모델
+	FClaudeModelTier& FastTier = ModelTiers.AddDefaulted_GetRef();
+	FastTier.ModelID          = TEXT("claude-haiku-4-5");
+	FastTier.MaxTokens        = 150;
+	FastTier.MinComplexity    = 0.0f;
+	FastTier.P95BudgetSeconds = 3.0f;
+
+	FClaudeModelTier& LargeTier = ModelTiers.AddDefaulted_GetRef();
+	LargeTier.ModelID          = TEXT("claude-sonnet-4-5");
+	LargeTier.MaxTokens        = 300;
+	LargeTier.MinComplexity    = 0.35f;
+	LargeTier.P95BudgetSeconds = 6.0f;
 }
 
 void APOClaudeAPIManager::BeginPlay()
 {
 	Super::BeginPlay();
 	LoadAPIKeyFromConfig();
+
+	RateLimiter.Configure(RequestsPerMinute, TokensPerMinute);
+
+	if (bEnableModelRouting)
+	{
+		ModelRouter.Configure(ModelTiers, LongMessageChars, DeepConversationTurns, LatencyWindowSeconds, MinLatencySamples);
+	}
+	RetryRandom.Initialize(static_cast<int32>(FPlatformTime::Cycles()));
+
+	if (bEnableResponseCache)
+	{
+		ResponseCache = MakeUnique<FPOClaudeResponseCache>();
+		ResponseCache->Configure(static_cast<int64>(ResponseCacheBudgetKB) * 1024, ResponseCacheVariants);
+
+		if (bPersistResponseCache)
+		{
+			ResponseCache->LoadFromDisk(GetResponseCachePath());
+		}
+	}
+
+	TWeakObjectPtr<APOClaudeAPIManager> WeakThis(this);
+	MetricsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float)
+	{
+		if (const APOClaudeAPIManager* Manager = WeakThis.Get())
+		{
+			FPOClaudeMetrics::Get().Publish(Manager->NumQueuedRequests, Manager->NumInFlightRequests);
+		}
+		return true;
+	}));
+
+	if (bEnableJournal)
+	{
+		Journal = MakeUnique<FPOClaudeJournalWriter>();
+		if (!Journal->Start(GetJournalDirectory(), static_cast<int64>(JournalMaxFileMB) * 1024 * 1024, JournalMaxFiles))
+		{
+			Journal.Reset();
+		}
+	}
+
+	if (bEnableMemory)
+	{
+		MemoryStore.Configure(MaxMemoriesPerNPC);
+
+		if (bPersistMemory)
+		{
+			MemoryStore.LoadFromDisk(GetMemoryPath());
+		}
+	}
+
+	if (Backend != EClaudeBackend::Http)
+	{
+		CreateOfflineBackend();
+	}
+
+	if (bEnableGreetingPrefetch)
+	{
+		GetWorldTimerManager().SetTimer(
+			PrefetchScanTimerHandle,
+			this,
+			&APOClaudeAPIManager::ScanPrefetchCandidates,
+			PrefetchScanInterval,
+			true  // 반복
+		);
+	}
+}
+
+void APOClaudeAPIManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(PrefetchScanTimerHandle);
+	GetWorldTimerManager().ClearTimer(PumpTimerHandle);
+	GetWorldTimerManager().ClearTimer(SLOTimerHandle);
+
+	// 첫 텍스트를 기다리던 감시 항목은 콜백 없이 취소로 확정하고 미결로 집계
+	int32 NumUnresolvedSLO = 0;
+	for (const FSLOWatch& Watch : SLOWatches)
+	{
+		if (CancelWithoutCallbacks(Watch.State))
+		{
+			++NumUnresolvedSLO;
+		}
+	}
+	SLOWatches.Reset();
+
+	// 전송 중인 HTTP 요청은 완료 콜백을 끊고 중단한 뒤 콜백 없이 취소로 확정 (종료 중인 매니저로 응답이 들어오지 않도록)
+	for (TPair<int32, FInFlightHttpRequest>& Pair : InFlightHttpRequests)
+	{
+		FInFlightHttpRequest& InFlight = Pair.Value;
+		InFlight.State->RequestCancel();
+		CancelWithoutCallbacks(InFlight.State);
+		InFlight.Request->OnProcessRequestComplete().Unbind();
+		InFlight.Request->CancelRequest();
+	}
+	if (InFlightHttpRequests.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 전송 중이던 요청 %d개 중단"), InFlightHttpRequests.Num());
+	}
+	InFlightHttpRequests.Reset();
+
+	// 프리페치 인사말을 기다리던 요청도 취소로 확정 (프리페치 완료 콜백이 끊겨 OnGreetingPrefetched가 오지 않음)
+	for (TPair<FObjectKey, FGreetingPrefetch>& Pair : GreetingPrefetches)
+	{
+		if (Pair.Value.Waiter.IsSet())
+		{
+			CancelWithoutCallbacks(Pair.Value.Waiter->State);
+		}
+	}
+	GreetingPrefetches.Reset();
+
+	if (NumLocalIntentChecks > 0)
+	{
+		DumpLocalIntentStats(*GLog);
+	}
+
+	if (ModelRouter.IsEnabled())
+	{
+		DumpRoutingStats(*GLog);
+	}
+
+	if (NumSLORequests > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 지연 목표 요청 %d / 폴백 %d (%.1f%%) / 후속 전달 %d / 종료 시 미결 %d"),
+			NumSLORequests, NumFallbackReplies, GetFallbackRate() * 100.0f, NumFollowUpReplies, NumUnresolvedSLO);
+	}
+
+	// 남은 대기 요청은 콜백 없이 취소로 확정 (핸들의 퓨처가 영원히 기다리지 않도록)
+	for (const FPendingRequest& Pending : PendingQueue)
+	{
+		CancelWithoutCallbacks(Pending.State);
+	}
+	PendingQueue.Reset();
+	NumQueuedRequests = 0;
+
+	if (OfflineBackend)
+	{
+		// 생성 중인 요청도 콜백 없이 취소로 확정
+		OfflineBackend->Shutdown();
+		OfflineBackend.Reset();
+
+		if (NumOfflineRequests > 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 로컬 모델 응답 %d"), NumOfflineRequests);
+		}
+	}
+
+	if (NumPrefetchIssued > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 인사말 프리페치 발행 %d / 사용 %d / 폐기 %d"),
+			NumPrefetchIssued, NumPrefetchServed, NumPrefetchDiscarded);
+	}
+
+	if (ResponseCache)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 응답 캐시 적중 %d / 미스 %d (항목 %d, %lld bytes)"),
+			ResponseCache->GetHits(), ResponseCache->GetMisses(),
+			ResponseCache->Num(), ResponseCache->GetMemoryUsage());
+
+		if (bPersistResponseCache)
+		{
+			ResponseCache->SaveToDisk(GetResponseCachePath());
+		}
+		ResponseCache.Reset();
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(MetricsTickerHandle);
+	MetricsTickerHandle.Reset();
+	FPOClaudeMetrics::Get().Dump(*GLog);
+
+	if (Journal)
+	{
+		// 남은 기록을 모두 쓴 뒤 종료
+		Journal->Shutdown();
+
+		const FPOClaudeJournalStats Stats = Journal->GetStats();
+		UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 대화 기록 %lld건 (%lld bytes, 파일 %d개, 버림 %lld): %s"),
+			Stats.NumWritten, Stats.BytesWritten, Stats.NumFiles, Stats.NumDropped, *Journal->GetDirectory());
+		Journal.Reset();
+	}
+
+	if (bEnableMemory && MemoryStore.GetNumFacts() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 기억 NPC %d / 사실 %d (%lld bytes)"),
+			MemoryStore.GetNumNPCs(), MemoryStore.GetNumFacts(), MemoryStore.GetMemoryUsage());
+
+		if (bPersistMemory)
+		{
+			MemoryStore.SaveToDisk(GetMemoryPath());
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FString APOClaudeAPIManager::GetResponseCachePath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("Claude") / TEXT("ResponseCache.bin");
+}
+
+FString APOClaudeAPIManager::GetMemoryPath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("Claude") / TEXT("Memory.bin");
+}
+
+FString APOClaudeAPIManager::GetJournalDirectory() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("Claude") / TEXT("Journal");
+}
+
+void APOClaudeAPIManager::RecordExchange(
+	const FRequestStateRef& State,
+	const FClaudeRequestContext& Context,
+	EPOClaudeJournalSource Source,
+	double StartTime,
+	bool bSuccess,
+	const FString& Text,
+	const FClaudeUsage& Usage,
+	int32 TierIndex,
+	uint64 CacheKey,
+	int32 StatusCode)
+{
+	const double Now = FPlatformTime::Seconds();
+	const bool bCancelled = State->IsCancelRequested();
+	const bool bTimedOut = !bSuccess && Now >= State->Deadline;
+
+	// 지표: 모델까지 간 요청만 전체 지연에 넣음 (캐시/로컬 의도 응답은 0에 가까워 분포를 흐림)
+	FPOClaudeMetrics& Metrics = FPOClaudeMetrics::Get();
+	if (bSuccess)
+	{
+		Metrics.RecordSuccess();
+	}
+	else if (!bCancelled)
+	{
+		// HTTP 연결 실패/상태 코드 오류는 재시도된 것까지 전송마다 완료 콜백에서 이미 셈
+		EPOClaudeErrorKind Kind = EPOClaudeErrorKind::Num;
+		if (Source == EPOClaudeJournalSource::Local)
+		{
+			Kind = bTimedOut ? EPOClaudeErrorKind::Timeout : EPOClaudeErrorKind::LocalBackend;
+		}
+		else if (Source == EPOClaudeJournalSource::Http && StatusCode == 200)
+		{
+			Kind = EPOClaudeErrorKind::Parse;
+		}
+
+		if (Kind != EPOClaudeErrorKind::Num)
+		{
+			Metrics.RecordError(Kind);
+			TRACE_BOOKMARK(TEXT("Claude #%d %s"), State->RequestId, FPOClaudeMetrics::GetErrorKindName(Kind));
+		}
+	}
+
+	if (Source == EPOClaudeJournalSource::Http || Source == EPOClaudeJournalSource::Local)
+	{
+		if (!bCancelled)
+		{
+			Metrics.Total.RecordSeconds(Now - StartTime);
+		}
+		if (Source == EPOClaudeJournalSource::Http)
+		{
+			Metrics.RecordUsage(Usage);
+		}
+	}
+
+	if (!Journal)
+	{
+		return;
+	}
+
+	FPOClaudeJournalEntry Entry;
+	FPOClaudeJournalFixed& Fixed = Entry.Fixed;
+	Fixed.Ticks                    = FDateTime::UtcNow().GetTicks();
+	Fixed.NPCKey                   = FPOClaudePromptBuilder::GetArchetypeKey(Context);
+	Fixed.PromptHash               = FPOClaudeJournalWriter::HashPrompt(Context);
+	Fixed.CacheKey                 = CacheKey;
+	Fixed.RequestId                = State->RequestId;
+	Fixed.LatencySeconds           = static_cast<float>(Now - StartTime);
+	Fixed.TimeOfDay                = Context.TimeOfDay;
+	Fixed.InputTokens              = Usage.InputTokens;
+	Fixed.OutputTokens             = Usage.OutputTokens;
+	Fixed.CacheReadInputTokens     = Usage.CacheReadInputTokens;
+	Fixed.CacheCreationInputTokens = Usage.CacheCreationInputTokens;
+	Fixed.StatusCode               = static_cast<int16>(StatusCode);
+	Fixed.TierIndex                = static_cast<int8>(TierIndex);
+	Fixed.Source                   = static_cast<uint8>(Source);
+	Fixed.NumHistoryTurns          = static_cast<uint8>(FMath::Min(Context.History.Num(), 255));
+
+	Fixed.Flags |= bSuccess ? POClaudeJournalFlags::Success : 0;
+	Fixed.Flags |= bCancelled ? POClaudeJournalFlags::Cancelled : 0;
+	Fixed.Flags |= bTimedOut ? POClaudeJournalFlags::TimedOut : 0;
+	Fixed.Flags |= (Context.History.Num() > 0 || !Context.HistorySummary.IsEmpty()) ? POClaudeJournalFlags::HasHistory : 0;
+
+	Entry.NPCName       = Context.NPCName;
+	Entry.WeatherType   = Context.WeatherType;
+	Entry.PlayerMessage = Context.PlayerMessage;
+	Entry.Response      = Text;
+
+	Journal->Append(MoveTemp(Entry));
+}
+
+void APOClaudeAPIManager::RecordExchange(
+	const FPendingRequest& Sent,
+	EPOClaudeJournalSource Source,
+	bool bSuccess,
+	const FString& Text,
+	const FClaudeUsage& Usage,
+	int32 StatusCode)
+{
+	RecordExchange(Sent.State, Sent.Context, Source, Sent.EnqueueTime, bSuccess, Text, Usage, Sent.TierIndex, Sent.CacheKey, StatusCode);
 }
 
 void APOClaudeAPIManager::LoadAPIKeyFromConfig()
@@ -30,7 +394,17 @@ void APOClaudeAPIManager::LoadAPIKeyFromConfig()
 	{
 		GConfig->GetString(TEXT("Claude"), TEXT("APIKey"), APIKey, GGameIni);
 
-		if (APIKey.IsEmpty())
+		FString ConfigEndpointURL;
+		if (GConfig->GetString(TEXT("Claude"), TEXT("EndpointURL"), ConfigEndpointURL, GGameIni) && !ConfigEndpointURL.IsEmpty())
+		{
+			EndpointURL = ConfigEndpointURL;
+		}
+
+		if (IsLoopbackEndpoint())
+		{
+			UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 루프백 엔드포인트 사용: %s"), *EndpointURL);
+		}
+		else if (APIKey.IsEmpty())
 		{
 			UE_LOG(LogTemp, Warning,
 				TEXT("[ClaudeAPIManager] API 키가 DefaultGame.ini [Claude] APIKey에 설정되지 않았습니다."));
@@ -43,251 +417,1604 @@ void APOClaudeAPIManager::LoadAPIKeyFromConfig()
 	}
 }
 
-void APOClaudeAPIManager::SendMessageToClaude(const FClaudeRequestContext& Context,const FOnClaudeResponse& ResponseCallback)
+void APOClaudeAPIManager::CreateOfflineBackend()
 {
-	if (bRequestInProgress)
+	FPOClaudeLocalBackendSettings Settings;
+	Settings.ModelPath        = FPaths::IsRelative(LocalModelPath) ? FPaths::ProjectContentDir() / LocalModelPath : LocalModelPath;
+	Settings.NumWorkers       = LocalWorkerThreads;
+	Settings.ThreadsPerWorker = LocalThreadsPerWorker;
+	Settings.ContextTokens    = LocalContextTokens;
+
+	TUniquePtr<FPOClaudeLocalBackend> LocalBackend = MakeUnique<FPOClaudeLocalBackend>();
+	if (LocalBackend->Initialize(Settings))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[ClaudeAPIManager] 이미 요청 처리 중입니다."));
-		ResponseCallback.ExecuteIfBound(false, TEXT("잠시 후 다시 말씀해 주세요."));
-		return;
+		OfflineBackend = MoveTemp(LocalBackend);
 	}
-
-	if (APIKey.IsEmpty())
+	else if (Backend == EClaudeBackend::Local)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[ClaudeAPIManager] API 키가 설정되지 않았습니다."));
-		ResponseCallback.ExecuteIfBound(false, TEXT("(API 키 오류)"));
-		return;
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeAPIManager] 로컬 모델을 쓸 수 없어 Claude API로 보냅니다."));
 	}
+}
 
-	bRequestInProgress = true;
-
-	FHttpModule& HttpModule = FHttpModule::Get();
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = HttpModule.CreateRequest();
+bool APOClaudeAPIManager::ShouldUseOfflineBackend() const
+{
+	if (!OfflineBackend || !OfflineBackend->IsAvailable())
+	{
+		return false;
+	}
 
-	Request->SetURL(TEXT("https://api.anthropic.com/v1/messages"));
-	Request->SetVerb(TEXT("POST"));
-	Request->SetHeader(TEXT("Content-Type"),       TEXT("application/json"));
-	Request->SetHeader(TEXT("x-api-key"),          APIKey);
-	Request->SetHeader(TEXT("anthropic-version"),  TEXT("2023-06-01"));
-	Request->SetContentAsString(BuildRequestJson(Context));
+	switch (Backend)
+	{
+	case EClaudeBackend::Local:
+		return true;
 
-	Request->OnProcessRequestComplete().BindLambda(
-		[this, ResponseCallback](
-			FHttpRequestPtr Req,
-			FHttpResponsePtr Res,
-			bool bConnectedSuccessfully)
-		{
-			bRequestInProgress = false;
+	case EClaudeBackend::Auto:
+		return (APIKey.IsEmpty() && !IsLoopbackEndpoint()) || FPlatformTime::Seconds() < OfflineUntil;
 
-			if (!bConnectedSuccessfully || !Res.IsValid())
-			{
-				UE_LOG(LogTemp, Error, TEXT("[ClaudeAPIManager] HTTP 연결 실패"));
-				ResponseCallback.ExecuteIfBound(false, TEXT("(네트워크 오류)"));
-				return;
-			}
+	default:
+		return false;
+	}
+}
 
-			const int32 StatusCode = Res->GetResponseCode();
-			if (StatusCode != 200)
-			{
-				UE_LOG(LogTemp, Error,
-					TEXT("[ClaudeAPIManager] API 오류 %d: %s"),
-					StatusCode, *Res->GetContentAsString());
-				ResponseCallback.ExecuteIfBound(false,
-					FString::Printf(TEXT("(API 오류: %d)"), StatusCode));
-				return;
-			}
+bool APOClaudeAPIManager::IsLoopbackEndpoint() const
+{
+	const FString Domain = FPlatformHttp::GetUrlDomain(EndpointURL);
+	return Domain == TEXT("127.0.0.1") || Domain.Equals(TEXT("localhost"), ESearchCase::IgnoreCase);
+}
 
-			const FString ParsedText = ParseClaudeResponse(Res->GetContentAsString());
-			UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 응답 수신: %s"), *ParsedText);
-			ResponseCallback.ExecuteIfBound(true, ParsedText);
-		});
+void APOClaudeAPIManager::SendMessageToClaude(const FClaudeRequestContext& Context,const FOnClaudeResponse& ResponseCallback)
+{
+	FClaudeRequestCallbacks Callbacks;
+	Callbacks.OnResponse = ResponseCallback;
+	EnqueueRequest(Context, Callbacks);
+}
 
-	Request->ProcessRequest();
-	UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 요청 전송 중... (날씨: %s, 시간: %.1fh)"),
-		*Context.WeatherType, Context.TimeOfDay);
+void APOClaudeAPIManager::SendMessageToClaudeWithQueueStatus(
+	const FClaudeRequestContext& Context,
+	const FOnClaudeResponse& ResponseCallback,
+	const FOnClaudeQueueStatus& QueueStatusCallback)
+{
+	FClaudeRequestCallbacks Callbacks;
+	Callbacks.OnResponse    = ResponseCallback;
+	Callbacks.OnQueueStatus = QueueStatusCallback;
+	EnqueueRequest(Context, Callbacks);
 }
 
-void APOClaudeAPIManager::SendMessageWithAutoContext(
-	const FString& PlayerMessage,
-	const FString& NPCName,
-	const FString& NPCPersonality,
-	const FOnClaudeResponse& ResponseCallback)
+bool APOClaudeAPIManager::TryAnswerLocally(
+	const FClaudeRequestContext& Context,
+	const FObjectKey& OwnerKey,
+	uint32 Seed,
+	FString& OutText)
 {
-	FClaudeRequestContext Ctx;
-	Ctx.PlayerMessage   = PlayerMessage;
-	Ctx.NPCName         = NPCName;
-	Ctx.NPCPersonality  = NPCPersonality;
+	++NumLocalIntentChecks;
 
-	// WeatherManager에서 현재 날씨 수집
-	APOWeatherSystemManager* WM = FindWeatherManager();
-	if (WM)
-	{
-		static const TMap<EWeatherType, FString> WeatherNames = {
-			{EWeatherType::Clear,  TEXT("맑음")},
-			{EWeatherType::Cloudy, TEXT("흐림")},
-			{EWeatherType::Rainy,  TEXT("비")},
-			{EWeatherType::Snowy,  TEXT("눈")},
-			{EWeatherType::Foggy,  TEXT("안개")},
-			{EWeatherType::Stormy, TEXT("폭풍")}
-		};
-		const EWeatherType WT = WM->GetCurrentWeather();
-		Ctx.WeatherType = WeatherNames.Contains(WT) ? WeatherNames[WT] : TEXT("맑음");
-	}
-
-	// RVTManager에서 날씨 수치 파라미터 수집
-	APORVTManager* RVT = FindRVTManager();
-	if (RVT)
-	{
-		Ctx.RainIntensity = RVT->RainIntensity;
-		Ctx.SnowCoverage  = RVT->SnowCoverage;
-		Ctx.WindStrength  = RVT->WindStrength;
+	FPOClaudeIntentMatch Match;
+	IntentMatcher.Match(Context.PlayerMessage, Match);
+	if (Match.Intent == EClaudeLocalIntent::None || Match.bForceAPI)
+	{
+		// 다른 때/까닭을 묻는 메시지는 규칙 표를 늘릴 후보가 아니므로 놓침으로 세지 않음
+		return false;
 	}
 
-	// TimeOfDayManager에서 현재 시간 수집
-	APOTimeOfDayManager* TM = FindTimeOfDayManager();
-	if (TM)
+	const int32 IntentIndex = static_cast<int32>(Match.Intent);
+	if (!Match.IsAnswerable(MaxUnmatchedChars)
+		|| !LocalReplies.Format(Match.Intent, OwnerKey, Context, Seed, OutText))
 	{
-		Ctx.TimeOfDay = TM->GetCurrentTime();
+		// 의도는 보였지만 API로 보낸 메시지는 규칙 표를 늘릴 후보로 기록
+		++LocalIntentMisses[IntentIndex];
+		if (RecentIntentMisses.Num() < MaxRecentIntentMisses)
+		{
+			RecentIntentMisses.Add(Context.PlayerMessage);
+		}
+		else
+		{
+			RecentIntentMisses[NextIntentMissSlot] = Context.PlayerMessage;
+		}
+		NextIntentMissSlot = (NextIntentMissSlot + 1) % MaxRecentIntentMisses;
+		return false;
 	}
 
-	SendMessageToClaude(Ctx, ResponseCallback);
+	++LocalIntentHits[IntentIndex];
+	++NumLocalIntentReplies;
+
+	UE_LOG(LogTemp, Verbose, TEXT("[ClaudeAPIManager] 로컬 의도 응답 (%s): %s"),
+		*StaticEnum<EClaudeLocalIntent>()->GetNameStringByValue(IntentIndex), *OutText);
+	return true;
 }
 
-FString APOClaudeAPIManager::BuildSystemPrompt(const FClaudeRequestContext& Context) const
+void APOClaudeAPIManager::DumpRoutingStats(FOutputDevice& Ar) const
 {
-	// 시간대 설명
-	const FString TimeDesc = TimeOfDayToKorean(Context.TimeOfDay);
+	ModelRouter.Dump(Ar, FPlatformTime::Seconds());
+	Ar.Logf(TEXT("[ClaudeAPIManager] 지연 예산 초과로 강등한 요청 %d"), NumDowngradedRequests);
+}
 
-	// 날씨 수치 → 상세 묘사 문자열
-	FString WeatherDetail;
-	if (Context.RainIntensity > 0.5f)
-		WeatherDetail += TEXT("비가 세차게 내리고 있습니다. ");
-	else if (Context.RainIntensity > 0.1f)
-		WeatherDetail += TEXT("가랑비가 내리고 있습니다. ");
+void APOClaudeAPIManager::ResetRoutingStats()
+{
+	ModelRouter.ResetStats();
+	NumDowngradedRequests = 0;
+}
 
-	if (Context.SnowCoverage > 0.5f)
-		WeatherDetail += TEXT("눈이 많이 쌓여있습니다. ");
-	else if (Context.SnowCoverage > 0.1f)
-		WeatherDetail += TEXT("눈이 살짝 쌓여있습니다. ");
+int32 APOClaudeAPIManager::GetLocalIntentHits(EClaudeLocalIntent Intent) const
+{
+	const int32 Index = static_cast<int32>(Intent);
+	return Index < NumLocalIntents ? LocalIntentHits[Index] : 0;
+}
 
-	if (Context.WindStrength > 0.7f)
-		WeatherDetail += TEXT("바람이 매우 강하게 붑니다. ");
-	else if (Context.WindStrength > 0.3f)
-		WeatherDetail += TEXT("바람이 제법 붑니다. ");
+void APOClaudeAPIManager::DumpLocalIntentStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("[ClaudeAPIManager] 로컬 의도: 판정 %d / 로컬 응답 %d (%.1f%%)"),
+		NumLocalIntentChecks, NumLocalIntentReplies, GetLocalIntentHitRate() * 100.0f);
 
-	if (WeatherDetail.IsEmpty())
-		WeatherDetail = TEXT("특별한 이상 날씨는 없습니다.");
+	const UEnum* IntentEnum = StaticEnum<EClaudeLocalIntent>();
+	for (int32 Index = 1; Index < NumLocalIntents; ++Index)
+	{
+		const int32 Seen = LocalIntentHits[Index] + LocalIntentMisses[Index];
+		Ar.Logf(TEXT("  %-10s 적중 %5d / 놓침 %5d (적중률 %.1f%%)"),
+			*IntentEnum->GetNameStringByValue(Index), LocalIntentHits[Index], LocalIntentMisses[Index],
+			Seen > 0 ? 100.0f * LocalIntentHits[Index] / Seen : 0.0f);
+	}
 
-	return FString::Printf(
-		TEXT(
-		"당신은 '%s'라는 이름의 %s입니다.\n"
-		"\n"
-		"## 현재 환경 정보\n"
-		"- 날씨: %s\n"
-		"- 시간: %.1f시 (%s)\n"
-		"- 날씨 상세: %s\n"
-		"\n"
-		"## 대화 규칙\n"
-		"1. 반드시 한국어로만 답하세요.\n"
-		"2. 현재 날씨와 시간을 반드시 대화에 자연스럽게 녹여내세요.\n"
-		"   - 비/폭풍 날씨: 불편함, 처마 밑으로 피하고 싶다는 표현 포함\n"
-		"   - 눈 날씨: 추위, 손 시림, 발이 미끄럽다는 표현 포함\n"
-		"   - 안개 날씨: 앞이 안 보인다, 방향 잃을 것 같다는 표현 포함\n"
-		"   - 맑은 날씨: 기분 좋음, 날씨 칭찬 포함\n"
-		"   - 야간(18시~06시): 어둠, 피곤함, 집에 들어가고 싶다는 표현 포함\n"
-		"3. 답변은 2~4문장으로 간결하게 하세요.\n"
-		"4. 마을 주민답게 소박하고 친근하게 말하세요.\n"
-		"5. 게임 캐릭터라는 사실을 절대 언급하지 마세요.\n"
-		),
-		*Context.NPCName,
-		*Context.NPCPersonality,
-		*Context.WeatherType,
-		Context.TimeOfDay,
-		*TimeDesc,
-		*WeatherDetail
-	);
+	if (RecentIntentMisses.Num() > 0)
+	{
+		Ar.Logf(TEXT("  최근 놓친 메시지 (의도는 걸렸지만 API로 보냄):"));
+		for (const FString& Message : RecentIntentMisses)
+		{
+			Ar.Logf(TEXT("    \"%s\""), *Message);
+		}
+	}
 }
 
-FString APOClaudeAPIManager::BuildRequestJson(const FClaudeRequestContext& Context) const
+void APOClaudeAPIManager::ResetLocalIntentStats()
 {
-	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetStringField(TEXT("model"),      ModelID);
-	Root->SetNumberField(TEXT("max_tokens"), MaxTokens);
-	Root->SetStringField(TEXT("system"),     BuildSystemPrompt(Context));
-
-	TArray<TSharedPtr<FJsonValue>> Messages;
-	TSharedRef<FJsonObject> UserMsg = MakeShared<FJsonObject>();
-	UserMsg->SetStringField(TEXT("role"),    TEXT("user"));
-	UserMsg->SetStringField(TEXT("content"), Context.PlayerMessage);
-	Messages.Add(MakeShared<FJsonValueObject>(UserMsg));
-	Root->SetArrayField(TEXT("messages"), Messages);
-
-	FString Output;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
-	FJsonSerializer::Serialize(Root, Writer);
-	return Output;
+	NumLocalIntentChecks = 0;
+	NumLocalIntentReplies = 0;
+	for (int32 Index = 0; Index < NumLocalIntents; ++Index)
+	{
+		LocalIntentHits[Index] = 0;
+		LocalIntentMisses[Index] = 0;
+	}
+	RecentIntentMisses.Reset();
+	NextIntentMissSlot = 0;
 }
 
-FString APOClaudeAPIManager::ParseClaudeResponse(const FString& ResponseBody) const
+FPOClaudeRequestHandle APOClaudeAPIManager::EnqueueRequest(
+	const FClaudeRequestContext& Context,
+	const FClaudeRequestCallbacks& Callbacks,
+	const FClaudeRequestOptions& Options)
 {
-	TSharedPtr<FJsonObject> JsonObj;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseBody);
+	SCOPE_CYCLE_COUNTER(STAT_ClaudeEnqueue);
+	TRACE_CPUPROFILER_EVENT_SCOPE(Claude_EnqueueRequest);
+	FScopedDurationTimer GameThreadTimer(EnqueueGameThreadSeconds);
+	const double StartTime = FPlatformTime::Seconds();
 
-	if (!FJsonSerializer::Deserialize(Reader, JsonObj) || !JsonObj.IsValid())
+	FPOClaudeMetrics::Get().RecordRequest();
+
+	const FRequestStateRef State = MakeRequestState(Callbacks, Options.TimeoutSeconds);
+	const FPOClaudeRequestHandle Handle(State);
+
+	// 인사/작별/감사/날씨·시간 질문은 API 왕복 없이 페르소나 템플릿으로 바로 응답
+	FString LocalText;
+	if (bEnableLocalIntents && !Options.bSkipLocalIntents && TryAnswerLocally(Context, FObjectKey(Callbacks.GetOwner()), State->RequestId, LocalText))
 	{
-		UE_LOG(LogTemp, Error, TEXT("[ClaudeAPIManager] JSON 파싱 실패"));
-		return TEXT("(응답을 읽을 수 없습니다.)");
+		RecordExchange(State, Context, EPOClaudeJournalSource::LocalIntent, StartTime, true, LocalText);
+		DeliverResponse(State, Callbacks, EClaudeRequestOutcome::Completed, true, LocalText);
+		return Handle;
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* ContentArray = nullptr;
-	if (!JsonObj->TryGetArrayField(TEXT("content"), ContentArray) || !ContentArray)
+	if (APIKey.IsEmpty() && !IsLoopbackEndpoint() && !ShouldUseOfflineBackend())
 	{
-		UE_LOG(LogTemp, Error, TEXT("[ClaudeAPIManager] content 필드 없음"));
-		return TEXT("(응답 형식 오류)");
+		UE_LOG(LogTemp, Error, TEXT("[ClaudeAPIManager] API 키가 설정되지 않았습니다."));
+		DeliverResponse(State, Callbacks, EClaudeRequestOutcome::Completed, false, TEXT("(API 키 오류)"));
+		return Handle;
 	}
 
-	for (const TSharedPtr<FJsonValue>& Item : *ContentArray)
+	// 캐시 적중 시 API 호출 없이 바로 응답 (이전 대화나 기억이 있으면 같은 메시지라도 답이 달라지므로 제외)
+	uint64 CacheKey = 0;
+	const bool bHasHistory = Context.History.Num() > 0 || !Context.HistorySummary.IsEmpty()
+		|| (bEnableMemory && MemoryStore.HasFacts(FPOClaudePromptBuilder::GetArchetypeKey(Context)));
+	if (ResponseCache && !bHasHistory)
 	{
-		TSharedPtr<FJsonObject> ItemObj = Item->AsObject();
-		if (!ItemObj.IsValid()) continue;
+		CacheKey = FPOClaudeResponseCache::MakeKey(Context, TimeOfDayToKorean(Context.TimeOfDay));
 
-		FString Type;
-		if (ItemObj->TryGetStringField(TEXT("type"), Type) && Type == TEXT("text"))
+		FString CachedText;
+		if (ResponseCache->Find(CacheKey, CachedText))
 		{
-			FString Text;
-			ItemObj->TryGetStringField(TEXT("text"), Text);
-			return Text;
+			UE_LOG(LogTemp, Verbose, TEXT("[ClaudeAPIManager] 응답 캐시 적중: %s"), *CachedText);
+			RecordExchange(State, Context, EPOClaudeJournalSource::Cache, StartTime, true, CachedText, FClaudeUsage(), INDEX_NONE, CacheKey);
+			DeliverResponse(State, Callbacks, EClaudeRequestOutcome::Completed, true, CachedText);
+			return Handle;
 		}
 	}
 
-	return TEXT("(빈 응답)");
-}
+	const FObjectKey OwnerKey(Callbacks.GetOwner());
 
-FString APOClaudeAPIManager::TimeOfDayToKorean(float TimeOfDay) const
-{
-	if (TimeOfDay >= 5.0f && TimeOfDay < 9.0f)   return TEXT("이른 아침");
-	if (TimeOfDay >= 9.0f && TimeOfDay < 12.0f)  return TEXT("오전");
-	if (TimeOfDay >= 12.0f && TimeOfDay < 14.0f) return TEXT("정오");
-	if (TimeOfDay >= 14.0f && TimeOfDay < 18.0f) return TEXT("오후");
-	if (TimeOfDay >= 18.0f && TimeOfDay < 21.0f) return TEXT("저녁");
-	if (TimeOfDay >= 21.0f && TimeOfDay < 24.0f) return TEXT("밤");
-	return TEXT("새벽");
-}
+	int32 OwnerQueued = 0;
+	for (const FPendingRequest& Pending : PendingQueue)
+	{
+		if (Pending.OwnerKey == OwnerKey)
+		{
+			++OwnerQueued;
+		}
+	}
 
-APOWeatherSystemManager* APOClaudeAPIManager::FindWeatherManager() const
-{
-	AActor* Found = UGameplayStatics::GetActorOfClass(GetWorld(), APOWeatherSystemManager::StaticClass());
-	return Cast<APOWeatherSystemManager>(Found);
+	if (PendingQueue.Num() >= MaxQueuedRequests || OwnerQueued >= MaxQueuedPerOwner)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeAPIManager] 대기열이 가득 찼습니다. (대기 %d, 소유자 대기 %d)"),
+			PendingQueue.Num(), OwnerQueued);
+
+		// 거절을 일반 실패와 구분할 수 있도록 위치 -1과 지금 줄을 섰다면 기다렸을 시간을 먼저 통지
+		Callbacks.OnQueueStatus.ExecuteIfBound(INDEX_NONE, EstimateWaitSeconds(PendingQueue.Num() + 1));
+		DeliverResponse(State, Callbacks, EClaudeRequestOutcome::Completed, false, TEXT("잠시 후 다시 말씀해 주세요."));
+		return Handle;
+	}
+
+	FPendingRequest& Pending = PendingQueue.Emplace_GetRef(State);
+	Pending.Context     = Context;
+	Pending.Callbacks   = Callbacks;
+	Pending.OwnerKey    = OwnerKey;
+	Pending.EnqueueTime = FPlatformTime::Seconds();
+	Pending.CacheKey    = CacheKey;
+	Pending.EstimatedTokens = EstimateRequestTokens(Context);
+	Pending.Deadline    = FMath::Min(Pending.EnqueueTime + RetryDeadlineSeconds, State->Deadline);
+
+	const int32 RequestId = Pending.RequestId;
+
+	// 스트리밍을 끄면 첫 텍스트가 곧 전체 응답이라 지연 목표가 거의 매번 넘어가므로 감시하지 않음
+	if (bUseStreaming && Options.FirstTextSLOSeconds > 0.0f)
+	{
+		StartSLOWatch(State, Callbacks, Context, Options.FirstTextSLOSeconds);
+	}
+
+	PumpQueue();
+
+	// 바로 전송되지 못했다면 대기 위치 통지
+	const int32 QueueIndex = PendingQueue.IndexOfByPredicate(
+		[RequestId](const FPendingRequest& P) { return P.RequestId == RequestId; });
+	if (QueueIndex != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 요청 #%d 대기열 등록 (위치: %d, 전송 중: %d)"),
+			RequestId, QueueIndex + 1, NumInFlightRequests);
+		PendingQueue[QueueIndex].bWasQueued = true;
+		Callbacks.OnQueueStatus.ExecuteIfBound(QueueIndex + 1, EstimateWaitSeconds(QueueIndex + 1));
+	}
+
+	return Handle;
 }
 
-APOTimeOfDayManager* APOClaudeAPIManager::FindTimeOfDayManager() const
+APOClaudeAPIManager::FRequestStateRef APOClaudeAPIManager::MakeRequestState(const FClaudeRequestCallbacks& Callbacks, float TimeoutSeconds)
 {
-	AActor* Found = UGameplayStatics::GetActorOfClass(GetWorld(), APOTimeOfDayManager::StaticClass());
-	return Cast<APOTimeOfDayManager>(Found);
+	const float Timeout = TimeoutSeconds > 0.0f ? TimeoutSeconds : RequestTimeoutSeconds;
+	const int32 RequestId = NextRequestId++;
+
+	// 요청 수명 전체를 Insights 타이밍 영역으로 표시 (결과 확정 시 DeliverResponse에서 닫음)
+	TRACE_BEGIN_REGION(*POClaudeAPIManagerTrace::GetRegionName(RequestId));
+
+	return MakeShared<FPOClaudeRequestState, ESPMode::ThreadSafe>(
+		RequestId, FPlatformTime::Seconds() + Timeout, Callbacks.GetOwner(), this);
 }
 
-APORVTManager* APOClaudeAPIManager::FindRVTManager() const
+void APOClaudeAPIManager::DeliverResponse(
+	const FRequestStateRef& State,
+	const FClaudeRequestCallbacks& Callbacks,
+	EClaudeRequestOutcome Outcome,
+	bool bSuccess,
+	const FString& Text)
 {
-	AActor* Found = UGameplayStatics::GetActorOfClass(GetWorld(), APORVTManager::StaticClass());
-	return Cast<APORVTManager>(Found);
+	StopSLOWatch(State);
+
+	// 응답이 먼저 도착했더라도 취소됐거나 받을 쪽이 사라졌으면 버림
+	if (State->IsCancelRequested() || State->IsOwnerGone())
+	{
+		Outcome = EClaudeRequestOutcome::Cancelled;
+	}
+
+	if (State->IsHedged())
+	{
+		// 폴백 대사로 이미 답한 요청: 실제 응답은 후속으로만 전달 (실패/취소는 조용히 버림)
+		if (Outcome == EClaudeRequestOutcome::Completed && bSuccess && Callbacks.OnFollowUp.IsBound())
+		{
+			++NumFollowUpReplies;
+			Callbacks.OnFollowUp.Execute(true, Text);
+		}
+		TRACE_END_REGION(*POClaudeAPIManagerTrace::GetRegionName(State->RequestId));
+		return;
+	}
+
+	if (!State->Settle(Outcome, bSuccess, Text))
+	{
+		return;
+	}
+	TRACE_END_REGION(*POClaudeAPIManagerTrace::GetRegionName(State->RequestId));
+
+	switch (Outcome)
+	{
+	case EClaudeRequestOutcome::Cancelled:
+		++NumCancelledRequests;
+		UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 요청 #%d 취소됨"), State->RequestId);
+		return;
+
+	case EClaudeRequestOutcome::TimedOut:
+		++NumTimedOutRequests;
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeAPIManager] 요청 #%d 기한 초과"), State->RequestId);
+		break;
+
+	default:
+		++NumCompletedRequests;
+		break;
+	}
+
+	Callbacks.ExecuteResponse(bSuccess, Text);
+}
+
+bool APOClaudeAPIManager::CancelWithoutCallbacks(const FRequestStateRef& State)
+{
+	const bool bSettled = State->Settle(EClaudeRequestOutcome::Cancelled, false, FString());
+	if (bSettled)
+	{
+		++NumCancelledRequests;
+	}
+
+	// 폴백으로 이미 확정된 요청도 실제 응답을 기다리며 구간이 열려 있음
+	if (bSettled || State->IsHedged())
+	{
+		TRACE_END_REGION(*POClaudeAPIManagerTrace::GetRegionName(State->RequestId));
+	}
+	return bSettled;
+}
+
+void APOClaudeAPIManager::StartSLOWatch(
+	const FRequestStateRef& State,
+	const FClaudeRequestCallbacks& Callbacks,
+	const FClaudeRequestContext& Context,
+	float SLOSeconds)
+{
+	++NumSLORequests;
+
+	FSLOWatch& Watch = SLOWatches.Emplace_GetRef(FSLOWatch{ State, Callbacks });
+	Watch.TimeOfDay = Context.TimeOfDay;
+	Watch.Deadline  = FPlatformTime::Seconds() + SLOSeconds;
+
+	// 더 이른 확인이 이미 예약돼 있으면 유지
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	if (!TimerManager.IsTimerActive(SLOTimerHandle) || TimerManager.GetTimerRemaining(SLOTimerHandle) > SLOSeconds)
+	{
+		TimerManager.SetTimer(SLOTimerHandle, this, &APOClaudeAPIManager::CheckSLOWatches, SLOSeconds, false);
+	}
+}
+
+void APOClaudeAPIManager::StopSLOWatch(const FRequestStateRef& State)
+{
+	if (SLOWatches.Num() > 0)
+	{
+		SLOWatches.RemoveAllSwap([&State](const FSLOWatch& Watch) { return Watch.State == State; });
+	}
+}
+
+void APOClaudeAPIManager::CheckSLOWatches()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<FSLOWatch> Missed;
+	double EarliestDeadline = MAX_dbl;
+	for (int32 i = SLOWatches.Num() - 1; i >= 0; --i)
+	{
+		if (SLOWatches[i].Deadline <= Now)
+		{
+			Missed.Add(MoveTemp(SLOWatches[i]));
+			SLOWatches.RemoveAtSwap(i);
+		}
+		else
+		{
+			EarliestDeadline = FMath::Min(EarliestDeadline, SLOWatches[i].Deadline);
+		}
+	}
+
+	if (SLOWatches.Num() > 0)
+	{
+		GetWorldTimerManager().SetTimer(SLOTimerHandle, this, &APOClaudeAPIManager::CheckSLOWatches,
+			FMath::Max(0.01f, static_cast<float>(EarliestDeadline - Now)), false);
+	}
+
+	if (Missed.Num() == 0)
+	{
+		return;
+	}
+
+	// 폴백 대사는 지금 날씨 기준 (요청 컨텍스트에는 한국어 이름만 있으므로 스냅샷 사용)
+	EWeatherType Weather = EWeatherType::Clear;
+	if (const UPOEnvironmentSubsystem* Environment = UPOEnvironmentSubsystem::Get(this))
+	{
+		Weather = Environment->GetSnapshot().Weather;
+	}
+
+	for (const FSLOWatch& Watch : Missed)
+	{
+		const FRequestStateRef& State = Watch.State;
+		if (State->IsSettled() || State->IsCancelRequested() || State->IsOwnerGone())
+		{
+			continue;
+		}
+
+		const FString& Fallback = FallbackReplies.Pick(Weather, UPOEnvironmentSubsystem::GetTimePeriod(Watch.TimeOfDay), State->RequestId);
+
+		// 폴백 대사가 이 요청의 최종 응답 (실제 응답은 후속 전달일 뿐이므로 완료는 여기서 한 번만 집계)
+		State->MarkHedged();
+		State->Settle(EClaudeRequestOutcome::Completed, true, Fallback);
+		++NumFallbackReplies;
+		++NumCompletedRequests;
+
+		UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 요청 #%d 지연 목표 초과 - 폴백 대사로 응답: %s"), State->RequestId, *Fallback);
+		Watch.Callbacks.ExecuteResponse(true, Fallback);
+
+		if (!bDeliverLateResponseAsFollowUp)
+		{
+			// 후속 전달을 안 하면 남은 대기/전송은 예산 낭비이므로 중단
+			State->RequestCancel();
+			ProcessCancellation(State);
+		}
+	}
+}
+
+void APOClaudeAPIManager::ProcessCancellation(const FRequestStateRef& State)
+{
+	// 대기 중: 대기열에서 바로 제거
+	const int32 QueueIndex = PendingQueue.IndexOfByPredicate(
+		[&State](const FPendingRequest& P) { return P.State == State; });
+	if (QueueIndex != INDEX_NONE)
+	{
+		const FPendingRequest Removed = MoveTemp(PendingQueue[QueueIndex]);
+		PendingQueue.RemoveAt(QueueIndex);
+		NumQueuedRequests = PendingQueue.Num();
+
+		DeliverResponse(State, Removed.Callbacks, EClaudeRequestOutcome::Cancelled, false, FString());
+		BroadcastQueuePositions();
+		return;
+	}
+
+	// 프리페치 인사말을 기다리는 중: 대기만 풀고 프리페치는 다음 대화를 위해 계속 받음
+	for (TPair<FObjectKey, FGreetingPrefetch>& Pair : GreetingPrefetches)
+	{
+		TOptional<FPendingRequest>& Waiter = Pair.Value.Waiter;
+		if (Waiter.IsSet() && Waiter->State == State)
+		{
+			const FClaudeRequestCallbacks Callbacks = Waiter->Callbacks;
+			Waiter.Reset();
+			DeliverResponse(State, Callbacks, EClaudeRequestOutcome::Cancelled, false, FString());
+			return;
+		}
+	}
+
+	// 전송 중: HTTP 요청 중단 (완료 콜백에서 취소로 확정)
+	if (TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = State->HttpRequest.Pin())
+	{
+		HttpRequest->CancelRequest();
+	}
+}
+
+double APOClaudeAPIManager::ExpirePendingRequests(double Now)
+{
+	double EarliestDeadline = MAX_dbl;
+	TArray<FPendingRequest> Expired;
+
+	for (int32 i = 0; i < PendingQueue.Num(); )
+	{
+		const FPendingRequest& Pending = PendingQueue[i];
+		const bool bCancelled = Pending.State->IsCancelRequested() || Pending.State->IsOwnerGone();
+		if (!bCancelled && Now < Pending.State->Deadline)
+		{
+			EarliestDeadline = FMath::Min(EarliestDeadline, Pending.State->Deadline);
+			++i;
+			continue;
+		}
+
+		Expired.Add(MoveTemp(PendingQueue[i]));
+		PendingQueue.RemoveAt(i);
+	}
+
+	// 콜백에서 다시 요청을 넣을 수 있으므로 대기열 정리가 끝난 뒤 통지 (DeliverResponse가 취소 여부를 다시 판단)
+	for (const FPendingRequest& Removed : Expired)
+	{
+		DeliverResponse(Removed.State, Removed.Callbacks, EClaudeRequestOutcome::TimedOut, false, TEXT("(응답 시간 초과)"));
+	}
+
+	return EarliestDeadline;
+}
+
+void APOClaudeAPIManager::PumpQueue()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	const int32 NumBeforeExpire = PendingQueue.Num();
+	const double EarliestDeadline = ExpirePendingRequests(Now);
+	bool bQueueChanged = PendingQueue.Num() != NumBeforeExpire;
+
+	while (NumInFlightRequests < MaxConcurrentRequests && PendingQueue.Num() > 0)
+	{
+		const int32 Index = SelectNextPendingIndex(Now);
+		if (Index == INDEX_NONE)
+		{
+			// 모두 백오프 중: 가장 먼저 풀리는 시각에 다시 시도
+			double EarliestNotBefore = MAX_dbl;
+			for (const FPendingRequest& Pending : PendingQueue)
+			{
+				EarliestNotBefore = FMath::Min(EarliestNotBefore, Pending.NotBefore);
+			}
+			SchedulePump(EarliestNotBefore - Now);
+			break;
+		}
+
+		// 분당 요청/토큰 한도에 걸리면 오류 대신 대기열에서 기다림 (로컬 모델은 API 한도와 무관)
+		const bool bOffline = ShouldUseOfflineBackend();
+		if (!bOffline)
+		{
+			const int32 EstimatedTokens = PendingQueue[Index].EstimatedTokens;
+			const double LimiterWait = RateLimiter.GetWaitSeconds(Now, EstimatedTokens);
+			if (LimiterWait > 0.0)
+			{
+				SchedulePump(LimiterWait);
+				break;
+			}
+			RateLimiter.Acquire(Now, EstimatedTokens);
+		}
+
+		FPendingRequest Pending = MoveTemp(PendingQueue[Index]);
+		PendingQueue.RemoveAt(Index);
+
+		if (bOffline)
+		{
+			DispatchToBackend(MoveTemp(Pending));
+		}
+		else
+		{
+			DispatchRequest(MoveTemp(Pending));
+		}
+		bQueueChanged = true;
+	}
+
+	NumQueuedRequests = PendingQueue.Num();
+
+	if (PendingQueue.Num() > 0)
+	{
+		// 대기 중인 요청이 기한을 넘기면 바로 실패를 알리도록 깨어남
+		SchedulePump(EarliestDeadline - Now);
+	}
+
+	if (bQueueChanged)
+	{
+		BroadcastQueuePositions();
+	}
+}
+
+int32 APOClaudeAPIManager::SelectNextPendingIndex(double Now) const
+{
+	int32 FirstReady = INDEX_NONE;
+
+	// 전송 중인 요청이 없는 NPC의 가장 오래된 요청을 우선 선택 (한 NPC가 슬롯을 독점하지 않도록)
+	for (int32 i = 0; i < PendingQueue.Num(); ++i)
+	{
+		const FPendingRequest& Pending = PendingQueue[i];
+		if (Pending.NotBefore > Now)
+		{
+			continue;
+		}
+
+		const int32* InFlight = InFlightPerOwner.Find(Pending.OwnerKey);
+		if (!InFlight || *InFlight == 0)
+		{
+			return i;
+		}
+
+		if (FirstReady == INDEX_NONE)
+		{
+			FirstReady = i;
+		}
+	}
+
+	// 모두 이미 전송 중인 요청이 있다면 순수 FIFO
+	return FirstReady;
+}
+
+void APOClaudeAPIManager::SchedulePump(double DelaySeconds)
+{
+	const float Delay = FMath::Max(0.01f, static_cast<float>(DelaySeconds));
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	if (TimerManager.IsTimerActive(PumpTimerHandle) && TimerManager.GetTimerRemaining(PumpTimerHandle) <= Delay)
+	{
+		return;
+	}
+
+	TimerManager.SetTimer(PumpTimerHandle, this, &APOClaudeAPIManager::PumpQueue, Delay, false);
+}
+
+int32 APOClaudeAPIManager::EstimateRequestTokens(const FClaudeRequestContext& Context)
+{
+	// 동적 블록은 고정 길이로 가정, 이전 대화는 예산 상한까지만 들어가므로 예산으로 자르고 출력 상한을 더함
+	static constexpr int32 DynamicBlockTokens = 80;
+
+	int32 HistoryTokens = 0;
+	for (const FClaudeDialogueTurn& Turn : Context.History)
+	{
+		HistoryTokens += POClaudeTokenEstimator::Estimate(Turn.PlayerMessage) + POClaudeTokenEstimator::Estimate(Turn.NPCResponse)
+			+ 2 * POClaudeTokenEstimator::MessageOverhead;
+	}
+	HistoryTokens = FMath::Min(HistoryTokens, HistoryTokenBudget);
+
+	const int32 SummaryTokens = FMath::Min(POClaudeTokenEstimator::Estimate(Context.HistorySummary), HistorySummaryTokenBudget);
+
+	return POClaudeTokenEstimator::Estimate(PromptBuilder.GetStaticBlock(Context)) + DynamicBlockTokens
+		+ HistoryTokens + SummaryTokens
+		+ POClaudeTokenEstimator::Estimate(Context.PlayerMessage) + POClaudeTokenEstimator::MessageOverhead
+		+ (ModelRouter.IsEnabled() ? ModelRouter.GetMaxOutputTokens() : MaxTokens);
+}
+
+bool APOClaudeAPIManager::IsRetryableStatus(int32 StatusCode)
+{
+	// 408 타임아웃, 429 속도 제한, 5xx 서버 오류 (529 과부하 포함)
+	return StatusCode == 408 || StatusCode == 429 || StatusCode >= 500;
+}
+
+bool APOClaudeAPIManager::TryScheduleRetry(
+	FPendingRequest& Sent,
+	FHttpResponsePtr Res,
+	bool bConnectedSuccessfully,
+	const TSharedPtr<FPOClaudeStreamState, ESPMode::ThreadSafe>& StreamState)
+{
+	const bool bConnected = bConnectedSuccessfully && Res.IsValid();
+	const int32 StatusCode = bConnected ? Res->GetResponseCode() : 0;
+
+	bool bRetryable = !bConnected || IsRetryableStatus(StatusCode);
+	if (!bRetryable && StatusCode == 200 && StreamState)
+	{
+		// 텍스트가 나오기 전에 스트림 안에서 overloaded 등 오류 이벤트를 받은 경우
+		FScopeLock ScopeLock(&StreamState->Lock);
+		bRetryable = StreamState->Parser.HasError() && StreamState->Parser.GetAccumulatedText().IsEmpty();
+	}
+
+	// 취소된 요청이나 받을 쪽이 사라진 요청은 다시 보내지 않음
+	if (!bRetryable || Sent.State->IsCancelRequested() || Sent.State->IsOwnerGone())
+	{
+		return false;
+	}
+
+	// 실패한 요청의 토큰 예약은 전부 반환
+	RateLimiter.Reconcile(Sent.EstimatedTokens, 0);
+
+	const double Now = FPlatformTime::Seconds();
+
+	double RetryAfterSeconds = 0.0;
+	if (bConnected)
+	{
+		const FString RetryAfter = Res->GetHeader(TEXT("retry-after"));
+		if (!RetryAfter.IsEmpty() && RetryAfter.IsNumeric())
+		{
+			RetryAfterSeconds = FCString::Atod(*RetryAfter);
+		}
+	}
+
+	const double Backoff = FPOClaudeRateLimiter::ComputeBackoffSeconds(
+		Sent.Attempt, BackoffBaseSeconds, BackoffMaxSeconds, RetryRandom);
+	const double Delay = FMath::Max(RetryAfterSeconds, Backoff);
+
+	if (StatusCode == 429)
+	{
+		// 계정 단위 제한이므로 다른 요청도 함께 멈춤
+		++NumRateLimited;
+		RateLimiter.BlockUntil(Now + Delay);
+	}
+
+	if (Now + Delay > Sent.Deadline)
+	{
+		++NumRetryGiveUps;
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeAPIManager] 요청 #%d 재시도 기한 초과 (상태 %d, 시도 %d회)"),
+			Sent.RequestId, StatusCode, Sent.Attempt + 1);
+		return false;
+	}
+
+	++NumRetries;
+	++Sent.Attempt;
+	Sent.NotBefore  = Now + Delay;
+	Sent.bWasQueued = true;
+
+	UE_LOG(LogTemp, Warning, TEXT("[ClaudeAPIManager] 요청 #%d 재시도 예약 (상태 %d, %d번째, %.2f초 후)"),
+		Sent.RequestId, StatusCode, Sent.Attempt, Delay);
+
+	// 순서를 잃지 않도록 대기열 맨 앞에 다시 넣고 NPC에는 대기 중으로 통지
+	const FOnClaudeQueueStatus QueueStatus = Sent.Callbacks.OnQueueStatus;
+	PendingQueue.Insert(MoveTemp(Sent), 0);
+	NumQueuedRequests = PendingQueue.Num();
+	QueueStatus.ExecuteIfBound(1, static_cast<float>(Delay) + AverageRequestSeconds);
+
+	SchedulePump(Delay);
+	return true;
+}
+
+void APOClaudeAPIManager::DispatchRequest(FPendingRequest&& Pending)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClaudeDispatch);
+	TRACE_CPUPROFILER_EVENT_SCOPE(Claude_DispatchRequest);
+
+	++NumInFlightRequests;
+	InFlightPerOwner.FindOrAdd(Pending.OwnerKey)++;
+
+	const double WaitedSeconds = FPlatformTime::Seconds() - Pending.EnqueueTime;
+	FPOClaudeMetrics::Get().QueueWait.RecordSeconds(WaitedSeconds);
+	if (Pending.bWasQueued)
+	{
+		// 대기했던 요청에만 전송 시작 통지
+		Pending.Callbacks.OnQueueStatus.ExecuteIfBound(0, 0.0f);
+	}
+
+	const FClaudeRequestContext& Context = Pending.Context;
+
+	// 재시도마다 다시 고름 (그사이 큰 티어가 느려졌으면 빠른 티어로)
+	if (ModelRouter.IsEnabled())
+	{
+		const FPOClaudeRouteDecision Route = ModelRouter.Route(Context, FPlatformTime::Seconds());
+		Pending.TierIndex = Route.Tier;
+
+		if (Route.IsDowngraded())
+		{
+			++NumDowngradedRequests;
+			UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 요청 #%d %s p95 지연 예산 초과 → %s (복잡도 %.2f)"),
+				Pending.RequestId, *ModelRouter.GetTier(Route.PreferredTier).ModelID,
+				*ModelRouter.GetTier(Route.Tier).ModelID, Route.Complexity);
+		}
+	}
+
+	FHttpModule& HttpModule = FHttpModule::Get();
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = HttpModule.CreateRequest();
+
+	Request->SetURL(EndpointURL);
+	Request->SetVerb(TEXT("POST"));
+	Request->SetHeader(TEXT("Content-Type"),       TEXT("application/json"));
+	Request->SetHeader(TEXT("x-api-key"),          APIKey);
+	Request->SetHeader(TEXT("anthropic-version"),  TEXT("2023-06-01"));
+	BuildRequestBody(Context, Pending.TierIndex, RequestBodyScratch);
+	Request->SetContent(RequestBodyScratch);
+
+	// 요청 기한까지 남은 시간만큼만 기다림 (넘기면 연결 실패로 완료되어 TimedOut 처리)
+	Request->SetTimeout(FMath::Max(1.0f, static_cast<float>(Pending.State->Deadline - FPlatformTime::Seconds())));
+	Pending.State->HttpRequest = Request;
+	InFlightHttpRequests.Add(Pending.RequestId, FInFlightHttpRequest{ Pending.State, Request });
+
+	// 연결(상태 줄 수신)과 첫 바이트 시각. HTTP 모듈이 소켓 연결 시각을 주지 않으므로 상태 코드 수신으로 근사
+	const TSharedRef<FPOClaudeRequestTimeline, ESPMode::ThreadSafe> Timeline = MakeShared<FPOClaudeRequestTimeline, ESPMode::ThreadSafe>();
+	Request->OnStatusCodeReceived().BindLambda([Timeline](FHttpRequestPtr, int32)
+	{
+		FPOClaudeRequestTimeline::MarkOnce(Timeline->ConnectTime, FPlatformTime::Seconds());
+	});
+
+	// 스트리밍: 바이트가 도착하는 대로 파싱해 누적 텍스트를 게임 스레드로 전달
+	TSharedPtr<FPOClaudeStreamState, ESPMode::ThreadSafe> StreamState;
+	if (!bUseStreaming)
+	{
+		Request->OnRequestProgress64().BindLambda([Timeline](FHttpRequestPtr, uint64, uint64 BytesReceived)
+		{
+			if (BytesReceived > 0)
+			{
+				FPOClaudeRequestTimeline::MarkOnce(Timeline->FirstByteTime, FPlatformTime::Seconds());
+			}
+		});
+	}
+	else
+	{
+		StreamState = MakeShared<FPOClaudeStreamState, ESPMode::ThreadSafe>();
+		const FOnClaudePartialResponse PartialCallback = Pending.Callbacks.OnPartial;
+		const FRequestStateRef RequestState = Pending.State;
+		TWeakObjectPtr<APOClaudeAPIManager> WeakThis(this);
+
+		Request->SetResponseBodyReceiveStreamDelegateV2(FHttpRequestStreamDelegateV2::CreateLambda(
+			[StreamState, Timeline, PartialCallback, RequestState, WeakThis](void* Ptr, int64& Length) -> bool
+			{
+				// 취소된 요청은 HTTP 스레드에서 바로 수신 중단
+				if (RequestState->IsCancelRequested())
+				{
+					return false;
+				}
+
+				const double ChunkTime = FPlatformTime::Seconds();
+				FPOClaudeRequestTimeline::MarkOnce(Timeline->FirstByteTime, ChunkTime);
+
+				FString Accumulated;
+				{
+					FScopeLock ScopeLock(&StreamState->Lock);
+					const bool bHasNewText = StreamState->Parser.AppendBytes(static_cast<const uint8*>(Ptr), Length);
+					StreamState->ParseSeconds += FPlatformTime::Seconds() - ChunkTime;
+					if (!bHasNewText || !PartialCallback.IsBound())
+					{
+						return true;
+					}
+					Accumulated = StreamState->Parser.GetAccumulatedText();
+				}
+
+				AsyncTask(ENamedThreads::GameThread,
+					[StreamState, PartialCallback, RequestState, WeakThis, Accumulated = MoveTemp(Accumulated)]()
+					{
+						APOClaudeAPIManager* Manager = WeakThis.Get();
+						if (!Manager || StreamState->bCompleted || RequestState->IsCancelRequested())
+						{
+							return;
+						}
+
+						// 첫 텍스트가 지연 목표 안에 도착. 이미 폴백으로 답했다면 조각은 보이지 않고 최종 응답만 후속 전달
+						Manager->StopSLOWatch(RequestState);
+						if (RequestState->IsHedged())
+						{
+							return;
+						}
+
+						FScopedDurationTimer GameThreadTimer(Manager->ResponseGameThreadSeconds);
+						PartialCallback.ExecuteIfBound(Accumulated);
+					});
+				return true;
+			}));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 요청 #%d 전송 중... (%s, 대기 %.2fs, 시도 %d, 전송 중 %d/%d, 날씨: %s, 시간: %.1fh)"),
+		Pending.RequestId, Pending.TierIndex != INDEX_NONE ? *ModelRouter.GetTier(Pending.TierIndex).ModelID : *ModelID,
+		WaitedSeconds, Pending.Attempt + 1, NumInFlightRequests, MaxConcurrentRequests,
+		*Context.WeatherType, Context.TimeOfDay);
+
+	// 재시도 시 대기열로 되돌리기 위해 요청 전체를 보관
+	TSharedRef<FPendingRequest> Sent = MakeShared<FPendingRequest>(MoveTemp(Pending));
+	const double SendTime = FPlatformTime::Seconds();
+
+	TWeakObjectPtr<APOClaudeAPIManager> WeakThis(this);
+	Request->OnProcessRequestComplete().BindLambda(
+		[WeakThis, Sent, SendTime, StreamState, Timeline](
+			FHttpRequestPtr Req,
+			FHttpResponsePtr Res,
+			bool bConnectedSuccessfully)
+		{
+			if (StreamState)
+			{
+				StreamState->bCompleted = true;
+			}
+
+			APOClaudeAPIManager* Manager = WeakThis.Get();
+			if (!Manager)
+			{
+				// 매니저가 먼저 사라짐 (레벨 종료 등): 결과만 확정하고 콜백은 생략
+				Sent->State->Settle(EClaudeRequestOutcome::Cancelled, false, FString());
+				return;
+			}
+
+			SCOPE_CYCLE_COUNTER(STAT_ClaudeComplete);
+			FScopedDurationTimer GameThreadTimer(Manager->ResponseGameThreadSeconds);
+			const double Now = FPlatformTime::Seconds();
+			Manager->InFlightHttpRequests.Remove(Sent->RequestId);
+			Manager->OnRequestFinished(Sent->OwnerKey, Now - SendTime);
+
+			// 전송 1회마다 구간 지연과 실패 원인 기록 (재시도로 복구된 429/5xx도 셈)
+			FPOClaudeMetrics& Metrics = FPOClaudeMetrics::Get();
+			const double ConnectTime   = Timeline->ConnectTime.load(std::memory_order_relaxed);
+			const double FirstByteTime = Timeline->FirstByteTime.load(std::memory_order_relaxed);
+			if (ConnectTime > 0.0)
+			{
+				Metrics.Connect.RecordSeconds(ConnectTime - SendTime);
+			}
+			if (FirstByteTime > 0.0)
+			{
+				Metrics.FirstByte.RecordSeconds(FirstByteTime - SendTime);
+			}
+			if (StreamState)
+			{
+				FScopeLock ScopeLock(&StreamState->Lock);
+				Metrics.Parse.RecordSeconds(StreamState->ParseSeconds);
+			}
+
+			const int32 AttemptStatus = (bConnectedSuccessfully && Res.IsValid()) ? Res->GetResponseCode() : 0;
+			if (AttemptStatus != 200 && !Sent->State->IsCancelRequested())
+			{
+				const EPOClaudeErrorKind Kind = (AttemptStatus == 0 && Now >= Sent->State->Deadline)
+					? EPOClaudeErrorKind::Timeout
+					: FPOClaudeMetrics::ClassifyStatus(AttemptStatus);
+				Metrics.RecordError(Kind);
+				TRACE_BOOKMARK(TEXT("Claude #%d %s (%d)"), Sent->RequestId, FPOClaudeMetrics::GetErrorKindName(Kind), AttemptStatus);
+			}
+
+			// 티어 지연 표본: 정상 응답과 연결 실패/시간 초과만 (429/5xx는 지연이 아니라 용량 신호)
+			if (Sent->TierIndex != INDEX_NONE && !Sent->State->IsCancelRequested()
+				&& (!bConnectedSuccessfully || (Res.IsValid() && Res->GetResponseCode() == 200)))
+			{
+				Manager->ModelRouter.RecordLatency(Sent->TierIndex, Now, Now - SendTime);
+			}
+
+			// 네트워크가 끊긴 것으로 보고 한동안 로컬 모델로 응답 (재시도도 로컬로 감)
+			if (!bConnectedSuccessfully && !Sent->State->IsCancelRequested() && FPlatformTime::Seconds() < Sent->State->Deadline
+				&& Manager->Backend == EClaudeBackend::Auto && Manager->OfflineBackend && Manager->OfflineBackend->IsAvailable())
+			{
+				if (FPlatformTime::Seconds() >= Manager->OfflineUntil)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("[ClaudeAPIManager] HTTP 연결 실패: %.0f초 동안 로컬 모델로 응답합니다."),
+						Manager->OfflineFallbackSeconds);
+				}
+				Manager->OfflineUntil = FPlatformTime::Seconds() + Manager->OfflineFallbackSeconds;
+			}
+
+			if (!Manager->TryScheduleRetry(*Sent, Res, bConnectedSuccessfully, StreamState))
+			{
+				Manager->HandleRequestComplete(Sent, Res, bConnectedSuccessfully, StreamState);
+			}
+			Manager->PumpQueue();
+		});
+
+	Request->ProcessRequest();
+}
+
+void APOClaudeAPIManager::DispatchToBackend(FPendingRequest&& Pending)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClaudeDispatch);
+	TRACE_CPUPROFILER_EVENT_SCOPE(Claude_DispatchToBackend);
+	FPOClaudeMetrics::Get().QueueWait.RecordSeconds(FPlatformTime::Seconds() - Pending.EnqueueTime);
+
+	++NumInFlightRequests;
+	++NumOfflineRequests;
+	InFlightPerOwner.FindOrAdd(Pending.OwnerKey)++;
+
+	if (Pending.bWasQueued)
+	{
+		Pending.Callbacks.OnQueueStatus.ExecuteIfBound(0, 0.0f);
+	}
+
+	const FClaudeRequestContext& Context = Pending.Context;
+
+	// HTTP 요청 본문과 같은 재료 (정적 블록은 아키타입마다 같아 로컬 KV 캐시 접두부로 재사용됨)
+	FPOClaudePromptParts Prompt;
+	PackPrompt(Context, Prompt);
+
+	FPOClaudeBackendRequest Request(Pending.State);
+	Request.StaticSystem  = *Prompt.StaticSystem;
+	Request.DynamicSystem = MoveTemp(Prompt.DynamicSystem);
+	Request.MaxTokens     = MaxTokens;
+
+	// HTTP 경로처럼 라우팅 티어의 max_tokens 사용 (로컬 모델에는 HTTP 지연 예산이 무의미하므로 복잡도로만 고름)
+	const int32 TierIndex = ModelRouter.GetPreferredTier(Context);
+	if (TierIndex != INDEX_NONE)
+	{
+		Request.MaxTokens = ModelRouter.GetTier(TierIndex).MaxTokens;
+	}
+
+	for (const FClaudeDialogueTurn* Turn : Prompt.Turns)
+	{
+		Request.Messages.Add({ false, Turn->PlayerMessage });
+		Request.Messages.Add({ true, Turn->NPCResponse });
+	}
+	Request.Messages.Add({ false, Context.PlayerMessage });
+
+	UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 요청 #%d %s 백엔드로 전송 (전송 중 %d/%d)"),
+		Pending.RequestId, OfflineBackend->GetName(), NumInFlightRequests, MaxConcurrentRequests);
+
+	TWeakObjectPtr<APOClaudeAPIManager> WeakThis(this);
+
+	FOnPOClaudeBackendPartial OnPartial;
+	if (Pending.Callbacks.OnPartial.IsBound())
+	{
+		OnPartial.BindLambda(
+			[WeakThis, RequestState = Pending.State, PartialCallback = Pending.Callbacks.OnPartial](const FString& Accumulated)
+			{
+				APOClaudeAPIManager* Manager = WeakThis.Get();
+				if (!Manager || RequestState->IsCancelRequested())
+				{
+					return;
+				}
+
+				// HTTP 스트리밍과 같은 규칙: 첫 텍스트로 지연 목표 해제, 폴백으로 이미 답했으면 조각은 숨김
+				Manager->StopSLOWatch(RequestState);
+				if (RequestState->IsHedged() || RequestState->IsSettled())
+				{
+					return;
+				}
+
+				FScopedDurationTimer GameThreadTimer(Manager->ResponseGameThreadSeconds);
+				PartialCallback.ExecuteIfBound(Accumulated);
+			});
+	}
+
+	const TSharedRef<FPendingRequest> Sent = MakeShared<FPendingRequest>(MoveTemp(Pending));
+	const double SendTime = FPlatformTime::Seconds();
+
+	OfflineBackend->Submit(MoveTemp(Request), MoveTemp(OnPartial), FOnPOClaudeBackendComplete::CreateLambda(
+		[WeakThis, Sent, SendTime](FPOClaudeBackendResult&& Result)
+		{
+			APOClaudeAPIManager* Manager = WeakThis.Get();
+			if (!Manager)
+			{
+				Sent->State->Settle(EClaudeRequestOutcome::Cancelled, false, FString());
+				return;
+			}
+
+			SCOPE_CYCLE_COUNTER(STAT_ClaudeComplete);
+			FScopedDurationTimer GameThreadTimer(Manager->ResponseGameThreadSeconds);
+			Manager->OnRequestFinished(Sent->OwnerKey, FPlatformTime::Seconds() - SendTime);
+			Manager->HandleBackendComplete(*Sent, MoveTemp(Result));
+			Manager->PumpQueue();
+		}));
+}
+
+void APOClaudeAPIManager::HandleBackendComplete(const FPendingRequest& Sent, FPOClaudeBackendResult&& Result)
+{
+	// 로컬 생성은 과금되지 않으므로 usage 누적/속도 제한 정산/응답 캐시 저장 없이 바로 전달
+	RecordExchange(Sent, EPOClaudeJournalSource::Local, Result.bSuccess, Result.Text, Result.Usage);
+
+	if (Result.bSuccess)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[ClaudeAPIManager] 로컬 응답 수신 (프롬프트 %d, 재사용 %d, 생성 %d 토큰): %s"),
+			Result.Usage.InputTokens, Result.Usage.CacheReadInputTokens, Result.Usage.OutputTokens, *Result.Text);
+		DeliverResponse(Sent.State, Sent.Callbacks, EClaudeRequestOutcome::Completed, true, Result.Text);
+		return;
+	}
+
+	if (Result.bTimedOut || FPlatformTime::Seconds() >= Sent.State->Deadline)
+	{
+		DeliverResponse(Sent.State, Sent.Callbacks, EClaudeRequestOutcome::TimedOut, false, TEXT("(응답 시간 초과)"));
+		return;
+	}
+
+	// 취소로 중단된 요청은 DeliverResponse에서 Cancelled로 바뀜
+	DeliverResponse(Sent.State, Sent.Callbacks, EClaudeRequestOutcome::Completed, false, TEXT("(로컬 모델 오류)"));
+}
+
+void APOClaudeAPIManager::HandleRequestComplete(
+	const TSharedRef<FPendingRequest>& Sent,
+	FHttpResponsePtr Res,
+	bool bConnectedSuccessfully,
+	const TSharedPtr<FPOClaudeStreamState, ESPMode::ThreadSafe>& StreamState)
+{
+	const FClaudeRequestCallbacks& Callbacks = Sent->Callbacks;
+	const int32 EstimatedTokens = Sent->EstimatedTokens;
+
+	if (!bConnectedSuccessfully || !Res.IsValid())
+	{
+		RateLimiter.Reconcile(EstimatedTokens, 0);
+		RecordExchange(*Sent, EPOClaudeJournalSource::Http, false, FString());
+
+		// 취소로 중단된 요청은 DeliverResponse에서 Cancelled로 바뀜
+		if (FPlatformTime::Seconds() >= Sent->State->Deadline)
+		{
+			DeliverResponse(Sent->State, Callbacks, EClaudeRequestOutcome::TimedOut, false, TEXT("(응답 시간 초과)"));
+			return;
+		}
+
+		if (!Sent->State->IsCancelRequested())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[ClaudeAPIManager] HTTP 연결 실패"));
+		}
+		DeliverResponse(Sent->State, Callbacks, EClaudeRequestOutcome::Completed, false, TEXT("(네트워크 오류)"));
+		return;
+	}
+
+	const int32 StatusCode = Res->GetResponseCode();
+	if (StatusCode != 200)
+	{
+		// 스트리밍 요청은 본문이 스트림 델리게이트로만 전달되므로 파서가 보관한 원문을 사용
+		FString ErrorBody;
+		if (StreamState)
+		{
+			FScopeLock ScopeLock(&StreamState->Lock);
+			ErrorBody = StreamState->Parser.GetRawPrefix();
+		}
+		else
+		{
+			ErrorBody = Res->GetContentAsString();
+		}
+
+		RateLimiter.Reconcile(EstimatedTokens, 0);
+		RecordExchange(*Sent, EPOClaudeJournalSource::Http, false, ErrorBody, FClaudeUsage(), StatusCode);
+
+		UE_LOG(LogTemp, Error,
+			TEXT("[ClaudeAPIManager] API 오류 %d: %s"),
+			StatusCode, *ErrorBody);
+		DeliverResponse(Sent->State, Callbacks, EClaudeRequestOutcome::Completed, false,
+			FString::Printf(TEXT("(API 오류: %d)"), StatusCode));
+		return;
+	}
+
+	if (StreamState)
+	{
+		FString ParsedText;
+		FClaudeUsage Usage;
+		{
+			FScopeLock ScopeLock(&StreamState->Lock);
+			const FPOClaudeStreamParser& Parser = StreamState->Parser;
+			Usage = Parser.GetUsage();
+
+			if (Parser.HasError())
+			{
+				RateLimiter.Reconcile(EstimatedTokens, FPOClaudeRateLimiter::CountBilledTokens(Usage));
+				RecordExchange(*Sent, EPOClaudeJournalSource::Http, false, Parser.GetErrorMessage(), Usage, StatusCode);
+				UE_LOG(LogTemp, Error, TEXT("[ClaudeAPIManager] 스트림 오류: %s"), *Parser.GetErrorMessage());
+				DeliverResponse(Sent->State, Callbacks, EClaudeRequestOutcome::Completed, false, TEXT("(응답 형식 오류)"));
+				return;
+			}
+
+			ParsedText = Parser.GetAccumulatedText();
+		}
+
+		const bool bParsed = !ParsedText.IsEmpty();
+		if (!bParsed)
+		{
+			ParsedText = TEXT("(빈 응답)");
+		}
+
+		FinishResponse(*Sent, MoveTemp(ParsedText), Usage, bParsed);
+		return;
+	}
+
+	// 비스트리밍: 본문 스캔은 워커에서, 게임 스레드에는 최종 문자열과 usage만 전달
+	TWeakObjectPtr<APOClaudeAPIManager> WeakThis(this);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis, Sent, Res]()
+		{
+			// 스캔 전에 취소됐으면 본문을 읽지 않음 (결과 확정은 게임 스레드에서)
+			if (Sent->State->IsCancelRequested())
+			{
+				AsyncTask(ENamedThreads::GameThread, [WeakThis, Sent]()
+				{
+					if (APOClaudeAPIManager* Manager = WeakThis.Get())
+					{
+						Manager->DeliverResponse(Sent->State, Sent->Callbacks, EClaudeRequestOutcome::Cancelled, false, FString());
+					}
+				});
+				return;
+			}
+
+			TRACE_CPUPROFILER_EVENT_SCOPE(Claude_ScanResponse);
+			const TArray<uint8>& Body = Res->GetContent();
+
+			FPOClaudeScanResult Scanned;
+			bool bParsed = false;
+			const double ScanStart = FPlatformTime::Seconds();
+			const bool bScanned = POClaudeResponseScanner::Scan(Body.GetData(), Body.Num(), Scanned);
+			FPOClaudeMetrics::Get().Parse.RecordSeconds(FPlatformTime::Seconds() - ScanStart);
+
+			if (!bScanned)
+			{
+				UE_LOG(LogTemp, Error, TEXT("[ClaudeAPIManager] JSON 파싱 실패"));
+				Scanned.Text = TEXT("(응답을 읽을 수 없습니다.)");
+			}
+			else if (!Scanned.bHasText)
+			{
+				Scanned.Text = TEXT("(빈 응답)");
+			}
+			else
+			{
+				bParsed = true;
+			}
+
+			AsyncTask(ENamedThreads::GameThread,
+				[WeakThis, Sent, bParsed, Text = MoveTemp(Scanned.Text), Usage = Scanned.Usage]() mutable
+				{
+					if (APOClaudeAPIManager* Manager = WeakThis.Get())
+					{
+						SCOPE_CYCLE_COUNTER(STAT_ClaudeComplete);
+						FScopedDurationTimer GameThreadTimer(Manager->ResponseGameThreadSeconds);
+						Manager->FinishResponse(*Sent, MoveTemp(Text), Usage, bParsed);
+					}
+					else
+					{
+						Sent->State->Settle(EClaudeRequestOutcome::Cancelled, false, FString());
+					}
+				});
+		});
+}
+
+void APOClaudeAPIManager::FinishResponse(
+	const FPendingRequest& Sent,
+	FString&& Text,
+	const FClaudeUsage& Usage,
+	bool bParsed)
+{
+	// 취소된 요청도 이미 과금됐으므로 usage/속도 제한 정산과 캐시 저장은 그대로 함
+	RecordUsage(Usage);
+	RateLimiter.Reconcile(Sent.EstimatedTokens, FPOClaudeRateLimiter::CountBilledTokens(Usage));
+
+	// 정상 응답만 캐시에 저장 (형식 오류 안내 문구는 저장하지 않음)
+	if (bParsed && Sent.CacheKey != 0 && ResponseCache)
+	{
+		ResponseCache->Add(Sent.CacheKey, Text);
+	}
+
+	RecordExchange(Sent, EPOClaudeJournalSource::Http, bParsed, Text, Usage, 200);
+
+	UE_LOG(LogTemp, Verbose, TEXT("[ClaudeAPIManager] 응답 수신: %s"), *Text);
+
+	// 읽을 수 없는 응답의 안내 문구는 실패로 전달 (호출자가 대사/이력/기억에 넣지 않고 실패 경로로 처리)
+	DeliverResponse(Sent.State, Sent.Callbacks, EClaudeRequestOutcome::Completed, bParsed, Text);
+}
+
+void APOClaudeAPIManager::OnRequestFinished(const FObjectKey& OwnerKey, double ElapsedSeconds)
+{
+	NumInFlightRequests = FMath::Max(0, NumInFlightRequests - 1);
+
+	if (int32* InFlight = InFlightPerOwner.Find(OwnerKey))
+	{
+		if (--(*InFlight) <= 0)
+		{
+			InFlightPerOwner.Remove(OwnerKey);
+		}
+	}
+
+	// 지수 이동평균으로 예상 대기 시간 보정
+	AverageRequestSeconds = FMath::Lerp(AverageRequestSeconds, static_cast<float>(ElapsedSeconds), 0.2f);
+}
+
+void APOClaudeAPIManager::BroadcastQueuePositions() const
+{
+	for (int32 i = 0; i < PendingQueue.Num(); ++i)
+	{
+		PendingQueue[i].Callbacks.OnQueueStatus.ExecuteIfBound(i + 1, EstimateWaitSeconds(i + 1));
+	}
+}
+
+float APOClaudeAPIManager::EstimateWaitSeconds(int32 QueuePosition) const
+{
+	// 앞선 요청들이 슬롯 수만큼 묶여 처리된다고 가정
+	const int32 Rounds = FMath::DivideAndRoundUp(QueuePosition, FMath::Max(1, MaxConcurrentRequests));
+	return Rounds * AverageRequestSeconds;
+}
+
+void APOClaudeAPIManager::RegisterNPC(APONPCCharacter* NPC)
+{
+	if (NPC)
+	{
+		RegisteredNPCs.AddUnique(NPC);
+		LocalReplies.SetPersona(FObjectKey(NPC), NPC->LocalReplyTemplates);
+	}
+}
+
+void APOClaudeAPIManager::UnregisterNPC(APONPCCharacter* NPC)
+{
+	RegisteredNPCs.RemoveSwap(NPC);
+
+	const FObjectKey NPCKey(NPC);
+	LocalReplies.RemovePersona(NPCKey);
+	if (const FGreetingPrefetch* Prefetch = GreetingPrefetches.Find(NPCKey))
+	{
+		if (Prefetch->Waiter.IsSet())
+		{
+			// 다른 취소와 같은 경로로 (지연 목표 감시 해제, 취소 집계, Insights 구간 종료)
+			const FRequestStateRef WaiterState = Prefetch->Waiter->State;
+			WaiterState->RequestCancel();
+			ProcessCancellation(WaiterState);
+		}
+		GreetingPrefetches.Remove(NPCKey);
+	}
+}
+
+bool APOClaudeAPIManager::IsGreetingMessage(const FString& PlayerMessage) const
+{
+	return PlayerMessage.IsEmpty() || PlayerMessage.TrimStartAndEnd().Equals(GreetingPlayerMessage, ESearchCase::IgnoreCase);
+}
+
+uint32 APOClaudeAPIManager::MakeEnvKey(const FClaudeRequestContext& Context)
+{
+	return HashCombine(GetTypeHash(Context.WeatherType),
+		GetTypeHash(FPOClaudePromptBuilder::TimeOfDayToKorean(Context.TimeOfDay)));
+}
+
+void APOClaudeAPIManager::ScanPrefetchCandidates()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// 날씨/시간대는 NPC마다 같으므로 한 번만 수집
+	const FClaudeRequestContext EnvContext = MakeAutoContext(GreetingPlayerMessage, FString(), FString());
+	const uint32 EnvKey = MakeEnvKey(EnvContext);
+
+	// 환경이 바뀌었거나 만료된 인사말 폐기 (응답을 기다리는 NPC가 있으면 유지)
+	for (auto It = GreetingPrefetches.CreateIterator(); It; ++It)
+	{
+		const FGreetingPrefetch& Prefetch = It.Value();
+		const bool bExpired = Prefetch.bReady && Now - Prefetch.ReadyTime > PrefetchTTLSeconds;
+		if (!Prefetch.Waiter.IsSet() && (bExpired || Prefetch.EnvKey != EnvKey))
+		{
+			++NumPrefetchDiscarded;
+			It.RemoveCurrent();
+		}
+	}
+
+	PrefetchIssueTimes.RemoveAll([Now](double IssueTime) { return Now - IssueTime > 60.0; });
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	if (!PlayerPawn)
+	{
+		return;
+	}
+
+	const FVector PlayerLocation = PlayerPawn->GetActorLocation();
+	const float RadiusSq = FMath::Square(PrefetchRadius);
+
+	RegisteredNPCs.RemoveAllSwap([](const TWeakObjectPtr<APONPCCharacter>& NPC) { return !NPC.IsValid(); });
+
+	for (const TWeakObjectPtr<APONPCCharacter>& WeakNPC : RegisteredNPCs)
+	{
+		// 실제 대화 요청 자리를 빼앗지 않도록 대기열이 비어 있고 슬롯이 남을 때만 발행
+		if (PrefetchIssueTimes.Num() >= MaxPrefetchesPerMinute
+			|| PendingQueue.Num() > 0
+			|| NumInFlightRequests >= MaxConcurrentRequests)
+		{
+			break;
+		}
+
+		APONPCCharacter* NPC = WeakNPC.Get();
+		if (NPC->TalkState != ENPCTalkState::Idle
+			|| GreetingPrefetches.Contains(FObjectKey(NPC))
+			|| FVector::DistSquared(NPC->GetActorLocation(), PlayerLocation) > RadiusSq)
+		{
+			continue;
+		}
+
+		IssueGreetingPrefetch(NPC, EnvContext, EnvKey);
+	}
+}
+
+void APOClaudeAPIManager::IssueGreetingPrefetch(APONPCCharacter* NPC, const FClaudeRequestContext& EnvContext, uint32 EnvKey)
+{
+	const FObjectKey NPCKey(NPC);
+	const uint32 Serial = NextPrefetchSerial++;
+
+	FGreetingPrefetch& Prefetch = GreetingPrefetches.Add(NPCKey);
+	Prefetch.EnvKey = EnvKey;
+	Prefetch.Serial = Serial;
+
+	FClaudeRequestContext Context = EnvContext;
+	Context.NPCName        = NPC->NPCName;
+	Context.NPCPersonality = NPC->NPCPersonality;
+
+	FClaudeRequestCallbacks Callbacks;
+	Callbacks.Owner = NPC;
+	Callbacks.OnResponseNative.BindUObject(this, &APOClaudeAPIManager::OnGreetingPrefetched, NPCKey, Serial);
+
+	// 인사말은 로컬 의도 템플릿에도 걸리지만, 프리페치는 모델 인사말을 미리 받아 두는 것이 목적
+	FClaudeRequestOptions Options;
+	Options.bSkipLocalIntents = true;
+
+	PrefetchIssueTimes.Add(FPlatformTime::Seconds());
+	++NumPrefetchIssued;
+
+	EnqueueRequest(Context, Callbacks, Options);
+
+	// 응답 캐시 적중/즉시 거절로 API를 쓰지 않았다면 예산 반환
+	const FGreetingPrefetch* After = GreetingPrefetches.Find(NPCKey);
+	if (!After || After->bReady)
+	{
+		PrefetchIssueTimes.Pop(EAllowShrinking::No);
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("[ClaudeAPIManager] 인사말 프리페치: %s"), *NPC->NPCName);
+}
+
+void APOClaudeAPIManager::OnGreetingPrefetched(bool bSuccess, const FString& ResponseText, FObjectKey NPCKey, uint32 Serial)
+{
+	FGreetingPrefetch* Prefetch = GreetingPrefetches.Find(NPCKey);
+	if (!Prefetch || Prefetch->Serial != Serial)
+	{
+		// 이미 폐기된 프리페치의 늦은 응답
+		return;
+	}
+
+	if (Prefetch->Waiter.IsSet())
+	{
+		const FPendingRequest Waiter = MoveTemp(Prefetch->Waiter.GetValue());
+		GreetingPrefetches.Remove(NPCKey);
+		if (bSuccess)
+		{
+			++NumPrefetchServed;
+		}
+		DeliverResponse(Waiter.State, Waiter.Callbacks, EClaudeRequestOutcome::Completed, bSuccess, ResponseText);
+		return;
+	}
+
+	if (!bSuccess)
+	{
+		GreetingPrefetches.Remove(NPCKey);
+		return;
+	}
+
+	Prefetch->bReady    = true;
+	Prefetch->ReadyTime = FPlatformTime::Seconds();
+	Prefetch->Text      = ResponseText;
+}
+
+FPOClaudeRequestHandle APOClaudeAPIManager::TryServePrefetchedGreeting(
+	APONPCCharacter* NPC,
+	const FClaudeRequestContext& Context,
+	const FClaudeRequestCallbacks& Callbacks,
+	const FClaudeRequestOptions& Options)
+{
+	// 미리 받은 인사는 대화 이력 없이 만든 것이므로 첫 인사에만 사용
+	if (!bEnableGreetingPrefetch || !IsGreetingMessage(Context.PlayerMessage)
+		|| Context.History.Num() > 0 || !Context.HistorySummary.IsEmpty())
+	{
+		return FPOClaudeRequestHandle();
+	}
+
+	const FObjectKey NPCKey(NPC);
+	FGreetingPrefetch* Prefetch = GreetingPrefetches.Find(NPCKey);
+	if (!Prefetch || Prefetch->Waiter.IsSet() || Prefetch->EnvKey != MakeEnvKey(Context))
+	{
+		return FPOClaudeRequestHandle();
+	}
+
+	if (!Prefetch->bReady)
+	{
+		// 아직 받는 중이면 도착하는 대로 이 대화에 전달 (기한은 프리페치 요청 쪽 기한을 따름)
+		FPendingRequest& Waiter = Prefetch->Waiter.Emplace(MakeRequestState(Callbacks, Options.TimeoutSeconds));
+		Waiter.Callbacks = Callbacks;
+
+		const FRequestStateRef WaiterState = Waiter.State;
+		if (bUseStreaming && Options.FirstTextSLOSeconds > 0.0f)
+		{
+			StartSLOWatch(WaiterState, Callbacks, Context, Options.FirstTextSLOSeconds);
+		}
+		return FPOClaudeRequestHandle(WaiterState);
+	}
+
+	if (FPlatformTime::Seconds() - Prefetch->ReadyTime > PrefetchTTLSeconds)
+	{
+		++NumPrefetchDiscarded;
+		GreetingPrefetches.Remove(NPCKey);
+		return FPOClaudeRequestHandle();
+	}
+
+	const FString Text = MoveTemp(Prefetch->Text);
+	GreetingPrefetches.Remove(NPCKey);
+	++NumPrefetchServed;
+
+	UE_LOG(LogTemp, Log, TEXT("[ClaudeAPIManager] 프리페치 인사말 사용: %s"), *Text);
+
+	const FRequestStateRef State = MakeRequestState(Callbacks, Options.TimeoutSeconds);
+	DeliverResponse(State, Callbacks, EClaudeRequestOutcome::Completed, true, Text);
+	return FPOClaudeRequestHandle(State);
+}
+
+void APOClaudeAPIManager::SendMessageWithAutoContext(
+	const FString& PlayerMessage,
+	const FString& NPCName,
+	const FString& NPCPersonality,
+	const FOnClaudeResponse& ResponseCallback)
+{
+	SendMessageToClaude(MakeAutoContext(PlayerMessage, NPCName, NPCPersonality), ResponseCallback);
+}
+
+void APOClaudeAPIManager::SendMessageWithAutoContextAndQueueStatus(
+	const FString& PlayerMessage,
+	const FString& NPCName,
+	const FString& NPCPersonality,
+	const FOnClaudeResponse& ResponseCallback,
+	const FOnClaudeQueueStatus& QueueStatusCallback)
+{
+	SendMessageToClaudeWithQueueStatus(MakeAutoContext(PlayerMessage, NPCName, NPCPersonality), ResponseCallback, QueueStatusCallback);
+}
+
+FClaudeRequestContext APOClaudeAPIManager::MakeAutoContext(
+	const FString& PlayerMessage,
+	const FString& NPCName,
+	const FString& NPCPersonality) const
+{
+	FClaudeRequestContext Ctx;
+	Ctx.PlayerMessage   = PlayerMessage;
+	Ctx.NPCName         = NPCName;
+	Ctx.NPCPersonality  = NPCPersonality;
+
+	// 환경 스냅샷에서 날씨/RVT 수치/시간 수집 (액터 탐색 없음)
+	const UPOEnvironmentSubsystem* Environment = UPOEnvironmentSubsystem::Get(this);
+	if (!Environment)
+	{
+		return Ctx;
+	}
+
+	const FPOEnvironmentSnapshot& Env = Environment->GetSnapshot();
+	if (Env.bHasWeather)
+	{
+		Ctx.WeatherType = UPOEnvironmentSubsystem::WeatherToKorean(Env.Weather);
+	}
+
+	if (Env.bHasRVT)
+	{
+		Ctx.RainIntensity = Env.RainIntensity;
+		Ctx.SnowCoverage  = Env.SnowCoverage;
+		Ctx.WindStrength  = Env.WindStrength;
+	}
+
+	if (Env.bHasTimeOfDay)
+	{
+		Ctx.TimeOfDay = Env.TimeOfDay;
+	}
+
+	return Ctx;
+}
+
+void APOClaudeAPIManager::RetrieveMemories(const FClaudeRequestContext& Context, TArray<const FString*>& OutMemories) const
+{
+	if (!bEnableMemory || MemoryTokenBudget <= 0)
+	{
+		return;
+	}
+
+	MemoryStore.Retrieve(FPOClaudePromptBuilder::GetArchetypeKey(Context), Context.PlayerMessage, MemoryTopK, MemoryTokenBudget, OutMemories);
+}
+
+void APOClaudeAPIManager::RememberExchange(const FString& NPCName, const FString& NPCPersonality, const FString& PlayerMessage)
+{
+	if (!bEnableMemory)
+	{
+		return;
+	}
+
+	const int32 NumAdded = MemoryStore.RememberExchange(FPOClaudePromptBuilder::GetArchetypeKey(NPCName, NPCPersonality), PlayerMessage);
+	if (NumAdded > 0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[ClaudeAPIManager] %s 기억 %d개 추가"), *NPCName, NumAdded);
+	}
+}
+
+void APOClaudeAPIManager::PackPrompt(const FClaudeRequestContext& Context, FPOClaudePromptParts& OutPrompt)
+{
+	// 플레이어 메시지와 관련된 기억만 예산 안에서
+	TArray<const FString*> Memories;
+	RetrieveMemories(Context, Memories);
+
+	PromptBuilder.BuildPrompt(Context, HistoryTokenBudget, HistorySummaryTokenBudget, Memories, OutPrompt);
+}
+
+void APOClaudeAPIManager::BuildRequestBody(const FClaudeRequestContext& Context, int32 TierIndex, TArray<uint8>& OutBody)
+{
+	FPOClaudePromptParts Prompt;
+	PackPrompt(Context, Prompt);
+
+	TArray<FPOClaudeMessageView, TInlineAllocator<21>> Messages;
+	for (const FClaudeDialogueTurn* Turn : Prompt.Turns)
+	{
+		FPOClaudeMessageView& User = Messages.AddDefaulted_GetRef();
+		User.Role    = "user";
+		User.Content = &Turn->PlayerMessage;
+
+		FPOClaudeMessageView& Assistant = Messages.AddDefaulted_GetRef();
+		Assistant.Role    = "assistant";
+		Assistant.Content = &Turn->NPCResponse;
+	}
+
+	FPOClaudeMessageView& UserMessage = Messages.AddDefaulted_GetRef();
+	UserMessage.Role    = "user";
+	UserMessage.Content = &Context.PlayerMessage;
+
+	FPOClaudeRequestBodyParams Params;
+	const FClaudeModelTier* Tier = TierIndex != INDEX_NONE ? &ModelRouter.GetTier(TierIndex) : nullptr;
+
+	Params.Model              = Tier ? &Tier->ModelID : &ModelID;
+	Params.MaxTokens          = Tier ? Tier->MaxTokens : MaxTokens;
+	Params.bStream            = bUseStreaming;
+	Params.StaticSystem       = Prompt.StaticSystem;
+	Params.bCacheStaticSystem = bEnablePromptCaching;
+	Params.DynamicSystem      = &Prompt.DynamicSystem;
+	Params.Messages           = Messages;
+
+	POClaudeRequestWriter::WriteRequestBody(Params, OutBody);
+}
+
+FString APOClaudeAPIManager::TimeOfDayToKorean(float TimeOfDay) const
+{
+	return FPOClaudePromptBuilder::TimeOfDayToKorean(TimeOfDay);
+}
+
+void APOClaudeAPIManager::RecordUsage(const FClaudeUsage& Usage)
+{
+	TotalInputTokens         += Usage.InputTokens;
+	TotalOutputTokens        += Usage.OutputTokens;
+	TotalCacheReadTokens     += Usage.CacheReadInputTokens;
+	TotalCacheCreationTokens += Usage.CacheCreationInputTokens;
+
+	if (Usage.CacheReadInputTokens > 0)
+	{
+		++PromptCacheHits;
+	}
+	else
+	{
+		++PromptCacheMisses;
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("[ClaudeAPIManager] usage 입력 %d / 출력 %d / 캐시 읽기 %d / 캐시 생성 %d"),
+		Usage.InputTokens, Usage.OutputTokens, Usage.CacheReadInputTokens, Usage.CacheCreationInputTokens);
 }
@@ -2,12 +2,26 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "UObject/ObjectKey.h"
+#include "HttpFwd.h"
+#include "Containers/Ticker.h"
 #include "POClaudeTypes.h"
+#include "POClaudeResponseCache.h"
+#include "POClaudePromptBuilder.h"
+#include "POClaudeRateLimiter.h"
+#include "POClaudeModelRouter.h"
+#include "POClaudeMemoryStore.h"
+#include "POClaudeJournal.h"
+#include "POClaudeMetrics.h"
+#include "POClaudeRequestHandle.h"
+#include "POClaudeFallbackReplies.h"
+#include "POClaudeIntentMatcher.h"
+#include "POClaudeLocalReplies.h"
+#include "POClaudeBackend.h"
 #include "POClaudeAPIManager.generated.h"
 
-class APOWeatherSystemManager;
-class APOTimeOfDayManager;
-class APORVTManager;
+class APONPCCharacter;
+struct FPOClaudeStreamState;
 
 UCLASS()
 class PROJECT_OPENWORLD_API APOClaudeAPIManager : public AActor
@@ -19,18 +33,318 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
-	// 사용할 Claude 모델 ID 
+	// 요청을 보낼 /v1/messages 주소 (DefaultGame.ini [Claude] EndpointURL로 덮어씀, 루프백 모의 서버 지정 가능) 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude|Config")
+	FString EndpointURL = TEXT("https://api.anthropic.com/v1/messages");
+
+	// 사용할 Claude 모델 ID (모델 라우팅을 끄거나 티어가 비었을 때) 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Config")
 	FString ModelID = TEXT("claude-haiku-4-5");
 
-	// 응답 최대 토큰 수 
+	// 응답 최대 토큰 수 (모델 라우팅을 쓰면 티어별 값 사용) 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Config",meta = (ClampMin = "50", ClampMax = "500"))
 	int32 MaxTokens = 200;
 
+	// SSE 스트리밍으로 받아 텍스트 조각을 즉시 전달할지 여부 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Config")
+	bool bUseStreaming = true;
+
+	// 정적 시스템 프롬프트 블록에 cache_control을 붙여 서버 측 프롬프트 캐시를 사용할지 여부 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Config")
+	bool bEnablePromptCaching = true;
+
+	// 요청마다 복잡도와 최근 응답 시간으로 모델 티어를 고를지 여부 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Routing")
+	bool bEnableModelRouting = true;
+
+	// 모델 티어 (빠른 모델 → 큰 모델 순) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Routing", meta = (EditCondition = "bEnableModelRouting"))
+	TArray<FClaudeModelTier> ModelTiers;
+
+	// 복잡도 계산에서 메시지 길이 항이 최대가 되는 글자 수 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Routing", meta = (ClampMin = "1", EditCondition = "bEnableModelRouting"))
+	int32 LongMessageChars = 80;
+
+	// 복잡도 계산에서 대화 깊이 항이 최대가 되는 이전 턴 수 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Routing", meta = (ClampMin = "1", EditCondition = "bEnableModelRouting"))
+	int32 DeepConversationTurns = 6;
+
+	// 티어별 p95 응답 시간을 볼 최근 구간 (초) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Routing", meta = (ClampMin = "6", EditCondition = "bEnableModelRouting"))
+	float LatencyWindowSeconds = 60.0f;
+
+	// 구간 안 표본이 이보다 적으면 지연 예산 검사를 하지 않음 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Routing", meta = (ClampMin = "1", EditCondition = "bEnableModelRouting"))
+	int32 MinLatencySamples = 5;
+
+	// 동시에 전송 중일 수 있는 최대 요청 수 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Queue", meta = (ClampMin = "1", ClampMax = "32"))
+	int32 MaxConcurrentRequests = 4;
+
+	// 대기열에 보관할 수 있는 최대 요청 수 (초과 시 거절) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Queue", meta = (ClampMin = "0"))
+	int32 MaxQueuedRequests = 64;
+
+	// 한 NPC가 대기열에 동시에 올려둘 수 있는 최대 요청 수 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Queue", meta = (ClampMin = "1"))
+	int32 MaxQueuedPerOwner = 2;
+
+	// 요청 기본 기한 (등록 시각 기준, 초). 대기/재시도/전송을 모두 포함하며 넘기면 실패 콜백 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Queue", meta = (ClampMin = "1"))
+	float RequestTimeoutSeconds = 30.0f;
+
+	// 지연 목표를 넘겨 폴백으로 먼저 답한 뒤 실제 응답이 오면 OnFollowUp으로 전달할지 (false면 요청을 중단하고 버림) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|SLO")
+	bool bDeliverLateResponseAsFollowUp = true;
+
+	// 인사/작별/감사/날씨·시간 질문을 API 호출 없이 페르소나 템플릿으로 바로 답할지 여부 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|LocalIntent")
+	bool bEnableLocalIntents = true;
+
+	// 의도 패턴에 덮이지 않은 글자가 이보다 많으면 API로 보냄 (정규화 후 글자 수). 2 이상이면 "몇 시에 문 닫아요?" 같은 질문도 템플릿으로 답함 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|LocalIntent", meta = (ClampMin = "0", ClampMax = "3", EditCondition = "bEnableLocalIntents"))
+	int32 MaxUnmatchedChars = FPOClaudeIntentMatcher::DefaultMaxUncoveredChars;
+
+	// 대사 생성 경로 (Auto = API 키가 없거나 HTTP 연결 실패 직후에는 로컬 모델로 응답) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Backend")
+	EClaudeBackend Backend = EClaudeBackend::Auto;
+
+	// 로컬 GGUF 모델 경로 (Content 기준 상대 경로 또는 절대 경로, 파일이 없으면 로컬 백엔드 비활성) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Backend", meta = (EditCondition = "Backend != EClaudeBackend::Http"))
+	FString LocalModelPath = TEXT("Models/npc-dialogue.gguf");
+
+	// 로컬 추론 워커 수 (동시에 생성하는 대사 수, 워커마다 KV 캐시 1개) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Backend", meta = (ClampMin = "1", ClampMax = "8", EditCondition = "Backend != EClaudeBackend::Http"))
+	int32 LocalWorkerThreads = 2;
+
+	// 워커 하나가 쓰는 CPU 스레드 수 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Backend", meta = (ClampMin = "1", ClampMax = "16", EditCondition = "Backend != EClaudeBackend::Http"))
+	int32 LocalThreadsPerWorker = 2;
+
+	// 워커 컨텍스트 길이 (프롬프트 + 응답 토큰) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Backend", meta = (ClampMin = "512", EditCondition = "Backend != EClaudeBackend::Http"))
+	int32 LocalContextTokens = 2048;
+
+	// Auto: HTTP 연결 실패 후 이 시간 동안은 로컬 모델로 보냄 (초) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Backend", meta = (ClampMin = "1", EditCondition = "Backend == EClaudeBackend::Auto"))
+	float OfflineFallbackSeconds = 30.0f;
+
+	// 분당 최대 요청 수 (0 = 제한 없음, 계정 한도보다 조금 낮게) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|RateLimit", meta = (ClampMin = "0"))
+	int32 RequestsPerMinute = 50;
+
+	// 분당 최대 토큰 수 (입력 + 캐시 생성 + 출력, 0 = 제한 없음) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|RateLimit", meta = (ClampMin = "0"))
+	int32 TokensPerMinute = 40000;
+
+	// 429/529/5xx/네트워크 오류 재시도를 포기할 기한 (최초 요청 시각 기준, 초) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|RateLimit", meta = (ClampMin = "0"))
+	float RetryDeadlineSeconds = 30.0f;
+
+	// 재시도 백오프 기준/상한 (초, 지터 포함 지수 증가) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|RateLimit", meta = (ClampMin = "0.05"))
+	float BackoffBaseSeconds = 0.5f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|RateLimit", meta = (ClampMin = "0.05"))
+	float BackoffMaxSeconds = 8.0f;
+
+	// 요청에 다시 보낼 이전 대화 턴의 토큰 예산 (최근 턴부터 채움) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|History", meta = (ClampMin = "0"))
+	int32 HistoryTokenBudget = 600;
+
+	// 예산 밖으로 밀려난 턴을 접은 요약의 토큰 예산 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|History", meta = (ClampMin = "0"))
+	int32 HistorySummaryTokenBudget = 200;
+
+	// 같은 NPC/날씨/시간대/메시지 조합의 응답을 재사용할지 여부 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Cache")
+	bool bEnableResponseCache = true;
+
+	// 응답 캐시 메모리 예산 (KB, 초과 시 LRU 제거) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Cache", meta = (ClampMin = "16", EditCondition = "bEnableResponseCache"))
+	int32 ResponseCacheBudgetKB = 1024;
+
+	// 키당 모아둘 응답 변형 수 (2 이상이면 그만큼 모일 때까지 API 호출 후 무작위 재사용) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Cache", meta = (ClampMin = "1", ClampMax = "8", EditCondition = "bEnableResponseCache"))
+	int32 ResponseCacheVariants = 1;
+
+	// Saved/Claude/ResponseCache.bin에 저장해 재시작 후에도 유지할지 여부 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Cache", meta = (EditCondition = "bEnableResponseCache"))
+	bool bPersistResponseCache = true;
+
+	// 플레이어가 말한 자기 이야기를 NPC별로 기억해 관련된 것을 프롬프트에 넣을지 여부 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Memory")
+	bool bEnableMemory = true;
+
+	// 요청마다 넣을 기억 최대 개수 (관련도 순) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Memory", meta = (ClampMin = "1", ClampMax = "16", EditCondition = "bEnableMemory"))
+	int32 MemoryTopK = 4;
+
+	// 기억 블록의 토큰 예산 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Memory", meta = (ClampMin = "0", EditCondition = "bEnableMemory"))
+	int32 MemoryTokenBudget = 120;
+
+	// NPC당 보관할 기억 수 (초과 시 가장 오래된 것부터 제거) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Memory", meta = (ClampMin = "16", EditCondition = "bEnableMemory"))
+	int32 MaxMemoriesPerNPC = 4096;
+
+	// Saved/Claude/Memory.bin에 저장해 재시작 후에도 유지할지 여부 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Memory", meta = (EditCondition = "bEnableMemory"))
+	bool bPersistMemory = true;
+
+	// 모든 대화(NPC, 환경, 프롬프트 해시, 응답, 지연, 토큰)를 Saved/Claude/Journal에 이진 기록으로 남길지 여부 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Journal")
+	bool bEnableJournal = true;
+
+	// 기록 파일 하나의 최대 크기 (MB, 넘으면 새 파일) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Journal", meta = (ClampMin = "1", EditCondition = "bEnableJournal"))
+	int32 JournalMaxFileMB = 64;
+
+	// 남겨 둘 기록 파일 수 (오래된 것부터 삭제) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Journal", meta = (ClampMin = "1", EditCondition = "bEnableJournal"))
+	int32 JournalMaxFiles = 20;
+
+	// 플레이어가 Idle NPC 근처에 오면 인사말을 미리 요청해 둘지 여부 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Prefetch")
+	bool bEnableGreetingPrefetch = false;
+
+	// 인사말로 취급할 플레이어 메시지 (StartConversation에 빈 문자열이 오면 이 문장으로 요청) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Prefetch")
+	FString GreetingPlayerMessage = TEXT("안녕하세요!");
+
+	// 프리페치를 시작할 플레이어-NPC 거리 (cm) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Prefetch", meta = (ClampMin = "100", EditCondition = "bEnableGreetingPrefetch"))
+	float PrefetchRadius = 1000.0f;
+
+	// 받아 둔 인사말 유효 시간 (초) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Prefetch", meta = (ClampMin = "5", EditCondition = "bEnableGreetingPrefetch"))
+	float PrefetchTTLSeconds = 90.0f;
+
+	// 분당 최대 프리페치 요청 수 (API 비용 상한) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Prefetch", meta = (ClampMin = "0", EditCondition = "bEnableGreetingPrefetch"))
+	int32 MaxPrefetchesPerMinute = 6;
+
+	// 근접 검사 주기 (초) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Claude|Prefetch", meta = (ClampMin = "0.1", EditCondition = "bEnableGreetingPrefetch"))
+	float PrefetchScanInterval = 0.5f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|State")
+	int32 NumInFlightRequests = 0;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|State")
-	bool bRequestInProgress = false;
+	int32 NumQueuedRequests = 0;
+
+	// 누적 토큰 사용량 (응답 usage 합계) 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|Usage")
+	int64 TotalInputTokens = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|Usage")
+	int64 TotalOutputTokens = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|Usage")
+	int64 TotalCacheReadTokens = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|Usage")
+	int64 TotalCacheCreationTokens = 0;
+
+	// 프롬프트 캐시 적중 (cache_read_input_tokens > 0) / 미스 응답 수 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|Usage")
+	int32 PromptCacheHits = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|Usage")
+	int32 PromptCacheMisses = 0;
+
+	// 최종 응답을 전달한 요청 수 (성공/실패 포함) / 취소·소유자 소멸로 버린 요청 수 / 기한 초과 요청 수 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|State")
+	int32 NumCompletedRequests = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|State")
+	int32 NumCancelledRequests = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|State")
+	int32 NumTimedOutRequests = 0;
+
+	// 지연 목표가 걸린 요청 수 / 목표를 넘겨 폴백 대사로 답한 수 / 폴백 뒤 실제 응답을 후속 전달한 수 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|SLO")
+	int32 NumSLORequests = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|SLO")
+	int32 NumFallbackReplies = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|SLO")
+	int32 NumFollowUpReplies = 0;
+
+	// 지연 목표가 걸린 요청 중 폴백으로 답한 비율 (0.0 ~ 1.0) 
+	UFUNCTION(BlueprintPure, Category = "Claude|SLO")
+	float GetFallbackRate() const { return NumSLORequests > 0 ? static_cast<float>(NumFallbackReplies) / NumSLORequests : 0.0f; }
+
+	// 로컬 의도 판정을 거친 메시지 수 / 그중 API 없이 템플릿으로 답한 수 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|LocalIntent")
+	int32 NumLocalIntentChecks = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|LocalIntent")
+	int32 NumLocalIntentReplies = 0;
+
+	// 판정을 거친 메시지 중 로컬로 답한 비율 (0.0 ~ 1.0) 
+	UFUNCTION(BlueprintPure, Category = "Claude|LocalIntent")
+	float GetLocalIntentHitRate() const { return NumLocalIntentChecks > 0 ? static_cast<float>(NumLocalIntentReplies) / NumLocalIntentChecks : 0.0f; }
+
+	// 의도별 로컬 응답 수 
+	UFUNCTION(BlueprintPure, Category = "Claude|LocalIntent")
+	int32 GetLocalIntentHits(EClaudeLocalIntent Intent) const;
+
+	// 의도별 적중/놓침 통계와 최근 놓친 메시지 출력 (규칙 표를 늘릴 근거, Claude.Intents 콘솔 명령) 
+	void DumpLocalIntentStats(FOutputDevice& Ar) const;
+	void ResetLocalIntentStats();
+
+	// 대화 한 턴이 끝난 뒤 플레이어 메시지에서 기억할 사실을 뽑아 NPC 기억에 추가 (NPC가 응답 수신 시 호출) 
+	void RememberExchange(const FString& NPCName, const FString& NPCPersonality, const FString& PlayerMessage);
+
+	// 저장된 기억 수 (전체 NPC) 
+	UFUNCTION(BlueprintPure, Category = "Claude|Memory")
+	int32 GetNumMemories() const { return MemoryStore.GetNumFacts(); }
+
+	// p95 지연 예산 초과로 더 빠른 티어로 보낸 요청 수 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|Routing")
+	int32 NumDowngradedRequests = 0;
+
+	// 티어별 전송/강등 수와 최근 p50/p95 출력 (Claude.Routing 콘솔 명령) 
+	void DumpRoutingStats(FOutputDevice& Ar) const;
+	void ResetRoutingStats();
+
+	// 로컬 모델로 보낸 요청 수 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|Backend")
+	int32 NumOfflineRequests = 0;
+
+	// 지금 새 요청을 로컬 모델로 보낼지 (Backend 설정, API 키, 최근 HTTP 연결 실패 기준) 
+	bool ShouldUseOfflineBackend() const;
+
+	// 재시도한 횟수 / 429 응답 수 / 기한 초과로 포기한 요청 수 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|RateLimit")
+	int32 NumRetries = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|RateLimit")
+	int32 NumRateLimited = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|RateLimit")
+	int32 NumRetryGiveUps = 0;
+
+	// 프리페치 요청 / 대화에 사용된 프리페치 / 날씨·시간대 변경이나 만료로 버린 프리페치 수 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|Prefetch")
+	int32 NumPrefetchIssued = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|Prefetch")
+	int32 NumPrefetchServed = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|Prefetch")
+	int32 NumPrefetchDiscarded = 0;
+
+	// 최근 응답 시간 이동평균 (예상 대기 시간 계산용) 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Claude|State")
+	float AverageRequestSeconds = 2.0f;
 
 	UFUNCTION(BlueprintCallable, Category = "Claude")
 	void SendMessageToClaude(const FClaudeRequestContext& Context,const FOnClaudeResponse& ResponseCallback);
@@ -38,23 +352,298 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Claude")
 	void SendMessageWithAutoContext(const FString& PlayerMessage,const FString& NPCName,const FString& NPCPersonality,const FOnClaudeResponse& ResponseCallback);
 
+	// 대기열 위치/예상 대기 시간도 받는 버전 (QueuePosition 0 = 전송 시작, -1 = 대기열이 가득 차 거절되어 곧 실패 응답) 
+	UFUNCTION(BlueprintCallable, Category = "Claude")
+	void SendMessageToClaudeWithQueueStatus(const FClaudeRequestContext& Context, const FOnClaudeResponse& ResponseCallback, const FOnClaudeQueueStatus& QueueStatusCallback);
+
+	UFUNCTION(BlueprintCallable, Category = "Claude")
+	void SendMessageWithAutoContextAndQueueStatus(const FString& PlayerMessage, const FString& NPCName, const FString& NPCPersonality,
+		const FOnClaudeResponse& ResponseCallback, const FOnClaudeQueueStatus& QueueStatusCallback);
+
+	// 요청을 대기열에 넣고 슬롯이 비는 대로 전송 (대기 위치는 OnQueueStatus로 통지) 
+	// 반환된 핸들로 취소/결과 대기 가능. 기한/첫 텍스트 지연 목표는 Options로 지정 
+	FPOClaudeRequestHandle EnqueueRequest(const FClaudeRequestContext& Context, const FClaudeRequestCallbacks& Callbacks,
+		const FClaudeRequestOptions& Options = FClaudeRequestOptions());
+
+	// 취소 플래그가 선 요청을 대기열/전송/프리페치 대기에서 제거 (FPOClaudeRequestHandle::Cancel이 게임 스레드에서 호출) 
+	void ProcessCancellation(const TSharedRef<FPOClaudeRequestState, ESPMode::ThreadSafe>& State);
+
+	// 날씨/RVT/시간 정보를 채운 요청 컨텍스트 생성 
+	FClaudeRequestContext MakeAutoContext(const FString& PlayerMessage, const FString& NPCName, const FString& NPCPersonality) const;
+
+	// 프리페치 대상 NPC 등록/해제 (NPC BeginPlay/EndPlay에서 호출) 
+	void RegisterNPC(APONPCCharacter* NPC);
+	void UnregisterNPC(APONPCCharacter* NPC);
+
+	// 인사말 요청이고 같은 날씨/시간대로 받아 둔(또는 받는 중인) 프리페치가 있으면 그것으로 응답. 처리하지 않았으면 빈 핸들 
+	FPOClaudeRequestHandle TryServePrefetchedGreeting(APONPCCharacter* NPC, const FClaudeRequestContext& Context, const FClaudeRequestCallbacks& Callbacks,
+		const FClaudeRequestOptions& Options = FClaudeRequestOptions());
+
+	bool IsGreetingMessage(const FString& PlayerMessage) const;
+
+	// EndpointURL이 localhost/127.0.0.1인지 (API 키 없이 허용) 
+	bool IsLoopbackEndpoint() const;
+
+	// 게임 스레드에서 쓴 누적 시간 (요청 등록 경로 / 응답·스트리밍 처리 경로, 초) 
+	double GetEnqueueGameThreadSeconds() const { return EnqueueGameThreadSeconds; }
+	double GetResponseGameThreadSeconds() const { return ResponseGameThreadSeconds; }
+
 private:
+	using FRequestStateRef = TSharedRef<FPOClaudeRequestState, ESPMode::ThreadSafe>;
+
+	struct FPendingRequest
+	{
+		explicit FPendingRequest(const FRequestStateRef& InState)
+			: RequestId(InState->RequestId)
+			, State(InState)
+		{
+		}
+
+		int32 RequestId = 0;
+		FClaudeRequestContext Context;
+		FClaudeRequestCallbacks Callbacks;
+
+		// 핸들과 공유하는 취소 플래그/기한/결과 
+		FRequestStateRef State;
+
+		// 공정성 판단 기준 (콜백이 바인딩된 NPC) 
+		FObjectKey OwnerKey;
+
+		double EnqueueTime = 0.0;
+
+		// 즉시 전송되지 못하고 대기 위치를 통지받았는지 
+		bool bWasQueued = false;
+
+		// 성공 시 응답을 저장할 캐시 키 (0 = 캐시 안 함) 
+		uint64 CacheKey = 0;
+
+		// 속도 제한기에 예약할 추정 토큰 수 
+		int32 EstimatedTokens = 0;
+
+		// 전송 시 고른 모델 티어 (INDEX_NONE = ModelID/MaxTokens) 
+		int32 TierIndex = INDEX_NONE;
+
+		// 재시도 횟수와 재시도 가능 기한 (요청 기한을 넘지 않음) 
+		int32 Attempt = 0;
+		double Deadline = 0.0;
+
+		// 백오프 중이면 이 시각 이후에만 전송 
+		double NotBefore = 0.0;
+	};
+
 	FString APIKey;
 
+	TUniquePtr<FPOClaudeResponseCache> ResponseCache;
+
+	FPOClaudeRateLimiter RateLimiter;
+
+	FPOClaudeModelRouter ModelRouter;
+
+	// NPC별 장기 기억 (bEnableMemory) 
+	FPOClaudeMemoryStore MemoryStore;
+
+	// 대화 기록기 (bEnableJournal이면 BeginPlay에서 시작) 
+	TUniquePtr<FPOClaudeJournalWriter> Journal;
+
+	// 매 프레임 지표를 stat/CSV/Insights로 내보내는 티커 
+	FTSTicker::FDelegateHandle MetricsTickerHandle;
+
+	// 백오프 지터용 
+	FRandomStream RetryRandom;
+
+	// 속도 제한/백오프가 풀리는 시점에 대기열을 다시 펌프 
+	FTimerHandle PumpTimerHandle;
+
+	FPOClaudePromptBuilder PromptBuilder;
+
+	// 비 HTTP 백엔드 (Backend가 Http가 아니면 BeginPlay에서 생성) 
+	TUniquePtr<IPOClaudeBackend> OfflineBackend;
+
+	// Auto: 이 시각까지는 로컬 모델로 보냄 (HTTP 연결 실패 시 갱신) 
+	double OfflineUntil = 0.0;
+
+	// 요청 본문 직렬화용 재사용 버퍼 (게임 스레드 전용) 
+	TArray<uint8> RequestBodyScratch;
+
+	// 전송 대기 중인 요청 (FIFO) 
+	TArray<FPendingRequest> PendingQueue;
+
+	// 소유자별 전송 중 요청 수 
+	TMap<FObjectKey, int32> InFlightPerOwner;
+
+	/** 전송 중인 HTTP 요청 (EndPlay에서 중단하고 취소로 확정) */
+	struct FInFlightHttpRequest
+	{
+		FRequestStateRef State;
+		FHttpRequestRef Request;
+	};
+
+	// 요청 ID → 전송 중인 HTTP 요청 (완료 콜백에서 제거) 
+	TMap<int32, FInFlightHttpRequest> InFlightHttpRequests;
+
+	int32 NextRequestId = 1;
+
+	/** NPC별 미리 받아 둔 인사말 */
+	struct FGreetingPrefetch
+	{
+		// 날씨 + 시간대 키 (바뀌면 폐기) 
+		uint32 EnvKey = 0;
+
+		// 늦게 도착한 이전 요청 응답을 구분하기 위한 일련번호 
+		uint32 Serial = 0;
+
+		bool bReady = false;
+		double ReadyTime = 0.0;
+		FString Text;
+
+		// 응답 도착 전에 대화를 시작한 NPC의 요청 (도착 즉시 전달) 
+		TOptional<FPendingRequest> Waiter;
+	};
+
+	TArray<TWeakObjectPtr<APONPCCharacter>> RegisteredNPCs;
+
+	TMap<FObjectKey, FGreetingPrefetch> GreetingPrefetches;
+
+	// 최근 1분간 프리페치 발행 시각 (분당 예산) 
+	TArray<double> PrefetchIssueTimes;
+
+	uint32 NextPrefetchSerial = 1;
+
+	FTimerHandle PrefetchScanTimerHandle;
+
+	double EnqueueGameThreadSeconds = 0.0;
+	double ResponseGameThreadSeconds = 0.0;
+
+	// 빈 슬롯만큼 대기열에서 꺼내 전송 (취소/기한 초과 요청은 먼저 정리) 
+	void PumpQueue();
+
+	// 대기열에서 취소·소유자 소멸·기한 초과 요청 제거. 남은 요청 중 가장 이른 기한 반환 
+	double ExpirePendingRequests(double Now);
+
+	FRequestStateRef MakeRequestState(const FClaudeRequestCallbacks& Callbacks, float TimeoutSeconds);
+
+	/** 첫 텍스트를 기다리는 지연 목표 감시 항목 */
+	struct FSLOWatch
+	{
+		FRequestStateRef State;
+		FClaudeRequestCallbacks Callbacks;
+
+		// 폴백 대사 시간대 선택용 
+		float TimeOfDay = 12.0f;
+
+		double Deadline = 0.0;
+	};
+
+	TArray<FSLOWatch> SLOWatches;
+
+	FTimerHandle SLOTimerHandle;
+
+	FPOClaudeFallbackReplies FallbackReplies;
+
+	FPOClaudeIntentMatcher IntentMatcher;
+
+	FPOClaudeLocalReplies LocalReplies;
+
+	static constexpr int32 NumLocalIntents = static_cast<int32>(EClaudeLocalIntent::MAX);
+
+	// 의도별 로컬 응답 수 / 의도는 걸렸지만 다른 말이 많아 API로 보낸 수 
+	TStaticArray<int32, NumLocalIntents> LocalIntentHits;
+	TStaticArray<int32, NumLocalIntents> LocalIntentMisses;
+
+	// 최근 놓친 메시지 (고정 크기 링 버퍼) 
+	static constexpr int32 MaxRecentIntentMisses = 32;
+	TArray<FString> RecentIntentMisses;
+	int32 NextIntentMissSlot = 0;
+
+	// 로컬 의도로 답할 수 있으면 OutText를 채우고 true 
+	bool TryAnswerLocally(const FClaudeRequestContext& Context, const FObjectKey& OwnerKey, uint32 Seed, FString& OutText);
+
+	void StartSLOWatch(const FRequestStateRef& State, const FClaudeRequestCallbacks& Callbacks, const FClaudeRequestContext& Context, float SLOSeconds);
+
+	// 첫 텍스트/최종 응답/취소 시 감시 해제 
+	void StopSLOWatch(const FRequestStateRef& State);
+
+	// 기한이 지난 감시 항목을 폴백 대사로 응답하고 다음 확인 예약 
+	void CheckSLOWatches();
+
+	// 요청 결과 확정 후 집계/콜백 (이미 확정됐으면 무시, 취소면 콜백 생략). 게임 스레드 전용 
+	void DeliverResponse(const FRequestStateRef& State, const FClaudeRequestCallbacks& Callbacks,
+		EClaudeRequestOutcome Outcome, bool bSuccess, const FString& Text);
+
+	// 종료 시 남은 요청을 콜백 없이 취소로 확정 (Insights 구간 종료, 취소 집계). 이번에 확정했으면 true 
+	bool CancelWithoutCallbacks(const FRequestStateRef& State);
+
+	// 다음에 전송할 대기열 인덱스 (백오프 중인 요청 제외, 전송 중 요청이 없는 NPC 우선). 없으면 INDEX_NONE 
+	int32 SelectNextPendingIndex(double Now) const;
+
+	// Delay초 뒤 PumpQueue 예약 (이미 더 이른 예약이 있으면 유지) 
+	void SchedulePump(double DelaySeconds);
+
+	void DispatchRequest(FPendingRequest&& Pending);
+
+	// 비 HTTP 백엔드로 전송 (속도 제한/재시도 없음, 대기열/공정성/SLO/취소는 HTTP와 동일) 
+	void DispatchToBackend(FPendingRequest&& Pending);
+
+	void HandleBackendComplete(const FPendingRequest& Sent, FPOClaudeBackendResult&& Result);
+
+	void CreateOfflineBackend();
+
+	// 재시도 가능한 실패(429/529/5xx/네트워크/빈 스트림 오류)면 백오프 후 대기열 앞에 다시 넣고 true 
+	bool TryScheduleRetry(FPendingRequest& Sent, FHttpResponsePtr Res, bool bConnectedSuccessfully,
+		const TSharedPtr<FPOClaudeStreamState, ESPMode::ThreadSafe>& StreamState);
+
+	static bool IsRetryableStatus(int32 StatusCode);
+
+	int32 EstimateRequestTokens(const FClaudeRequestContext& Context);
+
+	// 플레이어 주변 Idle NPC에 인사말 프리페치 발행, 만료/환경 변경 항목 정리 
+	void ScanPrefetchCandidates();
+
+	void IssueGreetingPrefetch(APONPCCharacter* NPC, const FClaudeRequestContext& EnvContext, uint32 EnvKey);
+
+	void OnGreetingPrefetched(bool bSuccess, const FString& ResponseText, FObjectKey NPCKey, uint32 Serial);
+
+	static uint32 MakeEnvKey(const FClaudeRequestContext& Context);
+
+	// 완료된 요청의 상태 코드/본문 검사 후 최종 콜백 호출
+	void HandleRequestComplete(const TSharedRef<FPendingRequest>& Sent, FHttpResponsePtr Res,
+		bool bConnectedSuccessfully, const TSharedPtr<FPOClaudeStreamState, ESPMode::ThreadSafe>& StreamState);
+
+	// 파싱이 끝난 응답 처리 (usage 집계, 캐시 저장, 최종 콜백). 게임 스레드 전용
+	void FinishResponse(const FPendingRequest& Sent, FString&& Text, const FClaudeUsage& Usage, bool bParsed);
+
+	void OnRequestFinished(const FObjectKey& OwnerKey, double ElapsedSeconds);
+
+	// 대기 중인 모든 요청에 현재 위치 통지 
+	void BroadcastQueuePositions() const;
+
+	float EstimateWaitSeconds(int32 QueuePosition) const;
+
 	void LoadAPIKeyFromConfig();
 
-	// 시스템 프롬프트 조립 (날씨/시간 필수 반영) 
-	FString BuildSystemPrompt(const FClaudeRequestContext& Context) const;
+	// 관련 기억을 골라 FPOClaudePromptBuilder::BuildPrompt로 프롬프트 재료를 만듦 (HTTP/로컬 공용) 
+	void PackPrompt(const FClaudeRequestContext& Context, FPOClaudePromptParts& OutPrompt);
 
-	// Claude API 요청 JSON 조립 
-	FString BuildRequestJson(const FClaudeRequestContext& Context) const;
+	// 이 NPC의 기억 중 플레이어 메시지와 관련된 것 (MemoryTopK개, MemoryTokenBudget 이내) 
+	void RetrieveMemories(const FClaudeRequestContext& Context, TArray<const FString*>& OutMemories) const;
 
-	// HTTP 응답에서 content[0].text 추출 
-	FString ParseClaudeResponse(const FString& ResponseBody) const;
+	// Claude API 요청 본문을 UTF-8로 바로 기록 (system은 캐시 가능한 정적 블록 + 짧은 동적 블록) 
+	void BuildRequestBody(const FClaudeRequestContext& Context, int32 TierIndex, TArray<uint8>& OutBody);
 
-	FString TimeOfDayToKorean(float TimeOfDay) const;
 
-	APOWeatherSystemManager* FindWeatherManager() const;
-	APOTimeOfDayManager* FindTimeOfDayManager() const;
-	APORVTManager* FindRVTManager() const;
+	// usage 누적 및 프롬프트 캐시 적중 집계
+	void RecordUsage(const FClaudeUsage& Usage);
+
+	FString GetResponseCachePath() const;
+	FString GetMemoryPath() const;
+	FString GetJournalDirectory() const;
+
+	// 응답 1건을 지표에 반영하고 대화 기록에 추가 (게임 스레드에서는 원자적 증가와 대기열 추가만 함) 
+	void RecordExchange(const FRequestStateRef& State, const FClaudeRequestContext& Context, EPOClaudeJournalSource Source,
+		double StartTime, bool bSuccess, const FString& Text, const FClaudeUsage& Usage = FClaudeUsage(),
+		int32 TierIndex = INDEX_NONE, uint64 CacheKey = 0, int32 StatusCode = 0);
+	void RecordExchange(const FPendingRequest& Sent, EPOClaudeJournalSource Source, bool bSuccess, const FString& Text,
+		const FClaudeUsage& Usage = FClaudeUsage(), int32 StatusCode = 0);
+
+	FString TimeOfDayToKorean(float TimeOfDay) const;
 };
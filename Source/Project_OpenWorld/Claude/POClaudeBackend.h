@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "POClaudeTypes.h"
+#include "POClaudeRequestHandle.h"
+
+/** 백엔드에 넘기는 대화 메시지 1개 (값 복사, 워커 스레드에서 읽음) */
+struct FPOClaudeChatMessage
+{
+	bool bAssistant = false;
+	FString Content;
+};
+
+/**
+ * 백엔드 생성 요청 1건
+ * APOClaudeAPIManager가 HTTP 요청 본문과 같은 재료(정적/동적 시스템 블록, 토큰 예산에 맞춘 이력)로 채운다.
+ */
+struct FPOClaudeBackendRequest
+{
+	explicit FPOClaudeBackendRequest(const TSharedRef<FPOClaudeRequestState, ESPMode::ThreadSafe>& InState)
+		: State(InState)
+	{
+	}
+
+	// 취소 플래그/기한 (워커가 토큰마다 확인)
+	TSharedRef<FPOClaudeRequestState, ESPMode::ThreadSafe> State;
+
+	// 아키타입마다 같은 공유 접두부 (로컬 백엔드는 이 구간의 KV 캐시를 재사용)
+	FString StaticSystem;
+	FString DynamicSystem;
+
+	// user/assistant 교대, 마지막은 user
+	TArray<FPOClaudeChatMessage> Messages;
+
+	int32 MaxTokens = 200;
+};
+
+/** 백엔드 생성 결과 */
+struct FPOClaudeBackendResult
+{
+	bool bSuccess = false;
+
+	// 기한을 넘겨 생성을 멈춤
+	bool bTimedOut = false;
+
+	FString Text;
+
+	// InputTokens = 새로 평가한 프롬프트 토큰, CacheReadInputTokens = 재사용한 접두부 토큰
+	FClaudeUsage Usage;
+};
+
+// 둘 다 게임 스레드에서 호출
+DECLARE_DELEGATE_OneParam(FOnPOClaudeBackendPartial, const FString& /*AccumulatedText*/);
+DECLARE_DELEGATE_OneParam(FOnPOClaudeBackendComplete, FPOClaudeBackendResult&& /*Result*/);
+
+/**
+ * APOClaudeAPIManager 뒤에 꽂는 비 HTTP 대화 생성 백엔드
+ * HTTP 경로(대기열/속도 제한/재시도/스트리밍)는 매니저가 직접 처리하고,
+ * 매니저가 이 인터페이스로 보내기로 고른 요청만 넘어온다. 대기열/공정성/SLO/취소 계약은 그대로 적용된다.
+ */
+class PROJECT_OPENWORLD_API IPOClaudeBackend
+{
+public:
+	virtual ~IPOClaudeBackend() = default;
+
+	virtual const TCHAR* GetName() const = 0;
+
+	// 요청을 받을 수 있는지 (초기화 중이면 true, 초기화 실패면 false)
+	virtual bool IsAvailable() const = 0;
+
+	// 게임 스레드에서 호출. OnComplete는 취소/기한 초과를 포함해 정확히 한 번 호출된다
+	virtual void Submit(FPOClaudeBackendRequest&& Request, FOnPOClaudeBackendPartial OnPartial, FOnPOClaudeBackendComplete OnComplete) = 0;
+
+	// 진행 중인 작업을 멈추고 스레드/자원 정리 (이후 콜백 없음)
+	virtual void Shutdown() = 0;
+};
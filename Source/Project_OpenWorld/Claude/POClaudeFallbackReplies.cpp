@@ -0,0 +1,46 @@
+#include "POClaudeFallbackReplies.h"
+
+FPOClaudeFallbackReplies::FPOClaudeFallbackReplies()
+{
+	// EPOTimePeriod 선언 순서와 같아야 함
+	static const TCHAR* const PeriodOpeners[NumPeriods] = {
+		TEXT("이 새벽에 어쩐 일이세요?"),
+		TEXT("좋은 아침이에요."),
+		TEXT("좋은 오전이네요."),
+		TEXT("벌써 점심때네요."),
+		TEXT("나른한 오후네요."),
+		TEXT("벌써 저녁이네요."),
+		TEXT("밤이 꽤 깊었네요.")
+	};
+
+	// EWeatherType 선언 순서와 같아야 함
+	static const TCHAR* const WeatherLines[NumWeathers][2] = {
+		{ TEXT("날이 참 맑아서 기분이 좋아요."),          TEXT("햇살이 좋으니 잠깐 쉬어 가세요.") },
+		{ TEXT("하늘이 잔뜩 흐려서 그런지 좀 가라앉네요."), TEXT("구름이 많은 게 비라도 오려나 봐요.") },
+		{ TEXT("비가 오니 발밑 조심하세요."),              TEXT("비가 계속 오네요. 잠깐 처마 밑에서 이야기해요.") },
+		{ TEXT("눈이 꽤 쌓였네요. 춥지 않으세요?"),        TEXT("눈길이 미끄러우니 천천히 다니세요.") },
+		{ TEXT("안개가 짙어서 앞이 잘 안 보이네요."),      TEXT("이런 안개 속에선 길 잃기 쉬워요.") },
+		{ TEXT("바람이 너무 세서 정신이 없네요!"),         TEXT("폭풍이 지나갈 때까지 조심하세요.") }
+	};
+
+	for (int32 Weather = 0; Weather < NumWeathers; ++Weather)
+	{
+		for (int32 Period = 0; Period < NumPeriods; ++Period)
+		{
+			TArray<FString>& Cell = Lines[Weather * NumPeriods + Period];
+			for (const TCHAR* WeatherLine : WeatherLines[Weather])
+			{
+				Cell.Add(FString::Printf(TEXT("%s %s"), PeriodOpeners[Period], WeatherLine));
+			}
+		}
+	}
+}
+
+const FString& FPOClaudeFallbackReplies::Pick(EWeatherType Weather, EPOTimePeriod Period, uint32 Seed) const
+{
+	const int32 WeatherIndex = FMath::Clamp(static_cast<int32>(Weather), 0, NumWeathers - 1);
+	const int32 PeriodIndex  = FMath::Clamp(static_cast<int32>(Period), 0, NumPeriods - 1);
+
+	const TArray<FString>& Cell = Lines[WeatherIndex * NumPeriods + PeriodIndex];
+	return Cell[Seed % Cell.Num()];
+}
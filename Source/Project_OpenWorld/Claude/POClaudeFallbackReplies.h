@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../Weather/WeatherTypes.h"
+#include "../World/POEnvironmentTypes.h"
+
+/**
+ * 응답 지연 목표(SLO)를 넘겼을 때 바로 돌려줄 로컬 대사 표
+ * (날씨 × 시간대) 칸마다 완성된 문장을 미리 만들어 두므로 고를 때 문자열 조립/할당이 없다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeFallbackReplies
+{
+public:
+	FPOClaudeFallbackReplies();
+
+	// Seed(보통 요청 ID)로 같은 칸 안에서 문장을 돌려 가며 선택
+	const FString& Pick(EWeatherType Weather, EPOTimePeriod Period, uint32 Seed) const;
+
+private:
+	static constexpr int32 NumWeathers = 6;
+	static constexpr int32 NumPeriods = 7;
+
+	TArray<FString> Lines[NumWeathers * NumPeriods];
+};
@@ -0,0 +1,356 @@
+#include "POClaudeIntentMatcher.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+
+namespace POClaudeIntentMatcher
+{
+	// 공백/문장부호는 버리고 영문은 소문자로 (패턴과 메시지에 같은 규칙 적용)
+	static bool NormalizeChar(TCHAR C, TCHAR& OutChar)
+	{
+		if (FChar::IsWhitespace(C) || FChar::IsPunct(C))
+		{
+			return false;
+		}
+		OutChar = FChar::ToLower(C);
+		return true;
+	}
+
+	// 우선순위 높은 순 (질문은 따로 충돌 검사)
+	static constexpr EClaudeLocalIntent IntentPriority[] = {
+		EClaudeLocalIntent::AskWeather,
+		EClaudeLocalIntent::AskTime,
+		EClaudeLocalIntent::Farewell,
+		EClaudeLocalIntent::Thanks,
+		EClaudeLocalIntent::Greeting
+	};
+
+	static constexpr uint32 IntentBit(EClaudeLocalIntent Intent)
+	{
+		return 1u << static_cast<uint32>(Intent);
+	}
+}
+
+const FPOClaudeIntentMatcher::FRule* FPOClaudeIntentMatcher::GetRules(int32& OutNum)
+{
+	using E = EClaudeLocalIntent;
+
+	// Intent None = 의도는 없지만 덮인 글자로 치는 군더더기 말 ("오늘", "혹시" 등). 한 음절짜리는 다른 낱말 속에서도
+	// 걸리므로 두지 않음 (남는 어미 한 음절은 DefaultMaxUncoveredChars로 허용)
+	// bForceAPI = 템플릿이 "지금"을 기준으로 답해 틀려지는 다른 때/까닭/감정 표현
+	// 규칙을 늘릴 때는 Claude.Intents 덤프의 "놓친 메시지"를 참고
+	static const FRule Rules[] = {
+		{ TEXT("안녕"), E::Greeting }, { TEXT("안녕하세요"), E::Greeting }, { TEXT("안녕하십니까"), E::Greeting },
+		{ TEXT("반가워"), E::Greeting }, { TEXT("반갑습니다"), E::Greeting }, { TEXT("처음뵙겠습니다"), E::Greeting },
+		{ TEXT("좋은아침"), E::Greeting }, { TEXT("여보세요"), E::Greeting }, { TEXT("하이"), E::Greeting },
+		{ TEXT("hi"), E::Greeting }, { TEXT("hello"), E::Greeting },
+
+		{ TEXT("안녕히계세요"), E::Farewell }, { TEXT("안녕히가세요"), E::Farewell }, { TEXT("잘가"), E::Farewell },
+		{ TEXT("잘있어"), E::Farewell }, { TEXT("다음에봐"), E::Farewell }, { TEXT("나중에봐"), E::Farewell },
+		{ TEXT("또봐"), E::Farewell }, { TEXT("또올게"), E::Farewell }, { TEXT("가볼게"), E::Farewell },
+		{ TEXT("바이"), E::Farewell }, { TEXT("bye"), E::Farewell },
+
+		{ TEXT("고마워"), E::Thanks }, { TEXT("고맙습니다"), E::Thanks }, { TEXT("감사"), E::Thanks },
+		{ TEXT("감사합니다"), E::Thanks }, { TEXT("감사해요"), E::Thanks }, { TEXT("덕분에"), E::Thanks },
+		{ TEXT("땡큐"), E::Thanks }, { TEXT("thanks"), E::Thanks }, { TEXT("thankyou"), E::Thanks },
+
+		{ TEXT("날씨"), E::AskWeather }, { TEXT("비와"), E::AskWeather }, { TEXT("비오나"), E::AskWeather },
+		{ TEXT("비올까"), E::AskWeather }, { TEXT("눈와"), E::AskWeather }, { TEXT("눈오나"), E::AskWeather },
+		{ TEXT("눈올까"), E::AskWeather },
+
+		{ TEXT("몇시"), E::AskTime }, { TEXT("시간이어떻게"), E::AskTime }, { TEXT("지금시간"), E::AskTime },
+
+		{ TEXT("오늘"), E::None }, { TEXT("지금"), E::None }, { TEXT("요즘"), E::None }, { TEXT("혹시"), E::None },
+		{ TEXT("어때"), E::None }, { TEXT("어때요"), E::None }, { TEXT("어떤가요"), E::None }, { TEXT("어떻습니까"), E::None },
+		{ TEXT("됐어"), E::None }, { TEXT("됐나요"), E::None }, { TEXT("되었나요"), E::None },
+		{ TEXT("인가요"), E::None }, { TEXT("이에요"), E::None }, { TEXT("예요"), E::None }, { TEXT("에요"), E::None },
+		{ TEXT("정말"), E::None }, { TEXT("진짜"), E::None }, { TEXT("많이"), E::None }, { TEXT("밖에"), E::None },
+		{ TEXT("친구"), E::None }, { TEXT("아저씨"), E::None }, { TEXT("아주머니"), E::None },
+		{ TEXT("할머니"), E::None }, { TEXT("할아버지"), E::None }, { TEXT("ㅎㅎ"), E::None }, { TEXT("ㅋㅋ"), E::None },
+
+		{ TEXT("내일"), E::None, true }, { TEXT("모레"), E::None, true }, { TEXT("어제"), E::None, true },
+		{ TEXT("그제"), E::None, true }, { TEXT("그저께"), E::None, true }, { TEXT("어젯밤"), E::None, true },
+		{ TEXT("아까"), E::None, true }, { TEXT("이따"), E::None, true },
+		{ TEXT("주말"), E::None, true }, { TEXT("다음주"), E::None, true }, { TEXT("지난주"), E::None, true },
+		{ TEXT("저녁에"), E::None, true }, { TEXT("밤에"), E::None, true }, { TEXT("아침에"), E::None, true },
+		{ TEXT("와서"), E::None, true }, { TEXT("때문"), E::None, true }, { TEXT("우울"), E::None, true },
+		{ TEXT("싫어"), E::None, true }
+	};
+
+	OutNum = UE_ARRAY_COUNT(Rules);
+	return Rules;
+}
+
+FPOClaudeIntentMatcher::FPOClaudeIntentMatcher()
+{
+	int32 NumRules = 0;
+	const FRule* Rules = GetRules(NumRules);
+	Build(MakeArrayView(Rules, NumRules));
+}
+
+void FPOClaudeIntentMatcher::Build(TConstArrayView<FRule> Rules)
+{
+	// 1) 맵 기반 트라이 구성
+	TArray<TMap<TCHAR, int32>> Children;
+	Children.AddDefaulted();
+	Nodes.Reset();
+	Nodes.AddDefaulted();
+
+	for (const FRule& Rule : Rules)
+	{
+		int32 Node = 0;
+		int32 Length = 0;
+		for (const TCHAR* It = Rule.Pattern; *It; ++It)
+		{
+			TCHAR C;
+			if (!POClaudeIntentMatcher::NormalizeChar(*It, C))
+			{
+				continue;
+			}
+
+			if (const int32* Next = Children[Node].Find(C))
+			{
+				Node = *Next;
+			}
+			else
+			{
+				const int32 NewNode = Nodes.AddDefaulted();
+				Children.AddDefaulted();
+				Children[Node].Add(C, NewNode);
+				Node = NewNode;
+			}
+			++Length;
+		}
+
+		if (Length > 0)
+		{
+			Nodes[Node].Length    = Length;
+			Nodes[Node].Intent    = Rule.Intent;
+			Nodes[Node].bForceAPI = Rule.bForceAPI;
+		}
+	}
+
+	// 2) 너비 우선으로 실패 링크/출력 링크 계산
+	TArray<int32> Queue;
+	Queue.Reserve(Nodes.Num());
+	for (const TPair<TCHAR, int32>& Pair : Children[0])
+	{
+		Queue.Add(Pair.Value);
+	}
+
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const int32 Node = Queue[Head];
+		for (const TPair<TCHAR, int32>& Pair : Children[Node])
+		{
+			const int32 Child = Pair.Value;
+
+			int32 Fail = Nodes[Node].Fail;
+			const int32* Target = Children[Fail].Find(Pair.Key);
+			while (!Target && Fail != 0)
+			{
+				Fail = Nodes[Fail].Fail;
+				Target = Children[Fail].Find(Pair.Key);
+			}
+
+			FNode& ChildNode = Nodes[Child];
+			ChildNode.Fail = Target ? *Target : 0;
+			ChildNode.OutputLink = Nodes[ChildNode.Fail].Length > 0 ? ChildNode.Fail : Nodes[ChildNode.Fail].OutputLink;
+
+			Queue.Add(Child);
+		}
+	}
+
+	// 3) 자식 목록을 정렬된 평면 배열로 (검색 시 이진 탐색, 맵 해시 없음)
+	Edges.Reset();
+	for (int32 Node = 0; Node < Nodes.Num(); ++Node)
+	{
+		Nodes[Node].FirstEdge = Edges.Num();
+		Nodes[Node].NumEdges = Children[Node].Num();
+		for (const TPair<TCHAR, int32>& Pair : Children[Node])
+		{
+			Edges.Add({ Pair.Key, Pair.Value });
+		}
+		Algo::SortBy(MakeArrayView(Edges.GetData() + Nodes[Node].FirstEdge, Nodes[Node].NumEdges), &FEdge::Char);
+	}
+}
+
+int32 FPOClaudeIntentMatcher::FindChild(int32 Node, TCHAR Char) const
+{
+	const FNode& N = Nodes[Node];
+	const TConstArrayView<FEdge> Children(Edges.GetData() + N.FirstEdge, N.NumEdges);
+
+	const int32 Index = Algo::LowerBoundBy(Children, Char, &FEdge::Char);
+	return (Index < Children.Num() && Children[Index].Char == Char) ? Children[Index].Next : INDEX_NONE;
+}
+
+int32 FPOClaudeIntentMatcher::Step(int32 Node, TCHAR Char) const
+{
+	for (;;)
+	{
+		const int32 Next = FindChild(Node, Char);
+		if (Next != INDEX_NONE)
+		{
+			return Next;
+		}
+		if (Node == 0)
+		{
+			return 0;
+		}
+		Node = Nodes[Node].Fail;
+	}
+}
+
+void FPOClaudeIntentMatcher::Match(const FString& Message, FPOClaudeIntentMatch& OutMatch) const
+{
+	OutMatch = FPOClaudeIntentMatch();
+
+	TArray<TCHAR, TInlineAllocator<MaxMessageChars>> Chars;
+	for (const TCHAR Raw : Message)
+	{
+		TCHAR C;
+		if (POClaudeIntentMatcher::NormalizeChar(Raw, C))
+		{
+			if (Chars.Num() == MaxMessageChars)
+			{
+				OutMatch.NumChars = OutMatch.NumUncovered = Message.Len();
+				return;
+			}
+			Chars.Add(C);
+		}
+	}
+
+	OutMatch.NumChars = Chars.Num();
+
+	TArray<bool, TInlineAllocator<MaxMessageChars>> Covered;
+	Covered.SetNumZeroed(Chars.Num());
+
+	uint32 IntentMask = 0;
+	int32 State = 0;
+	for (int32 i = 0; i < Chars.Num(); ++i)
+	{
+		State = Step(State, Chars[i]);
+
+		for (int32 Out = Nodes[State].Length > 0 ? State : Nodes[State].OutputLink; Out != 0; Out = Nodes[Out].OutputLink)
+		{
+			const FNode& Hit = Nodes[Out];
+			for (int32 j = i - Hit.Length + 1; j <= i; ++j)
+			{
+				Covered[j] = true;
+			}
+			IntentMask |= POClaudeIntentMatcher::IntentBit(Hit.Intent);
+			OutMatch.bForceAPI |= Hit.bForceAPI;
+		}
+	}
+
+	for (const bool bCovered : Covered)
+	{
+		OutMatch.NumUncovered += bCovered ? 0 : 1;
+	}
+
+	// 날씨와 시간을 함께 묻는 식의 복합 질문은 템플릿 하나로 답할 수 없음
+	constexpr uint32 QuestionMask = POClaudeIntentMatcher::IntentBit(EClaudeLocalIntent::AskWeather)
+		| POClaudeIntentMatcher::IntentBit(EClaudeLocalIntent::AskTime);
+	if ((IntentMask & QuestionMask) == QuestionMask)
+	{
+		return;
+	}
+
+	for (const EClaudeLocalIntent Intent : POClaudeIntentMatcher::IntentPriority)
+	{
+		if (IntentMask & POClaudeIntentMatcher::IntentBit(Intent))
+		{
+			OutMatch.Intent = Intent;
+			return;
+		}
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "POClaudeAPIManager.h"
+#include "POClaudeLocalReplies.h"
+
+namespace POClaudeIntentCommands
+{
+	static void Dump(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		APOClaudeAPIManager* Manager = World
+			? Cast<APOClaudeAPIManager>(UGameplayStatics::GetActorOfClass(World, APOClaudeAPIManager::StaticClass()))
+			: nullptr;
+		if (!Manager)
+		{
+			Ar.Log(TEXT("[ClaudeIntentMatcher] ClaudeAPIManager가 없습니다."));
+			return;
+		}
+
+		Manager->DumpLocalIntentStats(Ar);
+
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("Reset"), ESearchCase::IgnoreCase))
+		{
+			Manager->ResetLocalIntentStats();
+			Ar.Log(TEXT("[ClaudeIntentMatcher] 통계 초기화"));
+		}
+	}
+
+	// 판정 + 템플릿 응답 한 건의 비용 (API 왕복과 비교할 값)
+	static void Bench(const TArray<FString>& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+
+		const FPOClaudeIntentMatcher Matcher;
+		const FPOClaudeLocalReplies Replies;
+
+		FClaudeRequestContext Context;
+		Context.WeatherType = TEXT("비");
+		Context.TimeOfDay = 19.5f;
+
+		const TCHAR* const Messages[] = {
+			TEXT("안녕하세요!"),
+			TEXT("오늘 날씨 어때요?"),
+			TEXT("지금 몇 시예요?"),
+			TEXT("고마워요, 안녕히 계세요~"),
+			TEXT("내일 날씨 어때요?"),
+			TEXT("몇 시에 문 닫아요?"),
+			TEXT("비와서 우울해"),
+			TEXT("감사관이 왔어"),
+			TEXT("어제 동굴에서 이상한 빛을 봤는데 혹시 뭔지 아세요?")
+		};
+
+		for (const TCHAR* Message : Messages)
+		{
+			const FString MessageString(Message);
+			FPOClaudeIntentMatch Match;
+			FString Reply;
+
+			const double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Matcher.Match(MessageString, Match);
+				if (Match.IsAnswerable(FPOClaudeIntentMatcher::DefaultMaxUncoveredChars))
+				{
+					Replies.Format(Match.Intent, FObjectKey(), Context, i, Reply);
+				}
+			}
+			const double PerCall = (FPlatformTime::Seconds() - Start) / Iterations;
+
+			UE_LOG(LogTemp, Display, TEXT("[ClaudeIntentMatcher] \"%s\" → %s (미일치 %d/%d자) %.3f us \"%s\""),
+				Message, *StaticEnum<EClaudeLocalIntent>()->GetNameStringByValue(static_cast<int64>(Match.Intent)),
+				Match.NumUncovered, Match.NumChars, PerCall * 1e6, *Reply);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPOClaudeIntentsCmd(
+	TEXT("Claude.Intents"),
+	TEXT("로컬 의도 적중/놓침 통계와 최근 놓친 메시지 출력. 인자: [Reset]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&POClaudeIntentCommands::Dump));
+
+static FAutoConsoleCommand GPOClaudeBenchIntentsCmd(
+	TEXT("Claude.BenchIntents"),
+	TEXT("로컬 의도 판정 + 템플릿 응답 마이크로벤치마크. 인자: [반복 횟수]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&POClaudeIntentCommands::Bench));
+
+#endif // !UE_BUILD_SHIPPING
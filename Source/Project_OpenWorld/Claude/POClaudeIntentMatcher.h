@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "POClaudeTypes.h"
+
+/** 의도 판정 결과 */
+struct FPOClaudeIntentMatch
+{
+	EClaudeLocalIntent Intent = EClaudeLocalIntent::None;
+
+	// 정규화(소문자, 공백/문장부호 제거) 후 글자 수
+	int32 NumChars = 0;
+
+	// 어떤 규칙 패턴에도 덮이지 않은 글자 수 (많을수록 템플릿으로 답하면 안 되는 메시지)
+	int32 NumUncovered = 0;
+
+	// 현재가 아닌 때를 묻는 말("내일", "어제")처럼 템플릿이 틀리게 답할 문맥이 보임 → 무조건 API
+	bool bForceAPI = false;
+
+	bool IsAnswerable(int32 MaxUncoveredChars) const
+	{
+		return Intent != EClaudeLocalIntent::None && !bForceAPI && NumUncovered <= MaxUncoveredChars;
+	}
+};
+
+/**
+ * 플레이어 메시지 로컬 의도 판정기
+ * 규칙 표의 모든 패턴을 Aho-Corasick 오토마톤 하나로 묶어 메시지를 한 번만 훑는다.
+ * 여러 의도가 걸리면 우선순위가 높은 쪽(질문 > 작별 > 감사 > 인사)을 고르고,
+ * 날씨와 시간을 한꺼번에 묻는 등 질문이 둘 이상이면 API로 넘긴다.
+ * 패턴 밖 글자가 한 음절을 넘는 메시지("몇 시에 문 닫아요?")와 다른 때를 묻는 메시지("내일 날씨 어때요?")도 API 몫이다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeIntentMatcher
+{
+public:
+	FPOClaudeIntentMatcher();
+
+	void Match(const FString& Message, FPOClaudeIntentMatch& OutMatch) const;
+
+	// 이보다 긴 메시지는 짧은 인사/질문이 아니라고 보고 훑지 않음 (정규화 후 글자 수)
+	static constexpr int32 MaxMessageChars = 48;
+
+	// 기본 허용 미일치 글자 수 ("몇 시야?"의 "야"처럼 어미 한 음절까지만)
+	static constexpr int32 DefaultMaxUncoveredChars = 1;
+
+private:
+	struct FRule
+	{
+		const TCHAR* Pattern;
+		EClaudeLocalIntent Intent;
+
+		// 이 패턴이 보이면 의도와 관계없이 API로
+		bool bForceAPI = false;
+	};
+
+	struct FEdge
+	{
+		TCHAR Char;
+		int32 Next;
+	};
+
+	struct FNode
+	{
+		// Edges 안에서 이 노드의 자식 구간 (문자 오름차순)
+		int32 FirstEdge = 0;
+		int32 NumEdges = 0;
+
+		int32 Fail = 0;
+
+		// 이 노드에서 끝나는 패턴 (길이, 의도). 없으면 Length 0
+		int32 Length = 0;
+		EClaudeLocalIntent Intent = EClaudeLocalIntent::None;
+		bool bForceAPI = false;
+
+		// 실패 링크를 따라 가장 가까운 패턴 끝 노드 (없으면 0)
+		int32 OutputLink = 0;
+	};
+
+	TArray<FNode> Nodes;
+	TArray<FEdge> Edges;
+
+	void Build(TConstArrayView<FRule> Rules);
+
+	int32 FindChild(int32 Node, TCHAR Char) const;
+
+	int32 Step(int32 Node, TCHAR Char) const;
+
+	static const FRule* GetRules(int32& OutNum);
+};
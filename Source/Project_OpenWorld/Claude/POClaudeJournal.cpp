@@ -0,0 +1,501 @@
+#include "POClaudeJournal.h"
+#include "POClaudeTypes.h"
+#include "Async/MappedFileHandle.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace POClaudeJournal
+{
+	// 기록 스레드가 대기열을 비우는 주기 (생산자는 깨우지 않으므로 디스크 반영 지연의 상한)
+	constexpr uint32 DrainIntervalMs = 200;
+
+	// 이만큼 쌓이면 주기를 기다리지 않고 파일에 씀
+	constexpr int32 WriteChunkBytes = 256 * 1024;
+
+	// 기록 스레드가 밀렸을 때 붙잡아 둘 최대 기록 수 (넘으면 버림)
+	constexpr int32 MaxPendingRecords = 65536;
+
+	// 문자열 하나의 최대 길이 (바이트, 비정상적으로 긴 응답 방어)
+	constexpr int32 MaxStringBytes = 64 * 1024;
+
+	static const TCHAR* const FileExtension = TEXT(".pojl");
+
+	static void AppendBytes(TArray<uint8>& Out, const void* Data, int32 Bytes)
+	{
+		Out.Append(static_cast<const uint8*>(Data), Bytes);
+	}
+
+	static void AppendString(TArray<uint8>& Out, const FString& Text)
+	{
+		const FTCHARToUTF8 Utf8(*Text, Text.Len());
+		const uint32 Bytes = static_cast<uint32>(FMath::Min(Utf8.Length(), MaxStringBytes));
+		AppendBytes(Out, &Bytes, sizeof(Bytes));
+		AppendBytes(Out, Utf8.Get(), Bytes);
+	}
+
+	static uint64 HashString(const FString& Text, uint64 Seed)
+	{
+		return CityHash64WithSeed(reinterpret_cast<const char*>(*Text), Text.Len() * sizeof(TCHAR), Seed);
+	}
+}
+
+FPOClaudeJournalWriter::FPOClaudeJournalWriter()
+{
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FPOClaudeJournalWriter::~FPOClaudeJournalWriter()
+{
+	Shutdown();
+
+	if (WakeEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+	}
+}
+
+bool FPOClaudeJournalWriter::Start(const FString& InDirectory, int64 InMaxFileBytes, int32 InMaxFiles)
+{
+	check(!Thread);
+
+	Directory = InDirectory;
+	MaxFileBytes = FMath::Max<int64>(InMaxFileBytes, 64 * 1024);
+	MaxFiles = FMath::Max(1, InMaxFiles);
+	SessionStamp = FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S"));
+	FileSequence = 0;
+
+	if (!IFileManager::Get().MakeDirectory(*Directory, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeJournal] 기록 디렉터리를 만들 수 없습니다: %s"), *Directory);
+		return false;
+	}
+
+	bStopping.store(false, std::memory_order_release);
+	Thread = FRunnableThread::Create(this, TEXT("ClaudeJournalWriter"), 0, TPri_BelowNormal);
+	return Thread != nullptr;
+}
+
+void FPOClaudeJournalWriter::Shutdown()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+}
+
+void FPOClaudeJournalWriter::Stop()
+{
+	bStopping.store(true, std::memory_order_release);
+	WakeEvent->Trigger();
+}
+
+void FPOClaudeJournalWriter::Append(FPOClaudeJournalEntry&& Entry)
+{
+	if (NumPending.fetch_add(1, std::memory_order_relaxed) >= POClaudeJournal::MaxPendingRecords)
+	{
+		NumPending.fetch_sub(1, std::memory_order_relaxed);
+		NumDropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	// 생산자는 대기열에 넣기만 하고 깨우지 않음 (기록 스레드가 주기적으로 비움)
+	Queue.Enqueue(MoveTemp(Entry));
+}
+
+void FPOClaudeJournalWriter::Flush()
+{
+	WakeEvent->Trigger();
+}
+
+FPOClaudeJournalStats FPOClaudeJournalWriter::GetStats() const
+{
+	FPOClaudeJournalStats Stats;
+	Stats.NumWritten = NumWritten.load(std::memory_order_relaxed);
+	Stats.NumDropped = NumDropped.load(std::memory_order_relaxed);
+	Stats.BytesWritten = BytesWritten.load(std::memory_order_relaxed);
+	Stats.NumFiles = NumFiles.load(std::memory_order_relaxed);
+	return Stats;
+}
+
+uint64 FPOClaudeJournalWriter::HashPrompt(const FClaudeRequestContext& Context)
+{
+	using POClaudeJournal::HashString;
+
+	uint64 Hash = HashString(Context.NPCName, 0);
+	Hash = HashString(Context.NPCPersonality, Hash);
+	Hash = HashString(Context.WeatherType, Hash);
+
+	// 시간은 정시 단위 (분 단위 차이는 같은 프롬프트로 취급)
+	const int32 Hour = FMath::FloorToInt32(Context.TimeOfDay);
+	Hash = CityHash64WithSeed(reinterpret_cast<const char*>(&Hour), sizeof(Hour), Hash);
+
+	Hash = HashString(Context.HistorySummary, Hash);
+	for (const FClaudeDialogueTurn& Turn : Context.History)
+	{
+		Hash = HashString(Turn.PlayerMessage, Hash);
+		Hash = HashString(Turn.NPCResponse, Hash);
+	}
+	return HashString(Context.PlayerMessage, Hash);
+}
+
+uint32 FPOClaudeJournalWriter::Run()
+{
+	while (!bStopping.load(std::memory_order_acquire))
+	{
+		WakeEvent->Wait(POClaudeJournal::DrainIntervalMs);
+		Drain();
+	}
+
+	// 종료 직전에 들어온 기록까지
+	Drain();
+	File.Reset();
+	return 0;
+}
+
+void FPOClaudeJournalWriter::Drain()
+{
+	FPOClaudeJournalEntry Entry;
+	int32 NumDrained = 0;
+	while (Queue.Dequeue(Entry))
+	{
+		++NumDrained;
+		EncodeRecord(Entry);
+
+		if (Buffer.Num() >= POClaudeJournal::WriteChunkBytes)
+		{
+			WriteBuffer();
+		}
+	}
+
+	if (NumDrained == 0)
+	{
+		return;
+	}
+
+	NumPending.fetch_sub(NumDrained, std::memory_order_relaxed);
+	WriteBuffer();
+
+	// 비정상 종료 시에도 직전 주기까지는 남도록
+	if (File)
+	{
+		File->Flush();
+	}
+}
+
+void FPOClaudeJournalWriter::EncodeRecord(const FPOClaudeJournalEntry& Entry)
+{
+	using namespace POClaudeJournal;
+
+	const int32 RecordStart = Buffer.Num();
+
+	uint32 PayloadSize = 0;
+	AppendBytes(Buffer, &PayloadSize, sizeof(PayloadSize));
+	AppendBytes(Buffer, &Entry.Fixed, sizeof(Entry.Fixed));
+	AppendString(Buffer, Entry.NPCName);
+	AppendString(Buffer, Entry.WeatherType);
+	AppendString(Buffer, Entry.PlayerMessage);
+	AppendString(Buffer, Entry.Response);
+
+	const int32 RecordBytes = Buffer.Num() - RecordStart;
+	PayloadSize = static_cast<uint32>(RecordBytes - sizeof(PayloadSize));
+	FMemory::Memcpy(Buffer.GetData() + RecordStart, &PayloadSize, sizeof(PayloadSize));
+
+	// 이 레코드로 파일 상한을 넘으면 앞선 레코드까지 쓰고 새 파일에서 시작
+	if (File && FileBytes > FileHeaderSize && FileBytes + Buffer.Num() > MaxFileBytes)
+	{
+		TArray<uint8> Record(Buffer.GetData() + RecordStart, RecordBytes);
+		Buffer.SetNum(RecordStart, EAllowShrinking::No);
+		WriteBuffer();
+		File.Reset();
+		Buffer.Append(Record);
+	}
+
+	NumWritten.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FPOClaudeJournalWriter::WriteBuffer()
+{
+	if (Buffer.Num() == 0)
+	{
+		return;
+	}
+
+	if (!File && !OpenNextFile())
+	{
+		// 디스크 오류: 이번 묶음은 버리고 다음 주기에 다시 파일을 열어 봄
+		Buffer.Reset();
+		return;
+	}
+
+	if (File->Write(Buffer.GetData(), Buffer.Num()))
+	{
+		FileBytes += Buffer.Num();
+		BytesWritten.fetch_add(Buffer.Num(), std::memory_order_relaxed);
+	}
+	Buffer.Reset();
+}
+
+bool FPOClaudeJournalWriter::OpenNextFile()
+{
+	const FString FilePath = Directory / FString::Printf(TEXT("Dialogue_%s_%03d%s"),
+		*SessionStamp, FileSequence++, POClaudeJournal::FileExtension);
+
+	File.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*FilePath));
+	if (!File)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeJournal] 기록 파일을 열 수 없습니다: %s"), *FilePath);
+		return false;
+	}
+
+	uint32 Header[2] = { FileMagic, FileVersion };
+	const int64 CreatedTicks = FDateTime::UtcNow().GetTicks();
+	File->Write(reinterpret_cast<const uint8*>(Header), sizeof(Header));
+	File->Write(reinterpret_cast<const uint8*>(&CreatedTicks), sizeof(CreatedTicks));
+	FileBytes = FileHeaderSize;
+
+	NumFiles.fetch_add(1, std::memory_order_relaxed);
+	PruneOldFiles();
+	return true;
+}
+
+void FPOClaudeJournalWriter::PruneOldFiles() const
+{
+	TArray<FString> Paths;
+	FPOClaudeJournalReader::FindFiles(Directory, Paths);
+
+	// 이름에 생성 시각이 들어 있으므로 앞쪽이 오래된 파일
+	for (int32 i = 0; i + MaxFiles < Paths.Num(); ++i)
+	{
+		IFileManager::Get().Delete(*Paths[i], false, false, true);
+	}
+}
+
+FPOClaudeJournalReader::FPOClaudeJournalReader() = default;
+
+FPOClaudeJournalReader::~FPOClaudeJournalReader()
+{
+	Close();
+}
+
+bool FPOClaudeJournalReader::Open(const FString& FilePath)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*FilePath))
+	{
+		return false;
+	}
+
+	FOpenMappedResult Result = PlatformFile.OpenMappedEx(*FilePath);
+	if (!Result.HasError())
+	{
+		MappedFile = Result.StealValue();
+		if (MappedFile->GetFileSize() > 0)
+		{
+			MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+		}
+	}
+
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		Size = MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		// 매핑 미지원 플랫폼: 통째로 읽어서 동일하게 사용
+		MappedFile.Reset();
+		if (!FFileHelper::LoadFileToArray(FallbackBuffer, *FilePath))
+		{
+			return false;
+		}
+		Data = FallbackBuffer.GetData();
+		Size = FallbackBuffer.Num();
+	}
+
+	uint32 Header[2] = { 0, 0 };
+	if (Size < FPOClaudeJournalWriter::FileHeaderSize)
+	{
+		Close();
+		return false;
+	}
+	FMemory::Memcpy(Header, Data, sizeof(Header));
+
+	if (Header[0] != FPOClaudeJournalWriter::FileMagic || Header[1] != FPOClaudeJournalWriter::FileVersion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeJournal] 기록 파일 형식이 맞지 않습니다: %s"), *FilePath);
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void FPOClaudeJournalReader::Close()
+{
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	FallbackBuffer.Empty();
+	Data = nullptr;
+	Size = 0;
+	TrailingBytes = 0;
+}
+
+int64 FPOClaudeJournalReader::ForEach(TFunctionRef<bool(const FPOClaudeJournalRecordView&)> Visitor) const
+{
+	int64 Cursor = FPOClaudeJournalWriter::FileHeaderSize;
+	int64 NumRecords = 0;
+
+	auto ReadString = [this](int64& At, int64 End, FUtf8StringView& Out)
+	{
+		uint32 Bytes = 0;
+		if (At + static_cast<int64>(sizeof(Bytes)) > End)
+		{
+			return false;
+		}
+		FMemory::Memcpy(&Bytes, Data + At, sizeof(Bytes));
+		At += sizeof(Bytes);
+
+		if (At + Bytes > End)
+		{
+			return false;
+		}
+		Out = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Data + At), static_cast<int32>(Bytes));
+		At += Bytes;
+		return true;
+	};
+
+	FPOClaudeJournalRecordView View;
+	while (Data && Cursor + static_cast<int64>(sizeof(uint32)) <= Size)
+	{
+		uint32 PayloadSize = 0;
+		FMemory::Memcpy(&PayloadSize, Data + Cursor, sizeof(PayloadSize));
+
+		const int64 Start = Cursor + sizeof(PayloadSize);
+		const int64 End = Start + PayloadSize;
+		if (PayloadSize < sizeof(FPOClaudeJournalFixed) || End > Size)
+		{
+			break;
+		}
+
+		// 가변 길이 레코드 뒤라 정렬이 맞지 않을 수 있으므로 고정부는 복사
+		FMemory::Memcpy(&View.Fixed, Data + Start, sizeof(View.Fixed));
+
+		int64 At = Start + sizeof(FPOClaudeJournalFixed);
+		if (!ReadString(At, End, View.NPCName) || !ReadString(At, End, View.WeatherType)
+			|| !ReadString(At, End, View.PlayerMessage) || !ReadString(At, End, View.Response))
+		{
+			break;
+		}
+
+		Cursor = End;
+		++NumRecords;
+		if (!Visitor(View))
+		{
+			break;
+		}
+	}
+
+	TrailingBytes = Size - Cursor;
+	return NumRecords;
+}
+
+void FPOClaudeJournalReader::FindFiles(const FString& InDirectory, TArray<FString>& OutPaths)
+{
+	TArray<FString> Names;
+	IFileManager::Get().FindFiles(Names, *(InDirectory / (FString(TEXT("*")) + POClaudeJournal::FileExtension)), true, false);
+	Names.Sort();
+
+	OutPaths.Reset(Names.Num());
+	for (const FString& Name : Names)
+	{
+		OutPaths.Add(InDirectory / Name);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+#include "HAL/IConsoleManager.h"
+
+namespace POClaudeJournalBench
+{
+	static void Run(const TArray<FString>& Args)
+	{
+		const int32 NumRecords = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 50000;
+
+		const FString BenchDirectory = FPaths::ProjectSavedDir() / TEXT("Claude") / TEXT("JournalBench");
+		IFileManager::Get().DeleteDirectory(*BenchDirectory, false, true);
+
+		FPOClaudeJournalWriter Writer;
+		if (!Writer.Start(BenchDirectory, 16 * 1024 * 1024, 64))
+		{
+			return;
+		}
+
+		FPOClaudeJournalEntry Template;
+		Template.NPCName = TEXT("대장장이 한스");
+		Template.WeatherType = TEXT("비");
+		Template.PlayerMessage = TEXT("오늘 비가 많이 오네요. 검 좀 고쳐 줄 수 있어요?");
+		Template.Response = TEXT("이 빗속에 용케 왔구먼. 칼날이 많이 상했으니 저녁까지는 걸리겠어. 불 옆에서 몸 좀 녹이고 있게나.");
+
+		// 생산자(게임 스레드) 쪽 비용: 기록 1건을 만들어 대기열에 넣기까지
+		const double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumRecords; ++i)
+		{
+			FPOClaudeJournalEntry Entry = Template;
+			Entry.Fixed.RequestId = i;
+			Entry.Fixed.Ticks = FDateTime::UtcNow().GetTicks();
+			Writer.Append(MoveTemp(Entry));
+		}
+		const double AppendSeconds = FPlatformTime::Seconds() - Start;
+
+		Writer.Shutdown();
+		const double TotalSeconds = FPlatformTime::Seconds() - Start;
+		const FPOClaudeJournalStats Stats = Writer.GetStats();
+
+		// 읽기: 매핑한 파일을 훑기만
+		TArray<FString> Paths;
+		FPOClaudeJournalReader::FindFiles(BenchDirectory, Paths);
+
+		const double ReadStart = FPlatformTime::Seconds();
+		int64 NumRead = 0;
+		for (const FString& Path : Paths)
+		{
+			FPOClaudeJournalReader Reader;
+			if (Reader.Open(Path))
+			{
+				NumRead += Reader.ForEach([](const FPOClaudeJournalRecordView&) { return true; });
+			}
+		}
+		const double ReadSeconds = FPlatformTime::Seconds() - ReadStart;
+
+		UE_LOG(LogTemp, Display,
+			TEXT("[ClaudeJournal] %d건: 대기열 추가 %.3f us/건, 기록 완료 %.2f s (%.1f MB/s, 파일 %d개, 버림 %lld), 읽기 %lld건 %.2f ms (%.1f M건/s)"),
+			NumRecords,
+			AppendSeconds * 1e6 / NumRecords,
+			TotalSeconds,
+			TotalSeconds > 0.0 ? Stats.BytesWritten / TotalSeconds / (1024.0 * 1024.0) : 0.0,
+			Stats.NumFiles, Stats.NumDropped,
+			NumRead, ReadSeconds * 1e3,
+			ReadSeconds > 0.0 ? NumRead / ReadSeconds / 1e6 : 0.0);
+
+		IFileManager::Get().DeleteDirectory(*BenchDirectory, false, true);
+	}
+}
+
+static FAutoConsoleCommand GPOClaudeBenchJournalCmd(
+	TEXT("Claude.BenchJournal"),
+	TEXT("대화 기록기 마이크로벤치마크 (생산자 비용, 기록 처리량, 매핑 읽기 속도). 인자: [기록 수]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&POClaudeJournalBench::Run));
+
+#endif // !UE_BUILD_SHIPPING
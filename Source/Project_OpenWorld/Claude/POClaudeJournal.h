@@ -0,0 +1,213 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FClaudeRequestContext;
+
+/** 대화 기록 1건의 출처 */
+enum class EPOClaudeJournalSource : uint8
+{
+	Http,
+	Local,
+	Cache,
+	LocalIntent,
+
+	Num
+};
+
+namespace POClaudeJournalFlags
+{
+	constexpr uint8 Success    = 1 << 0;
+	constexpr uint8 Cancelled  = 1 << 1;
+	constexpr uint8 TimedOut   = 1 << 2;
+	constexpr uint8 HasHistory = 1 << 3;
+}
+
+/**
+ * 기록 1건의 고정 길이 부분 (파일에 그대로 기록, 리틀 엔디언)
+ * 필드를 바꾸면 FPOClaudeJournalWriter::FileVersion을 올린다.
+ */
+struct FPOClaudeJournalFixed
+{
+	// 기록 시각 (UTC FDateTime 틱)
+	int64 Ticks = 0;
+
+	// NPC 아키타입 키 / 프롬프트 전체 해시 / 응답 캐시 키 (0 = 캐시 대상 아님)
+	uint64 NPCKey = 0;
+	uint64 PromptHash = 0;
+	uint64 CacheKey = 0;
+
+	int32 RequestId = 0;
+
+	// 요청 등록부터 응답까지 (초)
+	float LatencySeconds = 0.0f;
+	float TimeOfDay = 0.0f;
+
+	int32 InputTokens = 0;
+	int32 OutputTokens = 0;
+	int32 CacheReadInputTokens = 0;
+	int32 CacheCreationInputTokens = 0;
+
+	// HTTP 상태 코드 (0 = 응답 없음/HTTP 아님)
+	int16 StatusCode = 0;
+
+	// 모델 티어 (-1 = 라우팅 안 함)
+	int8 TierIndex = -1;
+
+	uint8 Source = 0;
+	uint8 Flags = 0;
+	uint8 NumHistoryTurns = 0;
+	uint16 Reserved0 = 0;
+	uint32 Reserved1 = 0;
+};
+static_assert(sizeof(FPOClaudeJournalFixed) == 72, "기록 형식이 바뀌면 FileVersion을 올릴 것");
+
+/** 게임 스레드가 대기열에 넣는 기록 (UTF-8 변환/직렬화는 기록 스레드에서) */
+struct FPOClaudeJournalEntry
+{
+	FPOClaudeJournalFixed Fixed;
+
+	FString NPCName;
+	FString WeatherType;
+	FString PlayerMessage;
+	FString Response;
+};
+
+/** 통계 (아무 스레드에서나 조회) */
+struct FPOClaudeJournalStats
+{
+	int64 NumWritten = 0;
+	int64 NumDropped = 0;
+	int64 BytesWritten = 0;
+	int32 NumFiles = 0;
+};
+
+/**
+ * 대화 기록기 (추가 전용 이진 로그)
+ * 생산자(게임 스레드, 워커 등)는 잠금 없는 MPSC 대기열에 기록을 넣기만 하고,
+ * 전용 스레드가 주기적으로 대기열을 비워 길이 접두 레코드로 파일 끝에 이어 쓴다.
+ * 파일이 MaxFileBytes를 넘으면 새 파일로 넘어가고, 디렉터리에는 최근 MaxFiles개만 남긴다.
+ *
+ * 파일 = 헤더(매직, 버전, 생성 틱) + [uint32 본문 길이][FPOClaudeJournalFixed][문자열 4개: uint32 길이 + UTF-8]...
+ * 기록 도중 종료돼 잘린 마지막 레코드는 읽을 때 무시된다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeJournalWriter : public FRunnable
+{
+public:
+	static constexpr uint32 FileMagic = 0x4C4A4F50; // 'POJL'
+	static constexpr uint32 FileVersion = 1;
+	static constexpr int32 FileHeaderSize = 16;
+
+	FPOClaudeJournalWriter();
+	virtual ~FPOClaudeJournalWriter() override;
+
+	bool Start(const FString& InDirectory, int64 InMaxFileBytes, int32 InMaxFiles);
+
+	// 남은 기록을 모두 쓰고 스레드 종료
+	void Shutdown();
+
+	// 아무 스레드에서나 호출 (기록 스레드가 밀려 대기 중인 기록이 상한을 넘으면 버림)
+	void Append(FPOClaudeJournalEntry&& Entry);
+
+	// 대기 중인 기록을 즉시 쓰도록 깨움
+	void Flush();
+
+	bool IsRunning() const { return Thread != nullptr; }
+
+	FPOClaudeJournalStats GetStats() const;
+
+	const FString& GetDirectory() const { return Directory; }
+
+	// 프롬프트를 결정하는 입력 전체의 해시 (NPC, 날씨/시간대, 이력, 메시지)
+	static uint64 HashPrompt(const FClaudeRequestContext& Context);
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	FString Directory;
+	int64 MaxFileBytes = 64 * 1024 * 1024;
+	int32 MaxFiles = 20;
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopping{ false };
+
+	TQueue<FPOClaudeJournalEntry, EQueueMode::Mpsc> Queue;
+	std::atomic<int32> NumPending{ 0 };
+
+	std::atomic<int64> NumWritten{ 0 };
+	std::atomic<int64> NumDropped{ 0 };
+	std::atomic<int64> BytesWritten{ 0 };
+	std::atomic<int32> NumFiles{ 0 };
+
+	// 이하 기록 스레드 전용
+	TUniquePtr<IFileHandle> File;
+	int64 FileBytes = 0;
+	int32 FileSequence = 0;
+	FString SessionStamp;
+	TArray<uint8> Buffer;
+
+	void Drain();
+	void EncodeRecord(const FPOClaudeJournalEntry& Entry);
+	void WriteBuffer();
+	bool OpenNextFile();
+	void PruneOldFiles() const;
+};
+
+/** 레코드 1건 보기 (매핑된 파일을 그대로 가리킴, 콜백 안에서만 유효) */
+struct FPOClaudeJournalRecordView
+{
+	FPOClaudeJournalFixed Fixed;
+
+	FUtf8StringView NPCName;
+	FUtf8StringView WeatherType;
+	FUtf8StringView PlayerMessage;
+	FUtf8StringView Response;
+
+	EPOClaudeJournalSource GetSource() const { return static_cast<EPOClaudeJournalSource>(Fixed.Source); }
+	bool HasFlag(uint8 Flag) const { return (Fixed.Flags & Flag) != 0; }
+};
+
+/**
+ * 기록 파일 읽기 (메모리 매핑, 매핑 미지원 플랫폼은 통째로 읽음)
+ * 레코드를 복사하지 않고 훑으므로 수백만 건도 파일 크기만큼의 페이지 캐시로 처리된다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeJournalReader
+{
+public:
+	FPOClaudeJournalReader();
+	~FPOClaudeJournalReader();
+
+	bool Open(const FString& FilePath);
+	void Close();
+
+	// 모든 레코드를 순서대로 전달 (Visitor가 false를 반환하면 중단). 반환값 = 전달한 수
+	int64 ForEach(TFunctionRef<bool(const FPOClaudeJournalRecordView&)> Visitor) const;
+
+	// 잘린 마지막 레코드 등 읽지 못하고 남은 바이트
+	int64 GetTrailingBytes() const { return TrailingBytes; }
+
+	int64 GetSize() const { return Size; }
+
+	// 디렉터리의 기록 파일 (오래된 순)
+	static void FindFiles(const FString& InDirectory, TArray<FString>& OutPaths);
+
+private:
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> FallbackBuffer;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+	mutable int64 TrailingBytes = 0;
+};
@@ -0,0 +1,411 @@
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "HAL/IConsoleManager.h"
+#include "Containers/Ticker.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "POClaudeAPIManager.h"
+#include "POClaudeMockServer.h"
+#include "../NPC/PONPCCharacter.h"
+
+/**
+ * NPC 대화 파이프라인 부하 테스트
+ * NPC N명을 스폰해 목표 속도로 StartConversation을 호출하고
+ * 종단 지연(StartConversation → 최종 응답) p50/p95/p99, 처리량, 요청당 게임 스레드 비용을 보고한다.
+ * 헤드리스 실행 예: -game -nullrhi -ExecCmds="Claude.LoadTest NPCs=32 Rate=8 Duration=30 Mock=1 Quit=1"
+ */
+namespace POClaudeLoadTest
+{
+	struct FOptions
+	{
+		int32 NumNPCs = 16;
+		float RequestsPerSecond = 4.0f;
+		float DurationSeconds = 30.0f;
+
+		// 발송 종료 후 남은 요청을 기다릴 최대 시간
+		float DrainTimeoutSeconds = 30.0f;
+
+		bool bUseMockServer = true;
+		bool bQuitWhenDone = false;
+	};
+
+	class FRun
+	{
+	public:
+		FRun(UWorld* InWorld, const FOptions& InOptions)
+			: World(InWorld)
+			, Options(InOptions)
+		{
+		}
+
+		~FRun()
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+			Cleanup();
+		}
+
+		bool Start();
+
+	private:
+		struct FNPCSlot
+		{
+			TWeakObjectPtr<APONPCCharacter> NPC;
+			double RequestStartTime = 0.0;
+			bool bAwaitingResponse = false;
+		};
+
+		TWeakObjectPtr<UWorld> World;
+		FOptions Options;
+
+		TArray<FNPCSlot> Slots;
+		TWeakObjectPtr<APOClaudeAPIManager> Manager;
+		bool bSpawnedManager = false;
+		FString OriginalEndpointURL;
+
+		// 로컬 의도 템플릿이 답하면 요청이 서버에 닿지 않고 ~0ms 성공으로 잡히므로 측정 동안 끔
+		bool bOriginalEnableLocalIntents = false;
+		bool bRestoreLocalIntents = false;
+
+		FTSTicker::FDelegateHandle TickerHandle;
+
+		// 응답 완료 후 EndConversation을 걸어줄 슬롯 (상태 통지 안에서 다시 상태를 바꾸지 않도록 다음 틱에 처리)
+		TArray<int32> SlotsToRelease;
+
+		TArray<double> LatenciesSeconds;
+		int32 NumIssued = 0;
+		int32 NumSucceeded = 0;
+		int32 NumFailed = 0;
+		int32 NumSkipped = 0;
+
+		double StartTime = 0.0;
+		double IssueEndTime = 0.0;
+		double IssueAccumulator = 0.0;
+		int32 NextSlot = 0;
+
+		double StartConversationSeconds = 0.0;
+		double EnqueueSecondsAtStart = 0.0;
+		double ResponseSecondsAtStart = 0.0;
+
+		bool Tick(float DeltaTime);
+		void IssueRequest();
+		void OnTalkStateChanged(APONPCCharacter* NPC, ENPCTalkState NewState);
+		void Report();
+		void Cleanup();
+	};
+
+	static TUniquePtr<FRun> GActiveRun;
+
+	bool FRun::Start()
+	{
+		UWorld* WorldPtr = World.Get();
+		if (!WorldPtr)
+		{
+			return false;
+		}
+
+		APOClaudeAPIManager* ManagerPtr = Cast<APOClaudeAPIManager>(
+			UGameplayStatics::GetActorOfClass(WorldPtr, APOClaudeAPIManager::StaticClass()));
+		if (!ManagerPtr)
+		{
+			ManagerPtr = WorldPtr->SpawnActor<APOClaudeAPIManager>();
+			bSpawnedManager = true;
+		}
+		if (!ManagerPtr)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[ClaudeLoadTest] ClaudeAPIManager를 만들 수 없습니다."));
+			return false;
+		}
+		Manager = ManagerPtr;
+
+		if (Options.bUseMockServer)
+		{
+			FPOClaudeMockServer& MockServer = FPOClaudeMockServer::Get();
+			if (!MockServer.IsRunning() && !MockServer.Start(FPOClaudeMockServerSettings()))
+			{
+				return false;
+			}
+
+			OriginalEndpointURL = ManagerPtr->EndpointURL;
+			ManagerPtr->EndpointURL = MockServer.GetEndpointURL();
+		}
+
+		bOriginalEnableLocalIntents = ManagerPtr->bEnableLocalIntents;
+		bRestoreLocalIntents = true;
+		ManagerPtr->bEnableLocalIntents = false;
+
+		for (int32 i = 0; i < Options.NumNPCs; ++i)
+		{
+			// 격자 배치, AI 빙의 없이 대화 경로만 측정
+			const FTransform SpawnTransform(FVector((i % 16) * 200.0f, (i / 16) * 200.0f, 0.0f));
+			APONPCCharacter* NPC = WorldPtr->SpawnActorDeferred<APONPCCharacter>(
+				APONPCCharacter::StaticClass(), SpawnTransform, nullptr, nullptr,
+				ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+			if (!NPC)
+			{
+				continue;
+			}
+
+			NPC->AutoPossessAI = EAutoPossessAI::Disabled;
+			NPC->NPCName = FString::Printf(TEXT("부하테스트 주민 %d"), i);
+			NPC->TalkCooldown = 0.05f;
+
+			// 폴백 대사로 대화 상태가 바뀌면 백엔드 지연이 아니라 지연 목표를 재게 되므로 끔
+			NPC->ResponseSLOSeconds = 0.0f;
+			NPC->FinishSpawning(SpawnTransform);
+			NPC->GetCharacterMovement()->DisableMovement();
+
+			// 테스트 NPC가 레벨 매니저를 찾았더라도 대상 매니저로 고정
+			NPC->ClaudeManager = ManagerPtr;
+			NPC->OnTalkStateChanged.AddRaw(this, &FRun::OnTalkStateChanged);
+
+			FNPCSlot& Slot = Slots.AddDefaulted_GetRef();
+			Slot.NPC = NPC;
+		}
+
+		StartTime = FPlatformTime::Seconds();
+		IssueEndTime = StartTime + Options.DurationSeconds;
+		EnqueueSecondsAtStart = ManagerPtr->GetEnqueueGameThreadSeconds();
+		ResponseSecondsAtStart = ManagerPtr->GetResponseGameThreadSeconds();
+
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FRun::Tick));
+
+		UE_LOG(LogTemp, Display, TEXT("[ClaudeLoadTest] 시작: NPC %d, %.1f req/s, %.0f초, 엔드포인트 %s"),
+			Slots.Num(), Options.RequestsPerSecond, Options.DurationSeconds, *ManagerPtr->EndpointURL);
+		return Slots.Num() > 0;
+	}
+
+	bool FRun::Tick(float DeltaTime)
+	{
+		for (const int32 SlotIndex : SlotsToRelease)
+		{
+			if (APONPCCharacter* NPC = Slots[SlotIndex].NPC.Get())
+			{
+				NPC->EndConversation();
+			}
+		}
+		SlotsToRelease.Reset();
+
+		const double Now = FPlatformTime::Seconds();
+
+		if (Now < IssueEndTime)
+		{
+			IssueAccumulator += DeltaTime * Options.RequestsPerSecond;
+			while (IssueAccumulator >= 1.0)
+			{
+				IssueAccumulator -= 1.0;
+				IssueRequest();
+			}
+			return true;
+		}
+
+		const bool bAnyPending = Slots.ContainsByPredicate([](const FNPCSlot& Slot) { return Slot.bAwaitingResponse; });
+		if (bAnyPending && Now < IssueEndTime + Options.DrainTimeoutSeconds && Manager.IsValid())
+		{
+			return true;
+		}
+
+		Report();
+
+		const bool bQuit = Options.bQuitWhenDone;
+		TickerHandle.Reset();
+		GActiveRun.Reset();
+
+		if (bQuit)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+		return false;
+	}
+
+	void FRun::IssueRequest()
+	{
+		// 라운드 로빈으로 Idle NPC 탐색, 모두 바쁘면 포화로 집계
+		for (int32 Attempt = 0; Attempt < Slots.Num(); ++Attempt)
+		{
+			const int32 SlotIndex = NextSlot;
+			NextSlot = (NextSlot + 1) % Slots.Num();
+
+			FNPCSlot& Slot = Slots[SlotIndex];
+			APONPCCharacter* NPC = Slot.NPC.Get();
+			if (!NPC || NPC->TalkState != ENPCTalkState::Idle)
+			{
+				continue;
+			}
+
+			++NumIssued;
+			Slot.bAwaitingResponse = true;
+			Slot.RequestStartTime = FPlatformTime::Seconds();
+
+			// 응답 캐시에 걸리지 않도록 매번 다른 문장
+			const FString Message = FString::Printf(TEXT("오늘 날씨 어때요? 질문 %d"), NumIssued);
+
+			const double CallStart = FPlatformTime::Seconds();
+			NPC->StartConversation(Message);
+			StartConversationSeconds += FPlatformTime::Seconds() - CallStart;
+
+			// 즉시 거절되어 대기 상태로 들어가지 못한 경우
+			if (Slot.bAwaitingResponse && NPC->TalkState != ENPCTalkState::WaitingForAPI)
+			{
+				Slot.bAwaitingResponse = false;
+				++NumFailed;
+			}
+			return;
+		}
+
+		++NumSkipped;
+	}
+
+	void FRun::OnTalkStateChanged(APONPCCharacter* NPC, ENPCTalkState NewState)
+	{
+		if (NewState != ENPCTalkState::Talking && NewState != ENPCTalkState::Idle)
+		{
+			return;
+		}
+
+		const int32 SlotIndex = Slots.IndexOfByPredicate([NPC](const FNPCSlot& Slot) { return Slot.NPC.Get() == NPC; });
+		if (SlotIndex == INDEX_NONE || !Slots[SlotIndex].bAwaitingResponse)
+		{
+			return;
+		}
+
+		FNPCSlot& Slot = Slots[SlotIndex];
+		Slot.bAwaitingResponse = false;
+
+		if (NewState == ENPCTalkState::Talking)
+		{
+			++NumSucceeded;
+			LatenciesSeconds.Add(FPlatformTime::Seconds() - Slot.RequestStartTime);
+			SlotsToRelease.Add(SlotIndex);
+		}
+		else
+		{
+			++NumFailed;
+		}
+	}
+
+	static double Percentile(const TArray<double>& Sorted, double P)
+	{
+		if (Sorted.Num() == 0)
+		{
+			return 0.0;
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Index];
+	}
+
+	void FRun::Report()
+	{
+		const double Elapsed = FMath::Max(FPlatformTime::Seconds() - StartTime, UE_SMALL_NUMBER);
+
+		TArray<double> Sorted = LatenciesSeconds;
+		Sorted.Sort();
+
+		double ResponseSeconds = 0.0;
+		double EnqueueSeconds = 0.0;
+		if (const APOClaudeAPIManager* ManagerPtr = Manager.Get())
+		{
+			EnqueueSeconds = ManagerPtr->GetEnqueueGameThreadSeconds() - EnqueueSecondsAtStart;
+			ResponseSeconds = ManagerPtr->GetResponseGameThreadSeconds() - ResponseSecondsAtStart;
+		}
+
+		const int32 Completed = FMath::Max(1, NumSucceeded + NumFailed);
+		const int32 Issued = FMath::Max(1, NumIssued);
+
+		UE_LOG(LogTemp, Display, TEXT("[ClaudeLoadTest] ===== 결과 (%.1f초) ====="), Elapsed);
+		UE_LOG(LogTemp, Display, TEXT("[ClaudeLoadTest] 요청 %d / 성공 %d / 실패 %d / 포화로 건너뜀 %d"),
+			NumIssued, NumSucceeded, NumFailed, NumSkipped);
+		UE_LOG(LogTemp, Display, TEXT("[ClaudeLoadTest] 처리량 %.2f req/s"), NumSucceeded / Elapsed);
+		UE_LOG(LogTemp, Display, TEXT("[ClaudeLoadTest] 종단 지연 p50 %.0fms / p95 %.0fms / p99 %.0fms / 최대 %.0fms"),
+			Percentile(Sorted, 0.50) * 1000.0, Percentile(Sorted, 0.95) * 1000.0,
+			Percentile(Sorted, 0.99) * 1000.0, Sorted.Num() > 0 ? Sorted.Last() * 1000.0 : 0.0);
+		UE_LOG(LogTemp, Display, TEXT("[ClaudeLoadTest] 게임 스레드 비용/요청: StartConversation %.1fus (매니저 등록 %.1fus 포함), 응답·스트리밍 처리 %.1fus"),
+			StartConversationSeconds / Issued * 1e6, EnqueueSeconds / Issued * 1e6, ResponseSeconds / Completed * 1e6);
+
+		// 요청별 지연 CSV (Saved/Claude/LoadTest_*.csv)
+		FString Csv = TEXT("LatencyMs\n");
+		for (const double Latency : LatenciesSeconds)
+		{
+			Csv += FString::Printf(TEXT("%.2f\n"), Latency * 1000.0);
+		}
+		const FString CsvPath = FPaths::ProjectSavedDir() / TEXT("Claude")
+			/ FString::Printf(TEXT("LoadTest_%s.csv"), *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+		{
+			UE_LOG(LogTemp, Display, TEXT("[ClaudeLoadTest] 요청별 지연 저장: %s"), *CsvPath);
+		}
+	}
+
+	void FRun::Cleanup()
+	{
+		for (const FNPCSlot& Slot : Slots)
+		{
+			if (APONPCCharacter* NPC = Slot.NPC.Get())
+			{
+				NPC->OnTalkStateChanged.RemoveAll(this);
+				NPC->Destroy();
+			}
+		}
+		Slots.Reset();
+
+		if (APOClaudeAPIManager* ManagerPtr = Manager.Get())
+		{
+			if (!OriginalEndpointURL.IsEmpty())
+			{
+				ManagerPtr->EndpointURL = OriginalEndpointURL;
+			}
+			if (bRestoreLocalIntents)
+			{
+				ManagerPtr->bEnableLocalIntents = bOriginalEnableLocalIntents;
+			}
+			if (bSpawnedManager)
+			{
+				ManagerPtr->Destroy();
+			}
+		}
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (GActiveRun)
+		{
+			Ar.Log(TEXT("[ClaudeLoadTest] 이미 실행 중입니다."));
+			return;
+		}
+		if (!World)
+		{
+			Ar.Log(TEXT("[ClaudeLoadTest] 월드가 없습니다."));
+			return;
+		}
+
+		const FString Joined = FString::Join(Args, TEXT(" "));
+
+		FOptions Options;
+		FParse::Value(*Joined, TEXT("NPCs="),     Options.NumNPCs);
+		FParse::Value(*Joined, TEXT("Rate="),     Options.RequestsPerSecond);
+		FParse::Value(*Joined, TEXT("Duration="), Options.DurationSeconds);
+		FParse::Value(*Joined, TEXT("Drain="),    Options.DrainTimeoutSeconds);
+		FParse::Bool(*Joined,  TEXT("Mock="),     Options.bUseMockServer);
+		FParse::Bool(*Joined,  TEXT("Quit="),     Options.bQuitWhenDone);
+		Options.NumNPCs = FMath::Max(1, Options.NumNPCs);
+
+		GActiveRun = MakeUnique<FRun>(World, Options);
+		if (!GActiveRun->Start())
+		{
+			Ar.Log(TEXT("[ClaudeLoadTest] 시작 실패"));
+			GActiveRun.Reset();
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPOClaudeLoadTestCmd(
+	TEXT("Claude.LoadTest"),
+	TEXT("NPC 대화 부하 테스트. 인자: [NPCs=16] [Rate=4(req/s)] [Duration=30(s)] [Drain=30(s)] [Mock=1] [Quit=0]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&POClaudeLoadTest::Run));
+
+#endif // !UE_BUILD_SHIPPING
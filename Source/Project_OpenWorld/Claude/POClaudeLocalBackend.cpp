@@ -0,0 +1,779 @@
+#include "POClaudeLocalBackend.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+#if WITH_PO_LLAMA
+THIRD_PARTY_INCLUDES_START
+#include "llama.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
+namespace POClaudeLocalBackend
+{
+	// 일이 없을 때 종료 플래그를 다시 확인하는 간격 (ms)
+	constexpr uint32 WaitIntervalMs = 100;
+
+	// 프롬프트 평가 한 번에 넣는 최대 토큰 수
+	constexpr int32 MaxBatchTokens = 512;
+
+	// 완결된 UTF-8 문자까지의 바이트 수 (토큰 경계에서 잘린 다바이트 문자는 다음 토큰까지 보류)
+	static int32 CompleteUTF8Length(const TArray<ANSICHAR>& Bytes)
+	{
+		const int32 End = Bytes.Num();
+		for (int32 Back = 1; Back <= 4 && Back <= End; ++Back)
+		{
+			const uint8 Byte = static_cast<uint8>(Bytes[End - Back]);
+			if ((Byte & 0xC0) == 0x80)
+			{
+				continue;
+			}
+
+			int32 Needed = 1;
+			if ((Byte & 0xE0) == 0xC0)
+			{
+				Needed = 2;
+			}
+			else if ((Byte & 0xF0) == 0xE0)
+			{
+				Needed = 3;
+			}
+			else if ((Byte & 0xF8) == 0xF0)
+			{
+				Needed = 4;
+			}
+			return Back >= Needed ? End : End - Back;
+		}
+		return End;
+	}
+
+	static FString DecodeUTF8(const TArray<ANSICHAR>& Bytes, int32 Length)
+	{
+		const FUTF8ToTCHAR Converter(Bytes.GetData(), Length);
+		return FString(Converter.Length(), Converter.Get()).TrimStartAndEnd();
+	}
+}
+
+/** 전용 추론 스레드 1개 (llama 컨텍스트/샘플러/KV 캐시 소유) */
+class FPOClaudeLocalBackend::FWorker : public FRunnable
+{
+public:
+	FWorker(FPOClaudeLocalBackend& InOwner, int32 InIndex)
+		: Owner(InOwner)
+		, Index(InIndex)
+	{
+	}
+
+	virtual ~FWorker() override
+	{
+		Join();
+
+#if WITH_PO_LLAMA
+		if (Sampler)
+		{
+			llama_sampler_free(Sampler);
+		}
+		if (Context)
+		{
+			llama_free(Context);
+		}
+#endif
+	}
+
+#if WITH_PO_LLAMA
+	// 로딩 스레드에서 호출 (스레드 시작 전)
+	bool CreateContext(llama_model* Model, const FPOClaudeLocalBackendSettings& Settings)
+	{
+		llama_context_params ContextParams = llama_context_default_params();
+		ContextParams.n_ctx           = Settings.ContextTokens;
+		ContextParams.n_batch         = FMath::Min(POClaudeLocalBackend::MaxBatchTokens, Settings.ContextTokens);
+		ContextParams.n_ubatch        = ContextParams.n_batch;
+		ContextParams.n_threads       = Settings.ThreadsPerWorker;
+		ContextParams.n_threads_batch = Settings.ThreadsPerWorker;
+
+		Context = llama_init_from_model(Model, ContextParams);
+		if (!Context)
+		{
+			return false;
+		}
+
+		Sampler = llama_sampler_chain_init(llama_sampler_chain_default_params());
+		llama_sampler_chain_add(Sampler, llama_sampler_init_top_k(Settings.TopK));
+		llama_sampler_chain_add(Sampler, llama_sampler_init_top_p(Settings.TopP, 1));
+		llama_sampler_chain_add(Sampler, llama_sampler_init_temp(Settings.Temperature));
+		llama_sampler_chain_add(Sampler, llama_sampler_init_dist(FPlatformTime::Cycles() + Index));
+		return true;
+	}
+#endif
+
+	void Start()
+	{
+		Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("ClaudeLocalWorker%d"), Index), 0, TPri_BelowNormal);
+	}
+
+	void Join()
+	{
+		if (Thread)
+		{
+			Thread->WaitForCompletion();
+			delete Thread;
+			Thread = nullptr;
+		}
+	}
+
+	virtual uint32 Run() override
+	{
+		while (TUniquePtr<FJob> Job = Owner.WaitForJob(CachedPrefixKey))
+		{
+			FPOClaudeBackendResult Result;
+			Process(*Job, Result);
+
+			if (Owner.bStopping.load(std::memory_order_acquire))
+			{
+				// 종료 중에는 콜백 없이 결과만 확정
+				Job->Request.State->Settle(EClaudeRequestOutcome::Cancelled, false, FString());
+				continue;
+			}
+
+			CompleteJob(MoveTemp(Job), MoveTemp(Result));
+		}
+		return 0;
+	}
+
+private:
+	// 종료/취소/기한 초과 확인 (토큰마다 호출)
+	bool ShouldAbort(const FPOClaudeRequestState& State, bool& bOutTimedOut) const
+	{
+		if (Owner.bStopping.load(std::memory_order_acquire) || State.IsCancelRequested())
+		{
+			return true;
+		}
+
+		if (FPlatformTime::Seconds() >= State.Deadline)
+		{
+			bOutTimedOut = true;
+			return true;
+		}
+		return false;
+	}
+
+	void Process(FJob& Job, FPOClaudeBackendResult& Result)
+	{
+#if WITH_PO_LLAMA
+		const FPOClaudeBackendRequest& Request = Job.Request;
+		const FPOClaudeRequestState& State = *Request.State;
+
+		if (ShouldAbort(State, Result.bTimedOut))
+		{
+			return;
+		}
+
+		// 1. 모델 채팅 템플릿 적용 (system = 정적 블록 + 동적 블록, FPOClaudePromptBuilder::BuildPrompt와 같은 순서)
+		Arena.Reset();
+		Offsets.Reset();
+		auto AddText = [this](const FString& Text)
+		{
+			Offsets.Add(Arena.Num());
+			const FTCHARToUTF8 Converter(*Text);
+			Arena.Append(Converter.Get(), Converter.Length());
+			Arena.Add('\0');
+		};
+
+		AddText(Request.StaticSystem + TEXT("\n") + Request.DynamicSystem);
+		for (const FPOClaudeChatMessage& Message : Request.Messages)
+		{
+			AddText(Message.Content);
+		}
+
+		ChatMessages.Reset();
+		ChatMessages.Add({ "system", Arena.GetData() + Offsets[0] });
+		for (int32 i = 0; i < Request.Messages.Num(); ++i)
+		{
+			ChatMessages.Add({ Request.Messages[i].bAssistant ? "assistant" : "user", Arena.GetData() + Offsets[i + 1] });
+		}
+
+		const char* Template = llama_model_chat_template(Owner.Model, nullptr);
+		int32 PromptLength = llama_chat_apply_template(Template, ChatMessages.GetData(), ChatMessages.Num(), true,
+			PromptText.GetData(), PromptText.Num());
+		if (PromptLength > PromptText.Num())
+		{
+			PromptText.SetNumUninitialized(PromptLength);
+			PromptLength = llama_chat_apply_template(Template, ChatMessages.GetData(), ChatMessages.Num(), true,
+				PromptText.GetData(), PromptText.Num());
+		}
+		if (PromptLength < 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[ClaudeLocalBackend] 요청 #%d 채팅 템플릿 적용 실패"), State.RequestId);
+			return;
+		}
+
+		// 2. 토큰화
+		const llama_vocab* Vocab = llama_model_get_vocab(Owner.Model);
+		PromptTokens.SetNumUninitialized(PromptLength + 8);
+		int32 NumPromptTokens = llama_tokenize(Vocab, PromptText.GetData(), PromptLength,
+			PromptTokens.GetData(), PromptTokens.Num(), true, true);
+		if (NumPromptTokens < 0)
+		{
+			PromptTokens.SetNumUninitialized(-NumPromptTokens);
+			NumPromptTokens = llama_tokenize(Vocab, PromptText.GetData(), PromptLength,
+				PromptTokens.GetData(), PromptTokens.Num(), true, true);
+		}
+		if (NumPromptTokens <= 0)
+		{
+			return;
+		}
+		PromptTokens.SetNum(NumPromptTokens);
+
+		if (NumPromptTokens + Request.MaxTokens > static_cast<int32>(llama_n_ctx(Context)))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[ClaudeLocalBackend] 요청 #%d 프롬프트가 컨텍스트보다 깁니다 (%d + %d > %d)"),
+				State.RequestId, NumPromptTokens, Request.MaxTokens, llama_n_ctx(Context));
+			return;
+		}
+
+		// 3. 이전 요청과 겹치는 접두부의 KV 캐시 재사용 (마지막 토큰은 로짓을 얻기 위해 항상 다시 평가)
+		int32 NumReused = 0;
+		const int32 MaxReuse = FMath::Min(CachedTokens.Num(), NumPromptTokens - 1);
+		while (NumReused < MaxReuse && CachedTokens[NumReused] == PromptTokens[NumReused])
+		{
+			++NumReused;
+		}
+		llama_kv_cache_seq_rm(Context, 0, NumReused, -1);
+		CachedTokens.SetNum(NumReused);
+		CachedPrefixKey = Job.PrefixKey;
+
+		const double PrefillStart = FPlatformTime::Seconds();
+		for (int32 Pos = NumReused; Pos < NumPromptTokens; Pos += POClaudeLocalBackend::MaxBatchTokens)
+		{
+			if (ShouldAbort(State, Result.bTimedOut))
+			{
+				return;
+			}
+
+			const int32 Count = FMath::Min(POClaudeLocalBackend::MaxBatchTokens, NumPromptTokens - Pos);
+			if (llama_decode(Context, llama_batch_get_one(PromptTokens.GetData() + Pos, Count)) != 0)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[ClaudeLocalBackend] 요청 #%d 프롬프트 평가 실패"), State.RequestId);
+				InvalidateCache();
+				return;
+			}
+			CachedTokens.Append(PromptTokens.GetData() + Pos, Count);
+		}
+		const double PrefillSeconds = FPlatformTime::Seconds() - PrefillStart;
+
+		// 4. 생성 (완결된 UTF-8 문자까지만 조각으로 전달)
+		llama_sampler_reset(Sampler);
+
+		TArray<ANSICHAR> Output;
+		int32 EmittedLength = 0;
+		int32 NumGenerated = 0;
+		char Piece[256];
+
+		const double GenerateStart = FPlatformTime::Seconds();
+		for (; NumGenerated < Request.MaxTokens; ++NumGenerated)
+		{
+			if (ShouldAbort(State, Result.bTimedOut))
+			{
+				break;
+			}
+
+			llama_token Token = llama_sampler_sample(Sampler, Context, -1);
+			if (llama_vocab_is_eog(Vocab, Token))
+			{
+				break;
+			}
+
+			const int32 PieceLength = llama_token_to_piece(Vocab, Token, Piece, static_cast<int32>(sizeof(Piece)), 0, false);
+			if (PieceLength > 0)
+			{
+				Output.Append(Piece, PieceLength);
+			}
+
+			const int32 CompleteLength = POClaudeLocalBackend::CompleteUTF8Length(Output);
+			if (CompleteLength > EmittedLength && Job.OnPartial.IsBound())
+			{
+				EmittedLength = CompleteLength;
+				AsyncTask(ENamedThreads::GameThread,
+					[OnPartial = Job.OnPartial, Text = POClaudeLocalBackend::DecodeUTF8(Output, CompleteLength)]()
+					{
+						OnPartial.ExecuteIfBound(Text);
+					});
+			}
+
+			if (llama_decode(Context, llama_batch_get_one(&Token, 1)) != 0)
+			{
+				InvalidateCache();
+				break;
+			}
+			CachedTokens.Add(Token);
+		}
+		const double GenerateSeconds = FPlatformTime::Seconds() - GenerateStart;
+
+		Owner.NumJobs.fetch_add(1, std::memory_order_relaxed);
+		Owner.PrefillTokens.fetch_add(NumPromptTokens - NumReused, std::memory_order_relaxed);
+		Owner.ReusedTokens.fetch_add(NumReused, std::memory_order_relaxed);
+		Owner.GeneratedTokens.fetch_add(NumGenerated, std::memory_order_relaxed);
+		Owner.PrefillMicroseconds.fetch_add(static_cast<int64>(PrefillSeconds * 1e6), std::memory_order_relaxed);
+		Owner.GenerateMicroseconds.fetch_add(static_cast<int64>(GenerateSeconds * 1e6), std::memory_order_relaxed);
+
+		Result.Usage.InputTokens          = NumPromptTokens - NumReused;
+		Result.Usage.CacheReadInputTokens = NumReused;
+		Result.Usage.OutputTokens         = NumGenerated;
+
+		if (Result.bTimedOut || State.IsCancelRequested())
+		{
+			return;
+		}
+
+		Result.Text = POClaudeLocalBackend::DecodeUTF8(Output, POClaudeLocalBackend::CompleteUTF8Length(Output));
+		Result.bSuccess = !Result.Text.IsEmpty();
+#else
+		(void)Job;
+		(void)Result;
+#endif
+	}
+
+#if WITH_PO_LLAMA
+	// 디코딩 실패 시 KV 상태를 알 수 없으므로 통째로 비움
+	void InvalidateCache()
+	{
+		llama_kv_cache_clear(Context);
+		CachedTokens.Reset();
+		CachedPrefixKey = 0;
+	}
+#endif
+
+	FPOClaudeLocalBackend& Owner;
+	const int32 Index;
+
+	FRunnableThread* Thread = nullptr;
+
+	// 마지막으로 처리한 요청의 정적 시스템 블록 해시 (대기열에서 같은 접두부 요청을 먼저 가져옴)
+	uint32 CachedPrefixKey = 0;
+
+#if WITH_PO_LLAMA
+	llama_context* Context = nullptr;
+	llama_sampler* Sampler = nullptr;
+
+	// KV 캐시에 들어 있는 토큰 (프롬프트 + 생성, 위치 0부터)
+	TArray<llama_token> CachedTokens;
+
+	// 요청마다 재사용하는 버퍼
+	TArray<llama_token> PromptTokens;
+	TArray<llama_chat_message> ChatMessages;
+	TArray<ANSICHAR> Arena;
+	TArray<int32> Offsets;
+	TArray<char> PromptText;
+#endif
+};
+
+FPOClaudeLocalBackend::FPOClaudeLocalBackend()
+{
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FPOClaudeLocalBackend::~FPOClaudeLocalBackend()
+{
+	Shutdown();
+
+	if (WorkEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+		WorkEvent = nullptr;
+	}
+}
+
+bool FPOClaudeLocalBackend::IsCompiledIn()
+{
+	return WITH_PO_LLAMA != 0;
+}
+
+bool FPOClaudeLocalBackend::Initialize(const FPOClaudeLocalBackendSettings& InSettings)
+{
+	check(IsInGameThread());
+
+	if (!IsCompiledIn())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeLocalBackend] llama.cpp 없이 빌드되었습니다 (ThirdParty/llama). 로컬 백엔드를 사용할 수 없습니다."));
+		bLoadFailed = true;
+		return false;
+	}
+
+	if (!FPaths::FileExists(InSettings.ModelPath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeLocalBackend] 모델 파일이 없습니다: %s"), *InSettings.ModelPath);
+		bLoadFailed = true;
+		return false;
+	}
+
+	Settings = InSettings;
+	Settings.NumWorkers = FMath::Max(1, Settings.NumWorkers);
+	Settings.ThreadsPerWorker = FMath::Max(1, Settings.ThreadsPerWorker);
+
+	// GGUF 로딩은 수백 ms ~ 수 초 걸리므로 게임 스레드를 막지 않음
+	LoadTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]() { LoadModel(); });
+	return true;
+}
+
+void FPOClaudeLocalBackend::LoadModel()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+#if WITH_PO_LLAMA
+	static const bool bBackendInitialized = []()
+	{
+		llama_backend_init();
+		return true;
+	}();
+	(void)bBackendInitialized;
+
+	// CPU 전용 (그래픽 카드는 렌더링 몫)
+	llama_model_params ModelParams = llama_model_default_params();
+	ModelParams.n_gpu_layers = 0;
+
+	Model = llama_model_load_from_file(TCHAR_TO_UTF8(*Settings.ModelPath), ModelParams);
+	if (Model)
+	{
+		for (int32 i = 0; i < Settings.NumWorkers && !bStopping.load(std::memory_order_acquire); ++i)
+		{
+			TUniquePtr<FWorker> Worker = MakeUnique<FWorker>(*this, i);
+			if (!Worker->CreateContext(Model, Settings))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[ClaudeLocalBackend] 워커 %d 컨텍스트 생성 실패"), i);
+				break;
+			}
+			Workers.Add(MoveTemp(Worker));
+		}
+	}
+#endif
+
+	if (Workers.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[ClaudeLocalBackend] 모델 로딩 실패: %s"), *Settings.ModelPath);
+
+		// 로딩 중 들어온 요청은 실패로 돌려보냄 (이후 Submit은 잠금 안에서 bLoadFailed를 보고 바로 실패 처리)
+		TArray<TUniquePtr<FJob>> Orphans;
+		{
+			FScopeLock Lock(&QueueLock);
+			bLoadFailed = true;
+			Orphans = MoveTemp(Queue);
+		}
+		for (TUniquePtr<FJob>& Job : Orphans)
+		{
+			CompleteJob(MoveTemp(Job), FPOClaudeBackendResult());
+		}
+		return;
+	}
+
+	bModelLoaded = true;
+	for (const TUniquePtr<FWorker>& Worker : Workers)
+	{
+		Worker->Start();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ClaudeLocalBackend] 모델 로딩 완료 (%.2fs): %s, 워커 %d × 스레드 %d, 컨텍스트 %d"),
+		FPlatformTime::Seconds() - StartTime, *FPaths::GetCleanFilename(Settings.ModelPath),
+		Workers.Num(), Settings.ThreadsPerWorker, Settings.ContextTokens);
+}
+
+bool FPOClaudeLocalBackend::IsAvailable() const
+{
+	return !bLoadFailed.load(std::memory_order_acquire) && !bStopping.load(std::memory_order_acquire);
+}
+
+void FPOClaudeLocalBackend::Submit(FPOClaudeBackendRequest&& Request, FOnPOClaudeBackendPartial OnPartial, FOnPOClaudeBackendComplete OnComplete)
+{
+	TUniquePtr<FJob> Job = MakeUnique<FJob>(MoveTemp(Request));
+	Job->OnPartial  = MoveTemp(OnPartial);
+	Job->OnComplete = MoveTemp(OnComplete);
+	Job->PrefixKey  = GetTypeHash(Job->Request.StaticSystem);
+
+	{
+		FScopeLock Lock(&QueueLock);
+		if (IsAvailable())
+		{
+			Queue.Add(MoveTemp(Job));
+		}
+	}
+
+	if (Job)
+	{
+		CompleteJob(MoveTemp(Job), FPOClaudeBackendResult());
+		return;
+	}
+
+	WorkEvent->Trigger();
+}
+
+TUniquePtr<FPOClaudeLocalBackend::FJob> FPOClaudeLocalBackend::WaitForJob(uint32 PreferredPrefixKey)
+{
+	while (!bStopping.load(std::memory_order_acquire))
+	{
+		{
+			FScopeLock Lock(&QueueLock);
+			if (Queue.Num() > 0)
+			{
+				// 앞쪽 몇 개 중 이 워커 KV 캐시와 접두부가 같은 요청을 우선 (워커 수만큼만 봐서 FIFO가 크게 어긋나지 않음)
+				int32 Index = 0;
+				const int32 Lookahead = FMath::Min(Queue.Num(), Settings.NumWorkers);
+				for (int32 i = 0; i < Lookahead; ++i)
+				{
+					if (Queue[i]->PrefixKey == PreferredPrefixKey)
+					{
+						Index = i;
+						break;
+					}
+				}
+
+				TUniquePtr<FJob> Job = MoveTemp(Queue[Index]);
+				Queue.RemoveAt(Index);
+				return Job;
+			}
+		}
+
+		WorkEvent->Wait(POClaudeLocalBackend::WaitIntervalMs);
+	}
+	return nullptr;
+}
+
+void FPOClaudeLocalBackend::CompleteJob(TUniquePtr<FJob>&& Job, FPOClaudeBackendResult&& Result)
+{
+	AsyncTask(ENamedThreads::GameThread,
+		[OnComplete = MoveTemp(Job->OnComplete), Result = MoveTemp(Result)]() mutable
+		{
+			OnComplete.ExecuteIfBound(MoveTemp(Result));
+		});
+}
+
+void FPOClaudeLocalBackend::Shutdown()
+{
+	if (bStopping.exchange(true, std::memory_order_acq_rel))
+	{
+		return;
+	}
+
+	LoadTask.Wait();
+
+	for (int32 i = 0; i < Workers.Num(); ++i)
+	{
+		WorkEvent->Trigger();
+	}
+	Workers.Reset();
+
+	// 아직 꺼내지 않은 요청은 콜백 없이 취소로 확정
+	TArray<TUniquePtr<FJob>> Orphans;
+	{
+		FScopeLock Lock(&QueueLock);
+		Orphans = MoveTemp(Queue);
+	}
+	for (const TUniquePtr<FJob>& Job : Orphans)
+	{
+		Job->Request.State->Settle(EClaudeRequestOutcome::Cancelled, false, FString());
+	}
+
+#if WITH_PO_LLAMA
+	if (Model)
+	{
+		llama_model_free(Model);
+		Model = nullptr;
+	}
+#endif
+
+	const FPOClaudeLocalBackendStats Stats = GetStats();
+	if (Stats.NumJobs > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ClaudeLocalBackend] 요청 %lld / 프롬프트 평가 %lld 토큰 (재사용 %lld) / 생성 %lld 토큰 (%.1f tok/s/워커)"),
+			Stats.NumJobs, Stats.PrefillTokens, Stats.ReusedTokens, Stats.GeneratedTokens,
+			Stats.GenerateSeconds > 0.0 ? Stats.GeneratedTokens / Stats.GenerateSeconds : 0.0);
+	}
+}
+
+FPOClaudeLocalBackendStats FPOClaudeLocalBackend::GetStats() const
+{
+	FPOClaudeLocalBackendStats Stats;
+	Stats.NumJobs         = NumJobs.load(std::memory_order_relaxed);
+	Stats.PrefillTokens   = PrefillTokens.load(std::memory_order_relaxed);
+	Stats.ReusedTokens    = ReusedTokens.load(std::memory_order_relaxed);
+	Stats.GeneratedTokens = GeneratedTokens.load(std::memory_order_relaxed);
+	Stats.PrefillSeconds  = PrefillMicroseconds.load(std::memory_order_relaxed) * 1e-6;
+	Stats.GenerateSeconds = GenerateMicroseconds.load(std::memory_order_relaxed) * 1e-6;
+	return Stats;
+}
+
+#if !UE_BUILD_SHIPPING
+
+#include "HAL/IConsoleManager.h"
+#include "Containers/Ticker.h"
+#include "Misc/Parse.h"
+#include "POClaudePromptBuilder.h"
+
+/**
+ * 로컬 백엔드 처리량 벤치마크
+ * 같은 아키타입 요청 Runs개를 한꺼번에 넣고 프롬프트 평가/생성 tok/s와 코어당 tok/s, KV 접두부 재사용률을 보고한다.
+ * 모델 로딩 시간은 측정에서 제외한다.
+ * 예: Claude.BenchLocal Tokens=64 Runs=8 Workers=2 Threads=2 [Model=경로]
+ */
+namespace POClaudeLocalBackendCommands
+{
+	struct FBench
+	{
+		TUniquePtr<FPOClaudeLocalBackend> Backend;
+		FClaudeRequestContext Context;
+		FString StaticSystem;
+		int32 NumRuns = 0;
+		int32 NumTokens = 0;
+		int32 NumRemaining = 0;
+		int32 NumFailed = 0;
+		double StartTime = 0.0;
+		bool bSubmitted = false;
+		FTSTicker::FDelegateHandle TickerHandle;
+	};
+
+	static TSharedPtr<FBench> GActiveBench;
+
+	static void Finish(FBench& Bench)
+	{
+		const double WallSeconds = FPlatformTime::Seconds() - Bench.StartTime;
+		const FPOClaudeLocalBackendStats Stats = Bench.Backend->GetStats();
+		const FPOClaudeLocalBackendSettings& Settings = Bench.Backend->GetSettings();
+
+		const int32 NumCores = Settings.NumWorkers * Settings.ThreadsPerWorker;
+		const double PrefillRate  = Stats.PrefillSeconds > 0.0 ? Stats.PrefillTokens / Stats.PrefillSeconds : 0.0;
+		const double GenerateRate = Stats.GenerateSeconds > 0.0 ? Stats.GeneratedTokens / Stats.GenerateSeconds : 0.0;
+		const double Aggregate    = WallSeconds > 0.0 ? Stats.GeneratedTokens / WallSeconds : 0.0;
+		const int64 PromptTokens  = Stats.PrefillTokens + Stats.ReusedTokens;
+
+		UE_LOG(LogTemp, Display, TEXT("[ClaudeLocalBackend] 벤치마크: 요청 %d (실패 %d), 워커 %d × 스레드 %d = 코어 %d, %.2fs"),
+			Bench.NumRuns, Bench.NumFailed, Settings.NumWorkers, Settings.ThreadsPerWorker, NumCores, WallSeconds);
+		UE_LOG(LogTemp, Display, TEXT("[ClaudeLocalBackend]   프롬프트 평가 %lld 토큰: %.1f tok/s/워커 (%.1f tok/s/코어)"),
+			Stats.PrefillTokens, PrefillRate, PrefillRate / Settings.ThreadsPerWorker);
+		UE_LOG(LogTemp, Display, TEXT("[ClaudeLocalBackend]   생성 %lld 토큰: %.1f tok/s/워커 (%.1f tok/s/코어), 전체 %.1f tok/s (%.1f tok/s/코어)"),
+			Stats.GeneratedTokens, GenerateRate, GenerateRate / Settings.ThreadsPerWorker, Aggregate, Aggregate / NumCores);
+		UE_LOG(LogTemp, Display, TEXT("[ClaudeLocalBackend]   KV 접두부 재사용 %lld / %lld 토큰 (%.1f%%)"),
+			Stats.ReusedTokens, PromptTokens, PromptTokens > 0 ? 100.0 * Stats.ReusedTokens / PromptTokens : 0.0);
+	}
+
+	static void Submit(const TSharedRef<FBench>& Bench)
+	{
+		static const TCHAR* const Messages[] = {
+			TEXT("요즘 마을에 별일 없나요?"),
+			TEXT("이 근처에 묵을 만한 곳이 있을까요?"),
+			TEXT("북쪽 숲에 뭐가 있는지 아세요?"),
+			TEXT("당신은 여기서 무슨 일을 하세요?")
+		};
+
+		Bench->StartTime = FPlatformTime::Seconds();
+		Bench->bSubmitted = true;
+
+		for (int32 i = 0; i < Bench->NumRuns; ++i)
+		{
+			FClaudeRequestContext RunContext = Bench->Context;
+			RunContext.PlayerMessage = Messages[i % UE_ARRAY_COUNT(Messages)];
+
+			FPOClaudeBackendRequest Request(MakeShared<FPOClaudeRequestState, ESPMode::ThreadSafe>(
+				i + 1, FPlatformTime::Seconds() + 600.0, nullptr, nullptr));
+			Request.StaticSystem  = Bench->StaticSystem;
+			Request.DynamicSystem = FPOClaudePromptBuilder::BuildDynamicBlock(RunContext);
+			Request.MaxTokens     = Bench->NumTokens;
+			Request.Messages.Add({ false, RunContext.PlayerMessage });
+
+			Bench->Backend->Submit(MoveTemp(Request), FOnPOClaudeBackendPartial(),
+				FOnPOClaudeBackendComplete::CreateLambda([Bench](FPOClaudeBackendResult&& Result)
+				{
+					if (!Result.bSuccess)
+					{
+						++Bench->NumFailed;
+					}
+					--Bench->NumRemaining;
+				}));
+		}
+	}
+
+	static bool Tick(float DeltaTime)
+	{
+		const TSharedPtr<FBench> Bench = GActiveBench;
+		if (!Bench)
+		{
+			return false;
+		}
+
+		if (!Bench->bSubmitted)
+		{
+			if (!Bench->Backend->IsAvailable())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[ClaudeLocalBackend] 벤치마크 중단: 모델을 불러오지 못했습니다."));
+				GActiveBench.Reset();
+				return false;
+			}
+
+			// 로딩이 끝난 뒤부터 측정
+			if (Bench->Backend->IsModelLoaded())
+			{
+				Submit(Bench.ToSharedRef());
+			}
+			return true;
+		}
+
+		if (Bench->NumRemaining > 0)
+		{
+			return true;
+		}
+
+		Finish(*Bench);
+		Bench->Backend->Shutdown();
+		GActiveBench.Reset();
+		return false;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		if (GActiveBench)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[ClaudeLocalBackend] 벤치마크가 이미 실행 중입니다."));
+			return;
+		}
+
+		const FString Params = FString::Join(Args, TEXT(" "));
+
+		FPOClaudeLocalBackendSettings Settings;
+		Settings.ModelPath = FPaths::ProjectContentDir() / TEXT("Models") / TEXT("npc-dialogue.gguf");
+		FParse::Value(*Params, TEXT("Model="), Settings.ModelPath);
+		FParse::Value(*Params, TEXT("Workers="), Settings.NumWorkers);
+		FParse::Value(*Params, TEXT("Threads="), Settings.ThreadsPerWorker);
+
+		const TSharedRef<FBench> Bench = MakeShared<FBench>();
+		Bench->NumTokens = 64;
+		Bench->NumRuns = 8;
+		FParse::Value(*Params, TEXT("Tokens="), Bench->NumTokens);
+		FParse::Value(*Params, TEXT("Runs="), Bench->NumRuns);
+		Bench->NumTokens = FMath::Max(1, Bench->NumTokens);
+		Bench->NumRuns = FMath::Max(1, Bench->NumRuns);
+		Bench->NumRemaining = Bench->NumRuns;
+
+		Bench->Context.WeatherType = TEXT("비");
+		Bench->Context.TimeOfDay = 19.5f;
+
+		FPOClaudePromptBuilder PromptBuilder;
+		Bench->StaticSystem = PromptBuilder.GetStaticBlock(Bench->Context);
+
+		Bench->Backend = MakeUnique<FPOClaudeLocalBackend>();
+		if (!Bench->Backend->Initialize(Settings))
+		{
+			return;
+		}
+
+		GActiveBench = Bench;
+		Bench->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick), 0.05f);
+		UE_LOG(LogTemp, Display, TEXT("[ClaudeLocalBackend] 벤치마크 시작: 요청 %d × 최대 %d 토큰"), Bench->NumRuns, Bench->NumTokens);
+	}
+}
+
+static FAutoConsoleCommand GPOClaudeBenchLocalCmd(
+	TEXT("Claude.BenchLocal"),
+	TEXT("로컬 CPU 백엔드 처리량(tok/s, tok/s/코어)과 KV 접두부 재사용률 측정. 인자: [Tokens=64] [Runs=8] [Workers=2] [Threads=2] [Model=경로]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&POClaudeLocalBackendCommands::Run));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Tasks/Task.h"
+#include "POClaudeBackend.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+struct llama_model;
+
+/** 로컬 백엔드 설정 (매니저 UPROPERTY에서 채움) */
+struct FPOClaudeLocalBackendSettings
+{
+	// GGUF 모델 절대 경로
+	FString ModelPath;
+
+	// 동시에 생성할 수 있는 요청 수 (워커마다 llama 컨텍스트/KV 캐시 1개)
+	int32 NumWorkers = 2;
+
+	// 워커 하나가 행렬 연산에 쓰는 CPU 스레드 수
+	int32 ThreadsPerWorker = 2;
+
+	// 워커 컨텍스트 길이 (프롬프트 + 응답 토큰)
+	int32 ContextTokens = 2048;
+
+	float Temperature = 0.8f;
+	int32 TopK = 40;
+	float TopP = 0.9f;
+};
+
+/** 로컬 백엔드 누적 처리량 (아무 스레드에서나 조회) */
+struct FPOClaudeLocalBackendStats
+{
+	int64 NumJobs = 0;
+
+	// 새로 평가한 프롬프트 토큰 / KV 캐시에서 재사용한 프롬프트 토큰 / 생성한 토큰
+	int64 PrefillTokens = 0;
+	int64 ReusedTokens = 0;
+	int64 GeneratedTokens = 0;
+
+	// 워커들이 프롬프트 평가 / 토큰 생성에 쓴 시간 합계 (초)
+	double PrefillSeconds = 0.0;
+	double GenerateSeconds = 0.0;
+};
+
+/**
+ * 네트워크 없이 CPU에서 양자화 GGUF 소형 모델로 NPC 대사를 생성하는 백엔드 (llama.cpp 내장)
+ * 전용 워커 스레드마다 llama 컨텍스트를 하나씩 두고 공유 대기열에서 요청을 꺼내 처리한다.
+ * 워커는 마지막 프롬프트 토큰을 기억해 두고 다음 요청과 겹치는 접두부(아키타입 정적 시스템 블록)의
+ * KV 캐시를 그대로 재사용하며, 대기열에서는 같은 접두부를 마지막으로 처리한 워커가 그 요청을 먼저 가져간다.
+ *
+ * ThirdParty/llama가 없는 빌드(WITH_PO_LLAMA=0)에서는 IsAvailable()이 항상 false다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeLocalBackend : public IPOClaudeBackend
+{
+public:
+	FPOClaudeLocalBackend();
+	virtual ~FPOClaudeLocalBackend() override;
+
+	// llama.cpp가 함께 빌드됐는지
+	static bool IsCompiledIn();
+
+	// 모델 로딩은 백그라운드에서 진행 (그동안 들어온 요청은 대기열에서 기다림)
+	bool Initialize(const FPOClaudeLocalBackendSettings& InSettings);
+
+	// IPOClaudeBackend
+	virtual const TCHAR* GetName() const override { return TEXT("Local"); }
+	virtual bool IsAvailable() const override;
+	virtual void Submit(FPOClaudeBackendRequest&& Request, FOnPOClaudeBackendPartial OnPartial, FOnPOClaudeBackendComplete OnComplete) override;
+	virtual void Shutdown() override;
+
+	bool IsModelLoaded() const { return bModelLoaded.load(std::memory_order_acquire); }
+
+	const FPOClaudeLocalBackendSettings& GetSettings() const { return Settings; }
+
+	FPOClaudeLocalBackendStats GetStats() const;
+
+private:
+	/** 대기열 항목 */
+	struct FJob
+	{
+		explicit FJob(FPOClaudeBackendRequest&& InRequest)
+			: Request(MoveTemp(InRequest))
+		{
+		}
+
+		FPOClaudeBackendRequest Request;
+		FOnPOClaudeBackendPartial OnPartial;
+		FOnPOClaudeBackendComplete OnComplete;
+
+		// 정적 시스템 블록 해시 (워커 선택용)
+		uint32 PrefixKey = 0;
+	};
+
+	class FWorker;
+
+	// 워커 스레드에서 호출: 일이 생기거나 종료될 때까지 대기. 종료면 nullptr
+	TUniquePtr<FJob> WaitForJob(uint32 PreferredPrefixKey);
+
+	// 결과를 게임 스레드로 전달
+	static void CompleteJob(TUniquePtr<FJob>&& Job, FPOClaudeBackendResult&& Result);
+
+	void LoadModel();
+
+	FPOClaudeLocalBackendSettings Settings;
+
+	llama_model* Model = nullptr;
+
+	TArray<TUniquePtr<FWorker>> Workers;
+
+	FCriticalSection QueueLock;
+	TArray<TUniquePtr<FJob>> Queue;
+	FEvent* WorkEvent = nullptr;
+
+	UE::Tasks::FTask LoadTask;
+
+	std::atomic<bool> bStopping { false };
+	std::atomic<bool> bModelLoaded { false };
+	std::atomic<bool> bLoadFailed { false };
+
+	std::atomic<int64> NumJobs { 0 };
+	std::atomic<int64> PrefillTokens { 0 };
+	std::atomic<int64> ReusedTokens { 0 };
+	std::atomic<int64> GeneratedTokens { 0 };
+	std::atomic<int64> PrefillMicroseconds { 0 };
+	std::atomic<int64> GenerateMicroseconds { 0 };
+};
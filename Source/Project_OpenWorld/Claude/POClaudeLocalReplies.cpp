@@ -0,0 +1,178 @@
+#include "POClaudeLocalReplies.h"
+#include "../World/POEnvironmentSubsystem.h"
+
+FPOClaudeLocalReplies::FPOClaudeLocalReplies()
+{
+	// EClaudeLocalIntent 선언 순서와 같아야 함 (None 제외)
+	static const TCHAR* const DefaultTemplates[NumIntents][2] = {
+		{ nullptr, nullptr },
+		{ TEXT("안녕하세요! {name}입니다. 무슨 일로 오셨어요?"),      TEXT("어서 오세요. 좋은 {period} 보내고 계신가요?") },
+		{ TEXT("살펴 가세요. 또 들러 주세요!"),                       TEXT("조심히 가세요. 다음에 또 이야기해요.") },
+		{ TEXT("별말씀을요. 언제든 물어보세요."),                      TEXT("도움이 됐다니 다행이에요.") },
+		{ TEXT("지금 날씨요? 하늘을 보니 {weather}입니다."),           TEXT("보시다시피 {weather}입니다. 나가실 때 참고하세요.") },
+		{ TEXT("해를 보니 {period} {hour}시쯤 됐겠네요."),             TEXT("지금은 {period}, {hour}시 무렵이에요.") }
+	};
+
+	for (int32 Intent = 0; Intent < NumIntents; ++Intent)
+	{
+		for (const TCHAR* Source : DefaultTemplates[Intent])
+		{
+			if (Source)
+			{
+				Defaults.ByIntent[Intent].Add(Compile(Source));
+			}
+		}
+	}
+}
+
+void FPOClaudeLocalReplies::SetPersona(const FObjectKey& Owner, const TArray<FClaudeLocalReplyTemplates>& Templates)
+{
+	if (Templates.Num() == 0)
+	{
+		Personas.Remove(Owner);
+		return;
+	}
+
+	FPersona& Persona = Personas.FindOrAdd(Owner);
+	for (TArray<FTemplate>& List : Persona.ByIntent)
+	{
+		List.Reset();
+	}
+
+	for (const FClaudeLocalReplyTemplates& Entry : Templates)
+	{
+		const int32 Intent = static_cast<int32>(Entry.Intent);
+		if (Entry.Intent == EClaudeLocalIntent::None || Intent >= NumIntents)
+		{
+			continue;
+		}
+
+		for (const FString& Source : Entry.Templates)
+		{
+			if (!Source.IsEmpty())
+			{
+				Persona.ByIntent[Intent].Add(Compile(Source));
+			}
+		}
+	}
+}
+
+void FPOClaudeLocalReplies::RemovePersona(const FObjectKey& Owner)
+{
+	Personas.Remove(Owner);
+}
+
+bool FPOClaudeLocalReplies::Format(
+	EClaudeLocalIntent Intent,
+	const FObjectKey& Owner,
+	const FClaudeRequestContext& Context,
+	uint32 Seed,
+	FString& OutText) const
+{
+	const int32 Index = static_cast<int32>(Intent);
+	if (Intent == EClaudeLocalIntent::None || Index >= NumIntents)
+	{
+		return false;
+	}
+
+	const TArray<FTemplate>* List = &Defaults.ByIntent[Index];
+	if (const FPersona* Persona = Personas.Find(Owner))
+	{
+		if (Persona->ByIntent[Index].Num() > 0)
+		{
+			List = &Persona->ByIntent[Index];
+		}
+	}
+
+	if (List->Num() == 0)
+	{
+		return false;
+	}
+
+	const FTemplate& Template = (*List)[Seed % List->Num()];
+	OutText.Reset(Template.LiteralLen + Context.NPCName.Len() + 16);
+	Append(Template, Context, OutText);
+	return true;
+}
+
+FPOClaudeLocalReplies::FTemplate FPOClaudeLocalReplies::Compile(const FString& Source)
+{
+	static const TPair<const TCHAR*, ESlot> SlotNames[] = {
+		{ TEXT("{name}"),    ESlot::Name },
+		{ TEXT("{weather}"), ESlot::Weather },
+		{ TEXT("{period}"),  ESlot::Period },
+		{ TEXT("{hour}"),    ESlot::Hour }
+	};
+
+	FTemplate Template;
+	FSegment* Current = &Template.Segments.AddDefaulted_GetRef();
+
+	const TCHAR* It = *Source;
+	while (*It)
+	{
+		ESlot Slot = ESlot::None;
+		int32 SlotLen = 0;
+		if (*It == TEXT('{'))
+		{
+			for (const TPair<const TCHAR*, ESlot>& Pair : SlotNames)
+			{
+				const int32 NameLen = FCString::Strlen(Pair.Key);
+				if (FCString::Strncmp(It, Pair.Key, NameLen) == 0)
+				{
+					Slot = Pair.Value;
+					SlotLen = NameLen;
+					break;
+				}
+			}
+		}
+
+		if (Slot != ESlot::None)
+		{
+			Current->Slot = Slot;
+			Current = &Template.Segments.AddDefaulted_GetRef();
+			It += SlotLen;
+		}
+		else
+		{
+			// 모르는 {...}는 리터럴로 남김
+			Current->Literal.AppendChar(*It);
+			++Template.LiteralLen;
+			++It;
+		}
+	}
+
+	return Template;
+}
+
+void FPOClaudeLocalReplies::Append(const FTemplate& Template, const FClaudeRequestContext& Context, FString& OutText)
+{
+	for (const FSegment& Segment : Template.Segments)
+	{
+		OutText += Segment.Literal;
+
+		switch (Segment.Slot)
+		{
+		case ESlot::Name:
+			OutText += Context.NPCName;
+			break;
+
+		case ESlot::Weather:
+			OutText += Context.WeatherType;
+			break;
+
+		case ESlot::Period:
+			OutText += UPOEnvironmentSubsystem::TimePeriodToKorean(UPOEnvironmentSubsystem::GetTimePeriod(Context.TimeOfDay));
+			break;
+
+		case ESlot::Hour:
+		{
+			const int32 Hour = FMath::FloorToInt(Context.TimeOfDay) % 12;
+			OutText.AppendInt(Hour == 0 ? 12 : Hour);
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "POClaudeTypes.h"
+
+/**
+ * 로컬 의도 응답 템플릿 표 (기본 문구 + NPC별 페르소나 문구)
+ * 템플릿은 등록 시 리터럴/치환 칸 조각으로 미리 쪼개 두므로 응답할 때는 이어 붙이기만 한다.
+ * 페르소나에 없는 의도는 기본 문구로 답한다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeLocalReplies
+{
+public:
+	FPOClaudeLocalReplies();
+
+	// NPC 페르소나 템플릿 등록/해제 (빈 배열이면 기본 문구만 사용)
+	void SetPersona(const FObjectKey& Owner, const TArray<FClaudeLocalReplyTemplates>& Templates);
+	void RemovePersona(const FObjectKey& Owner);
+
+	// Seed(보통 요청 ID)로 템플릿을 돌려 가며 선택. 쓸 템플릿이 없으면 false
+	bool Format(EClaudeLocalIntent Intent, const FObjectKey& Owner, const FClaudeRequestContext& Context,
+		uint32 Seed, FString& OutText) const;
+
+private:
+	enum class ESlot : uint8
+	{
+		None,
+		Name,
+		Weather,
+		Period,
+		Hour
+	};
+
+	struct FSegment
+	{
+		FString Literal;
+
+		// 리터럴 뒤에 이어 붙일 치환 칸
+		ESlot Slot = ESlot::None;
+	};
+
+	struct FTemplate
+	{
+		TArray<FSegment, TInlineAllocator<4>> Segments;
+
+		// 리터럴 글자 수 합 (출력 버퍼 예약용)
+		int32 LiteralLen = 0;
+	};
+
+	static constexpr int32 NumIntents = static_cast<int32>(EClaudeLocalIntent::MAX);
+
+	struct FPersona
+	{
+		TArray<FTemplate> ByIntent[NumIntents];
+	};
+
+	FPersona Defaults;
+
+	TMap<FObjectKey, FPersona> Personas;
+
+	static FTemplate Compile(const FString& Source);
+
+	static void Append(const FTemplate& Template, const FClaudeRequestContext& Context, FString& OutText);
+};
@@ -0,0 +1,780 @@
+#include "POClaudeMemoryStore.h"
+#include "Algo/Unique.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "POClaudeTokenEstimator.h"
+
+namespace POClaudeMemory
+{
+	// BM25 매개변수 (짧은 문서 위주라 표준값 사용)
+	constexpr float K1 = 1.2f;
+	constexpr float B = 0.75f;
+
+	// 포스팅 = 문서 번호 24비트 | 빈도 8비트
+	constexpr uint32 DocMask = 0x00FFFFFF;
+	constexpr int32 FreqShift = 24;
+
+	// 사실 한 줄 최대 길이 (글자)
+	constexpr int32 MaxFactChars = 80;
+	constexpr int32 MinFactChars = 4;
+
+	// 묘비가 살아 있는 사실의 1/4을 넘으면 재구성
+	constexpr int32 MinTombstonesToCompact = 64;
+
+	static bool IsWordChar(TCHAR C)
+	{
+		return FChar::IsAlnum(C) || (C >= 0xAC00 && C <= 0xD7A3);
+	}
+
+	static uint32 MakeTerm(TCHAR First, TCHAR Second)
+	{
+		return (static_cast<uint32>(static_cast<uint16>(FChar::ToLower(First))) << 16)
+			| static_cast<uint16>(FChar::ToLower(Second));
+	}
+
+	// 1인칭 표지 (띄어쓰기 단위로 정확히 일치)
+	static const TCHAR* const FirstPersonWords[] = {
+		TEXT("나"), TEXT("나는"), TEXT("난"), TEXT("내"), TEXT("내가"), TEXT("나도"), TEXT("나를"), TEXT("내게"),
+		TEXT("저"), TEXT("저는"), TEXT("전"), TEXT("제"), TEXT("제가"), TEXT("저도"), TEXT("저를"), TEXT("제게"),
+		TEXT("우리"), TEXT("우리는"), TEXT("저희"), TEXT("저희는")
+	};
+
+	// 물음 표지 (물음표 없이 묻는 문장 제외)
+	static const TCHAR* const QuestionWords[] = {
+		TEXT("뭐"), TEXT("무엇"), TEXT("어디"), TEXT("언제"), TEXT("누구"), TEXT("왜"), TEXT("어떻"), TEXT("어때"), TEXT("몇")
+	};
+}
+
+void FPOClaudeMemoryIndex::Tokenize(const FString& Text, TArray<uint32>& OutTerms)
+{
+	using namespace POClaudeMemory;
+
+	OutTerms.Reset();
+
+	const TCHAR* Chars = *Text;
+	const int32 Len = Text.Len();
+
+	int32 WordStart = INDEX_NONE;
+	for (int32 i = 0; i <= Len; ++i)
+	{
+		const bool bWordChar = i < Len && IsWordChar(Chars[i]);
+		if (bWordChar)
+		{
+			if (WordStart == INDEX_NONE)
+			{
+				WordStart = i;
+			}
+			continue;
+		}
+
+		if (WordStart == INDEX_NONE)
+		{
+			continue;
+		}
+
+		if (i - WordStart == 1)
+		{
+			OutTerms.Add(MakeTerm(Chars[WordStart], TEXT('\0')));
+		}
+		else
+		{
+			for (int32 j = WordStart; j + 1 < i; ++j)
+			{
+				OutTerms.Add(MakeTerm(Chars[j], Chars[j + 1]));
+			}
+		}
+		WordStart = INDEX_NONE;
+	}
+}
+
+uint64 FPOClaudeMemoryIndex::HashTermSet(const TArray<uint32>& SortedTerms)
+{
+	return CityHash64(reinterpret_cast<const char*>(SortedTerms.GetData()), SortedTerms.Num() * sizeof(uint32));
+}
+
+bool FPOClaudeMemoryIndex::Add(const FString& Fact, int32 MaxFacts)
+{
+	TArray<uint32> Terms;
+	Tokenize(Fact, Terms);
+	if (Terms.Num() == 0)
+	{
+		return false;
+	}
+	Terms.Sort();
+
+	// 같은 용어 구성 = 같은 사실의 재진술: 옛 것을 지우고 새로 넣어 최근 것으로 만듦
+	TArray<uint32> UniqueTerms = Terms;
+	UniqueTerms.SetNum(Algo::Unique(UniqueTerms));
+	const uint64 TermSetHash = HashTermSet(UniqueTerms);
+	if (const int32* Existing = TermSetIndex.Find(TermSetHash))
+	{
+		Remove(*Existing);
+	}
+
+	// 가득 찼으면 가장 오래된 사실 제거
+	while (MaxFacts > 0 && NumAlive >= MaxFacts)
+	{
+		int32 Oldest = INDEX_NONE;
+		for (TConstSetBitIterator<> It(Alive); It; ++It)
+		{
+			if (Oldest == INDEX_NONE || Serials[It.GetIndex()] < Serials[Oldest])
+			{
+				Oldest = It.GetIndex();
+			}
+		}
+		Remove(Oldest);
+	}
+
+	if (Texts.Num() >= static_cast<int32>(POClaudeMemory::DocMask))
+	{
+		Compact();
+	}
+
+	AddDocument(Fact, Terms, TermSetHash, NextSerial++);
+
+	const int32 NumDead = Texts.Num() - NumAlive;
+	if (NumDead >= POClaudeMemory::MinTombstonesToCompact && NumDead * 4 > NumAlive)
+	{
+		Compact();
+	}
+	return true;
+}
+
+int32 FPOClaudeMemoryIndex::AddDocument(const FString& Fact, TArray<uint32>& SortedTerms, uint64 TermSetHash, uint32 Serial)
+{
+	const int32 Doc = Texts.Num();
+
+	Texts.Add(Fact);
+	Lengths.Add(static_cast<uint16>(FMath::Min(SortedTerms.Num(), static_cast<int32>(MAX_uint16))));
+	TokenCosts.Add(static_cast<uint16>(FMath::Min(POClaudeTokenEstimator::Estimate(Fact) + 2, static_cast<int32>(MAX_uint16))));
+	Serials.Add(Serial);
+	Alive.Add(true);
+	TermSetHashes.Add(TermSetHash);
+	TermSetIndex.Add(TermSetHash, Doc);
+
+	// 정렬된 용어를 묶어 용어별 빈도로 포스팅 추가
+	for (int32 i = 0; i < SortedTerms.Num();)
+	{
+		int32 End = i + 1;
+		while (End < SortedTerms.Num() && SortedTerms[End] == SortedTerms[i])
+		{
+			++End;
+		}
+
+		const uint32 Freq = static_cast<uint32>(FMath::Min(End - i, 255));
+		Postings.FindOrAdd(SortedTerms[i]).Add(static_cast<uint32>(Doc) | (Freq << POClaudeMemory::FreqShift));
+		i = End;
+	}
+
+	++NumAlive;
+	TotalAliveLength += Lengths[Doc];
+	return Doc;
+}
+
+void FPOClaudeMemoryIndex::Remove(int32 Doc)
+{
+	if (!Alive.IsValidIndex(Doc) || !Alive[Doc])
+	{
+		return;
+	}
+
+	Alive[Doc] = false;
+	--NumAlive;
+	TotalAliveLength -= Lengths[Doc];
+	TermSetIndex.Remove(TermSetHashes[Doc]);
+}
+
+void FPOClaudeMemoryIndex::Compact()
+{
+	if (NumAlive == Texts.Num())
+	{
+		return;
+	}
+
+	TArray<FString> OldTexts = MoveTemp(Texts);
+	TArray<uint32> OldSerials = MoveTemp(Serials);
+	TArray<uint64> OldHashes = MoveTemp(TermSetHashes);
+	TBitArray<> OldAlive = MoveTemp(Alive);
+
+	Texts.Reset();
+	Lengths.Reset();
+	TokenCosts.Reset();
+	Serials.Reset();
+	Alive.Reset();
+	TermSetHashes.Reset();
+	TermSetIndex.Reset();
+	Postings.Reset();
+	NumAlive = 0;
+	TotalAliveLength = 0;
+
+	TArray<uint32> Terms;
+	for (TConstSetBitIterator<> It(OldAlive); It; ++It)
+	{
+		const int32 OldDoc = It.GetIndex();
+		Tokenize(OldTexts[OldDoc], Terms);
+		Terms.Sort();
+		AddDocument(OldTexts[OldDoc], Terms, OldHashes[OldDoc], OldSerials[OldDoc]);
+	}
+
+	for (TPair<uint32, TArray<uint32>>& Pair : Postings)
+	{
+		Pair.Value.Shrink();
+	}
+	Postings.Shrink();
+}
+
+int32 FPOClaudeMemoryIndex::Retrieve(const FString& Query, int32 TopK, int32 TokenBudget, TArray<const FString*>& OutFacts) const
+{
+	using namespace POClaudeMemory;
+
+	OutFacts.Reset();
+	if (NumAlive == 0 || TopK <= 0 || TokenBudget <= 0)
+	{
+		return 0;
+	}
+
+	Tokenize(Query, QueryScratch);
+	QueryScratch.Sort();
+	QueryScratch.SetNum(Algo::Unique(QueryScratch));
+
+	if (ScoreScratch.Num() < Texts.Num())
+	{
+		ScoreScratch.SetNumZeroed(Texts.Num());
+	}
+	TouchedScratch.Reset();
+
+	const float NumDocs = static_cast<float>(NumAlive);
+	const float AverageLength = static_cast<float>(TotalAliveLength) / NumAlive;
+
+	for (const uint32 Term : QueryScratch)
+	{
+		const TArray<uint32>* List = Postings.Find(Term);
+		if (!List)
+		{
+			continue;
+		}
+
+		// 묘비를 포함한 문서 빈도 (재구성 전까지의 근사)
+		const float DocFreq = FMath::Min(static_cast<float>(List->Num()), NumDocs);
+		const float IDF = FMath::Loge(1.0f + (NumDocs - DocFreq + 0.5f) / (DocFreq + 0.5f));
+		if (IDF <= 0.0f)
+		{
+			continue;
+		}
+
+		for (const uint32 Posting : *List)
+		{
+			const int32 Doc = static_cast<int32>(Posting & DocMask);
+			if (!Alive[Doc])
+			{
+				continue;
+			}
+
+			const float Freq = static_cast<float>(Posting >> FreqShift);
+			const float Norm = K1 * (1.0f - B + B * Lengths[Doc] / AverageLength);
+
+			float& Score = ScoreScratch[Doc];
+			if (Score == 0.0f)
+			{
+				TouchedScratch.Add(Doc);
+			}
+			Score += IDF * Freq * (K1 + 1.0f) / (Freq + Norm);
+		}
+	}
+
+	// 상위 K개 (K가 작으므로 삽입 정렬, 동점이면 최근 사실 우선)
+	TArray<int32, TInlineAllocator<16>> Best;
+	for (const int32 Doc : TouchedScratch)
+	{
+		const float Score = ScoreScratch[Doc];
+		int32 Pos = Best.Num();
+		while (Pos > 0)
+		{
+			const int32 Other = Best[Pos - 1];
+			const float OtherScore = ScoreScratch[Other];
+			if (OtherScore > Score || (OtherScore == Score && Serials[Other] > Serials[Doc]))
+			{
+				break;
+			}
+			--Pos;
+		}
+
+		if (Pos < TopK)
+		{
+			Best.Insert(Doc, Pos);
+			if (Best.Num() > TopK)
+			{
+				Best.Pop(EAllowShrinking::No);
+			}
+		}
+	}
+
+	// 예산 안에 들어가는 것만 (큰 사실 하나가 예산을 넘으면 건너뛰고 다음 것을 시도)
+	int32 RemainingTokens = TokenBudget;
+	for (const int32 Doc : Best)
+	{
+		if (TokenCosts[Doc] <= RemainingTokens)
+		{
+			RemainingTokens -= TokenCosts[Doc];
+			OutFacts.Add(&Texts[Doc]);
+		}
+	}
+
+	for (const int32 Doc : TouchedScratch)
+	{
+		ScoreScratch[Doc] = 0.0f;
+	}
+	return OutFacts.Num();
+}
+
+int64 FPOClaudeMemoryIndex::GetMemoryUsage() const
+{
+	int64 Bytes = Texts.GetAllocatedSize() + Lengths.GetAllocatedSize() + TokenCosts.GetAllocatedSize()
+		+ Serials.GetAllocatedSize() + Alive.GetAllocatedSize() + TermSetHashes.GetAllocatedSize()
+		+ TermSetIndex.GetAllocatedSize() + Postings.GetAllocatedSize();
+
+	for (const FString& Text : Texts)
+	{
+		Bytes += Text.GetAllocatedSize();
+	}
+	for (const TPair<uint32, TArray<uint32>>& Pair : Postings)
+	{
+		Bytes += Pair.Value.GetAllocatedSize();
+	}
+	return Bytes;
+}
+
+void FPOClaudeMemoryIndex::Serialize(FArchive& Ar) const
+{
+	// Compact() 이후 호출 (묘비 없음)
+	check(NumAlive == Texts.Num());
+
+	uint32 Counts[3] = { static_cast<uint32>(Texts.Num()), static_cast<uint32>(Postings.Num()), NextSerial };
+	Ar.Serialize(Counts, sizeof(Counts));
+
+	for (int32 Doc = 0; Doc < Texts.Num(); ++Doc)
+	{
+		const FTCHARToUTF8 Utf8(*Texts[Doc]);
+
+		uint16 Length = Lengths[Doc];
+		uint16 TokenCost = TokenCosts[Doc];
+		uint32 Serial = Serials[Doc];
+		uint64 Hash = TermSetHashes[Doc];
+		uint32 TextBytes = static_cast<uint32>(Utf8.Length());
+
+		Ar.Serialize(&Length, sizeof(Length));
+		Ar.Serialize(&TokenCost, sizeof(TokenCost));
+		Ar.Serialize(&Serial, sizeof(Serial));
+		Ar.Serialize(&Hash, sizeof(Hash));
+		Ar.Serialize(&TextBytes, sizeof(TextBytes));
+		Ar.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), TextBytes);
+	}
+
+	for (const TPair<uint32, TArray<uint32>>& Pair : Postings)
+	{
+		uint32 Entry[2] = { Pair.Key, static_cast<uint32>(Pair.Value.Num()) };
+		Ar.Serialize(Entry, sizeof(Entry));
+		Ar.Serialize(const_cast<uint32*>(Pair.Value.GetData()), Pair.Value.Num() * sizeof(uint32));
+	}
+}
+
+bool FPOClaudeMemoryIndex::Deserialize(const uint8* Data, int64 Size, int64& Cursor)
+{
+	auto Read = [Data, Size, &Cursor](void* Dest, int64 Bytes)
+	{
+		if (Bytes < 0 || Cursor + Bytes > Size)
+		{
+			return false;
+		}
+		FMemory::Memcpy(Dest, Data + Cursor, Bytes);
+		Cursor += Bytes;
+		return true;
+	};
+
+	// 문서 하나의 최소 크기 (Length, TokenCost, Serial, Hash, TextBytes) / 포스팅 목록 하나의 최소 크기 (Term, Num)
+	constexpr int64 MinDocBytes     = sizeof(uint16) * 2 + sizeof(uint32) + sizeof(uint64) + sizeof(uint32);
+	constexpr int64 MinPostingBytes = sizeof(uint32) * 2;
+
+	// 개수는 할당 전에 남은 바이트로 검증 (손상된 레코드가 거대한 Reserve 를 일으키지 않도록)
+	uint32 Counts[3] = { 0, 0, 0 };
+	if (!Read(Counts, sizeof(Counts)) || Counts[0] > POClaudeMemory::DocMask
+		|| static_cast<int64>(Counts[0]) * MinDocBytes > Size - Cursor)
+	{
+		return false;
+	}
+
+	const int32 NumDocs = static_cast<int32>(Counts[0]);
+	Texts.Reserve(NumDocs);
+	for (int32 Doc = 0; Doc < NumDocs; ++Doc)
+	{
+		uint16 Length = 0;
+		uint16 TokenCost = 0;
+		uint32 Serial = 0;
+		uint64 Hash = 0;
+		uint32 TextBytes = 0;
+		if (!Read(&Length, sizeof(Length)) || !Read(&TokenCost, sizeof(TokenCost)) || !Read(&Serial, sizeof(Serial))
+			|| !Read(&Hash, sizeof(Hash)) || !Read(&TextBytes, sizeof(TextBytes)) || Cursor + TextBytes > Size)
+		{
+			return false;
+		}
+
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data + Cursor), TextBytes);
+		Cursor += TextBytes;
+
+		Texts.Emplace(Converter.Length(), Converter.Get());
+		Lengths.Add(Length);
+		TokenCosts.Add(TokenCost);
+		Serials.Add(Serial);
+		Alive.Add(true);
+		TermSetHashes.Add(Hash);
+		TermSetIndex.Add(Hash, Doc);
+		TotalAliveLength += Length;
+	}
+	NumAlive = NumDocs;
+	NextSerial = Counts[2];
+
+	if (static_cast<int64>(Counts[1]) * MinPostingBytes > Size - Cursor)
+	{
+		return false;
+	}
+
+	Postings.Reserve(Counts[1]);
+	for (uint32 i = 0; i < Counts[1]; ++i)
+	{
+		uint32 Entry[2] = { 0, 0 };
+		if (!Read(Entry, sizeof(Entry)) || static_cast<int64>(Entry[1]) * sizeof(uint32) > Size - Cursor)
+		{
+			return false;
+		}
+
+		TArray<uint32>& List = Postings.Add(Entry[0]);
+		List.SetNumUninitialized(Entry[1]);
+		if (!Read(List.GetData(), static_cast<int64>(Entry[1]) * sizeof(uint32)))
+		{
+			return false;
+		}
+
+		for (const uint32 Posting : List)
+		{
+			if (static_cast<int32>(Posting & POClaudeMemory::DocMask) >= NumDocs)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void FPOClaudeMemoryStore::Configure(int32 InMaxFactsPerNPC)
+{
+	MaxFactsPerNPC = FMath::Max(1, InMaxFactsPerNPC);
+}
+
+void FPOClaudeMemoryStore::ExtractFacts(const FString& PlayerMessage, TArray<FString>& OutFacts)
+{
+	using namespace POClaudeMemory;
+
+	const int32 Len = PlayerMessage.Len();
+	int32 SentenceStart = 0;
+
+	for (int32 i = 0; i <= Len; ++i)
+	{
+		const TCHAR C = i < Len ? PlayerMessage[i] : TEXT('\n');
+		const bool bEnd = C == TEXT('.') || C == TEXT('!') || C == TEXT('?') || C == TEXT('\n') || C == TEXT('~') || C == TEXT('…');
+		if (!bEnd)
+		{
+			continue;
+		}
+
+		const FString Sentence = PlayerMessage.Mid(SentenceStart, i - SentenceStart).TrimStartAndEnd();
+		SentenceStart = i + 1;
+
+		if (C == TEXT('?') || Sentence.Len() < MinFactChars || Sentence.Len() > MaxFactChars)
+		{
+			continue;
+		}
+
+		bool bQuestion = false;
+		for (const TCHAR* Word : QuestionWords)
+		{
+			if (Sentence.Contains(Word))
+			{
+				bQuestion = true;
+				break;
+			}
+		}
+		if (bQuestion)
+		{
+			continue;
+		}
+
+		// 1인칭 표지가 띄어쓰기 단위로 있어야 플레이어 자신에 대한 진술로 봄
+		TArray<FString> Words;
+		Sentence.ParseIntoArrayWS(Words);
+
+		bool bFirstPerson = false;
+		for (const FString& Word : Words)
+		{
+			for (const TCHAR* Marker : FirstPersonWords)
+			{
+				if (Word.Equals(Marker))
+				{
+					bFirstPerson = true;
+					break;
+				}
+			}
+			if (bFirstPerson)
+			{
+				break;
+			}
+		}
+
+		if (bFirstPerson)
+		{
+			OutFacts.Add(Sentence);
+		}
+	}
+}
+
+int32 FPOClaudeMemoryStore::RememberExchange(uint64 NPCKey, const FString& PlayerMessage)
+{
+	TArray<FString> Facts;
+	ExtractFacts(PlayerMessage, Facts);
+
+	int32 NumAdded = 0;
+	for (const FString& Fact : Facts)
+	{
+		NumAdded += AddFact(NPCKey, Fact) ? 1 : 0;
+	}
+	return NumAdded;
+}
+
+bool FPOClaudeMemoryStore::AddFact(uint64 NPCKey, const FString& Fact)
+{
+	return Indices.FindOrAdd(NPCKey).Add(Fact, MaxFactsPerNPC);
+}
+
+int32 FPOClaudeMemoryStore::Retrieve(uint64 NPCKey, const FString& Query, int32 TopK, int32 TokenBudget, TArray<const FString*>& OutFacts) const
+{
+	const FPOClaudeMemoryIndex* Index = Indices.Find(NPCKey);
+	if (!Index)
+	{
+		OutFacts.Reset();
+		return 0;
+	}
+	return Index->Retrieve(Query, TopK, TokenBudget, OutFacts);
+}
+
+bool FPOClaudeMemoryStore::HasFacts(uint64 NPCKey) const
+{
+	const FPOClaudeMemoryIndex* Index = Indices.Find(NPCKey);
+	return Index && Index->Num() > 0;
+}
+
+int32 FPOClaudeMemoryStore::GetNumFacts() const
+{
+	int32 Total = 0;
+	for (const TPair<uint64, FPOClaudeMemoryIndex>& Pair : Indices)
+	{
+		Total += Pair.Value.Num();
+	}
+	return Total;
+}
+
+int64 FPOClaudeMemoryStore::GetMemoryUsage() const
+{
+	int64 Bytes = Indices.GetAllocatedSize();
+	for (const TPair<uint64, FPOClaudeMemoryIndex>& Pair : Indices)
+	{
+		Bytes += Pair.Value.GetMemoryUsage();
+	}
+	return Bytes;
+}
+
+bool FPOClaudeMemoryStore::LoadFromDisk(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	uint32 Header[3] = { 0, 0, 0 };
+	if (Bytes.Num() < static_cast<int32>(sizeof(Header)))
+	{
+		return false;
+	}
+	FMemory::Memcpy(Header, Bytes.GetData(), sizeof(Header));
+
+	if (Header[0] != FileMagic || Header[1] != FileVersion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeMemoryStore] 기억 파일 형식이 맞지 않아 무시합니다: %s"), *FilePath);
+		return false;
+	}
+
+	Indices.Reset();
+	int64 Cursor = sizeof(Header);
+	for (uint32 i = 0; i < Header[2]; ++i)
+	{
+		uint64 Key = 0;
+		if (Cursor + static_cast<int64>(sizeof(Key)) > Bytes.Num())
+		{
+			break;
+		}
+		FMemory::Memcpy(&Key, Bytes.GetData() + Cursor, sizeof(Key));
+		Cursor += sizeof(Key);
+
+		FPOClaudeMemoryIndex Index;
+		if (!Index.Deserialize(Bytes.GetData(), Bytes.Num(), Cursor))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[ClaudeMemoryStore] 손상된 레코드 이후는 무시합니다. (%u/%u)"), i, Header[2]);
+			break;
+		}
+		Indices.Add(Key, MoveTemp(Index));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ClaudeMemoryStore] 기억 로딩: NPC %d, 사실 %d (%lld bytes)"),
+		Indices.Num(), GetNumFacts(), GetMemoryUsage());
+	return true;
+}
+
+bool FPOClaudeMemoryStore::SaveToDisk(const FString& FilePath)
+{
+	const FString TempPath = FilePath + TEXT(".tmp");
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeMemoryStore] 기억 파일을 쓸 수 없습니다: %s"), *TempPath);
+		return false;
+	}
+
+	uint32 NumIndices = 0;
+	for (TPair<uint64, FPOClaudeMemoryIndex>& Pair : Indices)
+	{
+		Pair.Value.Compact();
+		NumIndices += Pair.Value.Num() > 0 ? 1 : 0;
+	}
+
+	uint32 Header[3] = { FileMagic, FileVersion, NumIndices };
+	Writer->Serialize(Header, sizeof(Header));
+
+	for (const TPair<uint64, FPOClaudeMemoryIndex>& Pair : Indices)
+	{
+		if (Pair.Value.Num() == 0)
+		{
+			continue;
+		}
+
+		uint64 Key = Pair.Key;
+		Writer->Serialize(&Key, sizeof(Key));
+		Pair.Value.Serialize(*Writer);
+	}
+
+	const bool bWriteOk = Writer->Close();
+	Writer.Reset();
+
+	if (!bWriteOk || !IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeMemoryStore] 기억 파일 저장 실패: %s"), *FilePath);
+		IFileManager::Get().Delete(*TempPath);
+		return false;
+	}
+	return true;
+}
+
+#if !UE_BUILD_SHIPPING
+
+#include "HAL/IConsoleManager.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace POClaudeMemoryStoreBench
+{
+	static void Run(const TArray<FString>& Args)
+	{
+		const int32 NumFacts = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 5000;
+		const int32 NumQueries = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1000;
+
+		static const TCHAR* const Subjects[] = { TEXT("나는"), TEXT("저는"), TEXT("내가"), TEXT("제가"), TEXT("우리는") };
+		static const TCHAR* const Objects[] = {
+			TEXT("사과"), TEXT("검술"), TEXT("낚시"), TEXT("북쪽 마을"), TEXT("대장간"), TEXT("여동생"), TEXT("고양이"), TEXT("등산"),
+			TEXT("마법서"), TEXT("항구"), TEXT("빵집"), TEXT("사냥"), TEXT("노래"), TEXT("별자리"), TEXT("약초"), TEXT("용병단")
+		};
+		static const TCHAR* const Predicates[] = {
+			TEXT("을 정말 좋아해요"), TEXT("에서 자랐어요"), TEXT("을 배우고 있어요"), TEXT("이 싫어요"), TEXT("에 가 볼 생각이에요")
+		};
+
+		FRandomStream Random(1234);
+		auto MakeSentence = [&Random](int32 Serial)
+		{
+			return FString::Printf(TEXT("%s %s%s %d"),
+				Subjects[Random.RandHelper(static_cast<int32>(UE_ARRAY_COUNT(Subjects)))],
+				Objects[Random.RandHelper(static_cast<int32>(UE_ARRAY_COUNT(Objects)))],
+				Predicates[Random.RandHelper(static_cast<int32>(UE_ARRAY_COUNT(Predicates)))],
+				Serial);
+		};
+
+		TArray<FString> Facts;
+		Facts.Reserve(NumFacts);
+		for (int32 i = 0; i < NumFacts; ++i)
+		{
+			Facts.Add(MakeSentence(i));
+		}
+
+		TArray<FString> Queries;
+		Queries.Reserve(NumQueries);
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			Queries.Add(FString::Printf(TEXT("%s 얘기 좀 해 줄래요?"), Objects[Random.RandHelper(static_cast<int32>(UE_ARRAY_COUNT(Objects)))]));
+		}
+
+		FPOClaudeMemoryIndex Index;
+
+		double Start = FPlatformTime::Seconds();
+		for (const FString& Fact : Facts)
+		{
+			Index.Add(Fact, NumFacts);
+		}
+		const double AddSeconds = FPlatformTime::Seconds() - Start;
+
+		TArray<const FString*> Found;
+		int64 NumFound = 0;
+
+		Start = FPlatformTime::Seconds();
+		for (const FString& Query : Queries)
+		{
+			NumFound += Index.Retrieve(Query, 4, 120, Found);
+		}
+		const double RetrieveSeconds = FPlatformTime::Seconds() - Start;
+
+		Index.Compact();
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		Index.Serialize(Writer);
+
+		FPOClaudeMemoryIndex Loaded;
+		int64 Cursor = 0;
+		Start = FPlatformTime::Seconds();
+		const bool bLoaded = Loaded.Deserialize(Bytes.GetData(), Bytes.Num(), Cursor);
+		const double LoadSeconds = FPlatformTime::Seconds() - Start;
+
+		UE_LOG(LogTemp, Display,
+			TEXT("[ClaudeMemoryStore] 사실 %d개: 추가 %.2f us/개, 검색 %.2f us/회 (평균 %.1f개 반환), 색인 %lld bytes, 파일 %d bytes, 로딩 %.2f ms (%s)"),
+			Index.Num(),
+			AddSeconds * 1e6 / NumFacts,
+			RetrieveSeconds * 1e6 / NumQueries,
+			static_cast<double>(NumFound) / NumQueries,
+			Index.GetMemoryUsage(), Bytes.Num(),
+			LoadSeconds * 1e3,
+			bLoaded && Loaded.Num() == Index.Num() ? TEXT("일치") : TEXT("불일치"));
+	}
+}
+
+static FAutoConsoleCommand GPOClaudeBenchMemoryCmd(
+	TEXT("Claude.BenchMemory"),
+	TEXT("NPC 기억 색인 추가/검색/직렬화 마이크로벤치마크. 인자: [사실 수] [검색 수]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&POClaudeMemoryStoreBench::Run));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * NPC 한 명의 장기 기억 (플레이어에 대한 짧은 사실 목록 + 역색인)
+ * 용어 = 정규화한 단어 안의 글자 바이그램 (한 글자 단어는 유니그램). 조사가 붙어도 어간 바이그램이 겹쳐 맞는다.
+ * 역색인은 용어 → 포스팅(문서 번호 24비트 | 빈도 8비트) 배열이며, 검색은 BM25 점수 상위 K개.
+ * 지운 사실은 묘비로 두었다가 일정 비율을 넘으면 살아 있는 사실만으로 다시 만든다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeMemoryIndex
+{
+public:
+	// 사실 추가 (같은 용어 구성의 이전 사실은 새 것으로 대체, 가득 차면 가장 오래된 것 제거). 색인할 용어가 없으면 false
+	bool Add(const FString& Fact, int32 MaxFacts);
+
+	// Query와 관련도 상위 TopK개 중 토큰 예산 안에 들어가는 사실 (관련도 순). 반환값 = 고른 수
+	int32 Retrieve(const FString& Query, int32 TopK, int32 TokenBudget, TArray<const FString*>& OutFacts) const;
+
+	int32 Num() const { return NumAlive; }
+
+	// 대략적인 메모리 사용량 (바이트)
+	int64 GetMemoryUsage() const;
+
+	// 묘비를 걷어 내고 살아 있는 사실만으로 색인 재구성
+	void Compact();
+
+	void Serialize(FArchive& Ar) const;
+	bool Deserialize(const uint8* Data, int64 Size, int64& Cursor);
+
+	// 단어 안 글자 바이그램 (소문자화, 한글/영숫자 외 문자는 구분자)
+	static void Tokenize(const FString& Text, TArray<uint32>& OutTerms);
+
+private:
+	// 사실마다 한 칸 (번호 = 문서 번호)
+	TArray<FString> Texts;
+	TArray<uint16> Lengths;
+	TArray<uint16> TokenCosts;
+	TArray<uint32> Serials;
+	TBitArray<> Alive;
+
+	TMap<uint32, TArray<uint32>> Postings;
+
+	// 용어 구성 해시 → 문서 번호 (같은 사실 재진술 대체용)
+	TMap<uint64, int32> TermSetIndex;
+	TArray<uint64> TermSetHashes;
+
+	int32 NumAlive = 0;
+	int64 TotalAliveLength = 0;
+	uint32 NextSerial = 1;
+
+	// 검색용 재사용 버퍼 (게임 스레드 전용)
+	mutable TArray<float> ScoreScratch;
+	mutable TArray<int32> TouchedScratch;
+	mutable TArray<uint32> QueryScratch;
+
+	int32 AddDocument(const FString& Fact, TArray<uint32>& Terms, uint64 TermSetHash, uint32 Serial);
+	void Remove(int32 Doc);
+
+	static uint64 HashTermSet(const TArray<uint32>& SortedTerms);
+};
+
+/**
+ * 모든 NPC의 장기 기억 저장소 (NPC 아키타입 키별 FPOClaudeMemoryIndex)
+ * 대화 턴이 끝날 때 플레이어 메시지에서 자기 소개/취향/계획 같은 1인칭 진술을 사실로 뽑아 저장하고,
+ * 요청마다 플레이어 메시지와 관련된 사실을 토큰 예산 안에서 골라 동적 시스템 블록에 넣는다.
+ * Saved/Claude/Memory.bin에 색인째 저장해 다음 세션에서 토큰화 없이 바로 쓴다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeMemoryStore
+{
+public:
+	void Configure(int32 InMaxFactsPerNPC);
+
+	// 대화 한 턴의 플레이어 메시지에서 사실을 뽑아 저장. 저장한 수 반환
+	int32 RememberExchange(uint64 NPCKey, const FString& PlayerMessage);
+
+	bool AddFact(uint64 NPCKey, const FString& Fact);
+
+	int32 Retrieve(uint64 NPCKey, const FString& Query, int32 TopK, int32 TokenBudget, TArray<const FString*>& OutFacts) const;
+
+	bool HasFacts(uint64 NPCKey) const;
+
+	// 플레이어 메시지에서 기억할 만한 1인칭 평서문 추출
+	static void ExtractFacts(const FString& PlayerMessage, TArray<FString>& OutFacts);
+
+	bool LoadFromDisk(const FString& FilePath);
+	bool SaveToDisk(const FString& FilePath);
+
+	int32 GetNumNPCs() const { return Indices.Num(); }
+	int32 GetNumFacts() const;
+	int64 GetMemoryUsage() const;
+
+private:
+	static constexpr uint32 FileMagic = 0x4D4D4F50; // 'POMM'
+	static constexpr uint32 FileVersion = 1;
+
+	TMap<uint64, FPOClaudeMemoryIndex> Indices;
+
+	int32 MaxFactsPerNPC = 4096;
+};
@@ -0,0 +1,373 @@
+#include "POClaudeMetrics.h"
+#include "POClaudeTypes.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DEFINE_STAT(STAT_ClaudeEnqueue);
+DEFINE_STAT(STAT_ClaudeDispatch);
+DEFINE_STAT(STAT_ClaudeComplete);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued"), STAT_ClaudeQueued, STATGROUP_Claude);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("In flight"), STAT_ClaudeInFlight, STATGROUP_Claude);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Requests"), STAT_ClaudeRequests, STATGROUP_Claude);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Succeeded"), STAT_ClaudeSucceeded, STATGROUP_Claude);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Errors"), STAT_ClaudeErrors, STATGROUP_Claude);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Errors: rate limited (429)"), STAT_ClaudeErrorsRateLimited, STATGROUP_Claude);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Errors: network/timeout"), STAT_ClaudeErrorsNetwork, STATGROUP_Claude);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Input tokens"), STAT_ClaudeInputTokens, STATGROUP_Claude);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Output tokens"), STAT_ClaudeOutputTokens, STATGROUP_Claude);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cache read tokens"), STAT_ClaudeCacheReadTokens, STATGROUP_Claude);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Queue wait p50 (ms)"), STAT_ClaudeQueueWaitP50, STATGROUP_Claude);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Queue wait p95 (ms)"), STAT_ClaudeQueueWaitP95, STATGROUP_Claude);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Connect p95 (ms)"), STAT_ClaudeConnectP95, STATGROUP_Claude);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("First byte p50 (ms)"), STAT_ClaudeFirstByteP50, STATGROUP_Claude);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("First byte p95 (ms)"), STAT_ClaudeFirstByteP95, STATGROUP_Claude);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Total p50 (ms)"), STAT_ClaudeTotalP50, STATGROUP_Claude);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Total p95 (ms)"), STAT_ClaudeTotalP95, STATGROUP_Claude);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Total p99 (ms)"), STAT_ClaudeTotalP99, STATGROUP_Claude);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Parse p95 (ms)"), STAT_ClaudeParseP95, STATGROUP_Claude);
+
+CSV_DEFINE_CATEGORY(Claude, true);
+
+TRACE_DECLARE_INT_COUNTER(ClaudeQueued, TEXT("Claude/Queued"));
+TRACE_DECLARE_INT_COUNTER(ClaudeInFlight, TEXT("Claude/InFlight"));
+
+namespace POClaudeMetrics
+{
+	// 백분위 재계산 주기 (버킷 1024개 × 히스토그램 5개를 매 프레임 훑지 않도록)
+	constexpr double PercentileInterval = 0.25;
+
+	static float ToMs(double Seconds)
+	{
+		return static_cast<float>(Seconds * 1000.0);
+	}
+
+	static void AtomicMax(std::atomic<uint64>& Target, uint64 Value)
+	{
+		uint64 Current = Target.load(std::memory_order_relaxed);
+		while (Value > Current && !Target.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+		{
+		}
+	}
+}
+
+int32 FPOClaudeHdrHistogram::GetBucket(uint64 Micros)
+{
+	Micros = FMath::Min<uint64>(Micros, (uint64(1) << MaxValueBits) - 1);
+	if (Micros < static_cast<uint64>(SubBucketCount))
+	{
+		return static_cast<int32>(Micros);
+	}
+
+	// 최상위 SubBucketBits 비트만 남겨 [Half, Count) 구간의 하위 버킷 번호로
+	const int32 Shift = static_cast<int32>(FPlatformMath::FloorLog2_64(Micros)) - (SubBucketBits - 1);
+	const int32 SubBucket = static_cast<int32>(Micros >> Shift) - SubBucketHalfCount;
+	return SubBucketCount + (Shift - 1) * SubBucketHalfCount + SubBucket;
+}
+
+uint64 FPOClaudeHdrHistogram::GetBucketUpperBound(int32 Bucket)
+{
+	if (Bucket < SubBucketCount)
+	{
+		return static_cast<uint64>(Bucket);
+	}
+
+	const int32 Offset = Bucket - SubBucketCount;
+	const int32 Shift = Offset / SubBucketHalfCount + 1;
+	const uint64 SubBucket = static_cast<uint64>(Offset % SubBucketHalfCount + SubBucketHalfCount);
+	return ((SubBucket + 1) << Shift) - 1;
+}
+
+void FPOClaudeHdrHistogram::Record(uint64 Micros)
+{
+	Counts[GetBucket(Micros)].fetch_add(1, std::memory_order_relaxed);
+	SumMicros.fetch_add(Micros, std::memory_order_relaxed);
+	POClaudeMetrics::AtomicMax(MaxMicros, Micros);
+}
+
+uint64 FPOClaudeHdrHistogram::GetCount() const
+{
+	uint64 Count = 0;
+	for (const std::atomic<uint32>& Bucket : Counts)
+	{
+		Count += Bucket.load(std::memory_order_relaxed);
+	}
+	return Count;
+}
+
+double FPOClaudeHdrHistogram::GetPercentileSeconds(double Percentile) const
+{
+	// 기록과 동시에 읽어도 되도록 한 번 복사한 값으로 계산
+	uint32 Snapshot[NumBuckets];
+	uint64 Count = 0;
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		Snapshot[i] = Counts[i].load(std::memory_order_relaxed);
+		Count += Snapshot[i];
+	}
+
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(Percentile * Count)));
+	uint64 Cumulative = 0;
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		Cumulative += Snapshot[i];
+		if (Cumulative >= Rank)
+		{
+			return GetBucketUpperBound(i) * 1e-6;
+		}
+	}
+	return GetBucketUpperBound(NumBuckets - 1) * 1e-6;
+}
+
+double FPOClaudeHdrHistogram::GetMeanSeconds() const
+{
+	const uint64 Count = GetCount();
+	return Count > 0 ? SumMicros.load(std::memory_order_relaxed) * 1e-6 / Count : 0.0;
+}
+
+void FPOClaudeHdrHistogram::Reset()
+{
+	for (std::atomic<uint32>& Bucket : Counts)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+	SumMicros.store(0, std::memory_order_relaxed);
+	MaxMicros.store(0, std::memory_order_relaxed);
+}
+
+FPOClaudeMetrics& FPOClaudeMetrics::Get()
+{
+	static FPOClaudeMetrics Instance;
+	return Instance;
+}
+
+void FPOClaudeMetrics::RecordError(EPOClaudeErrorKind Kind)
+{
+	Errors[static_cast<int32>(Kind)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void FPOClaudeMetrics::RecordUsage(const FClaudeUsage& Usage)
+{
+	InputTokens.fetch_add(Usage.InputTokens, std::memory_order_relaxed);
+	OutputTokens.fetch_add(Usage.OutputTokens, std::memory_order_relaxed);
+	CacheReadInputTokens.fetch_add(Usage.CacheReadInputTokens, std::memory_order_relaxed);
+	CacheCreationInputTokens.fetch_add(Usage.CacheCreationInputTokens, std::memory_order_relaxed);
+}
+
+EPOClaudeErrorKind FPOClaudeMetrics::ClassifyStatus(int32 StatusCode)
+{
+	if (StatusCode == 0)
+	{
+		return EPOClaudeErrorKind::Network;
+	}
+	if (StatusCode == 429)
+	{
+		return EPOClaudeErrorKind::RateLimited;
+	}
+	if (StatusCode == 529)
+	{
+		return EPOClaudeErrorKind::Overloaded;
+	}
+	if (StatusCode >= 500)
+	{
+		return EPOClaudeErrorKind::ServerError;
+	}
+	if (StatusCode >= 400)
+	{
+		return EPOClaudeErrorKind::ClientError;
+	}
+
+	// 200인데 실패 = 본문/스트림을 읽지 못함
+	return EPOClaudeErrorKind::Parse;
+}
+
+const TCHAR* FPOClaudeMetrics::GetErrorKindName(EPOClaudeErrorKind Kind)
+{
+	switch (Kind)
+	{
+	case EPOClaudeErrorKind::Network:      return TEXT("네트워크");
+	case EPOClaudeErrorKind::Timeout:      return TEXT("기한 초과");
+	case EPOClaudeErrorKind::RateLimited:  return TEXT("429");
+	case EPOClaudeErrorKind::Overloaded:   return TEXT("529");
+	case EPOClaudeErrorKind::ServerError:  return TEXT("5xx");
+	case EPOClaudeErrorKind::ClientError:  return TEXT("4xx");
+	case EPOClaudeErrorKind::Parse:        return TEXT("응답 형식");
+	case EPOClaudeErrorKind::LocalBackend: return TEXT("로컬 모델");
+	default:                               return TEXT("?");
+	}
+}
+
+int64 FPOClaudeMetrics::GetNumErrors() const
+{
+	int64 Total = 0;
+	for (const std::atomic<int64>& Count : Errors)
+	{
+		Total += Count.load(std::memory_order_relaxed);
+	}
+	return Total;
+}
+
+void FPOClaudeMetrics::Publish(int32 NumQueued, int32 NumInFlight)
+{
+	using POClaudeMetrics::ToMs;
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastPercentileTime >= POClaudeMetrics::PercentileInterval)
+	{
+		LastPercentileTime = Now;
+		Published.QueueWaitP50 = ToMs(QueueWait.GetPercentileSeconds(0.50));
+		Published.QueueWaitP95 = ToMs(QueueWait.GetPercentileSeconds(0.95));
+		Published.ConnectP95   = ToMs(Connect.GetPercentileSeconds(0.95));
+		Published.FirstByteP50 = ToMs(FirstByte.GetPercentileSeconds(0.50));
+		Published.FirstByteP95 = ToMs(FirstByte.GetPercentileSeconds(0.95));
+		Published.TotalP50     = ToMs(Total.GetPercentileSeconds(0.50));
+		Published.TotalP95     = ToMs(Total.GetPercentileSeconds(0.95));
+		Published.TotalP99     = ToMs(Total.GetPercentileSeconds(0.99));
+		Published.ParseP95     = ToMs(Parse.GetPercentileSeconds(0.95));
+	}
+
+	const int64 Requests = NumRequests.load(std::memory_order_relaxed);
+	const int64 NumErrors = GetNumErrors();
+	const int64 Output = OutputTokens.load(std::memory_order_relaxed);
+
+	SET_DWORD_STAT(STAT_ClaudeQueued, NumQueued);
+	SET_DWORD_STAT(STAT_ClaudeInFlight, NumInFlight);
+	SET_DWORD_STAT(STAT_ClaudeRequests, Requests);
+	SET_DWORD_STAT(STAT_ClaudeSucceeded, NumSucceeded.load(std::memory_order_relaxed));
+	SET_DWORD_STAT(STAT_ClaudeErrors, NumErrors);
+	SET_DWORD_STAT(STAT_ClaudeErrorsRateLimited, Errors[static_cast<int32>(EPOClaudeErrorKind::RateLimited)].load(std::memory_order_relaxed));
+	SET_DWORD_STAT(STAT_ClaudeErrorsNetwork,
+		Errors[static_cast<int32>(EPOClaudeErrorKind::Network)].load(std::memory_order_relaxed)
+		+ Errors[static_cast<int32>(EPOClaudeErrorKind::Timeout)].load(std::memory_order_relaxed));
+	SET_DWORD_STAT(STAT_ClaudeInputTokens, InputTokens.load(std::memory_order_relaxed));
+	SET_DWORD_STAT(STAT_ClaudeOutputTokens, Output);
+	SET_DWORD_STAT(STAT_ClaudeCacheReadTokens, CacheReadInputTokens.load(std::memory_order_relaxed));
+	SET_FLOAT_STAT(STAT_ClaudeQueueWaitP50, Published.QueueWaitP50);
+	SET_FLOAT_STAT(STAT_ClaudeQueueWaitP95, Published.QueueWaitP95);
+	SET_FLOAT_STAT(STAT_ClaudeConnectP95, Published.ConnectP95);
+	SET_FLOAT_STAT(STAT_ClaudeFirstByteP50, Published.FirstByteP50);
+	SET_FLOAT_STAT(STAT_ClaudeFirstByteP95, Published.FirstByteP95);
+	SET_FLOAT_STAT(STAT_ClaudeTotalP50, Published.TotalP50);
+	SET_FLOAT_STAT(STAT_ClaudeTotalP95, Published.TotalP95);
+	SET_FLOAT_STAT(STAT_ClaudeTotalP99, Published.TotalP99);
+	SET_FLOAT_STAT(STAT_ClaudeParseP95, Published.ParseP95);
+
+	// CSV: 상태는 현재값, 누적값은 프레임 사이 증가분
+	CSV_CUSTOM_STAT(Claude, Queued, NumQueued, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Claude, InFlight, NumInFlight, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Claude, Requests, static_cast<int32>(Requests - LastRequests), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Claude, Errors, static_cast<int32>(NumErrors - LastErrors), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Claude, OutputTokens, static_cast<int32>(Output - LastOutputTokens), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Claude, FirstByteP95Ms, Published.FirstByteP95, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Claude, TotalP95Ms, Published.TotalP95, ECsvCustomStatOp::Set);
+
+	LastRequests = Requests;
+	LastErrors = NumErrors;
+	LastOutputTokens = Output;
+
+	// Insights 타이밍 뷰에서 프레임과 나란히 보이도록
+	TRACE_COUNTER_SET(ClaudeQueued, NumQueued);
+	TRACE_COUNTER_SET(ClaudeInFlight, NumInFlight);
+}
+
+void FPOClaudeMetrics::Dump(FOutputDevice& Ar) const
+{
+	auto LogHistogram = [&Ar](const TCHAR* Label, const FPOClaudeHdrHistogram& Histogram)
+	{
+		const uint64 Count = Histogram.GetCount();
+		if (Count == 0)
+		{
+			return;
+		}
+
+		Ar.Logf(TEXT("[ClaudeMetrics] %-8s %llu건: 평균 %.0fms p50 %.0fms p90 %.0fms p95 %.0fms p99 %.0fms 최대 %.0fms"),
+			Label, Count,
+			Histogram.GetMeanSeconds() * 1000.0,
+			Histogram.GetPercentileSeconds(0.50) * 1000.0, Histogram.GetPercentileSeconds(0.90) * 1000.0,
+			Histogram.GetPercentileSeconds(0.95) * 1000.0, Histogram.GetPercentileSeconds(0.99) * 1000.0,
+			Histogram.GetMaxSeconds() * 1000.0);
+	};
+
+	Ar.Logf(TEXT("[ClaudeMetrics] 요청 %lld / 성공 %lld / 실패 %lld"),
+		NumRequests.load(std::memory_order_relaxed), NumSucceeded.load(std::memory_order_relaxed), GetNumErrors());
+
+	LogHistogram(TEXT("대기"), QueueWait);
+	LogHistogram(TEXT("연결"), Connect);
+	LogHistogram(TEXT("첫 바이트"), FirstByte);
+	LogHistogram(TEXT("전체"), Total);
+	LogHistogram(TEXT("파싱"), Parse);
+
+	FString ErrorLine;
+	for (int32 i = 0; i < static_cast<int32>(EPOClaudeErrorKind::Num); ++i)
+	{
+		const int64 Count = Errors[i].load(std::memory_order_relaxed);
+		if (Count > 0)
+		{
+			ErrorLine += FString::Printf(TEXT(" %s %lld"), GetErrorKindName(static_cast<EPOClaudeErrorKind>(i)), Count);
+		}
+	}
+	if (!ErrorLine.IsEmpty())
+	{
+		Ar.Logf(TEXT("[ClaudeMetrics] 실패 원인:%s"), *ErrorLine);
+	}
+
+	Ar.Logf(TEXT("[ClaudeMetrics] 토큰: 입력 %lld / 캐시 읽기 %lld / 캐시 기록 %lld / 출력 %lld"),
+		InputTokens.load(std::memory_order_relaxed), CacheReadInputTokens.load(std::memory_order_relaxed),
+		CacheCreationInputTokens.load(std::memory_order_relaxed), OutputTokens.load(std::memory_order_relaxed));
+}
+
+void FPOClaudeMetrics::Reset()
+{
+	QueueWait.Reset();
+	Connect.Reset();
+	FirstByte.Reset();
+	Total.Reset();
+	Parse.Reset();
+
+	NumRequests.store(0, std::memory_order_relaxed);
+	NumSucceeded.store(0, std::memory_order_relaxed);
+	for (std::atomic<int64>& Count : Errors)
+	{
+		Count.store(0, std::memory_order_relaxed);
+	}
+
+	InputTokens.store(0, std::memory_order_relaxed);
+	OutputTokens.store(0, std::memory_order_relaxed);
+	CacheReadInputTokens.store(0, std::memory_order_relaxed);
+	CacheCreationInputTokens.store(0, std::memory_order_relaxed);
+
+	LastRequests = 0;
+	LastErrors = 0;
+	LastOutputTokens = 0;
+	LastPercentileTime = 0.0;
+}
+
+#if !UE_BUILD_SHIPPING
+
+#include "HAL/IConsoleManager.h"
+
+namespace POClaudeMetricsCommands
+{
+	static void Dump(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		FPOClaudeMetrics::Get().Dump(Ar);
+
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("Reset"), ESearchCase::IgnoreCase))
+		{
+			FPOClaudeMetrics::Get().Reset();
+			Ar.Log(TEXT("[ClaudeMetrics] 지표 초기화"));
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPOClaudeMetricsCmd(
+	TEXT("Claude.Metrics"),
+	TEXT("대화 경로 지연 분포(대기/연결/첫 바이트/전체/파싱), 실패 원인, 토큰 누적 출력. 인자: [Reset]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&POClaudeMetricsCommands::Dump));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include <atomic>
+
+struct FClaudeUsage;
+
+DECLARE_STATS_GROUP(TEXT("Claude"), STATGROUP_Claude, STATCAT_Advanced);
+
+// 게임 스레드에서 쓰는 요청 처리 구간
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enqueue"), STAT_ClaudeEnqueue, STATGROUP_Claude, PROJECT_OPENWORLD_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dispatch"), STAT_ClaudeDispatch, STATGROUP_Claude, PROJECT_OPENWORLD_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Complete"), STAT_ClaudeComplete, STATGROUP_Claude, PROJECT_OPENWORLD_API);
+
+/**
+ * 잠금 없는 HDR 방식 히스토그램 (마이크로초 단위 값)
+ * 값의 최상위 비트 위치(2의 거듭제곱 구간)마다 선형 하위 버킷 32개를 두어 전 구간에서 상대 오차 약 3% 이내.
+ * 1us ~ 약 19시간을 버킷 1024개(4KB)로 덮으며, 기록은 원자적 증가 한 번이라 어느 스레드에서나 호출한다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeHdrHistogram
+{
+public:
+	static constexpr int32 SubBucketBits = 6;
+	static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+	static constexpr int32 SubBucketHalfCount = SubBucketCount / 2;
+	static constexpr int32 MaxValueBits = 36;
+	static constexpr int32 NumBuckets = SubBucketCount + (MaxValueBits - SubBucketBits) * SubBucketHalfCount;
+
+	void Record(uint64 Micros);
+	void RecordSeconds(double Seconds) { Record(Seconds > 0.0 ? static_cast<uint64>(Seconds * 1e6) : 0); }
+
+	uint64 GetCount() const;
+
+	// 백분위 (0.0 ~ 1.0, 해당 버킷 상한, 초). 표본이 없으면 0
+	double GetPercentileSeconds(double Percentile) const;
+
+	double GetMeanSeconds() const;
+	double GetMaxSeconds() const { return MaxMicros.load(std::memory_order_relaxed) * 1e-6; }
+
+	void Reset();
+
+	static int32 GetBucket(uint64 Micros);
+	static uint64 GetBucketUpperBound(int32 Bucket);
+
+private:
+	std::atomic<uint32> Counts[NumBuckets] = {};
+	std::atomic<uint64> SumMicros{ 0 };
+	std::atomic<uint64> MaxMicros{ 0 };
+};
+
+/** 실패 원인 분류 */
+enum class EPOClaudeErrorKind : uint8
+{
+	Network,
+	Timeout,
+	RateLimited,
+	Overloaded,
+	ServerError,
+	ClientError,
+	Parse,
+	LocalBackend,
+
+	Num
+};
+
+/**
+ * Claude 대화 경로 지표 (프로세스 전역, 잠금 없음)
+ * 대기열 대기 / 연결(상태 줄 수신) / 첫 바이트 / 전체 지연 / 응답 파싱 시간 히스토그램과
+ * 요청·성공·실패·토큰 누적값을 모으고, 게임 스레드에서 매 프레임 Publish()로
+ * `stat Claude` 그룹, CSV 프로파일러(Claude 카테고리), Insights 카운터에 내보낸다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeMetrics
+{
+public:
+	static FPOClaudeMetrics& Get();
+
+	FPOClaudeHdrHistogram QueueWait;
+	FPOClaudeHdrHistogram Connect;
+	FPOClaudeHdrHistogram FirstByte;
+	FPOClaudeHdrHistogram Total;
+	FPOClaudeHdrHistogram Parse;
+
+	void RecordRequest() { NumRequests.fetch_add(1, std::memory_order_relaxed); }
+	void RecordSuccess() { NumSucceeded.fetch_add(1, std::memory_order_relaxed); }
+	void RecordError(EPOClaudeErrorKind Kind);
+	void RecordUsage(const FClaudeUsage& Usage);
+
+	// HTTP 상태 코드(0 = 응답 없음) → 실패 원인
+	static EPOClaudeErrorKind ClassifyStatus(int32 StatusCode);
+	static const TCHAR* GetErrorKindName(EPOClaudeErrorKind Kind);
+
+	// 게임 스레드에서 매 프레임 호출 (백분위는 PublishInterval마다 다시 계산)
+	void Publish(int32 NumQueued, int32 NumInFlight);
+
+	// 전체 요약 출력 (Claude.Metrics 콘솔 명령, 매니저 EndPlay)
+	void Dump(FOutputDevice& Ar) const;
+	void Reset();
+
+private:
+	std::atomic<int64> NumRequests{ 0 };
+	std::atomic<int64> NumSucceeded{ 0 };
+	std::atomic<int64> Errors[static_cast<int32>(EPOClaudeErrorKind::Num)] = {};
+
+	std::atomic<int64> InputTokens{ 0 };
+	std::atomic<int64> OutputTokens{ 0 };
+	std::atomic<int64> CacheReadInputTokens{ 0 };
+	std::atomic<int64> CacheCreationInputTokens{ 0 };
+
+	// 게임 스레드 전용: 마지막으로 계산한 백분위 (ms)와 프레임 간 증가분 계산용 이전 값
+	struct FPublished
+	{
+		float QueueWaitP50 = 0.0f;
+		float QueueWaitP95 = 0.0f;
+		float ConnectP95 = 0.0f;
+		float FirstByteP50 = 0.0f;
+		float FirstByteP95 = 0.0f;
+		float TotalP50 = 0.0f;
+		float TotalP95 = 0.0f;
+		float TotalP99 = 0.0f;
+		float ParseP95 = 0.0f;
+	};
+	FPublished Published;
+	double LastPercentileTime = 0.0;
+	int64 LastRequests = 0;
+	int64 LastErrors = 0;
+	int64 LastOutputTokens = 0;
+
+	int64 GetNumErrors() const;
+};
@@ -0,0 +1,413 @@
+#include "POClaudeMockServer.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "HttpServerModule.h"
+#include "IHttpRouter.h"
+#include "HttpPath.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "POClaudeRequestWriter.h"
+
+namespace POClaudeMockServer
+{
+	static const TArray<FString>& GetDefaultReplies()
+	{
+		static const TArray<FString> Replies = {
+			TEXT("어서 오세요, 오늘 날씨가 참 묘하네요."),
+			TEXT("이런 날엔 집에서 따뜻한 차 한잔이 최고지요."),
+			TEXT("길 조심하세요. 요즘 숲 쪽이 좀 험하답니다."),
+			TEXT("하늘 보니 곧 날씨가 바뀌겠어요. \"우산\" 챙기셨어요?")
+		};
+		return Replies;
+	}
+
+	static void AppendAscii(TArray<uint8>& Out, const ANSICHAR* Text)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(Text), FCStringAnsi::Strlen(Text));
+	}
+
+	// 요청 본문에 "stream": true가 있는지 (공백 허용)
+	static bool IsStreamRequested(const TArray<uint8>& Body)
+	{
+		static constexpr ANSICHAR Key[] = "\"stream\"";
+		static constexpr int32 KeyLen = UE_ARRAY_COUNT(Key) - 1;
+
+		for (int32 i = 0; i + KeyLen <= Body.Num(); ++i)
+		{
+			if (FMemory::Memcmp(Body.GetData() + i, Key, KeyLen) != 0)
+			{
+				continue;
+			}
+
+			int32 j = i + KeyLen;
+			while (j < Body.Num() && (Body[j] == ' ' || Body[j] == ':'))
+			{
+				++j;
+			}
+			return j < Body.Num() && Body[j] == 't';
+		}
+		return false;
+	}
+
+	// "event: <이름>\ndata: <JSON>\n\n"
+	static void AppendEvent(TArray<uint8>& Out, const ANSICHAR* EventName, const TArray<uint8>& Json)
+	{
+		AppendAscii(Out, "event: ");
+		AppendAscii(Out, EventName);
+		AppendAscii(Out, "\ndata: ");
+		Out.Append(Json);
+		AppendAscii(Out, "\n\n");
+	}
+}
+
+FPOClaudeMockServer& FPOClaudeMockServer::Get()
+{
+	static FPOClaudeMockServer Instance;
+	return Instance;
+}
+
+bool FPOClaudeMockServer::Start(const FPOClaudeMockServerSettings& InSettings)
+{
+	Stop();
+
+	Settings = InSettings;
+
+	FHttpServerModule& HttpServer = FHttpServerModule::Get();
+	Router = HttpServer.GetHttpRouter(Settings.Port, /*bFailOnBindFailure*/ true);
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[ClaudeMockServer] 포트 %u 바인딩 실패"), Settings.Port);
+		return false;
+	}
+
+	RouteHandle = Router->BindRoute(
+		FHttpPath(TEXT("/v1/messages")),
+		EHttpServerRequestVerbs::VERB_POST,
+		FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			return HandleMessages(Request, OnComplete);
+		}));
+
+	if (!RouteHandle.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[ClaudeMockServer] /v1/messages 경로 등록 실패 (이미 사용 중?)"));
+		Router.Reset();
+		return false;
+	}
+
+	HttpServer.StartAllListeners();
+
+	AliveToken = MakeShared<bool>(true);
+	Random.Initialize(static_cast<int32>(FPlatformTime::Cycles()));
+	bPromptCacheWarm = false;
+	NumRequests = 0;
+	NumInjectedErrors = 0;
+
+	UE_LOG(LogTemp, Display, TEXT("[ClaudeMockServer] 시작: %s (지연 중앙값 %.0fms, 429 %.0f%%, 5xx %.0f%%)"),
+		*GetEndpointURL(), Settings.MedianLatencyMs, Settings.RateLimitRatio * 100.0f, Settings.ServerErrorRatio * 100.0f);
+	return true;
+}
+
+void FPOClaudeMockServer::Stop()
+{
+	if (!Router.IsValid())
+	{
+		return;
+	}
+
+	if (AliveToken.IsValid())
+	{
+		*AliveToken = false;
+		AliveToken.Reset();
+	}
+
+	Router->UnbindRoute(RouteHandle);
+	RouteHandle.Reset();
+	Router.Reset();
+
+	UE_LOG(LogTemp, Display, TEXT("[ClaudeMockServer] 종료 (요청 %d, 주입 오류 %d)"), NumRequests, NumInjectedErrors);
+}
+
+FString FPOClaudeMockServer::GetEndpointURL() const
+{
+	return FString::Printf(TEXT("http://127.0.0.1:%u/v1/messages"), Settings.Port);
+}
+
+bool FPOClaudeMockServer::HandleMessages(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	++NumRequests;
+
+	TUniquePtr<FHttpServerResponse> Response = MakeUnique<FHttpServerResponse>();
+
+	const float Roll = Random.FRand();
+	if (Roll < Settings.RateLimitRatio)
+	{
+		++NumInjectedErrors;
+		Response->Code = static_cast<EHttpServerResponseCodes>(429);
+		Response->Headers.Add(TEXT("retry-after"), { FString::FromInt(Settings.RetryAfterSeconds) });
+		WriteErrorBody("rate_limit_error", "Number of request tokens has exceeded your per-minute rate limit", Response->Body);
+	}
+	else if (Roll < Settings.RateLimitRatio + Settings.ServerErrorRatio)
+	{
+		++NumInjectedErrors;
+		const bool bOverloaded = Random.FRand() < 0.5f;
+		Response->Code = static_cast<EHttpServerResponseCodes>(bOverloaded ? 529 : 500);
+		WriteErrorBody(bOverloaded ? "overloaded_error" : "api_error",
+			bOverloaded ? "Overloaded" : "Internal server error", Response->Body);
+	}
+	else
+	{
+		// 입력 토큰은 본문 크기로 대략 추정 (4바이트 ≈ 1토큰)
+		const int32 InputTokens = FMath::Max(1, Request.Body.Num() / 4);
+
+		const bool bStream = POClaudeMockServer::IsStreamRequested(Request.Body);
+
+		const FString& Reply = PickReply();
+		Response->Code = EHttpServerResponseCodes::Ok;
+		if (bStream)
+		{
+			Response->Headers.Add(TEXT("content-type"), { TEXT("text/event-stream") });
+			WriteStreamBody(Reply, InputTokens, Response->Body);
+		}
+		else
+		{
+			Response->Headers.Add(TEXT("content-type"), { TEXT("application/json") });
+			WriteMessageBody(Reply, InputTokens, Response->Body);
+		}
+	}
+
+	if (!Response->Headers.Contains(TEXT("content-type")))
+	{
+		Response->Headers.Add(TEXT("content-type"), { TEXT("application/json") });
+	}
+
+	// 지연 후 응답 (델리게이트는 복사 가능해야 하므로 응답은 공유 포인터로 보관, 서버가 멈췄으면 버림)
+	const float Delay = SampleLatencySeconds();
+	TWeakPtr<bool> WeakAlive = AliveToken;
+	TSharedRef<TUniquePtr<FHttpServerResponse>> PendingResponse = MakeShared<TUniquePtr<FHttpServerResponse>>(MoveTemp(Response));
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+		[WeakAlive, OnComplete, PendingResponse](float)
+		{
+			const TSharedPtr<bool> Alive = WeakAlive.Pin();
+			if (Alive.IsValid() && *Alive && PendingResponse->IsValid())
+			{
+				OnComplete(MoveTemp(*PendingResponse));
+			}
+			return false;
+		}), Delay);
+
+	return true;
+}
+
+float FPOClaudeMockServer::SampleLatencySeconds()
+{
+	const float Median = FMath::Max(0.0f, Settings.MedianLatencyMs) * 0.001f;
+
+	switch (Settings.Distribution)
+	{
+	case EPOMockLatencyDistribution::Uniform:
+		return Median * Random.FRandRange(1.0f - Settings.LatencySpread, 1.0f + Settings.LatencySpread);
+
+	case EPOMockLatencyDistribution::LogNormal:
+	{
+		// Box-Muller 표준정규 → exp(σ·z) 배율
+		const float U1 = FMath::Max(Random.FRand(), UE_KINDA_SMALL_NUMBER);
+		const float U2 = Random.FRand();
+		const float Z = FMath::Sqrt(-2.0f * FMath::Loge(U1)) * FMath::Cos(2.0f * UE_PI * U2);
+		return Median * FMath::Exp(Settings.LatencySpread * Z);
+	}
+
+	case EPOMockLatencyDistribution::Fixed:
+	default:
+		return Median;
+	}
+}
+
+const FString& FPOClaudeMockServer::PickReply()
+{
+	const TArray<FString>& Replies = Settings.CannedReplies.Num() > 0
+		? Settings.CannedReplies
+		: POClaudeMockServer::GetDefaultReplies();
+	return Replies[Random.RandHelper(Replies.Num())];
+}
+
+void FPOClaudeMockServer::WriteMessageBody(const FString& Text, int32 InputTokens, TArray<uint8>& OutBody)
+{
+	const bool bCacheRead = bPromptCacheWarm;
+	bPromptCacheWarm = true;
+
+	FPOJsonUtf8Writer Writer(OutBody);
+	Writer.BeginObject();
+	Writer.Key("id");          Writer.AsciiString("msg_mock");
+	Writer.Key("type");        Writer.AsciiString("message");
+	Writer.Key("role");        Writer.AsciiString("assistant");
+	Writer.Key("content");
+	Writer.BeginArray();
+	Writer.BeginObject();
+	Writer.Key("type");        Writer.AsciiString("text");
+	Writer.Key("text");        Writer.String(Text);
+	Writer.EndObject();
+	Writer.EndArray();
+	Writer.Key("stop_reason"); Writer.AsciiString("end_turn");
+	Writer.Key("usage");
+	Writer.BeginObject();
+	Writer.Key("input_tokens");                Writer.Number(InputTokens);
+	Writer.Key("output_tokens");               Writer.Number(FMath::Max(1, Text.Len() / 2));
+	Writer.Key("cache_creation_input_tokens"); Writer.Number(bCacheRead ? 0 : InputTokens / 2);
+	Writer.Key("cache_read_input_tokens");     Writer.Number(bCacheRead ? InputTokens / 2 : 0);
+	Writer.EndObject();
+	Writer.EndObject();
+}
+
+void FPOClaudeMockServer::WriteStreamBody(const FString& Text, int32 InputTokens, TArray<uint8>& OutBody)
+{
+	using namespace POClaudeMockServer;
+
+	const bool bCacheRead = bPromptCacheWarm;
+	bPromptCacheWarm = true;
+
+	OutBody.Reset();
+	TArray<uint8> Json;
+
+	{
+		FPOJsonUtf8Writer Writer(Json);
+		Writer.BeginObject();
+		Writer.Key("type"); Writer.AsciiString("message_start");
+		Writer.Key("message");
+		Writer.BeginObject();
+		Writer.Key("id");   Writer.AsciiString("msg_mock");
+		Writer.Key("type"); Writer.AsciiString("message");
+		Writer.Key("role"); Writer.AsciiString("assistant");
+		Writer.Key("content"); Writer.BeginArray(); Writer.EndArray();
+		Writer.Key("usage");
+		Writer.BeginObject();
+		Writer.Key("input_tokens");                Writer.Number(InputTokens);
+		Writer.Key("output_tokens");               Writer.Number(1);
+		Writer.Key("cache_creation_input_tokens"); Writer.Number(bCacheRead ? 0 : InputTokens / 2);
+		Writer.Key("cache_read_input_tokens");     Writer.Number(bCacheRead ? InputTokens / 2 : 0);
+		Writer.EndObject();
+		Writer.EndObject();
+		Writer.EndObject();
+		AppendEvent(OutBody, "message_start", Json);
+	}
+
+	{
+		FPOJsonUtf8Writer Writer(Json);
+		Writer.BeginObject();
+		Writer.Key("type");  Writer.AsciiString("content_block_start");
+		Writer.Key("index"); Writer.Number(0);
+		Writer.Key("content_block");
+		Writer.BeginObject();
+		Writer.Key("type"); Writer.AsciiString("text");
+		Writer.Key("text"); Writer.AsciiString("");
+		Writer.EndObject();
+		Writer.EndObject();
+		AppendEvent(OutBody, "content_block_start", Json);
+	}
+
+	const int32 ChunkChars = FMath::Max(1, Settings.StreamChunkChars);
+	for (int32 Offset = 0; Offset < Text.Len(); Offset += ChunkChars)
+	{
+		const int32 Len = FMath::Min(ChunkChars, Text.Len() - Offset);
+
+		FPOJsonUtf8Writer Writer(Json);
+		Writer.BeginObject();
+		Writer.Key("type");  Writer.AsciiString("content_block_delta");
+		Writer.Key("index"); Writer.Number(0);
+		Writer.Key("delta");
+		Writer.BeginObject();
+		Writer.Key("type"); Writer.AsciiString("text_delta");
+		Writer.Key("text"); Writer.String(*Text + Offset, Len);
+		Writer.EndObject();
+		Writer.EndObject();
+		AppendEvent(OutBody, "content_block_delta", Json);
+	}
+
+	{
+		FPOJsonUtf8Writer Writer(Json);
+		Writer.BeginObject();
+		Writer.Key("type");  Writer.AsciiString("content_block_stop");
+		Writer.Key("index"); Writer.Number(0);
+		Writer.EndObject();
+		AppendEvent(OutBody, "content_block_stop", Json);
+	}
+
+	{
+		FPOJsonUtf8Writer Writer(Json);
+		Writer.BeginObject();
+		Writer.Key("type"); Writer.AsciiString("message_delta");
+		Writer.Key("delta");
+		Writer.BeginObject();
+		Writer.Key("stop_reason"); Writer.AsciiString("end_turn");
+		Writer.EndObject();
+		Writer.Key("usage");
+		Writer.BeginObject();
+		Writer.Key("output_tokens"); Writer.Number(FMath::Max(1, Text.Len() / 2));
+		Writer.EndObject();
+		Writer.EndObject();
+		AppendEvent(OutBody, "message_delta", Json);
+	}
+
+	{
+		FPOJsonUtf8Writer Writer(Json);
+		Writer.BeginObject();
+		Writer.Key("type"); Writer.AsciiString("message_stop");
+		Writer.EndObject();
+		AppendEvent(OutBody, "message_stop", Json);
+	}
+}
+
+void FPOClaudeMockServer::WriteErrorBody(const ANSICHAR* ErrorType, const ANSICHAR* Message, TArray<uint8>& OutBody)
+{
+	FPOJsonUtf8Writer Writer(OutBody);
+	Writer.BeginObject();
+	Writer.Key("type"); Writer.AsciiString("error");
+	Writer.Key("error");
+	Writer.BeginObject();
+	Writer.Key("type");    Writer.AsciiString(ErrorType);
+	Writer.Key("message"); Writer.AsciiString(Message);
+	Writer.EndObject();
+	Writer.EndObject();
+}
+
+namespace POClaudeMockServer
+{
+	static void StartFromArgs(const TArray<FString>& Args)
+	{
+		const FString Joined = FString::Join(Args, TEXT(" "));
+
+		FPOClaudeMockServerSettings NewSettings;
+		FParse::Value(*Joined, TEXT("Port="),    NewSettings.Port);
+		FParse::Value(*Joined, TEXT("Latency="), NewSettings.MedianLatencyMs);
+		FParse::Value(*Joined, TEXT("Spread="),  NewSettings.LatencySpread);
+		FParse::Value(*Joined, TEXT("Err429="),  NewSettings.RateLimitRatio);
+		FParse::Value(*Joined, TEXT("Err5xx="),  NewSettings.ServerErrorRatio);
+		FParse::Value(*Joined, TEXT("RetryAfter="), NewSettings.RetryAfterSeconds);
+		FParse::Value(*Joined, TEXT("Chunk="),   NewSettings.StreamChunkChars);
+
+		FString Distribution;
+		if (FParse::Value(*Joined, TEXT("Dist="), Distribution))
+		{
+			if (Distribution == TEXT("Fixed"))        NewSettings.Distribution = EPOMockLatencyDistribution::Fixed;
+			else if (Distribution == TEXT("Uniform")) NewSettings.Distribution = EPOMockLatencyDistribution::Uniform;
+			else                                      NewSettings.Distribution = EPOMockLatencyDistribution::LogNormal;
+		}
+
+		FPOClaudeMockServer::Get().Start(NewSettings);
+	}
+}
+
+static FAutoConsoleCommand GPOClaudeMockStartCmd(
+	TEXT("Claude.Mock.Start"),
+	TEXT("/v1/messages 루프백 모의 서버 시작. 인자: [Port=18089] [Latency=800(ms)] [Spread=0.5] [Dist=Fixed|Uniform|LogNormal] [Err429=0] [Err5xx=0] [RetryAfter=1] [Chunk=6]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&POClaudeMockServer::StartFromArgs));
+
+static FAutoConsoleCommand GPOClaudeMockStopCmd(
+	TEXT("Claude.Mock.Stop"),
+	TEXT("루프백 모의 서버 종료"),
+	FConsoleCommandDelegate::CreateLambda([]() { FPOClaudeMockServer::Get().Stop(); }));
+
+#endif // !UE_BUILD_SHIPPING
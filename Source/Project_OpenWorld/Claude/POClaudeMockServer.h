@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "HttpRouteHandle.h"
+#include "HttpResultCallback.h"
+
+class IHttpRouter;
+struct FHttpServerRequest;
+
+/** 모의 서버 응답 지연 분포 */
+enum class EPOMockLatencyDistribution : uint8
+{
+	// 항상 MedianLatencyMs
+	Fixed,
+
+	// MedianLatencyMs × [1 - Spread, 1 + Spread] 균등 분포
+	Uniform,
+
+	// 중앙값 MedianLatencyMs, 로그 표준편차 Spread (실제 API 꼬리 지연 흉내)
+	LogNormal
+};
+
+/** 모의 서버 설정 */
+struct FPOClaudeMockServerSettings
+{
+	uint32 Port = 18089;
+
+	EPOMockLatencyDistribution Distribution = EPOMockLatencyDistribution::LogNormal;
+	float MedianLatencyMs = 800.0f;
+	float LatencySpread = 0.5f;
+
+	// 요청 중 429(rate_limit_error)로 응답할 비율
+	float RateLimitRatio = 0.0f;
+
+	// 요청 중 529(overloaded_error) / 500(api_error)으로 응답할 비율
+	float ServerErrorRatio = 0.0f;
+
+	// 429 응답의 retry-after 헤더 값 (초)
+	int32 RetryAfterSeconds = 1;
+
+	// 스트리밍 응답에서 content_block_delta 한 건에 담을 글자 수
+	int32 StreamChunkChars = 6;
+
+	// 응답 문구 (비어 있으면 기본 문구 사용, 요청마다 무작위 선택)
+	TArray<FString> CannedReplies;
+};
+
+/**
+ * /v1/messages 루프백 모의 서버 (부하 테스트/벤치마크 전용)
+ * 요청 본문의 "stream":true 여부에 따라 일반 JSON 또는 SSE 본문을 돌려준다.
+ * 응답은 지연 분포에 따라 코어 티커로 늦춰 보내므로 게임 스레드를 막지 않는다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeMockServer
+{
+public:
+	static FPOClaudeMockServer& Get();
+
+	bool Start(const FPOClaudeMockServerSettings& InSettings);
+	void Stop();
+
+	bool IsRunning() const { return Router.IsValid(); }
+
+	// APOClaudeAPIManager::EndpointURL에 넣을 주소
+	FString GetEndpointURL() const;
+
+	const FPOClaudeMockServerSettings& GetSettings() const { return Settings; }
+
+	int32 GetNumRequests() const { return NumRequests; }
+	int32 GetNumInjectedErrors() const { return NumInjectedErrors; }
+
+private:
+	FPOClaudeMockServerSettings Settings;
+
+	TSharedPtr<IHttpRouter> Router;
+	FHttpRouteHandle RouteHandle;
+
+	// Stop 이후 늦게 깨어난 지연 응답을 버리기 위한 세대 토큰
+	TSharedPtr<bool> AliveToken;
+
+	FRandomStream Random;
+
+	// 첫 요청은 캐시 생성, 이후는 캐시 읽기로 usage 보고
+	bool bPromptCacheWarm = false;
+
+	int32 NumRequests = 0;
+	int32 NumInjectedErrors = 0;
+
+	bool HandleMessages(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	float SampleLatencySeconds();
+
+	const FString& PickReply();
+
+	void WriteMessageBody(const FString& Text, int32 InputTokens, TArray<uint8>& OutBody);
+	void WriteStreamBody(const FString& Text, int32 InputTokens, TArray<uint8>& OutBody);
+	static void WriteErrorBody(const ANSICHAR* ErrorType, const ANSICHAR* Message, TArray<uint8>& OutBody);
+};
+
+#endif // !UE_BUILD_SHIPPING
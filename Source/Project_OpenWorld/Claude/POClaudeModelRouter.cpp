@@ -0,0 +1,292 @@
+#include "POClaudeModelRouter.h"
+
+namespace POClaudeModelRouter
+{
+	// 첫 버킷 상한과 버킷 간 배율 (0.05s × 1.2^39 ≈ 60s)
+	constexpr double FirstBucketSeconds = 0.05;
+	constexpr double BucketRatio = 1.2;
+
+	constexpr float LengthWeight = 0.4f;
+	constexpr float DepthWeight = 0.3f;
+	constexpr float ImportanceWeight = 0.3f;
+}
+
+void FPOClaudeLatencyHistogram::Configure(double WindowSeconds)
+{
+	SliceSeconds = FMath::Max(1.0, WindowSeconds / NumSlices);
+	Reset();
+}
+
+void FPOClaudeLatencyHistogram::Reset()
+{
+	for (FSlice& Slice : Slices)
+	{
+		Slice = FSlice();
+	}
+}
+
+int32 FPOClaudeLatencyHistogram::GetBucket(double Seconds)
+{
+	if (Seconds <= POClaudeModelRouter::FirstBucketSeconds)
+	{
+		return 0;
+	}
+
+	const int32 Bucket = FMath::CeilToInt32(FMath::Loge(Seconds / POClaudeModelRouter::FirstBucketSeconds) / FMath::Loge(POClaudeModelRouter::BucketRatio));
+	return FMath::Clamp(Bucket, 0, NumBuckets - 1);
+}
+
+double FPOClaudeLatencyHistogram::GetBucketUpperBound(int32 Bucket)
+{
+	return POClaudeModelRouter::FirstBucketSeconds * FMath::Pow(POClaudeModelRouter::BucketRatio, static_cast<double>(Bucket));
+}
+
+void FPOClaudeLatencyHistogram::Add(double Now, double Seconds)
+{
+	const int64 Epoch = GetEpoch(Now);
+	FSlice& Slice = Slices[Epoch % NumSlices];
+	if (Slice.Epoch != Epoch)
+	{
+		Slice = FSlice();
+		Slice.Epoch = Epoch;
+	}
+
+	++Slice.Counts[GetBucket(Seconds)];
+	++Slice.Total;
+}
+
+int32 FPOClaudeLatencyHistogram::GetCount(double Now) const
+{
+	const int64 NowEpoch = GetEpoch(Now);
+
+	int32 Count = 0;
+	for (const FSlice& Slice : Slices)
+	{
+		if (IsLive(Slice, NowEpoch))
+		{
+			Count += Slice.Total;
+		}
+	}
+	return Count;
+}
+
+double FPOClaudeLatencyHistogram::GetPercentile(double Now, double Percentile) const
+{
+	const int64 NowEpoch = GetEpoch(Now);
+
+	int32 Merged[NumBuckets] = {};
+	int32 Total = 0;
+	for (const FSlice& Slice : Slices)
+	{
+		if (!IsLive(Slice, NowEpoch))
+		{
+			continue;
+		}
+
+		for (int32 i = 0; i < NumBuckets; ++i)
+		{
+			Merged[i] += Slice.Counts[i];
+		}
+		Total += Slice.Total;
+	}
+
+	if (Total == 0)
+	{
+		return 0.0;
+	}
+
+	// 누적 개수가 처음으로 순위에 닿는 버킷
+	const int32 Rank = FMath::Max(1, FMath::CeilToInt32(Percentile * Total));
+	int32 Cumulative = 0;
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		Cumulative += Merged[i];
+		if (Cumulative >= Rank)
+		{
+			return GetBucketUpperBound(i);
+		}
+	}
+	return GetBucketUpperBound(NumBuckets - 1);
+}
+
+void FPOClaudeModelRouter::Configure(
+	const TArray<FClaudeModelTier>& InTiers,
+	int32 InLongMessageChars,
+	int32 InDeepConversationTurns,
+	double WindowSeconds,
+	int32 InMinSamples)
+{
+	Tiers.Reset();
+	for (const FClaudeModelTier& Tier : InTiers)
+	{
+		if (!Tier.ModelID.IsEmpty())
+		{
+			Tiers.Add(Tier);
+		}
+	}
+
+	States.Reset();
+	States.SetNum(Tiers.Num());
+	for (FTierState& State : States)
+	{
+		State.Latency.Configure(WindowSeconds);
+	}
+
+	LongMessageChars = FMath::Max(1, InLongMessageChars);
+	DeepConversationTurns = FMath::Max(1, InDeepConversationTurns);
+	MinSamples = FMath::Max(1, InMinSamples);
+}
+
+float FPOClaudeModelRouter::ComputeComplexity(const FClaudeRequestContext& Context) const
+{
+	// 접힌 요약이 있으면 그만큼 오래된 대화로 보고 한 턴을 더함
+	const int32 Depth = Context.History.Num() + (Context.HistorySummary.IsEmpty() ? 0 : 1);
+
+	const float Length = FMath::Min(1.0f, static_cast<float>(Context.PlayerMessage.Len()) / LongMessageChars);
+	const float DepthRatio = FMath::Min(1.0f, static_cast<float>(Depth) / DeepConversationTurns);
+	const float Importance = FMath::Clamp(Context.Importance, 0.0f, 1.0f);
+
+	return POClaudeModelRouter::LengthWeight * Length
+		+ POClaudeModelRouter::DepthWeight * DepthRatio
+		+ POClaudeModelRouter::ImportanceWeight * Importance;
+}
+
+int32 FPOClaudeModelRouter::FindTier(float Complexity) const
+{
+	for (int32 i = Tiers.Num() - 1; i > 0; --i)
+	{
+		if (Complexity >= Tiers[i].MinComplexity)
+		{
+			return i;
+		}
+	}
+	return 0;
+}
+
+int32 FPOClaudeModelRouter::GetPreferredTier(const FClaudeRequestContext& Context) const
+{
+	return IsEnabled() ? FindTier(ComputeComplexity(Context)) : INDEX_NONE;
+}
+
+FPOClaudeRouteDecision FPOClaudeModelRouter::Route(const FClaudeRequestContext& Context, double Now)
+{
+	FPOClaudeRouteDecision Decision;
+	if (!IsEnabled())
+	{
+		return Decision;
+	}
+
+	Decision.Complexity    = ComputeComplexity(Context);
+	Decision.PreferredTier = FindTier(Decision.Complexity);
+
+	// 가장 빠른 티어는 예산을 넘어도 마지막 선택지로 남김
+	Decision.Tier = Decision.PreferredTier;
+	while (Decision.Tier > 0 && IsOverBudget(Decision.Tier, Now))
+	{
+		--Decision.Tier;
+	}
+
+	++States[Decision.Tier].NumRouted;
+	if (Decision.IsDowngraded())
+	{
+		++States[Decision.PreferredTier].NumDowngraded;
+	}
+	return Decision;
+}
+
+void FPOClaudeModelRouter::RecordLatency(int32 Tier, double Now, double Seconds)
+{
+	if (States.IsValidIndex(Tier))
+	{
+		States[Tier].Latency.Add(Now, Seconds);
+	}
+}
+
+bool FPOClaudeModelRouter::IsOverBudget(int32 Tier, double Now) const
+{
+	const float Budget = Tiers[Tier].P95BudgetSeconds;
+	if (Budget <= 0.0f)
+	{
+		return false;
+	}
+
+	const FPOClaudeLatencyHistogram& Latency = States[Tier].Latency;
+	return Latency.GetCount(Now) >= MinSamples && Latency.GetPercentile(Now, 0.95) > Budget;
+}
+
+int32 FPOClaudeModelRouter::GetMaxOutputTokens() const
+{
+	int32 Max = 0;
+	for (const FClaudeModelTier& Tier : Tiers)
+	{
+		Max = FMath::Max(Max, Tier.MaxTokens);
+	}
+	return Max;
+}
+
+void FPOClaudeModelRouter::Dump(FOutputDevice& Ar, double Now) const
+{
+	if (!IsEnabled())
+	{
+		Ar.Log(TEXT("[ClaudeModelRouter] 모델 라우팅 비활성"));
+		return;
+	}
+
+	for (int32 i = 0; i < Tiers.Num(); ++i)
+	{
+		const FClaudeModelTier& Tier = Tiers[i];
+		const FTierState& State = States[i];
+
+		Ar.Logf(TEXT("[ClaudeModelRouter] 티어 %d %s (max_tokens %d, 복잡도 ≥ %.2f): 전송 %d / 강등 %d, 최근 %d건 p50 %.2fs p95 %.2fs (예산 %.2fs)%s"),
+			i, *Tier.ModelID, Tier.MaxTokens, Tier.MinComplexity, State.NumRouted, State.NumDowngraded,
+			State.Latency.GetCount(Now), State.Latency.GetPercentile(Now, 0.5), State.Latency.GetPercentile(Now, 0.95),
+			Tier.P95BudgetSeconds, IsOverBudget(i, Now) ? TEXT(" [예산 초과]") : TEXT(""));
+	}
+}
+
+void FPOClaudeModelRouter::ResetStats()
+{
+	for (FTierState& State : States)
+	{
+		State.NumRouted = 0;
+		State.NumDowngraded = 0;
+		State.Latency.Reset();
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "POClaudeAPIManager.h"
+
+namespace POClaudeModelRouterCommands
+{
+	static void Dump(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		APOClaudeAPIManager* Manager = World
+			? Cast<APOClaudeAPIManager>(UGameplayStatics::GetActorOfClass(World, APOClaudeAPIManager::StaticClass()))
+			: nullptr;
+		if (!Manager)
+		{
+			Ar.Log(TEXT("[ClaudeModelRouter] ClaudeAPIManager가 없습니다."));
+			return;
+		}
+
+		Manager->DumpRoutingStats(Ar);
+
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("Reset"), ESearchCase::IgnoreCase))
+		{
+			Manager->ResetRoutingStats();
+			Ar.Log(TEXT("[ClaudeModelRouter] 통계 초기화"));
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPOClaudeRoutingCmd(
+	TEXT("Claude.Routing"),
+	TEXT("모델 티어별 전송/강등 수와 최근 응답 시간 p50/p95 출력. 인자: [Reset]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&POClaudeModelRouterCommands::Dump));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "POClaudeTypes.h"
+
+/**
+ * 최근 WindowSeconds 동안의 응답 시간 분포 (로그 간격 버킷 × 시간 조각 링)
+ * 조각 하나가 창의 1/NumSlices를 맡고, 오래된 조각은 다음에 그 자리를 쓸 때 비워진다.
+ * 백분위는 해당 버킷의 상한으로 돌려주므로 실제보다 최대 한 버킷(약 20%)만큼 보수적이다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeLatencyHistogram
+{
+public:
+	static constexpr int32 NumBuckets = 40;
+	static constexpr int32 NumSlices = 6;
+
+	void Configure(double WindowSeconds);
+
+	void Add(double Now, double Seconds);
+
+	// 창 안의 표본 수
+	int32 GetCount(double Now) const;
+
+	// 창 안의 백분위 (0.0 ~ 1.0, 표본이 없으면 0)
+	double GetPercentile(double Now, double Percentile) const;
+
+	void Reset();
+
+private:
+	struct FSlice
+	{
+		int64 Epoch = -1;
+		int32 Total = 0;
+		int32 Counts[NumBuckets] = {};
+	};
+
+	FSlice Slices[NumSlices];
+
+	double SliceSeconds = 10.0;
+
+	int64 GetEpoch(double Now) const { return static_cast<int64>(Now / SliceSeconds); }
+	bool IsLive(const FSlice& Slice, int64 NowEpoch) const { return Slice.Epoch > NowEpoch - NumSlices; }
+
+	static int32 GetBucket(double Seconds);
+	static double GetBucketUpperBound(int32 Bucket);
+};
+
+/** 요청 1건의 티어 선택 결과 */
+struct FPOClaudeRouteDecision
+{
+	// 실제로 보낼 티어 / 복잡도만 보면 골랐을 티어
+	int32 Tier = INDEX_NONE;
+	int32 PreferredTier = INDEX_NONE;
+
+	float Complexity = 0.0f;
+
+	// 지연 예산 초과로 더 빠른 티어로 내려갔는지
+	bool IsDowngraded() const { return Tier != PreferredTier; }
+};
+
+/**
+ * 요청마다 모델 티어를 고르는 라우터 (매니저의 모든 HTTP 요청이 공유)
+ * 복잡도 = 메시지 길이 40% + 대화 깊이 30% + NPC 중요도 30% (각각 0~1로 포화).
+ * 복잡도로 고른 티어의 최근 p95 응답 시간이 예산을 넘으면 예산 안의 더 빠른 티어로 내려가며,
+ * 내려간 티어는 표본이 창 밖으로 밀려나면 다시 트래픽을 받아 회복 여부를 확인한다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeModelRouter
+{
+public:
+	// 티어는 빠른 모델 → 큰 모델 순. 비어 있으면 라우팅 비활성
+	void Configure(const TArray<FClaudeModelTier>& InTiers, int32 InLongMessageChars, int32 InDeepConversationTurns,
+		double WindowSeconds, int32 InMinSamples);
+
+	bool IsEnabled() const { return Tiers.Num() > 0; }
+
+	int32 Num() const { return Tiers.Num(); }
+	const FClaudeModelTier& GetTier(int32 Index) const { return Tiers[Index]; }
+
+	float ComputeComplexity(const FClaudeRequestContext& Context) const;
+
+	FPOClaudeRouteDecision Route(const FClaudeRequestContext& Context, double Now);
+
+	// 복잡도만으로 고른 티어 (지연 예산/집계 없음, 로컬 백엔드의 토큰 상한용). 비활성이면 INDEX_NONE
+	int32 GetPreferredTier(const FClaudeRequestContext& Context) const;
+
+	// 완료된 요청의 응답 시간 (연결 실패/시간 초과도 지연 신호로 기록)
+	void RecordLatency(int32 Tier, double Now, double Seconds);
+
+	// 표본이 충분하고 p95가 예산을 넘었는지
+	bool IsOverBudget(int32 Tier, double Now) const;
+
+	// 속도 제한 예약용 최대 출력 토큰
+	int32 GetMaxOutputTokens() const;
+
+	// 티어별 라우팅 수/강등 수/p50/p95 출력 (Claude.Routing 콘솔 명령)
+	void Dump(FOutputDevice& Ar, double Now) const;
+	void ResetStats();
+
+private:
+	struct FTierState
+	{
+		FPOClaudeLatencyHistogram Latency;
+
+		// 이 티어로 보낸 수 / 이 티어를 골랐지만 지연 예산 때문에 내려간 수
+		int32 NumRouted = 0;
+		int32 NumDowngraded = 0;
+	};
+
+	TArray<FClaudeModelTier> Tiers;
+	TArray<FTierState> States;
+
+	int32 LongMessageChars = 80;
+	int32 DeepConversationTurns = 6;
+	int32 MinSamples = 5;
+
+	// MinComplexity를 넘는 가장 큰 티어 (첫 티어는 항상 후보)
+	int32 FindTier(float Complexity) const;
+};
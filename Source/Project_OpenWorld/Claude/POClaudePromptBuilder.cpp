@@ -0,0 +1,208 @@
+#include "POClaudePromptBuilder.h"
+#include "POClaudeTypes.h"
+#include "POClaudeTokenEstimator.h"
+#include "Hash/CityHash.h"
+#include "../World/POEnvironmentSubsystem.h"
+
+const FString& FPOClaudePromptBuilder::GetStaticBlock(const FClaudeRequestContext& Context)
+{
+	const uint64 Key = GetArchetypeKey(Context);
+	if (const FString* Cached = StaticBlocks.Find(Key))
+	{
+		return *Cached;
+	}
+
+	FString Block = FString::Printf(
+		TEXT(
+		"당신은 '%s'라는 이름의 %s입니다.\n"
+		"\n"
+		"## 대화 규칙\n"
+		"1. 반드시 한국어로만 답하세요.\n"
+		"2. 아래 '현재 환경 정보'의 날씨와 시간을 반드시 대화에 자연스럽게 녹여내세요.\n"
+		"   - 비/폭풍 날씨: 불편함, 처마 밑으로 피하고 싶다는 표현 포함\n"
+		"   - 눈 날씨: 추위, 손 시림, 발이 미끄럽다는 표현 포함\n"
+		"   - 안개 날씨: 앞이 안 보인다, 방향 잃을 것 같다는 표현 포함\n"
+		"   - 맑은 날씨: 기분 좋음, 날씨 칭찬 포함\n"
+		"   - 야간(18시~06시): 어둠, 피곤함, 집에 들어가고 싶다는 표현 포함\n"
+		"3. 답변은 2~4문장으로 간결하게 하세요.\n"
+		"4. 마을 주민답게 소박하고 친근하게 말하세요.\n"
+		"5. 게임 캐릭터라는 사실을 절대 언급하지 마세요.\n"
+		),
+		*Context.NPCName,
+		*Context.NPCPersonality
+	);
+
+	return StaticBlocks.Add(Key, MoveTemp(Block));
+}
+
+FString FPOClaudePromptBuilder::BuildDynamicBlock(const FClaudeRequestContext& Context, const FString& HistorySummary, TConstArrayView<const FString*> Memories)
+{
+	// 날씨 수치 → 상세 묘사 문자열
+	FString WeatherDetail;
+	if (Context.RainIntensity > 0.5f)
+		WeatherDetail += TEXT("비가 세차게 내리고 있습니다. ");
+	else if (Context.RainIntensity > 0.1f)
+		WeatherDetail += TEXT("가랑비가 내리고 있습니다. ");
+
+	if (Context.SnowCoverage > 0.5f)
+		WeatherDetail += TEXT("눈이 많이 쌓여있습니다. ");
+	else if (Context.SnowCoverage > 0.1f)
+		WeatherDetail += TEXT("눈이 살짝 쌓여있습니다. ");
+
+	if (Context.WindStrength > 0.7f)
+		WeatherDetail += TEXT("바람이 매우 강하게 붑니다. ");
+	else if (Context.WindStrength > 0.3f)
+		WeatherDetail += TEXT("바람이 제법 붑니다. ");
+
+	if (WeatherDetail.IsEmpty())
+		WeatherDetail = TEXT("특별한 이상 날씨는 없습니다.");
+
+	FString Block = FString::Printf(
+		TEXT(
+		"## 현재 환경 정보\n"
+		"- 날씨: %s\n"
+		"- 시간: %.1f시 (%s)\n"
+		"- 날씨 상세: %s\n"
+		),
+		*Context.WeatherType,
+		Context.TimeOfDay,
+		*TimeOfDayToKorean(Context.TimeOfDay),
+		*WeatherDetail
+	);
+
+	// 정적 블록 캐시를 깨지 않도록 기억은 동적 블록에만 넣음
+	if (Memories.Num() > 0)
+	{
+		Block += TEXT("\n## 플레이어에 대해 기억하는 것 (플레이어가 예전에 한 말)\n");
+		for (const FString* Memory : Memories)
+		{
+			Block += TEXT("- ");
+			Block += *Memory;
+			Block += TEXT("\n");
+		}
+	}
+
+	if (!HistorySummary.IsEmpty())
+	{
+		Block += TEXT("\n## 이전 대화 요약 (오래된 순)\n");
+		Block += HistorySummary;
+	}
+
+	return Block;
+}
+
+void FPOClaudePromptBuilder::BuildPrompt(
+	const FClaudeRequestContext& Context,
+	int32 TurnTokenBudget,
+	int32 SummaryTokenBudget,
+	TConstArrayView<const FString*> Memories,
+	FPOClaudePromptParts& Out)
+{
+	Out.StaticSystem = &GetStaticBlock(Context);
+
+	// 최근 턴은 user/assistant 메시지로 그대로, 예산 밖의 오래된 턴은 동적 블록의 요약으로
+	FPOClaudePackedHistory Packed;
+	PackHistory(Context, TurnTokenBudget, SummaryTokenBudget, Packed);
+
+	Out.DynamicSystem = BuildDynamicBlock(Context, Packed.Summary, Memories);
+
+	Out.Turns.Reset();
+	for (int32 i = Packed.FirstTurn; i < Context.History.Num(); ++i)
+	{
+		const FClaudeDialogueTurn& Turn = Context.History[i];
+
+		// API는 빈 content를 거부하므로 한쪽이 빈 턴은 통째로 건너뜀 (user/assistant 교대 유지)
+		if (Turn.PlayerMessage.IsEmpty() || Turn.NPCResponse.IsEmpty())
+		{
+			continue;
+		}
+		Out.Turns.Add(&Turn);
+	}
+}
+
+void FPOClaudePromptBuilder::PackHistory(
+	const FClaudeRequestContext& Context,
+	int32 TurnTokenBudget,
+	int32 SummaryTokenBudget,
+	FPOClaudePackedHistory& Out)
+{
+	using namespace POClaudeTokenEstimator;
+
+	const TArray<FClaudeDialogueTurn>& History = Context.History;
+
+	// 최근 턴부터 거꾸로 예산이 허락하는 만큼 포함
+	Out.FirstTurn = History.Num();
+	Out.TurnTokens = 0;
+	for (int32 i = History.Num() - 1; i >= 0; --i)
+	{
+		const FClaudeDialogueTurn& Turn = History[i];
+		const int32 TurnTokens = Estimate(Turn.PlayerMessage) + Estimate(Turn.NPCResponse) + 2 * MessageOverhead;
+		if (Out.TurnTokens + TurnTokens > TurnTokenBudget)
+		{
+			break;
+		}
+
+		Out.TurnTokens += TurnTokens;
+		Out.FirstTurn = i;
+	}
+
+	// 들어가지 못한 오래된 턴은 기존 요약 뒤에 한 줄씩 접음
+	Out.Summary = Context.HistorySummary;
+	for (int32 i = 0; i < Out.FirstTurn; ++i)
+	{
+		AppendToSummary(Out.Summary, SummarizeTurn(History[i].PlayerMessage, History[i].NPCResponse), SummaryTokenBudget);
+	}
+}
+
+FString FPOClaudePromptBuilder::SummarizeTurn(const FString& PlayerMessage, const FString& NPCResponse)
+{
+	static constexpr int32 MaxPlayerChars = 30;
+	static constexpr int32 MaxResponseChars = 40;
+
+	auto Clip = [](const FString& Text, int32 MaxChars)
+	{
+		FString Line = Text.Replace(TEXT("\n"), TEXT(" ")).TrimStartAndEnd();
+		if (Line.Len() > MaxChars)
+		{
+			Line.LeftInline(MaxChars);
+			Line += TEXT("…");
+		}
+		return Line;
+	};
+
+	return FString::Printf(TEXT("- 플레이어: \"%s\" → 나: \"%s\"\n"),
+		*Clip(PlayerMessage, MaxPlayerChars), *Clip(NPCResponse, MaxResponseChars));
+}
+
+void FPOClaudePromptBuilder::AppendToSummary(FString& Summary, const FString& Line, int32 SummaryTokenBudget)
+{
+	Summary += Line;
+
+	while (!Summary.IsEmpty() && POClaudeTokenEstimator::Estimate(Summary) > SummaryTokenBudget)
+	{
+		int32 LineEnd = INDEX_NONE;
+		if (!Summary.FindChar(TEXT('\n'), LineEnd) || LineEnd == Summary.Len() - 1)
+		{
+			// 마지막 한 줄마저 예산을 넘으면 요약을 비움
+			Summary.Reset();
+			break;
+		}
+		Summary.RightChopInline(LineEnd + 1);
+	}
+}
+
+uint64 FPOClaudePromptBuilder::GetArchetypeKey(const FClaudeRequestContext& Context)
+{
+	return GetArchetypeKey(Context.NPCName, Context.NPCPersonality);
+}
+
+uint64 FPOClaudePromptBuilder::GetArchetypeKey(const FString& NPCName, const FString& NPCPersonality)
+{
+	const FString Composite = NPCName + TEXT("\x1F") + NPCPersonality;
+	return CityHash64(reinterpret_cast<const char*>(*Composite), Composite.Len() * sizeof(TCHAR));
+}
+
+FString FPOClaudePromptBuilder::TimeOfDayToKorean(float TimeOfDay)
+{
+	return UPOEnvironmentSubsystem::TimePeriodToKorean(UPOEnvironmentSubsystem::GetTimePeriod(TimeOfDay));
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FClaudeRequestContext;
+struct FClaudeDialogueTurn;
+
+/** 토큰 예산에 맞춰 고른 대화 이력 */
+struct FPOClaudePackedHistory
+{
+	// Context.History 중 요청 메시지로 그대로 넣을 첫 턴 인덱스 (History.Num()이면 없음)
+	int32 FirstTurn = 0;
+
+	// 기존 요약 + 예산에서 밀려난 턴 요약 (동적 블록에 들어감)
+	FString Summary;
+
+	// 포함한 턴의 추정 토큰 수
+	int32 TurnTokens = 0;
+};
+
+/** 요청 하나의 프롬프트 재료 (시스템 블록 두 개 + 메시지로 보낼 이전 턴) */
+struct FPOClaudePromptParts
+{
+	// 정적 블록 (빌더 캐시를 가리키므로 다른 아키타입 블록을 만들기 전에 사용)
+	const FString* StaticSystem = nullptr;
+
+	FString DynamicSystem;
+
+	// Context.History 안의 턴 (빈 쪽이 있는 턴 제외)
+	TArray<const FClaudeDialogueTurn*, TInlineAllocator<10>> Turns;
+};
+
+/**
+ * Claude 시스템 프롬프트 조립기
+ * 변하지 않는 페르소나/대화 규칙(정적 블록)과 매 요청 바뀌는 날씨/시간(동적 블록)을 분리한다.
+ * 정적 블록은 NPC 아키타입(이름 + 성격)마다 한 번만 만들어 재사용하며 프롬프트 캐시 대상이 된다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudePromptBuilder
+{
+public:
+	// 페르소나 + 대화 규칙 (아키타입별 캐시)
+	const FString& GetStaticBlock(const FClaudeRequestContext& Context);
+
+	// 날씨/시간 환경 정보 + 플레이어에 대한 기억 + 이전 대화 요약 (매 요청 생성, 짧게 유지)
+	static FString BuildDynamicBlock(const FClaudeRequestContext& Context, const FString& HistorySummary = FString(),
+		TConstArrayView<const FString*> Memories = TConstArrayView<const FString*>());
+
+	// 대화/로컬 모델/bark 굽기 공용 프롬프트 조립: 정적 블록 + 동적 블록(요약, 기억 포함) + 예산 안의 이전 턴
+	void BuildPrompt(const FClaudeRequestContext& Context, int32 TurnTokenBudget, int32 SummaryTokenBudget,
+		TConstArrayView<const FString*> Memories, FPOClaudePromptParts& Out);
+
+	// 최근 턴부터 TurnTokenBudget 안에 들어가는 만큼 고르고, 나머지는 요약(SummaryTokenBudget 이내)으로 접는다
+	static void PackHistory(const FClaudeRequestContext& Context, int32 TurnTokenBudget, int32 SummaryTokenBudget, FPOClaudePackedHistory& Out);
+
+	// 한 턴을 요약 한 줄로 압축
+	static FString SummarizeTurn(const FString& PlayerMessage, const FString& NPCResponse);
+
+	// 요약 끝에 한 줄 추가, 예산을 넘으면 가장 오래된 줄부터 버림
+	static void AppendToSummary(FString& Summary, const FString& Line, int32 SummaryTokenBudget);
+
+	// NPC 이름 + 성격 해시 (bark 표 키로도 사용)
+	static uint64 GetArchetypeKey(const FClaudeRequestContext& Context);
+	static uint64 GetArchetypeKey(const FString& NPCName, const FString& NPCPersonality);
+
+	static FString TimeOfDayToKorean(float TimeOfDay);
+
+	int32 GetNumCachedArchetypes() const { return StaticBlocks.Num(); }
+
+private:
+	TMap<uint64, FString> StaticBlocks;
+};
@@ -0,0 +1,88 @@
+#include "POClaudeRateLimiter.h"
+#include "POClaudeTypes.h"
+
+void FPOClaudeRateLimiter::Configure(int32 RequestsPerMinute, int32 TokensPerMinute)
+{
+	Requests.Capacity        = FMath::Max(0, RequestsPerMinute);
+	Requests.RefillPerSecond = Requests.Capacity / 60.0;
+	Requests.Level           = Requests.Capacity;
+
+	Tokens.Capacity        = FMath::Max(0, TokensPerMinute);
+	Tokens.RefillPerSecond = Tokens.Capacity / 60.0;
+	Tokens.Level           = Tokens.Capacity;
+
+	LastRefillTime = FPlatformTime::Seconds();
+	BlockedUntil = 0.0;
+}
+
+void FPOClaudeRateLimiter::Refill(double Now)
+{
+	const double Elapsed = FMath::Max(0.0, Now - LastRefillTime);
+	LastRefillTime = Now;
+
+	for (FBucket* Bucket : { &Requests, &Tokens })
+	{
+		if (Bucket->IsLimited())
+		{
+			Bucket->Level = FMath::Min(Bucket->Capacity, Bucket->Level + Elapsed * Bucket->RefillPerSecond);
+		}
+	}
+}
+
+double FPOClaudeRateLimiter::FBucket::WaitFor(double Amount) const
+{
+	if (!IsLimited())
+	{
+		return 0.0;
+	}
+
+	const double Needed = FMath::Min(Amount, Capacity) - Level;
+	return Needed > 0.0 ? Needed / RefillPerSecond : 0.0;
+}
+
+double FPOClaudeRateLimiter::GetWaitSeconds(double Now, int32 EstimatedTokens)
+{
+	Refill(Now);
+
+	const double BlockedWait = FMath::Max(0.0, BlockedUntil - Now);
+	return FMath::Max3(BlockedWait, Requests.WaitFor(1.0), Tokens.WaitFor(EstimatedTokens));
+}
+
+void FPOClaudeRateLimiter::Acquire(double Now, int32 EstimatedTokens)
+{
+	Refill(Now);
+
+	if (Requests.IsLimited())
+	{
+		Requests.Level -= 1.0;
+	}
+	if (Tokens.IsLimited())
+	{
+		Tokens.Level -= EstimatedTokens;
+	}
+}
+
+void FPOClaudeRateLimiter::Reconcile(int32 EstimatedTokens, int32 ActualTokens)
+{
+	// 추정보다 많이 썼으면 버킷이 음수(빚)가 되어 다음 전송이 그만큼 늦춰진다
+	if (Tokens.IsLimited())
+	{
+		Tokens.Level = FMath::Min(Tokens.Capacity, Tokens.Level + (EstimatedTokens - ActualTokens));
+	}
+}
+
+void FPOClaudeRateLimiter::BlockUntil(double Time)
+{
+	BlockedUntil = FMath::Max(BlockedUntil, Time);
+}
+
+int32 FPOClaudeRateLimiter::CountBilledTokens(const FClaudeUsage& Usage)
+{
+	return Usage.InputTokens + Usage.CacheCreationInputTokens + Usage.OutputTokens;
+}
+
+double FPOClaudeRateLimiter::ComputeBackoffSeconds(int32 Attempt, double BaseSeconds, double MaxSeconds, FRandomStream& Random)
+{
+	const double Ceiling = FMath::Min(MaxSeconds, BaseSeconds * FMath::Pow(2.0, FMath::Min(Attempt, 16)));
+	return Random.FRandRange(0.0f, static_cast<float>(Ceiling));
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FClaudeUsage;
+
+/**
+ * Claude API 요청 속도 제한기 (매니저의 모든 요청이 공유)
+ * 분당 요청 수(RPM)와 분당 토큰 수(TPM) 토큰 버킷으로 전송 시점을 조절한다.
+ * 토큰은 전송 시 추정치로 예약하고, 응답 usage가 오면 실제 사용량으로 정산한다.
+ * 429의 retry-after를 받으면 그 시각까지 모든 전송을 멈춘다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeRateLimiter
+{
+public:
+	// 0 이하 = 해당 버킷 제한 없음
+	void Configure(int32 RequestsPerMinute, int32 TokensPerMinute);
+
+	// 지금 보낼 수 있으면 0, 아니면 기다려야 할 시간(초)
+	double GetWaitSeconds(double Now, int32 EstimatedTokens);
+
+	// 요청 1건과 추정 토큰 예약 (GetWaitSeconds가 0일 때 호출)
+	void Acquire(double Now, int32 EstimatedTokens);
+
+	// 예약한 추정치를 실제 사용량으로 정산 (실패한 요청은 ActualTokens = 0으로 전부 반환)
+	void Reconcile(int32 EstimatedTokens, int32 ActualTokens);
+
+	// retry-after 등으로 지정 시각까지 전송 중단
+	void BlockUntil(double Time);
+
+	bool IsBlocked(double Now) const { return Now < BlockedUntil; }
+
+	// TPM 정산 대상 토큰 (캐시 읽기는 제외: 입력 + 캐시 생성 + 출력)
+	static int32 CountBilledTokens(const FClaudeUsage& Usage);
+
+	// 전체 지터 지수 백오프: [0, min(Max, Base × 2^Attempt)] 균등
+	static double ComputeBackoffSeconds(int32 Attempt, double BaseSeconds, double MaxSeconds, FRandomStream& Random);
+
+private:
+	struct FBucket
+	{
+		double Capacity = 0.0;
+		double RefillPerSecond = 0.0;
+		double Level = 0.0;
+
+		bool IsLimited() const { return Capacity > 0.0; }
+
+		// Amount만큼 쌓일 때까지 남은 시간 (용량보다 큰 요청은 가득 찼을 때 통과)
+		double WaitFor(double Amount) const;
+	};
+
+	FBucket Requests;
+	FBucket Tokens;
+
+	double LastRefillTime = 0.0;
+	double BlockedUntil = 0.0;
+
+	void Refill(double Now);
+};
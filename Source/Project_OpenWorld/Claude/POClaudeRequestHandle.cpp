@@ -0,0 +1,64 @@
+#include "POClaudeRequestHandle.h"
+#include "Async/Async.h"
+#include "POClaudeAPIManager.h"
+
+FPOClaudeRequestState::FPOClaudeRequestState(int32 InRequestId, double InDeadline, UObject* InOwner, APOClaudeAPIManager* InManager)
+	: RequestId(InRequestId)
+	, Deadline(InDeadline)
+	, Manager(InManager)
+	, Owner(InOwner)
+	, bHasOwner(InOwner != nullptr)
+{
+	Future = Promise.GetFuture().Share();
+}
+
+bool FPOClaudeRequestState::Settle(EClaudeRequestOutcome InOutcome, bool bSuccess, const FString& Text)
+{
+	uint8 Expected = static_cast<uint8>(EClaudeRequestOutcome::Pending);
+	if (!Outcome.compare_exchange_strong(Expected, static_cast<uint8>(InOutcome), std::memory_order_acq_rel))
+	{
+		return false;
+	}
+
+	FClaudeRequestResult Result;
+	Result.Outcome  = InOutcome;
+	Result.bSuccess = bSuccess;
+	Result.Text     = Text;
+	Promise.SetValue(MoveTemp(Result));
+	return true;
+}
+
+void FPOClaudeRequestHandle::Cancel()
+{
+	if (!State || (State->IsSettled() && !State->IsHedged()) || !State->RequestCancel())
+	{
+		return;
+	}
+
+	// 대기열/HTTP 요청은 게임 스레드에서만 만지므로 그쪽으로 넘김
+	auto ProcessOnGameThread = [State = State]()
+	{
+		if (APOClaudeAPIManager* Manager = State->Manager.Get())
+		{
+			Manager->ProcessCancellation(State.ToSharedRef());
+		}
+		else
+		{
+			State->Settle(EClaudeRequestOutcome::Cancelled, false, FString());
+		}
+	};
+
+	if (IsInGameThread())
+	{
+		ProcessOnGameThread();
+	}
+	else
+	{
+		AsyncTask(ENamedThreads::GameThread, MoveTemp(ProcessOnGameThread));
+	}
+}
+
+TSharedFuture<FClaudeRequestResult> FPOClaudeRequestHandle::GetFuture() const
+{
+	return State ? State->GetFuture() : TSharedFuture<FClaudeRequestResult>();
+}
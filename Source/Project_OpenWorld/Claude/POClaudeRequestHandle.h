@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "HttpFwd.h"
+#include <atomic>
+
+class APOClaudeAPIManager;
+
+/** Claude 요청의 최종 결과 종류 */
+enum class EClaudeRequestOutcome : uint8
+{
+	// 아직 결과 없음 (대기열/전송 중)
+	Pending,
+
+	// 응답 전달 (오류 안내 문구 포함, bSuccess로 구분)
+	Completed,
+
+	// 취소 또는 소유자 소멸 (콜백 호출 안 함)
+	Cancelled,
+
+	// 요청 기한 초과 (실패 콜백 호출)
+	TimedOut
+};
+
+/** 요청 핸들 퓨처로 전달되는 결과 */
+struct FClaudeRequestResult
+{
+	EClaudeRequestOutcome Outcome = EClaudeRequestOutcome::Pending;
+	bool bSuccess = false;
+	FString Text;
+};
+
+/**
+ * 요청 하나의 공유 상태 (매니저와 핸들이 함께 소유)
+ * 취소 플래그와 결과는 원자적으로 바뀌므로 아무 스레드에서나 조회할 수 있다.
+ * 결과는 처음 한 번만 확정되며(Settle), 확정과 동시에 퓨처가 채워진다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeRequestState
+{
+public:
+	FPOClaudeRequestState(int32 InRequestId, double InDeadline, UObject* InOwner, APOClaudeAPIManager* InManager);
+
+	const int32 RequestId;
+
+	// 이 시각이 지나면 대기열/전송 여부와 관계없이 TimedOut (FPlatformTime::Seconds 기준)
+	const double Deadline;
+
+	bool IsCancelRequested() const { return bCancelRequested.load(std::memory_order_acquire); }
+
+	// 취소 플래그 설정. 처음 설정했으면 true
+	bool RequestCancel() { return !bCancelRequested.exchange(true, std::memory_order_acq_rel); }
+
+	EClaudeRequestOutcome GetOutcome() const { return static_cast<EClaudeRequestOutcome>(Outcome.load(std::memory_order_acquire)); }
+	bool IsSettled() const { return GetOutcome() != EClaudeRequestOutcome::Pending; }
+
+	// 결과 확정 (이미 확정됐으면 false, 아무것도 바꾸지 않음)
+	bool Settle(EClaudeRequestOutcome InOutcome, bool bSuccess, const FString& Text);
+
+	TSharedFuture<FClaudeRequestResult> GetFuture() const { return Future; }
+
+	// 지연 목표를 넘겨 폴백 대사로 먼저 확정했는지 (실제 응답은 후속으로만 전달)
+	bool IsHedged() const { return bHedged.load(std::memory_order_acquire); }
+	void MarkHedged() { bHedged.store(true, std::memory_order_release); }
+
+	// 게임 스레드 전용: 바인딩 당시 소유자가 있었는데 지금은 소멸했는지
+	bool IsOwnerGone() const { return bHasOwner && !Owner.IsValid(); }
+
+	// 게임 스레드 전용: 전송 중인 HTTP 요청 (취소 시 중단용)
+	TWeakPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest;
+
+	TWeakObjectPtr<APOClaudeAPIManager> Manager;
+
+private:
+	TWeakObjectPtr<UObject> Owner;
+	const bool bHasOwner;
+
+	std::atomic<bool> bCancelRequested { false };
+	std::atomic<bool> bHedged { false };
+	std::atomic<uint8> Outcome { static_cast<uint8>(EClaudeRequestOutcome::Pending) };
+
+	TPromise<FClaudeRequestResult> Promise;
+	TSharedFuture<FClaudeRequestResult> Future;
+};
+
+/**
+ * Claude 요청 핸들 (EnqueueRequest 반환값)
+ * 복사 가능한 얕은 참조이며, 마지막 핸들이 사라져도 요청 자체는 계속 진행된다.
+ * Cancel은 어느 스레드에서나 부를 수 있고, 대기열 제거/HTTP 중단은 게임 스레드에서 처리된다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeRequestHandle
+{
+public:
+	FPOClaudeRequestHandle() = default;
+	explicit FPOClaudeRequestHandle(TSharedPtr<FPOClaudeRequestState, ESPMode::ThreadSafe> InState)
+		: State(MoveTemp(InState))
+	{
+	}
+
+	bool IsValid() const { return State.IsValid(); }
+
+	// 대기 중이면 대기열에서 빼고, 전송 중이면 HTTP 요청을 중단 (콜백은 호출되지 않음)
+	// 폴백으로 이미 답한 요청도 후속 응답을 기다리는 중이면 중단한다
+	void Cancel();
+
+	bool IsCancelled() const { return State && State->GetOutcome() == EClaudeRequestOutcome::Cancelled; }
+	bool IsDone() const { return State && State->IsSettled(); }
+
+	EClaudeRequestOutcome GetOutcome() const { return State ? State->GetOutcome() : EClaudeRequestOutcome::Pending; }
+
+	int32 GetRequestId() const { return State ? State->RequestId : 0; }
+
+	// 결과 퓨처 (Then/Wait 가능, 게임 스레드에서 Wait하면 응답이 올 때까지 멈추므로 주의)
+	TSharedFuture<FClaudeRequestResult> GetFuture() const;
+
+	void Reset() { State.Reset(); }
+
+private:
+	TSharedPtr<FPOClaudeRequestState, ESPMode::ThreadSafe> State;
+};
@@ -0,0 +1,385 @@
+#include "POClaudeRequestWriter.h"
+#include "HAL/IConsoleManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+FPOJsonUtf8Writer::FPOJsonUtf8Writer(TArray<uint8>& InBuffer)
+	: Buffer(InBuffer)
+{
+	Buffer.Reset();
+	FMemory::Memzero(NeedComma, sizeof(NeedComma));
+}
+
+void FPOJsonUtf8Writer::BeforeValue()
+{
+	if (bAfterKey)
+	{
+		bAfterKey = false;
+		return;
+	}
+
+	if (NeedComma[Depth])
+	{
+		RawChar(',');
+	}
+	NeedComma[Depth] = true;
+}
+
+void FPOJsonUtf8Writer::BeginObject()
+{
+	BeforeValue();
+	RawChar('{');
+	check(Depth + 1 < MaxDepth);
+	NeedComma[++Depth] = false;
+}
+
+void FPOJsonUtf8Writer::EndObject()
+{
+	--Depth;
+	RawChar('}');
+}
+
+void FPOJsonUtf8Writer::BeginArray()
+{
+	BeforeValue();
+	RawChar('[');
+	check(Depth + 1 < MaxDepth);
+	NeedComma[++Depth] = false;
+}
+
+void FPOJsonUtf8Writer::EndArray()
+{
+	--Depth;
+	RawChar(']');
+}
+
+void FPOJsonUtf8Writer::Key(const ANSICHAR* Name)
+{
+	BeforeValue();
+	RawChar('"');
+	Raw(Name, FCStringAnsi::Strlen(Name));
+	RawChar('"');
+	RawChar(':');
+	bAfterKey = true;
+}
+
+void FPOJsonUtf8Writer::String(const TCHAR* Value, int32 Len)
+{
+	BeforeValue();
+	RawChar('"');
+	AppendEscaped(Value, Len);
+	RawChar('"');
+}
+
+void FPOJsonUtf8Writer::AsciiString(const ANSICHAR* Value)
+{
+	BeforeValue();
+	RawChar('"');
+	Raw(Value, FCStringAnsi::Strlen(Value));
+	RawChar('"');
+}
+
+void FPOJsonUtf8Writer::Number(int32 Value)
+{
+	BeforeValue();
+
+	ANSICHAR Digits[12];
+	int32 Pos = UE_ARRAY_COUNT(Digits);
+	uint32 Magnitude = Value < 0 ? 0u - static_cast<uint32>(Value) : static_cast<uint32>(Value);
+
+	do
+	{
+		Digits[--Pos] = static_cast<ANSICHAR>('0' + Magnitude % 10);
+		Magnitude /= 10;
+	}
+	while (Magnitude != 0);
+
+	if (Value < 0)
+	{
+		Digits[--Pos] = '-';
+	}
+
+	Raw(Digits + Pos, UE_ARRAY_COUNT(Digits) - Pos);
+}
+
+void FPOJsonUtf8Writer::Bool(bool bValue)
+{
+	BeforeValue();
+	if (bValue)
+	{
+		Raw("true", 4);
+	}
+	else
+	{
+		Raw("false", 5);
+	}
+}
+
+void FPOJsonUtf8Writer::Raw(const ANSICHAR* Text, int32 Len)
+{
+	Buffer.Append(reinterpret_cast<const uint8*>(Text), Len);
+}
+
+void FPOJsonUtf8Writer::AppendEscaped(const TCHAR* Value, int32 Len)
+{
+	static const ANSICHAR HexDigits[] = "0123456789abcdef";
+
+	// 최악의 경우(제어 문자 \u00XX) 문자당 6바이트. 한 번만 확보하고 포인터로 직접 기록
+	const int32 Start = Buffer.Num();
+	Buffer.Reserve(Start + Len * 6);
+	uint8* Out = Buffer.GetData() + Start;
+	uint8* const OutBegin = Out;
+
+	for (int32 i = 0; i < Len; ++i)
+	{
+		uint32 CodePoint = static_cast<uint32>(Value[i]);
+
+		if (CodePoint < 0x80)
+		{
+			switch (CodePoint)
+			{
+			case '"':  *Out++ = '\\'; *Out++ = '"';  break;
+			case '\\': *Out++ = '\\'; *Out++ = '\\'; break;
+			case '\n': *Out++ = '\\'; *Out++ = 'n';  break;
+			case '\r': *Out++ = '\\'; *Out++ = 'r';  break;
+			case '\t': *Out++ = '\\'; *Out++ = 't';  break;
+			case '\b': *Out++ = '\\'; *Out++ = 'b';  break;
+			case '\f': *Out++ = '\\'; *Out++ = 'f';  break;
+			default:
+				if (CodePoint < 0x20)
+				{
+					*Out++ = '\\'; *Out++ = 'u'; *Out++ = '0'; *Out++ = '0';
+					*Out++ = HexDigits[CodePoint >> 4];
+					*Out++ = HexDigits[CodePoint & 0xF];
+				}
+				else
+				{
+					*Out++ = static_cast<uint8>(CodePoint);
+				}
+				break;
+			}
+			continue;
+		}
+
+		// UTF-16 서로게이트 쌍 결합 (짝이 없으면 U+FFFD)
+		if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF)
+		{
+			const uint32 Low = (i + 1 < Len) ? static_cast<uint32>(Value[i + 1]) : 0;
+			if (Low >= 0xDC00 && Low <= 0xDFFF)
+			{
+				CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+				++i;
+			}
+			else
+			{
+				CodePoint = 0xFFFD;
+			}
+		}
+		else if (CodePoint >= 0xDC00 && CodePoint <= 0xDFFF)
+		{
+			CodePoint = 0xFFFD;
+		}
+
+		if (CodePoint < 0x800)
+		{
+			*Out++ = static_cast<uint8>(0xC0 | (CodePoint >> 6));
+			*Out++ = static_cast<uint8>(0x80 | (CodePoint & 0x3F));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			*Out++ = static_cast<uint8>(0xE0 | (CodePoint >> 12));
+			*Out++ = static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F));
+			*Out++ = static_cast<uint8>(0x80 | (CodePoint & 0x3F));
+		}
+		else
+		{
+			*Out++ = static_cast<uint8>(0xF0 | (CodePoint >> 18));
+			*Out++ = static_cast<uint8>(0x80 | ((CodePoint >> 12) & 0x3F));
+			*Out++ = static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F));
+			*Out++ = static_cast<uint8>(0x80 | (CodePoint & 0x3F));
+		}
+	}
+
+	Buffer.SetNumUninitialized(Start + static_cast<int32>(Out - OutBegin), EAllowShrinking::No);
+}
+
+void POClaudeRequestWriter::WriteRequestBody(const FPOClaudeRequestBodyParams& Params, TArray<uint8>& OutBody)
+{
+	// 널 포인터 대비용 (삼항 연산으로 임시 FString이 복사되지 않도록 참조로 사용)
+	static const FString EmptyString;
+
+	FPOJsonUtf8Writer Writer(OutBody);
+
+	Writer.BeginObject();
+
+	Writer.Key("model");
+	Writer.String(Params.Model ? *Params.Model : EmptyString);
+
+	Writer.Key("max_tokens");
+	Writer.Number(Params.MaxTokens);
+
+	if (Params.bStream)
+	{
+		Writer.Key("stream");
+		Writer.Bool(true);
+	}
+
+	// system: [정적 페르소나/규칙 (cache_control), 동적 날씨/시간]
+	Writer.Key("system");
+	Writer.BeginArray();
+	if (Params.StaticSystem)
+	{
+		Writer.BeginObject();
+		Writer.Key("type");
+		Writer.AsciiString("text");
+		Writer.Key("text");
+		Writer.String(*Params.StaticSystem);
+		if (Params.bCacheStaticSystem)
+		{
+			Writer.Key("cache_control");
+			Writer.BeginObject();
+			Writer.Key("type");
+			Writer.AsciiString("ephemeral");
+			Writer.EndObject();
+		}
+		Writer.EndObject();
+	}
+	if (Params.DynamicSystem)
+	{
+		Writer.BeginObject();
+		Writer.Key("type");
+		Writer.AsciiString("text");
+		Writer.Key("text");
+		Writer.String(*Params.DynamicSystem);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+
+	Writer.Key("messages");
+	Writer.BeginArray();
+	for (const FPOClaudeMessageView& Message : Params.Messages)
+	{
+		Writer.BeginObject();
+		Writer.Key("role");
+		Writer.AsciiString(Message.Role);
+		Writer.Key("content");
+		Writer.String(Message.Content ? *Message.Content : EmptyString);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+
+	Writer.EndObject();
+}
+
+#if !UE_BUILD_SHIPPING
+
+namespace POClaudeRequestWriterBench
+{
+	// 이전 BuildRequestJson 경로 재현: FJsonObject DOM → UTF-16 FString → UTF-8 변환
+	static void WriteWithJsonDom(const FPOClaudeRequestBodyParams& Params, TArray<uint8>& OutBody)
+	{
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("model"),      *Params.Model);
+		Root->SetNumberField(TEXT("max_tokens"), Params.MaxTokens);
+		Root->SetBoolField(TEXT("stream"),       Params.bStream);
+
+		TArray<TSharedPtr<FJsonValue>> SystemBlocks;
+		TSharedRef<FJsonObject> StaticBlock = MakeShared<FJsonObject>();
+		StaticBlock->SetStringField(TEXT("type"), TEXT("text"));
+		StaticBlock->SetStringField(TEXT("text"), *Params.StaticSystem);
+		TSharedRef<FJsonObject> CacheControl = MakeShared<FJsonObject>();
+		CacheControl->SetStringField(TEXT("type"), TEXT("ephemeral"));
+		StaticBlock->SetObjectField(TEXT("cache_control"), CacheControl);
+		SystemBlocks.Add(MakeShared<FJsonValueObject>(StaticBlock));
+		TSharedRef<FJsonObject> DynamicBlock = MakeShared<FJsonObject>();
+		DynamicBlock->SetStringField(TEXT("type"), TEXT("text"));
+		DynamicBlock->SetStringField(TEXT("text"), *Params.DynamicSystem);
+		SystemBlocks.Add(MakeShared<FJsonValueObject>(DynamicBlock));
+		Root->SetArrayField(TEXT("system"), SystemBlocks);
+
+		TArray<TSharedPtr<FJsonValue>> Messages;
+		for (const FPOClaudeMessageView& Message : Params.Messages)
+		{
+			TSharedRef<FJsonObject> Msg = MakeShared<FJsonObject>();
+			Msg->SetStringField(TEXT("role"),    ANSI_TO_TCHAR(Message.Role));
+			Msg->SetStringField(TEXT("content"), *Message.Content);
+			Messages.Add(MakeShared<FJsonValueObject>(Msg));
+		}
+		Root->SetArrayField(TEXT("messages"), Messages);
+
+		FString Output;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		FJsonSerializer::Serialize(Root, Writer);
+
+		// SetContentAsString 내부 변환과 동일
+		const FTCHARToUTF8 Converted(*Output, Output.Len());
+		OutBody.Reset();
+		OutBody.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	static double TimePerCall(int32 Iterations, TFunctionRef<void()> Body)
+	{
+		const double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			Body();
+		}
+		return (FPlatformTime::Seconds() - Start) / Iterations;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 20000;
+
+		const FString Model = TEXT("claude-haiku-4-5");
+		const FString StaticSystem = FString::ChrN(300, TEXT('규')) + TEXT("\n\"규칙\"\t1. 반드시 한국어로만 답하세요.\n");
+		const FString DynamicSystem = TEXT("## 현재 환경 정보\n- 날씨: 비\n- 시간: 19.5시 (저녁)\n");
+
+		TArray<FString> Turns;
+		for (int32 i = 0; i < 20; ++i)
+		{
+			Turns.Add(FString::Printf(TEXT("%d번째 대화: 오늘 비가 오네요. \"우산\" 있으세요?"), i));
+		}
+
+		for (const int32 NumTurns : { 1, 20 })
+		{
+			TArray<FPOClaudeMessageView> Views;
+			for (int32 i = 0; i < NumTurns; ++i)
+			{
+				FPOClaudeMessageView& View = Views.AddDefaulted_GetRef();
+				// 마지막이 user가 되도록 뒤에서부터 번갈아 배치
+				View.Role = ((NumTurns - 1 - i) % 2 == 0) ? "user" : "assistant";
+				View.Content = &Turns[i];
+			}
+
+			FPOClaudeRequestBodyParams Params;
+			Params.Model = &Model;
+			Params.MaxTokens = 200;
+			Params.bStream = true;
+			Params.StaticSystem = &StaticSystem;
+			Params.DynamicSystem = &DynamicSystem;
+			Params.Messages = Views;
+
+			TArray<uint8> DomBody;
+			TArray<uint8> DirectBody;
+
+			const double DomSeconds = TimePerCall(Iterations, [&]() { WriteWithJsonDom(Params, DomBody); });
+			const double DirectSeconds = TimePerCall(Iterations, [&]() { POClaudeRequestWriter::WriteRequestBody(Params, DirectBody); });
+
+			UE_LOG(LogTemp, Display,
+				TEXT("[ClaudeRequestWriter] %2d턴: DOM %.2f us (%d bytes) / 직접 기록 %.2f us (%d bytes) → %.1fx"),
+				NumTurns,
+				DomSeconds * 1e6, DomBody.Num(),
+				DirectSeconds * 1e6, DirectBody.Num(),
+				DirectSeconds > 0.0 ? DomSeconds / DirectSeconds : 0.0);
+		}
+	}
+}
+
+static FAutoConsoleCommand GPOClaudeBenchRequestWriterCmd(
+	TEXT("Claude.BenchRequestWriter"),
+	TEXT("요청 본문 직렬화 마이크로벤치마크 (FJsonObject DOM vs UTF-8 직접 기록). 인자: [반복 횟수]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&POClaudeRequestWriterBench::Run));
+
+#endif // !UE_BUILD_SHIPPING
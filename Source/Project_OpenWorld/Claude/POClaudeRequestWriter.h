@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * DOM 없이 UTF-8 바이트 버퍼에 바로 JSON을 쓰는 최소 스트리밍 라이터
+ * 문자열은 UTF-16 → UTF-8 변환과 이스케이프를 한 번에 처리한다.
+ * 버퍼는 호출자가 재사용하므로 예열 이후에는 할당이 발생하지 않는다.
+ */
+class PROJECT_OPENWORLD_API FPOJsonUtf8Writer
+{
+public:
+	explicit FPOJsonUtf8Writer(TArray<uint8>& InBuffer);
+
+	void BeginObject();
+	void EndObject();
+	void BeginArray();
+	void EndArray();
+
+	// 키는 ASCII 리터럴만 사용 (이스케이프 생략)
+	void Key(const ANSICHAR* Name);
+
+	void String(const FString& Value) { String(*Value, Value.Len()); }
+	void String(const TCHAR* Value, int32 Len);
+
+	// ASCII 리터럴 값 (이스케이프 생략)
+	void AsciiString(const ANSICHAR* Value);
+
+	void Number(int32 Value);
+	void Bool(bool bValue);
+
+private:
+	TArray<uint8>& Buffer;
+
+	// 깊이별 "다음 값 앞에 쉼표 필요" 여부
+	static constexpr int32 MaxDepth = 16;
+	bool NeedComma[MaxDepth];
+	int32 Depth = 0;
+
+	// 바로 앞이 키였으면 값 앞에 쉼표를 쓰지 않음
+	bool bAfterKey = false;
+
+	void BeforeValue();
+	void Raw(const ANSICHAR* Text, int32 Len);
+	void RawChar(ANSICHAR Ch) { Buffer.Add(static_cast<uint8>(Ch)); }
+	void AppendEscaped(const TCHAR* Value, int32 Len);
+};
+
+/** 요청 본문 메시지 1개 (문자열은 호출자 소유) */
+struct FPOClaudeMessageView
+{
+	// "user" / "assistant"
+	const ANSICHAR* Role = "user";
+	const FString* Content = nullptr;
+};
+
+/** /v1/messages 요청 본문 구성 요소 (모두 호출자 소유, 복사 없음) */
+struct FPOClaudeRequestBodyParams
+{
+	const FString* Model = nullptr;
+	int32 MaxTokens = 200;
+	bool bStream = false;
+
+	// 캐시 대상 정적 시스템 블록
+	const FString* StaticSystem = nullptr;
+	bool bCacheStaticSystem = true;
+
+	// 매 요청 바뀌는 동적 시스템 블록
+	const FString* DynamicSystem = nullptr;
+
+	TArrayView<const FPOClaudeMessageView> Messages;
+};
+
+namespace POClaudeRequestWriter
+{
+	// 요청 본문을 OutBody에 UTF-8로 기록 (기존 내용은 지움, 용량은 유지)
+	PROJECT_OPENWORLD_API void WriteRequestBody(const FPOClaudeRequestBodyParams& Params, TArray<uint8>& OutBody);
+}
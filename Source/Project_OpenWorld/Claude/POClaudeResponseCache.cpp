@@ -0,0 +1,511 @@
+#include "POClaudeResponseCache.h"
+#include "POClaudeTypes.h"
+#include "Hash/CityHash.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/FileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace POClaudeCache
+{
+	// FPOClaudePromptBuilder::BuildDynamicBlock의 묘사 구간과 동일한 경계로 양자화 (프롬프트가 같으면 키도 같도록)
+	static uint8 Band(float Value, float Low, float High)
+	{
+		return Value > High ? 2 : (Value > Low ? 1 : 0);
+	}
+}
+
+FPOClaudeResponseCache::FPOClaudeResponseCache()
+{
+}
+
+FPOClaudeResponseCache::~FPOClaudeResponseCache()
+{
+	UnmapFile();
+}
+
+void FPOClaudeResponseCache::Configure(int64 InMemoryBudgetBytes, int32 InVariantsPerKey)
+{
+	MemoryBudgetBytes = FMath::Max<int64>(InMemoryBudgetBytes, 1024);
+	VariantsPerKey    = FMath::Max(InVariantsPerKey, 1);
+	EvictToBudget();
+}
+
+uint64 FPOClaudeResponseCache::MakeKey(const FClaudeRequestContext& Context, const FString& TimePeriodName)
+{
+	using namespace POClaudeCache;
+
+	const FString Composite = FString::Printf(TEXT("%s\x1F%s\x1F%s\x1F%s\x1F%d%d%d\x1F%s"),
+		*Context.NPCName,
+		*Context.NPCPersonality,
+		*Context.WeatherType,
+		*TimePeriodName,
+		Band(Context.RainIntensity, 0.1f, 0.5f),
+		Band(Context.SnowCoverage,  0.1f, 0.5f),
+		Band(Context.WindStrength,  0.3f, 0.7f),
+		*NormalizeMessage(Context.PlayerMessage));
+
+	return CityHash64(reinterpret_cast<const char*>(*Composite), Composite.Len() * sizeof(TCHAR));
+}
+
+FString FPOClaudeResponseCache::NormalizeMessage(const FString& Message)
+{
+	FString Result;
+	Result.Reserve(Message.Len());
+
+	for (const TCHAR Ch : Message)
+	{
+		if (FChar::IsWhitespace(Ch) || FChar::IsPunct(Ch) || Ch == TEXT('~') || Ch == TEXT('…'))
+		{
+			continue;
+		}
+		Result.AppendChar(FChar::ToLower(Ch));
+	}
+
+	return Result;
+}
+
+int32 FPOClaudeResponseCache::Num() const
+{
+	int32 NumColdOnly = 0;
+	for (const TPair<uint64, FColdRecord>& Pair : ColdIndex)
+	{
+		if (!Index.Contains(Pair.Key))
+		{
+			++NumColdOnly;
+		}
+	}
+	return Index.Num() + NumColdOnly;
+}
+
+bool FPOClaudeResponseCache::Find(uint64 Key, FString& OutText)
+{
+	int32 Slot = INDEX_NONE;
+	if (const int32* Found = Index.Find(Key))
+	{
+		Slot = *Found;
+	}
+	else if (ColdIndex.Contains(Key))
+	{
+		Slot = PromoteCold(Key);
+	}
+
+	if (Slot == INDEX_NONE)
+	{
+		++Misses;
+		return false;
+	}
+
+	Touch(Slot);
+
+	const FEntry& Entry = Entries[Slot];
+	if (Entry.Variants.Num() < VariantsPerKey)
+	{
+		// 변형이 덜 모였으면 API에서 새 변형을 받아오도록 미스
+		++Misses;
+		return false;
+	}
+
+	OutText = Entry.Variants[FMath::RandHelper(Entry.Variants.Num())];
+	++Hits;
+	return true;
+}
+
+void FPOClaudeResponseCache::Add(uint64 Key, const FString& Text)
+{
+	if (Text.IsEmpty())
+	{
+		return;
+	}
+
+	int32 Slot = INDEX_NONE;
+	if (const int32* Found = Index.Find(Key))
+	{
+		Slot = *Found;
+	}
+	else if (ColdIndex.Contains(Key))
+	{
+		Slot = PromoteCold(Key);
+	}
+
+	if (Slot == INDEX_NONE)
+	{
+		Slot = AddEntry(Key);
+	}
+
+	FEntry& Entry = Entries[Slot];
+	if (!Entry.Variants.Contains(Text))
+	{
+		if (Entry.Variants.Num() >= VariantsPerKey)
+		{
+			Entry.Variants.RemoveAt(0);
+		}
+		Entry.Variants.Add(Text);
+
+		MemoryUsage -= Entry.Bytes;
+		RecalculateBytes(Entry);
+		MemoryUsage += Entry.Bytes;
+	}
+
+	Touch(Slot);
+	EvictToBudget();
+}
+
+int32 FPOClaudeResponseCache::AddEntry(uint64 Key)
+{
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+		Entries[Slot] = FEntry();
+	}
+	else
+	{
+		Slot = Entries.AddDefaulted();
+	}
+
+	FEntry& Entry = Entries[Slot];
+	Entry.Key = Key;
+	RecalculateBytes(Entry);
+	MemoryUsage += Entry.Bytes;
+
+	Index.Add(Key, Slot);
+	LinkFront(Slot);
+	return Slot;
+}
+
+void FPOClaudeResponseCache::RemoveEntry(int32 Slot)
+{
+	FEntry& Entry = Entries[Slot];
+	Unlink(Slot);
+	Index.Remove(Entry.Key);
+	MemoryUsage -= Entry.Bytes;
+
+	Entry.Variants.Empty();
+	Entry.Bytes = 0;
+	FreeSlots.Add(Slot);
+}
+
+void FPOClaudeResponseCache::LinkFront(int32 Slot)
+{
+	FEntry& Entry = Entries[Slot];
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = Head;
+
+	if (Head != INDEX_NONE)
+	{
+		Entries[Head].Prev = Slot;
+	}
+	Head = Slot;
+
+	if (Tail == INDEX_NONE)
+	{
+		Tail = Slot;
+	}
+}
+
+void FPOClaudeResponseCache::Unlink(int32 Slot)
+{
+	FEntry& Entry = Entries[Slot];
+
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		Head = Entry.Next;
+	}
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+	else
+	{
+		Tail = Entry.Prev;
+	}
+
+	Entry.Prev = Entry.Next = INDEX_NONE;
+}
+
+void FPOClaudeResponseCache::Touch(int32 Slot)
+{
+	if (Head == Slot)
+	{
+		return;
+	}
+
+	Unlink(Slot);
+	LinkFront(Slot);
+}
+
+void FPOClaudeResponseCache::EvictToBudget()
+{
+	// 방금 사용한 엔트리(Head) 하나는 예산을 넘더라도 남긴다
+	while (MemoryUsage > MemoryBudgetBytes && Tail != INDEX_NONE && Tail != Head)
+	{
+		RemoveEntry(Tail);
+	}
+}
+
+void FPOClaudeResponseCache::RecalculateBytes(FEntry& Entry)
+{
+	Entry.Bytes = sizeof(FEntry) + Entry.Variants.GetAllocatedSize();
+	for (const FString& Variant : Entry.Variants)
+	{
+		Entry.Bytes += Variant.GetAllocatedSize();
+	}
+}
+
+int32 FPOClaudeResponseCache::PromoteCold(uint64 Key)
+{
+	// 디스크 레코드는 남겨 둠 (메모리에서 밀려난 뒤 다시 조회하거나 저장할 때 사용)
+	const FColdRecord* Record = ColdIndex.Find(Key);
+	if (!Record || !ColdData)
+	{
+		return INDEX_NONE;
+	}
+
+	TArray<FString> Variants;
+	if (!ReadVariants(ColdData + Record->Offset + sizeof(uint64), Record->Size - sizeof(uint64), Variants))
+	{
+		ColdIndex.Remove(Key);
+		return INDEX_NONE;
+	}
+
+	const int32 Slot = AddEntry(Key);
+	FEntry& Entry = Entries[Slot];
+
+	// 설정이 줄었다면 최근 변형만 유지
+	const int32 Excess = Variants.Num() - VariantsPerKey;
+	if (Excess > 0)
+	{
+		Variants.RemoveAt(0, Excess);
+	}
+	Entry.Variants = MoveTemp(Variants);
+
+	MemoryUsage -= Entry.Bytes;
+	RecalculateBytes(Entry);
+	MemoryUsage += Entry.Bytes;
+
+	EvictToBudget();
+	return Index.Contains(Key) ? Index[Key] : INDEX_NONE;
+}
+
+bool FPOClaudeResponseCache::ReadVariants(const uint8* Data, int64 Size, TArray<FString>& OutVariants)
+{
+	if (Size < static_cast<int64>(sizeof(uint32)))
+	{
+		return false;
+	}
+
+	uint32 Count = 0;
+	FMemory::Memcpy(&Count, Data, sizeof(uint32));
+	int64 Cursor = sizeof(uint32);
+
+	OutVariants.Reset(Count);
+	for (uint32 i = 0; i < Count; ++i)
+	{
+		uint32 Len = 0;
+		if (Cursor + static_cast<int64>(sizeof(uint32)) > Size)
+		{
+			return false;
+		}
+		FMemory::Memcpy(&Len, Data + Cursor, sizeof(uint32));
+		Cursor += sizeof(uint32);
+
+		if (Cursor + Len > Size)
+		{
+			return false;
+		}
+
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Cursor), Len);
+		OutVariants.Emplace(Converted.Length(), Converted.Get());
+		Cursor += Len;
+	}
+
+	return true;
+}
+
+void FPOClaudeResponseCache::WriteRecord(FArchive& Ar, uint64 Key, const TArray<FString>& Variants)
+{
+	Ar << Key;
+
+	uint32 Count = Variants.Num();
+	Ar << Count;
+
+	for (const FString& Variant : Variants)
+	{
+		const FTCHARToUTF8 Utf8(*Variant, Variant.Len());
+		uint32 Len = Utf8.Length();
+		Ar << Len;
+		Ar.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Len);
+	}
+}
+
+bool FPOClaudeResponseCache::LoadFromDisk(const FString& FilePath)
+{
+	if (!MapFile(FilePath))
+	{
+		return false;
+	}
+
+	// 헤더 검증 후 레코드 위치만 색인 (본문은 조회 시점에 변환)
+	uint32 Header[3] = { 0, 0, 0 };
+	if (ColdSize < static_cast<int64>(sizeof(Header)))
+	{
+		UnmapFile();
+		return false;
+	}
+	FMemory::Memcpy(Header, ColdData, sizeof(Header));
+
+	if (Header[0] != FileMagic || Header[1] != FileVersion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeResponseCache] 캐시 파일 형식이 맞지 않아 무시합니다: %s"), *FilePath);
+		UnmapFile();
+		return false;
+	}
+
+	ColdIndex.Reset();
+	int64 Cursor = sizeof(Header);
+
+	for (uint32 i = 0; i < Header[2]; ++i)
+	{
+		const int64 RecordStart = Cursor;
+		if (Cursor + static_cast<int64>(sizeof(uint64) + sizeof(uint32)) > ColdSize)
+		{
+			break;
+		}
+
+		uint64 Key = 0;
+		uint32 Count = 0;
+		FMemory::Memcpy(&Key, ColdData + Cursor, sizeof(uint64));
+		Cursor += sizeof(uint64);
+		FMemory::Memcpy(&Count, ColdData + Cursor, sizeof(uint32));
+		Cursor += sizeof(uint32);
+
+		bool bValid = true;
+		for (uint32 v = 0; v < Count && bValid; ++v)
+		{
+			uint32 Len = 0;
+			if (Cursor + static_cast<int64>(sizeof(uint32)) > ColdSize)
+			{
+				bValid = false;
+				break;
+			}
+			FMemory::Memcpy(&Len, ColdData + Cursor, sizeof(uint32));
+			Cursor += sizeof(uint32) + Len;
+			bValid = Cursor <= ColdSize;
+		}
+
+		if (!bValid)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[ClaudeResponseCache] 손상된 레코드 이후는 무시합니다. (%u/%u)"), i, Header[2]);
+			break;
+		}
+
+		// 이미 메모리에 있는 키도 색인 (조회는 메모리 쪽이 우선, 메모리에서 밀려나면 이 레코드로 복구)
+		FColdRecord& Record = ColdIndex.Add(Key);
+		Record.Offset = RecordStart;
+		Record.Size   = Cursor - RecordStart;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ClaudeResponseCache] 디스크 캐시 매핑 완료: %d개 (%lld bytes)"), ColdIndex.Num(), ColdSize);
+	return true;
+}
+
+bool FPOClaudeResponseCache::SaveToDisk(const FString& FilePath)
+{
+	const FString TempPath = FilePath + TEXT(".tmp");
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeResponseCache] 캐시 파일을 쓸 수 없습니다: %s"), *TempPath);
+		return false;
+	}
+
+	uint32 Header[3] = { FileMagic, FileVersion, static_cast<uint32>(Num()) };
+	Writer->Serialize(Header, sizeof(Header));
+
+	// 최근 사용 순으로 기록
+	for (int32 Slot = Head; Slot != INDEX_NONE; Slot = Entries[Slot].Next)
+	{
+		WriteRecord(*Writer, Entries[Slot].Key, Entries[Slot].Variants);
+	}
+
+	// 메모리에 없는 레코드(로드하지 않았거나 밀려난 것)는 매핑된 원본 바이트를 그대로 복사
+	for (const TPair<uint64, FColdRecord>& Pair : ColdIndex)
+	{
+		if (Index.Contains(Pair.Key))
+		{
+			continue;
+		}
+		Writer->Serialize(const_cast<uint8*>(ColdData + Pair.Value.Offset), Pair.Value.Size);
+	}
+
+	const bool bWriteOk = Writer->Close();
+	Writer.Reset();
+
+	// 교체 전에 매핑 해제 (Windows는 매핑된 파일을 덮어쓸 수 없음)
+	UnmapFile();
+	ColdIndex.Reset();
+
+	if (!bWriteOk || !IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ClaudeResponseCache] 캐시 파일 저장 실패: %s"), *FilePath);
+		IFileManager::Get().Delete(*TempPath);
+		return false;
+	}
+
+	// 저장한 파일을 다시 매핑 (이후 메모리에서 밀려나는 레코드도 디스크에서 다시 읽을 수 있도록)
+	LoadFromDisk(FilePath);
+	return true;
+}
+
+bool FPOClaudeResponseCache::MapFile(const FString& FilePath)
+{
+	UnmapFile();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*FilePath))
+	{
+		return false;
+	}
+
+	FOpenMappedResult Result = PlatformFile.OpenMappedEx(*FilePath);
+	if (!Result.HasError())
+	{
+		MappedFile = Result.StealValue();
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	}
+
+	if (MappedRegion)
+	{
+		ColdData = MappedRegion->GetMappedPtr();
+		ColdSize = MappedRegion->GetMappedSize();
+		return true;
+	}
+
+	// 매핑 미지원 플랫폼: 통째로 읽어서 동일하게 사용
+	MappedFile.Reset();
+	if (!FFileHelper::LoadFileToArray(FallbackBuffer, *FilePath))
+	{
+		return false;
+	}
+
+	ColdData = FallbackBuffer.GetData();
+	ColdSize = FallbackBuffer.Num();
+	return true;
+}
+
+void FPOClaudeResponseCache::UnmapFile()
+{
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	FallbackBuffer.Empty();
+	ColdData = nullptr;
+	ColdSize = 0;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FClaudeRequestContext;
+
+/**
+ * Claude 응답 LRU 캐시
+ * 키 = NPC + 날씨 + 시간대 + 양자화된 RVT 수치 + 정규화된 플레이어 메시지.
+ * 메모리 예산을 넘으면 가장 오래 쓰지 않은 키부터 제거하고,
+ * 디스크 파일은 메모리 매핑으로 열어 실제로 조회된 레코드만 메모리에 올린다.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeResponseCache
+{
+public:
+	FPOClaudeResponseCache();
+	~FPOClaudeResponseCache();
+
+	// 메모리 예산(바이트)과 키당 보관할 응답 변형 수 설정
+	void Configure(int64 InMemoryBudgetBytes, int32 InVariantsPerKey);
+
+	// 캐시 키 생성 (TimePeriodName은 TimeOfDayToKorean 결과)
+	static uint64 MakeKey(const FClaudeRequestContext& Context, const FString& TimePeriodName);
+
+	// 공백/문장부호 제거 + 소문자화 ("날씨 어때요?" == "날씨어때요")
+	static FString NormalizeMessage(const FString& Message);
+
+	// 변형이 VariantsPerKey개 모였으면 그중 하나 반환. 덜 모였으면 다양성 확보를 위해 미스 처리
+	bool Find(uint64 Key, FString& OutText);
+
+	// 응답 변형 추가 (이미 같은 문장이 있으면 무시)
+	void Add(uint64 Key, const FString& Text);
+
+	// 디스크 캐시를 메모리 매핑으로 연다 (레코드는 조회 시점에 로드)
+	bool LoadFromDisk(const FString& FilePath);
+
+	// 메모리 + 메모리에 없는 디스크 레코드를 합쳐 저장
+	// (이번 실행에 새로 받아 디스크에 없던 응답이 예산 초과로 밀려났다면 그 응답만 저장되지 않음)
+	bool SaveToDisk(const FString& FilePath);
+
+	// 메모리 엔트리 + 메모리에 올라오지 않은 디스크 레코드 수
+	int32 Num() const;
+	int64 GetMemoryUsage() const { return MemoryUsage; }
+	int32 GetHits() const { return Hits; }
+	int32 GetMisses() const { return Misses; }
+
+private:
+	struct FEntry
+	{
+		uint64 Key = 0;
+		TArray<FString> Variants;
+		int64 Bytes = 0;
+
+		// LRU 이중 연결 리스트 (Entries 인덱스)
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+	};
+
+	// 매핑된 파일 안 레코드 위치
+	struct FColdRecord
+	{
+		int64 Offset = 0;
+		int64 Size = 0;
+	};
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeSlots;
+	TMap<uint64, int32> Index;
+
+	// 가장 최근 / 가장 오래된 엔트리
+	int32 Head = INDEX_NONE;
+	int32 Tail = INDEX_NONE;
+
+	// 매핑된 파일의 모든 레코드. 메모리로 올린 뒤에도 남겨 두어 LRU에서 밀려나도 저장 때 잃지 않는다
+	// (같은 키가 메모리에 있으면 메모리 쪽이 우선)
+	TMap<uint64, FColdRecord> ColdIndex;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	// 매핑을 지원하지 않는 플랫폼용 대체 버퍼
+	TArray<uint8> FallbackBuffer;
+
+	const uint8* ColdData = nullptr;
+	int64 ColdSize = 0;
+
+	int64 MemoryBudgetBytes = 1024 * 1024;
+	int32 VariantsPerKey = 1;
+	int64 MemoryUsage = 0;
+
+	int32 Hits = 0;
+	int32 Misses = 0;
+
+	static constexpr uint32 FileMagic = 0x43434F50; // 'POCC'
+	static constexpr uint32 FileVersion = 1;
+
+	int32 AddEntry(uint64 Key);
+	void RemoveEntry(int32 Slot);
+	void LinkFront(int32 Slot);
+	void Unlink(int32 Slot);
+	void Touch(int32 Slot);
+	void EvictToBudget();
+	void RecalculateBytes(FEntry& Entry);
+
+	// 매핑된 레코드를 메모리로 올림
+	int32 PromoteCold(uint64 Key);
+
+	bool MapFile(const FString& FilePath);
+	void UnmapFile();
+
+	static bool ReadVariants(const uint8* Data, int64 Size, TArray<FString>& OutVariants);
+	static void WriteRecord(FArchive& Ar, uint64 Key, const TArray<FString>& Variants);
+};
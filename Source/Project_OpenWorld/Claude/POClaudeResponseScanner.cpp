@@ -0,0 +1,466 @@
+#include "POClaudeResponseScanner.h"
+
+namespace POClaudeResponseScanner
+{
+	namespace Private
+	{
+		// 중첩이 이보다 깊은 응답은 형식 오류로 간주 (재귀 스택 보호)
+		static constexpr int32 MaxDepth = 64;
+
+		struct FCursor
+		{
+			const uint8* P = nullptr;
+			const uint8* End = nullptr;
+
+			void SkipWhitespace()
+			{
+				while (P < End && (*P == ' ' || *P == '\t' || *P == '\n' || *P == '\r'))
+				{
+					++P;
+				}
+			}
+
+			bool Consume(uint8 Ch)
+			{
+				SkipWhitespace();
+				if (P < End && *P == Ch)
+				{
+					++P;
+					return true;
+				}
+				return false;
+			}
+
+			bool Peek(uint8 Ch)
+			{
+				SkipWhitespace();
+				return P < End && *P == Ch;
+			}
+		};
+
+		/** 따옴표 안의 원문 범위 (디코딩 전) */
+		struct FRawString
+		{
+			const uint8* Begin = nullptr;
+			const uint8* End = nullptr;
+			bool bEscaped = false;
+
+			bool Equals(const ANSICHAR* Literal) const
+			{
+				const int64 Len = FCStringAnsi::Strlen(Literal);
+				return !bEscaped && (End - Begin) == Len && FMemory::Memcmp(Begin, Literal, Len) == 0;
+			}
+		};
+
+		static bool ReadRawString(FCursor& C, FRawString& Out)
+		{
+			if (!C.Consume('"'))
+			{
+				return false;
+			}
+
+			Out.Begin = C.P;
+			Out.bEscaped = false;
+
+			while (C.P < C.End)
+			{
+				const uint8 Ch = *C.P;
+				if (Ch == '"')
+				{
+					Out.End = C.P++;
+					return true;
+				}
+				if (Ch == '\\')
+				{
+					Out.bEscaped = true;
+					C.P += 2;
+					continue;
+				}
+				++C.P;
+			}
+			return false;
+		}
+
+		static bool ReadHex4(const uint8* P, const uint8* End, uint32& Out)
+		{
+			if (End - P < 4)
+			{
+				return false;
+			}
+
+			Out = 0;
+			for (int32 i = 0; i < 4; ++i)
+			{
+				const uint8 Ch = P[i];
+				uint32 Digit;
+				if (Ch >= '0' && Ch <= '9')      Digit = Ch - '0';
+				else if (Ch >= 'a' && Ch <= 'f') Digit = Ch - 'a' + 10;
+				else if (Ch >= 'A' && Ch <= 'F') Digit = Ch - 'A' + 10;
+				else return false;
+				Out = (Out << 4) | Digit;
+			}
+			return true;
+		}
+
+		template <typename BufferType>
+		static void AppendUtf8(BufferType& Out, uint32 CodePoint)
+		{
+			if (CodePoint < 0x80)
+			{
+				Out.Add(static_cast<ANSICHAR>(CodePoint));
+			}
+			else if (CodePoint < 0x800)
+			{
+				Out.Add(static_cast<ANSICHAR>(0xC0 | (CodePoint >> 6)));
+				Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+			}
+			else if (CodePoint < 0x10000)
+			{
+				Out.Add(static_cast<ANSICHAR>(0xE0 | (CodePoint >> 12)));
+				Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+				Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+			}
+			else
+			{
+				Out.Add(static_cast<ANSICHAR>(0xF0 | (CodePoint >> 18)));
+				Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 12) & 0x3F)));
+				Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+				Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+			}
+		}
+
+		static bool DecodeString(const FRawString& Raw, FString& Out)
+		{
+			// 이스케이프가 없으면 UTF-8 → TCHAR 변환 한 번으로 끝
+			if (!Raw.bEscaped)
+			{
+				const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Raw.Begin), static_cast<int32>(Raw.End - Raw.Begin));
+				Out = FString(Converted.Length(), Converted.Get());
+				return true;
+			}
+
+			TArray<ANSICHAR, TInlineAllocator<512>> Unescaped;
+			Unescaped.Reserve(static_cast<int32>(Raw.End - Raw.Begin));
+
+			for (const uint8* P = Raw.Begin; P < Raw.End; )
+			{
+				if (*P != '\\')
+				{
+					Unescaped.Add(static_cast<ANSICHAR>(*P++));
+					continue;
+				}
+
+				if (P + 1 >= Raw.End)
+				{
+					return false;
+				}
+
+				const uint8 Escape = P[1];
+				P += 2;
+
+				switch (Escape)
+				{
+				case '"':  Unescaped.Add('"');  break;
+				case '\\': Unescaped.Add('\\'); break;
+				case '/':  Unescaped.Add('/');  break;
+				case 'b':  Unescaped.Add('\b'); break;
+				case 'f':  Unescaped.Add('\f'); break;
+				case 'n':  Unescaped.Add('\n'); break;
+				case 'r':  Unescaped.Add('\r'); break;
+				case 't':  Unescaped.Add('\t'); break;
+				case 'u':
+				{
+					uint32 CodePoint = 0;
+					if (!ReadHex4(P, Raw.End, CodePoint))
+					{
+						return false;
+					}
+					P += 4;
+
+					// 😀 형태의 서로게이트 쌍 결합
+					if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF)
+					{
+						uint32 Low = 0;
+						if (Raw.End - P >= 6 && P[0] == '\\' && P[1] == 'u'
+							&& ReadHex4(P + 2, Raw.End, Low) && Low >= 0xDC00 && Low <= 0xDFFF)
+						{
+							CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+							P += 6;
+						}
+						else
+						{
+							CodePoint = 0xFFFD;
+						}
+					}
+					else if (CodePoint >= 0xDC00 && CodePoint <= 0xDFFF)
+					{
+						CodePoint = 0xFFFD;
+					}
+
+					AppendUtf8(Unescaped, CodePoint);
+					break;
+				}
+				default:
+					return false;
+				}
+			}
+
+			const FUTF8ToTCHAR Converted(Unescaped.GetData(), Unescaped.Num());
+			Out = FString(Converted.Length(), Converted.Get());
+			return true;
+		}
+
+		static bool SkipValue(FCursor& C, int32 Depth);
+
+		template <typename VisitorType>
+		static bool ForEachMember(FCursor& C, int32 Depth, VisitorType&& Visitor)
+		{
+			if (Depth > MaxDepth || !C.Consume('{'))
+			{
+				return false;
+			}
+			if (C.Consume('}'))
+			{
+				return true;
+			}
+
+			do
+			{
+				FRawString Key;
+				if (!ReadRawString(C, Key) || !C.Consume(':'))
+				{
+					return false;
+				}
+				if (!Visitor(Key))
+				{
+					return false;
+				}
+			}
+			while (C.Consume(','));
+
+			return C.Consume('}');
+		}
+
+		template <typename VisitorType>
+		static bool ForEachElement(FCursor& C, int32 Depth, VisitorType&& Visitor)
+		{
+			if (Depth > MaxDepth || !C.Consume('['))
+			{
+				return false;
+			}
+			if (C.Consume(']'))
+			{
+				return true;
+			}
+
+			do
+			{
+				if (!Visitor())
+				{
+					return false;
+				}
+			}
+			while (C.Consume(','));
+
+			return C.Consume(']');
+		}
+
+		static bool SkipValue(FCursor& C, int32 Depth)
+		{
+			C.SkipWhitespace();
+			if (C.P >= C.End)
+			{
+				return false;
+			}
+
+			switch (*C.P)
+			{
+			case '"':
+			{
+				FRawString Ignored;
+				return ReadRawString(C, Ignored);
+			}
+			case '{':
+				return ForEachMember(C, Depth + 1, [&C, Depth](const FRawString&) { return SkipValue(C, Depth + 1); });
+			case '[':
+				return ForEachElement(C, Depth + 1, [&C, Depth]() { return SkipValue(C, Depth + 1); });
+			default:
+			{
+				// 숫자 / true / false / null
+				const uint8* Start = C.P;
+				while (C.P < C.End && *C.P != ',' && *C.P != '}' && *C.P != ']'
+					&& *C.P != ' ' && *C.P != '\t' && *C.P != '\n' && *C.P != '\r')
+				{
+					++C.P;
+				}
+				return C.P > Start;
+			}
+			}
+		}
+
+		static bool ReadInt(FCursor& C, int32& Out)
+		{
+			C.SkipWhitespace();
+
+			const uint8* Start = C.P;
+			bool bNegative = false;
+			if (C.P < C.End && *C.P == '-')
+			{
+				bNegative = true;
+				++C.P;
+			}
+
+			int64 Value = 0;
+			const uint8* DigitsStart = C.P;
+			while (C.P < C.End && *C.P >= '0' && *C.P <= '9')
+			{
+				Value = Value * 10 + (*C.P - '0');
+				++C.P;
+			}
+
+			if (C.P == DigitsStart)
+			{
+				// null 등 숫자가 아닌 값은 건너뜀
+				C.P = Start;
+				return SkipValue(C, 0);
+			}
+
+			Out = static_cast<int32>(FMath::Clamp<int64>(bNegative ? -Value : Value, MIN_int32, MAX_int32));
+
+			// 소수부/지수부가 있으면 버림
+			while (C.P < C.End && (*C.P == '.' || *C.P == 'e' || *C.P == 'E' || *C.P == '+' || *C.P == '-' || (*C.P >= '0' && *C.P <= '9')))
+			{
+				++C.P;
+			}
+			return true;
+		}
+
+		static bool ReadStringOrSkip(FCursor& C, int32 Depth, FString& Out)
+		{
+			if (!C.Peek('"'))
+			{
+				return SkipValue(C, Depth);
+			}
+
+			FRawString Raw;
+			return ReadRawString(C, Raw) && DecodeString(Raw, Out);
+		}
+
+		static bool ScanUsage(FCursor& C, int32 Depth, FClaudeUsage& Usage)
+		{
+			return ForEachMember(C, Depth, [&C, &Usage, Depth](const FRawString& Key)
+			{
+				if (Key.Equals("input_tokens"))                return ReadInt(C, Usage.InputTokens);
+				if (Key.Equals("output_tokens"))               return ReadInt(C, Usage.OutputTokens);
+				if (Key.Equals("cache_creation_input_tokens")) return ReadInt(C, Usage.CacheCreationInputTokens);
+				if (Key.Equals("cache_read_input_tokens"))     return ReadInt(C, Usage.CacheReadInputTokens);
+				return SkipValue(C, Depth + 1);
+			});
+		}
+
+		static bool ScanContentBlock(FCursor& C, int32 Depth, FPOClaudeScanResult& Result)
+		{
+			FString BlockType;
+			FString BlockText;
+			bool bBlockHasText = false;
+
+			const bool bOk = ForEachMember(C, Depth, [&](const FRawString& Key)
+			{
+				if (Key.Equals("type"))
+				{
+					return ReadStringOrSkip(C, Depth + 1, BlockType);
+				}
+				if (Key.Equals("text") && !Result.bHasText)
+				{
+					bBlockHasText = true;
+					return ReadStringOrSkip(C, Depth + 1, BlockText);
+				}
+				return SkipValue(C, Depth + 1);
+			});
+
+			if (bOk && bBlockHasText && !Result.bHasText && BlockType == TEXT("text"))
+			{
+				Result.Text = MoveTemp(BlockText);
+				Result.bHasText = true;
+			}
+			return bOk;
+		}
+
+		static bool ScanContentArray(FCursor& C, int32 Depth, FPOClaudeScanResult& Result)
+		{
+			return ForEachElement(C, Depth, [&C, &Result, Depth]()
+			{
+				return C.Peek('{') ? ScanContentBlock(C, Depth + 1, Result) : SkipValue(C, Depth + 1);
+			});
+		}
+
+		// content_block_delta / message_delta 의 delta
+		static bool ScanDelta(FCursor& C, int32 Depth, FPOClaudeScanResult& Result)
+		{
+			return ForEachMember(C, Depth, [&C, &Result, Depth](const FRawString& Key)
+			{
+				if (Key.Equals("text"))
+				{
+					Result.bHasText = true;
+					return ReadStringOrSkip(C, Depth + 1, Result.Text);
+				}
+				if (Key.Equals("stop_reason"))
+				{
+					return ReadStringOrSkip(C, Depth + 1, Result.StopReason);
+				}
+				return SkipValue(C, Depth + 1);
+			});
+		}
+
+		// message_start 의 message
+		static bool ScanMessage(FCursor& C, int32 Depth, FPOClaudeScanResult& Result)
+		{
+			return ForEachMember(C, Depth, [&C, &Result, Depth](const FRawString& Key)
+			{
+				if (Key.Equals("usage"))       return ScanUsage(C, Depth + 1, Result.Usage);
+				if (Key.Equals("content"))     return ScanContentArray(C, Depth + 1, Result);
+				if (Key.Equals("stop_reason")) return ReadStringOrSkip(C, Depth + 1, Result.StopReason);
+				return SkipValue(C, Depth + 1);
+			});
+		}
+
+		static bool ScanError(FCursor& C, int32 Depth, FPOClaudeScanResult& Result)
+		{
+			return ForEachMember(C, Depth, [&C, &Result, Depth](const FRawString& Key)
+			{
+				if (Key.Equals("message"))
+				{
+					return ReadStringOrSkip(C, Depth + 1, Result.ErrorMessage);
+				}
+				return SkipValue(C, Depth + 1);
+			});
+		}
+	}
+
+	bool Scan(const uint8* Data, int64 Size, FPOClaudeScanResult& OutResult)
+	{
+		using namespace Private;
+
+		if (!Data || Size <= 0)
+		{
+			return false;
+		}
+
+		FCursor C;
+		C.P = Data;
+		C.End = Data + Size;
+
+		const int32 Depth = 0;
+		return ForEachMember(C, Depth, [&C, &OutResult, Depth](const FRawString& Key)
+		{
+			if (Key.Equals("type"))        return ReadStringOrSkip(C, Depth + 1, OutResult.Type);
+			if (Key.Equals("content"))     return ScanContentArray(C, Depth + 1, OutResult);
+			if (Key.Equals("usage"))       return ScanUsage(C, Depth + 1, OutResult.Usage);
+			if (Key.Equals("stop_reason")) return ReadStringOrSkip(C, Depth + 1, OutResult.StopReason);
+			if (Key.Equals("delta"))       return ScanDelta(C, Depth + 1, OutResult);
+			if (Key.Equals("message"))     return ScanMessage(C, Depth + 1, OutResult);
+			if (Key.Equals("error"))       return ScanError(C, Depth + 1, OutResult);
+			return SkipValue(C, Depth + 1);
+		});
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "POClaudeTypes.h"
+
+/** 응답/스트림 이벤트에서 뽑아낸 필드 */
+struct FPOClaudeScanResult
+{
+	// 최상위 "type" (message, content_block_delta, message_delta, error ...)
+	FString Type;
+
+	// 첫 번째 content[] 텍스트 블록 또는 delta.text
+	FString Text;
+	bool bHasText = false;
+
+	// stop_reason 또는 delta.stop_reason
+	FString StopReason;
+
+	// usage 또는 message.usage
+	FClaudeUsage Usage;
+
+	// error.message
+	FString ErrorMessage;
+};
+
+/**
+ * Claude 응답 JSON 풀 스캐너
+ * UTF-8 본문을 한 번만 훑으며 필요한 필드만 디코딩하고 나머지 값은 건너뛴다.
+ * DOM 노드/공유 포인터를 만들지 않으며 상태가 없어 워커 스레드에서 호출해도 안전하다.
+ */
+namespace POClaudeResponseScanner
+{
+	// 본문 전체(/v1/messages 응답) 또는 SSE data 한 건 스캔. JSON 형식이 깨졌으면 false
+	PROJECT_OPENWORLD_API bool Scan(const uint8* Data, int64 Size, FPOClaudeScanResult& OutResult);
+}
@@ -0,0 +1,151 @@
+#include "POClaudeStreamParser.h"
+#include "POClaudeResponseScanner.h"
+
+bool FPOClaudeStreamParser::AppendBytes(const uint8* Data, int64 Length)
+{
+	if (!Data || Length <= 0)
+	{
+		return false;
+	}
+
+	if (RawPrefix.Num() < MaxRawPrefixBytes)
+	{
+		const int64 Copy = FMath::Min<int64>(Length, MaxRawPrefixBytes - RawPrefix.Num());
+		RawPrefix.Append(Data, static_cast<int32>(Copy));
+	}
+
+	bool bNewText = false;
+	int64 LineStart = 0;
+
+	for (int64 i = 0; i < Length; ++i)
+	{
+		if (Data[i] != '\n')
+		{
+			continue;
+		}
+
+		// 이전 조각에 남은 바이트가 없으면 수신 버퍼를 그대로 한 줄로 사용
+		const uint8* Line = Data + LineStart;
+		int32 LineLen = static_cast<int32>(i - LineStart);
+		if (LineBuffer.Num() > 0)
+		{
+			LineBuffer.Append(Line, LineLen);
+			Line = LineBuffer.GetData();
+			LineLen = LineBuffer.Num();
+		}
+		if (LineLen > 0 && Line[LineLen - 1] == '\r')
+		{
+			--LineLen;
+		}
+
+		bNewText |= ProcessLine(Line, LineLen);
+
+		LineBuffer.Reset();
+		LineStart = i + 1;
+	}
+
+	if (LineStart < Length)
+	{
+		LineBuffer.Append(Data + LineStart, static_cast<int32>(Length - LineStart));
+	}
+
+	return bNewText;
+}
+
+FString FPOClaudeStreamParser::GetRawPrefix() const
+{
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(RawPrefix.GetData()), RawPrefix.Num());
+	return FString(Converted.Length(), Converted.Get());
+}
+
+bool FPOClaudeStreamParser::ProcessLine(const uint8* Line, int32 Len)
+{
+	// 빈 줄 = 이벤트 종료
+	if (Len == 0)
+	{
+		return DispatchEvent();
+	}
+
+	// 주석 줄
+	if (Line[0] == ':')
+	{
+		return false;
+	}
+
+	// event: 이름은 message 본문의 "type"과 같으므로 data만 모아 둔다
+	static constexpr ANSICHAR DataPrefix[] = "data:";
+	static constexpr int32 DataPrefixLen = UE_ARRAY_COUNT(DataPrefix) - 1;
+
+	if (Len >= DataPrefixLen && FMemory::Memcmp(Line, DataPrefix, DataPrefixLen) == 0)
+	{
+		int32 Offset = DataPrefixLen;
+		if (Offset < Len && Line[Offset] == ' ')
+		{
+			++Offset;
+		}
+
+		if (CurrentData.Num() > 0)
+		{
+			CurrentData.Add('\n');
+		}
+		CurrentData.Append(Line + Offset, Len - Offset);
+	}
+
+	return false;
+}
+
+bool FPOClaudeStreamParser::DispatchEvent()
+{
+	bool bNewText = false;
+
+	if (CurrentData.Num() > 0)
+	{
+		FPOClaudeScanResult Event;
+		if (POClaudeResponseScanner::Scan(CurrentData.GetData(), CurrentData.Num(), Event))
+		{
+			const FString& Type = Event.Type;
+
+			if (Type == TEXT("content_block_delta"))
+			{
+				if (Event.bHasText && !Event.Text.IsEmpty())
+				{
+					AccumulatedText += Event.Text;
+					bNewText = true;
+				}
+			}
+			else if (Type == TEXT("message_start"))
+			{
+				Usage.InputTokens = Event.Usage.InputTokens;
+				Usage.CacheCreationInputTokens = Event.Usage.CacheCreationInputTokens;
+				Usage.CacheReadInputTokens = Event.Usage.CacheReadInputTokens;
+			}
+			else if (Type == TEXT("message_delta"))
+			{
+				if (!Event.StopReason.IsEmpty())
+				{
+					StopReason = MoveTemp(Event.StopReason);
+				}
+				Usage.OutputTokens = Event.Usage.OutputTokens;
+			}
+			else if (Type == TEXT("message_stop"))
+			{
+				bMessageComplete = true;
+			}
+			else if (Type == TEXT("error"))
+			{
+				if (Event.ErrorMessage.IsEmpty())
+				{
+					const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(CurrentData.GetData()), CurrentData.Num());
+					ErrorMessage = FString(Converted.Length(), Converted.Get());
+				}
+				else
+				{
+					ErrorMessage = MoveTemp(Event.ErrorMessage);
+				}
+			}
+		}
+	}
+
+	CurrentData.Reset();
+	return bNewText;
+}
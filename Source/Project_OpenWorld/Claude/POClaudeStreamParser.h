@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "POClaudeTypes.h"
+
+/**
+ * Claude Messages API 스트리밍(SSE) 응답 파서
+ * HTTP 수신 스레드에서 바이트 조각을 그대로 밀어 넣으면 완성된 이벤트 단위로
+ * content_block_delta 텍스트를 누적한다. 스레드 동기화는 호출자가 담당.
+ */
+class PROJECT_OPENWORLD_API FPOClaudeStreamParser
+{
+public:
+	// 수신 바이트 누적 후 완성된 줄/이벤트 처리. 새 텍스트가 추가되었으면 true
+	bool AppendBytes(const uint8* Data, int64 Length);
+
+	// 지금까지 받은 전체 텍스트
+	const FString& GetAccumulatedText() const { return AccumulatedText; }
+
+	const FString& GetStopReason() const { return StopReason; }
+
+	const FClaudeUsage& GetUsage() const { return Usage; }
+
+	// message_stop 이벤트를 받았는지
+	bool IsMessageComplete() const { return bMessageComplete; }
+
+	// 스트림 안에서 error 이벤트를 받았는지
+	bool HasError() const { return !ErrorMessage.IsEmpty(); }
+	const FString& GetErrorMessage() const { return ErrorMessage; }
+
+	// SSE가 아닌 응답(HTTP 오류 본문 등) 로그용 원문 앞부분
+	FString GetRawPrefix() const;
+
+private:
+	// 아직 개행을 만나지 못한 바이트
+	TArray<uint8> LineBuffer;
+
+	// 에러 로그용 원문 앞부분
+	TArray<uint8> RawPrefix;
+
+	// 현재 이벤트의 data: 원문 (UTF-8 그대로, 스캐너가 직접 읽음)
+	TArray<uint8> CurrentData;
+
+	FString AccumulatedText;
+	FString StopReason;
+	FString ErrorMessage;
+
+	FClaudeUsage Usage;
+
+	bool bMessageComplete = false;
+
+	static constexpr int32 MaxRawPrefixBytes = 4096;
+
+	// 한 줄(UTF-8, 개행 제외) 처리. 이벤트가 끝나(빈 줄) 새 텍스트가 생겼으면 true
+	bool ProcessLine(const uint8* Line, int32 Len);
+
+	// event/data 한 묶음 처리
+	bool DispatchEvent();
+};
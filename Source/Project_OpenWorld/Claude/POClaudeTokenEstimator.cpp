@@ -0,0 +1,35 @@
+#include "POClaudeTokenEstimator.h"
+
+namespace POClaudeTokenEstimator
+{
+	int32 Estimate(const TCHAR* Text, int32 Len)
+	{
+		int32 Tokens = 0;
+		int32 AsciiRun = 0;
+
+		for (int32 i = 0; i < Len; ++i)
+		{
+			const TCHAR Ch = Text[i];
+
+			if ((Ch >= TEXT('a') && Ch <= TEXT('z')) || (Ch >= TEXT('A') && Ch <= TEXT('Z')) || (Ch >= TEXT('0') && Ch <= TEXT('9')))
+			{
+				++AsciiRun;
+				continue;
+			}
+
+			// 영숫자 묶음 마감
+			Tokens += (AsciiRun + 3) / 4;
+			AsciiRun = 0;
+
+			if (Ch == TEXT(' ') || Ch == TEXT('\t') || Ch == TEXT('\n') || Ch == TEXT('\r'))
+			{
+				continue;
+			}
+
+			// 한글 음절/자모, CJK, 그 밖의 기호 모두 글자당 1토큰
+			++Tokens;
+		}
+
+		return Tokens + (AsciiRun + 3) / 4;
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 로컬 토큰 수 추정기 (토크나이저 없이 문자 종류로 근사)
+ * 한글/한자/가나는 글자당 1토큰, 영숫자 묶음은 4글자당 1토큰, 그 밖의 기호는 글자당 1토큰, 공백은 0으로 센다.
+ * 실제 값과는 차이가 있으므로 예산 배분과 속도 제한 예약에만 쓰고 정산은 응답 usage로 한다.
+ */
+namespace POClaudeTokenEstimator
+{
+	// 메시지 1건에 붙는 역할/구분자 오버헤드
+	static constexpr int32 MessageOverhead = 4;
+
+	PROJECT_OPENWORLD_API int32 Estimate(const TCHAR* Text, int32 Len);
+
+	inline int32 Estimate(const FString& Text)
+	{
+		return Estimate(*Text, Text.Len());
+	}
+}
@@ -5,6 +5,99 @@
 
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnClaudeResponse,bool, bSuccess,const FString&, ResponseText);
 
+// C++ 호출자용 최종 응답 (람다 바인딩 가능)
+DECLARE_DELEGATE_TwoParams(FOnClaudeResponseNative, bool /*bSuccess*/, const FString& /*ResponseText*/);
+
+// 대기열 위치(0 = 전송 시작, -1 = 대기열이 가득 차 거절)와 예상 대기 시간(초) 통지
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnClaudeQueueStatus, int32, QueuePosition, float, EstimatedWaitSeconds);
+
+// 스트리밍 중 지금까지 받은 누적 텍스트 통지
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnClaudePartialResponse, const FString&, AccumulatedText);
+
+/** NPC 대사 생성 경로 */
+UENUM(BlueprintType)
+enum class EClaudeBackend : uint8
+{
+	// Claude API (HTTP)
+	Http  UMETA(DisplayName = "Claude API"),
+
+	// 기기 내 CPU 소형 모델 (네트워크 불필요)
+	Local UMETA(DisplayName = "로컬 모델"),
+
+	// API 키가 없거나 네트워크 연결이 끊겼을 때만 로컬 모델
+	Auto  UMETA(DisplayName = "자동")
+};
+
+/** API 호출 없이 로컬 템플릿으로 답하는 플레이어 메시지 의도 */
+UENUM(BlueprintType)
+enum class EClaudeLocalIntent : uint8
+{
+	None       UMETA(DisplayName = "없음"),
+	Greeting   UMETA(DisplayName = "인사"),
+	Farewell   UMETA(DisplayName = "작별"),
+	Thanks     UMETA(DisplayName = "감사"),
+	AskWeather UMETA(DisplayName = "날씨 질문"),
+	AskTime    UMETA(DisplayName = "시간 질문"),
+
+	MAX        UMETA(Hidden)
+};
+
+/**
+ * 의도 하나에 대한 NPC 응답 템플릿
+ * {name} = NPC 이름, {weather} = 날씨, {period} = 시간대, {hour} = 시각(1~12시)으로 치환된다.
+ */
+USTRUCT(BlueprintType)
+struct FClaudeLocalReplyTemplates
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude")
+	EClaudeLocalIntent Intent = EClaudeLocalIntent::Greeting;
+
+	/** 요청마다 돌려 가며 사용 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude", meta = (MultiLine = true))
+	TArray<FString> Templates;
+};
+
+/**
+ * 모델 라우팅 티어 하나 (빠른 모델 → 큰 모델 순으로 나열)
+ * 요청 복잡도(메시지 길이, 대화 깊이, NPC 중요도)가 MinComplexity 이상인 티어 중 가장 큰 것을 고르고,
+ * 최근 p95 지연이 예산을 넘은 티어는 건너뛰어 더 빠른 티어로 내려간다.
+ */
+USTRUCT(BlueprintType)
+struct FClaudeModelTier
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude")
+	FString ModelID;
+
+	/** 이 티어의 응답 최대 토큰 수 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude", meta = (ClampMin = "50", ClampMax = "1000"))
+	int32 MaxTokens = 200;
+
+	/** 요청 복잡도가 이 값 이상이면 이 티어 사용 (0.0 ~ 1.0, 첫 티어는 0) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinComplexity = 0.0f;
+
+	/** 최근 응답 시간 p95가 이 값을 넘으면 더 빠른 티어로 내림 (초, 0 = 검사 안 함) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude", meta = (ClampMin = "0.0"))
+	float P95BudgetSeconds = 0.0f;
+};
+
+/** 이전 대화 한 턴 (플레이어 메시지 + NPC 응답) */
+USTRUCT(BlueprintType)
+struct FClaudeDialogueTurn
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "Claude")
+	FString PlayerMessage;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Claude")
+	FString NPCResponse;
+};
+
 USTRUCT(BlueprintType)
 struct FClaudeRequestContext
 {
@@ -41,4 +134,83 @@ struct FClaudeRequestContext
 	/** 바람 강도 (0.0 ~ 1.0) */
 	UPROPERTY(BlueprintReadWrite, Category = "Claude")
 	float WindStrength = 0.0f;
+
+	/** 이전 대화 턴 (오래된 것 → 최근 것, 토큰 예산 안에서 최근 턴부터 요청에 포함) */
+	UPROPERTY(BlueprintReadWrite, Category = "Claude")
+	TArray<FClaudeDialogueTurn> History;
+
+	/** History에서 밀려난 오래된 대화의 누적 요약 */
+	UPROPERTY(BlueprintReadWrite, Category = "Claude")
+	FString HistorySummary;
+
+	/** NPC 중요도 (0.0 ~ 1.0, 모델 티어 선택에 반영) */
+	UPROPERTY(BlueprintReadWrite, Category = "Claude")
+	float Importance = 0.0f;
+};
+
+/** 응답의 usage 필드 (토큰 사용량 / 프롬프트 캐시 적중) */
+USTRUCT(BlueprintType)
+struct FClaudeUsage
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Claude")
+	int32 InputTokens = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Claude")
+	int32 OutputTokens = 0;
+
+	/** 이번 요청으로 새로 캐시에 기록된 프롬프트 토큰 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "Claude")
+	int32 CacheCreationInputTokens = 0;
+
+	/** 캐시에서 읽어 재사용한 프롬프트 토큰 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "Claude")
+	int32 CacheReadInputTokens = 0;
+};
+
+/** 요청 1건에 연결되는 콜백 묶음 (네이티브 호출자용) */
+struct FClaudeRequestCallbacks
+{
+	/** 최종 응답 (성공/실패) */
+	FOnClaudeResponse OnResponse;
+
+	/** 대기열 진입/위치 변경/전송 시작 통지 (선택) */
+	FOnClaudeQueueStatus OnQueueStatus;
+
+	/** 스트리밍 모드에서 텍스트 조각 도착 시 누적 텍스트 통지 (선택) */
+	FOnClaudePartialResponse OnPartial;
+
+	/** C++ 전용 최종 응답 (OnResponse와 함께 호출, 선택) */
+	FOnClaudeResponseNative OnResponseNative;
+
+	/** 지연 목표를 넘겨 폴백 대사로 먼저 응답한 뒤 도착한 실제 응답 (선택, 바인딩 안 하면 버림) */
+	FOnClaudeResponseNative OnFollowUp;
+
+	/** 공정성/대기열 상한 판단 기준 (비어 있으면 OnResponse가 바인딩된 객체) */
+	TWeakObjectPtr<UObject> Owner;
+
+	UObject* GetOwner() const
+	{
+		return Owner.IsExplicitlyNull() ? OnResponse.GetUObject() : Owner.Get();
+	}
+
+	void ExecuteResponse(bool bSuccess, const FString& ResponseText) const
+	{
+		OnResponse.ExecuteIfBound(bSuccess, ResponseText);
+		OnResponseNative.ExecuteIfBound(bSuccess, ResponseText);
+	}
+};
+
+/** 요청별 옵션 (EnqueueRequest) */
+struct FClaudeRequestOptions
+{
+	/** 요청 기한 (초, 0 이하 = 매니저 RequestTimeoutSeconds) */
+	float TimeoutSeconds = 0.0f;
+
+	/** 첫 텍스트까지의 지연 목표 (초, 0 = 사용 안 함). 넘기면 날씨/시간대 폴백 대사로 먼저 응답 (스트리밍을 끄면 무시) */
+	float FirstTextSLOSeconds = 0.0f;
+
+	/** 로컬 의도 템플릿을 건너뛰고 모델로 요청 (인사말 프리페치처럼 모델 대사가 목적인 요청) */
+	bool bSkipLocalIntents = false;
 };
@@ -0,0 +1,552 @@
+#include "POVillagerCrowdManager.h"
+#include "POVillagerFragments.h"
+#include "POVillagerProcessors.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityManager.h"
+#include "MassExecutor.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "../PONPCCharacter.h"
+#include "../../World/POEnvironmentSubsystem.h"
+
+DECLARE_STATS_GROUP(TEXT("Villagers"), STATGROUP_Villagers, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Simulate (Mass)"), STAT_VillagerSimulate, STATGROUP_Villagers);
+DECLARE_CYCLE_STAT(TEXT("Promote/Demote"), STAT_VillagerRepresentation, STATGROUP_Villagers);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Villagers"), STAT_VillagerCount, STATGROUP_Villagers);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Promoted (actors)"), STAT_VillagerPromoted, STATGROUP_Villagers);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled actors"), STAT_VillagerPooled, STATGROUP_Villagers);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Saved dialogue states"), STAT_VillagerSavedStates, STATGROUP_Villagers);
+
+namespace POVillagerCrowd
+{
+	// 지면 탐색 높이 (조각 위치 위아래로, cm)
+	constexpr float GroundTraceHeight = 5000.0f;
+
+	// 근무 시간 주민별 흔들림 (시)
+	constexpr float WorkHourJitter = 1.0f;
+
+	static FMassArchetypeHandle CreateArchetype(FMassEntityManager& EntityManager)
+	{
+		const TArray<const UScriptStruct*> Structs = {
+			FPOVillagerTransformFragment::StaticStruct(),
+			FPOVillagerArchetypeFragment::StaticStruct(),
+			FPOVillagerWeatherFragment::StaticStruct(),
+			FPOVillagerScheduleFragment::StaticStruct(),
+		};
+		return EntityManager.CreateArchetype(Structs);
+	}
+
+	static int32 PickArchetype(TConstArrayView<FPOVillagerArchetype> Archetypes, float TotalWeight, FRandomStream& Random)
+	{
+		float Pick = Random.FRandRange(0.0f, TotalWeight);
+		for (int32 i = 0; i < Archetypes.Num(); ++i)
+		{
+			Pick -= FMath::Max(0.0f, Archetypes[i].Weight);
+			if (Pick <= 0.0f)
+			{
+				return i;
+			}
+		}
+		return Archetypes.Num() - 1;
+	}
+
+	// Center 주변 Radius 안에 집, 집에서 CommuteRadius 안에 일터를 둔 주민 Count명 생성
+	static void SpawnVillagers(FMassEntityManager& EntityManager, const FMassArchetypeHandle& Archetype,
+		const FVector& Center, float Radius, float CommuteRadius, int32 Count,
+		TConstArrayView<FPOVillagerArchetype> Archetypes, FRandomStream& Random, TArray<FMassEntityHandle>& OutEntities)
+	{
+		if (Count <= 0 || Archetypes.Num() == 0)
+		{
+			return;
+		}
+
+		float TotalWeight = 0.0f;
+		for (const FPOVillagerArchetype& Type : Archetypes)
+		{
+			TotalWeight += FMath::Max(0.0f, Type.Weight);
+		}
+
+		TArray<FMassEntityHandle> NewEntities;
+		EntityManager.BatchCreateEntities(Archetype, Count, NewEntities);
+
+		const uint32 FirstId = static_cast<uint32>(OutEntities.Num());
+		for (int32 i = 0; i < NewEntities.Num(); ++i)
+		{
+			const FMassEntityHandle Entity = NewEntities[i];
+			const int32 ArchetypeIndex = TotalWeight > 0.0f ? PickArchetype(Archetypes, TotalWeight, Random) : 0;
+			const FPOVillagerArchetype& Type = Archetypes[ArchetypeIndex];
+
+			const FVector2D HomeOffset = FVector2D(Random.VRand()).GetSafeNormal() * Radius * FMath::Sqrt(Random.FRand());
+			const FVector2D WorkOffset = FVector2D(Random.VRand()).GetSafeNormal() * CommuteRadius * FMath::Sqrt(Random.FRand());
+			const FVector Home = Center + FVector(HomeOffset, 0.0f);
+			const FVector Work = Home + FVector(WorkOffset, 0.0f);
+
+			FPOVillagerScheduleFragment& Schedule = EntityManager.GetFragmentDataChecked<FPOVillagerScheduleFragment>(Entity);
+			Schedule.HomeLocation  = Home;
+			Schedule.WorkLocation  = Work;
+			Schedule.WorkStartHour = FMath::Clamp(Type.WorkStartHour + Random.FRandRange(-WorkHourJitter, WorkHourJitter), 0.0f, 24.0f);
+			Schedule.WorkEndHour   = FMath::Clamp(Type.WorkEndHour + Random.FRandRange(-WorkHourJitter, WorkHourJitter), 0.0f, 24.0f);
+			Schedule.WalkSpeed     = Random.FRandRange(120.0f, 170.0f);
+
+			FPOVillagerTransformFragment& Transform = EntityManager.GetFragmentDataChecked<FPOVillagerTransformFragment>(Entity);
+			Transform.Location = Home;
+			Transform.Yaw      = Random.FRandRange(-180.0f, 180.0f);
+
+			FPOVillagerArchetypeFragment& Identity = EntityManager.GetFragmentDataChecked<FPOVillagerArchetypeFragment>(Entity);
+			Identity.VillagerId     = FirstId + static_cast<uint32>(i);
+			Identity.ArchetypeIndex = static_cast<uint16>(ArchetypeIndex);
+		}
+
+		OutEntities.Append(NewEntities);
+	}
+
+	static void RunProcessors(FMassEntityManager& EntityManager, TArrayView<UMassProcessor* const> Processors, float DeltaTime)
+	{
+		FMassProcessingContext ProcessingContext(EntityManager, DeltaTime);
+		UE::Mass::Executor::RunProcessorsView(Processors, ProcessingContext);
+	}
+
+	static const FPOVillagerArchetype& GetDefaultArchetype()
+	{
+		static const FPOVillagerArchetype Default = []
+		{
+			FPOVillagerArchetype Archetype;
+			Archetype.Names = { TEXT("마을 주민") };
+			return Archetype;
+		}();
+		return Default;
+	}
+}
+
+APOVillagerCrowdManager::APOVillagerCrowdManager()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	// 플레이어 이동 뒤에 승격/강등 판정
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+}
+
+void APOVillagerCrowdManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UMassEntitySubsystem* EntitySubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+	if (!EntitySubsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[VillagerCrowd] MassEntitySubsystem 없음 - 주민 시뮬레이션 비활성화"));
+		SetActorTickEnabled(false);
+		return;
+	}
+	EntityManager = &EntitySubsystem->GetMutableEntityManager();
+
+	if (Archetypes.Num() == 0)
+	{
+		Archetypes.Add(POVillagerCrowd::GetDefaultArchetype());
+	}
+
+	FRandomStream Random(RandomSeed);
+	const FMassArchetypeHandle Archetype = POVillagerCrowd::CreateArchetype(*EntityManager);
+	POVillagerCrowd::SpawnVillagers(*EntityManager, Archetype, GetActorLocation(), SpawnRadius, CommuteRadius,
+		NumVillagers, Archetypes, Random, Villagers);
+
+	WeatherProcessor = NewObject<UPOVillagerWeatherProcessor>(this);
+	ScheduleProcessor = NewObject<UPOVillagerScheduleProcessor>(this);
+	LODProcessor = NewObject<UPOVillagerLODProcessor>(this);
+	WeatherProcessor->Initialize(*this);
+	ScheduleProcessor->Initialize(*this);
+	LODProcessor->Initialize(*this);
+
+	for (int32 i = 0; i < FMath::Min(PrewarmPoolSize, MaxActiveCharacters); ++i)
+	{
+		if (APONPCCharacter* NPC = SpawnPooledCharacter())
+		{
+			PooledCharacters.Add(NPC);
+		}
+	}
+
+	if (UPOEnvironmentSubsystem* Environment = UPOEnvironmentSubsystem::Get(this))
+	{
+		const FPOEnvironmentSnapshot& Env = Environment->GetSnapshot();
+		if (Env.bHasWeather)
+		{
+			CurrentWeather = Env.Weather;
+		}
+		WeatherChangedHandle = Environment->OnWeatherChanged.AddUObject(this, &APOVillagerCrowdManager::HandleWeatherChanged);
+	}
+	bWeatherDirty = true;
+
+	UE_LOG(LogTemp, Log, TEXT("[VillagerCrowd] 주민 %d명 생성, 풀 %d"), Villagers.Num(), PooledCharacters.Num());
+}
+
+void APOVillagerCrowdManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPOEnvironmentSubsystem* Environment = UPOEnvironmentSubsystem::Get(this))
+	{
+		Environment->OnWeatherChanged.Remove(WeatherChangedHandle);
+	}
+	WeatherChangedHandle.Reset();
+
+	if (EntityManager && Villagers.Num() > 0)
+	{
+		EntityManager->BatchDestroyEntities(Villagers);
+	}
+	Villagers.Reset();
+	ActiveCharacters.Reset();
+	SavedStates.Reset();
+	EntityManager = nullptr;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void APOVillagerCrowdManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!EntityManager || Villagers.Num() == 0)
+	{
+		return;
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VillagerSimulate);
+
+		SyncPromotedTransforms();
+
+		if (const UPOEnvironmentSubsystem* Environment = UPOEnvironmentSubsystem::Get(this))
+		{
+			const FPOEnvironmentSnapshot& Env = Environment->GetSnapshot();
+			if (Env.bHasTimeOfDay)
+			{
+				ScheduleProcessor->TimeOfDay = Env.TimeOfDay;
+			}
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+		if (PC)
+		{
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		}
+		else
+		{
+			// 시점이 없으면 아무도 승격하지 않음
+			ViewLocation = FVector(UE_BIG_NUMBER);
+		}
+
+		LODProcessor->ViewLocation = ViewLocation;
+		LODProcessor->PromoteRadius = PromoteRadius;
+		LODProcessor->DemoteRadius = DemoteRadius;
+
+		TArray<UMassProcessor*, TInlineAllocator<3>> Processors;
+		if (bWeatherDirty)
+		{
+			WeatherProcessor->Weather = CurrentWeather;
+			Processors.Add(WeatherProcessor);
+			bWeatherDirty = false;
+		}
+		Processors.Add(ScheduleProcessor);
+		Processors.Add(LODProcessor);
+
+		POVillagerCrowd::RunProcessors(*EntityManager, Processors, DeltaTime);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VillagerRepresentation);
+
+		for (const FMassEntityHandle Villager : LODProcessor->DemoteCandidates)
+		{
+			Demote(Villager);
+		}
+
+		int32 NumPromoted = 0;
+		for (const TPair<float, FMassEntityHandle>& Candidate : LODProcessor->PromoteCandidates)
+		{
+			if (NumPromoted >= MaxPromotionsPerFrame || ActiveCharacters.Num() >= MaxActiveCharacters)
+			{
+				break;
+			}
+			if (!Promote(Candidate.Value))
+			{
+				break;
+			}
+			++NumPromoted;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_VillagerCount, Villagers.Num());
+	SET_DWORD_STAT(STAT_VillagerPromoted, ActiveCharacters.Num());
+	SET_DWORD_STAT(STAT_VillagerPooled, PooledCharacters.Num());
+	SET_DWORD_STAT(STAT_VillagerSavedStates, SavedStates.Num());
+}
+
+APONPCCharacter* APOVillagerCrowdManager::FindCharacter(FMassEntityHandle Villager) const
+{
+	const TWeakObjectPtr<APONPCCharacter>* Found = ActiveCharacters.Find(Villager);
+	return Found ? Found->Get() : nullptr;
+}
+
+APONPCCharacter* APOVillagerCrowdManager::AcquireCharacter()
+{
+	while (PooledCharacters.Num() > 0)
+	{
+		APONPCCharacter* NPC = PooledCharacters.Pop(EAllowShrinking::No);
+		if (IsValid(NPC))
+		{
+			return NPC;
+		}
+		--NumSpawnedCharacters;
+	}
+
+	if (NumSpawnedCharacters >= MaxActiveCharacters)
+	{
+		return nullptr;
+	}
+	return SpawnPooledCharacter();
+}
+
+APONPCCharacter* APOVillagerCrowdManager::SpawnPooledCharacter()
+{
+	UClass* Class = VillagerClass ? VillagerClass.Get() : APONPCCharacter::StaticClass();
+
+	FActorSpawnParameters Params;
+	Params.Owner = this;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	APONPCCharacter* NPC = GetWorld()->SpawnActor<APONPCCharacter>(Class, GetActorLocation(), FRotator::ZeroRotator, Params);
+	if (!NPC)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[VillagerCrowd] 풀 액터 생성 실패: %s"), *Class->GetName());
+		return nullptr;
+	}
+
+	if (!NPC->GetController())
+	{
+		NPC->SpawnDefaultController();
+	}
+
+	// 생성 직후 상태는 비어 있으므로 버림
+	FNPCPersistentState Discarded;
+	NPC->DeactivateToPool(Discarded);
+
+	++NumSpawnedCharacters;
+	return NPC;
+}
+
+bool APOVillagerCrowdManager::Promote(FMassEntityHandle Villager)
+{
+	if (!EntityManager->IsEntityValid(Villager) || ActiveCharacters.Contains(Villager))
+	{
+		return true;
+	}
+
+	APONPCCharacter* NPC = AcquireCharacter();
+	if (!NPC)
+	{
+		return false;
+	}
+
+	const FPOVillagerTransformFragment& Transform = EntityManager->GetFragmentDataChecked<FPOVillagerTransformFragment>(Villager);
+	const FPOVillagerArchetypeFragment& Identity = EntityManager->GetFragmentDataChecked<FPOVillagerArchetypeFragment>(Villager);
+	const FPOVillagerArchetype& Type = GetArchetype(Identity.ArchetypeIndex);
+
+	const float HalfHeight = NPC->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	const FVector Location = SnapToGround(Transform.Location) + FVector(0.0f, 0.0f, HalfHeight);
+	NPC->SetActorLocationAndRotation(Location, FRotator(0.0f, Transform.Yaw, 0.0f), false, nullptr, ETeleportType::TeleportPhysics);
+
+	FNPCPersistentState State;
+	if (FNPCPersistentState* Saved = SavedStates.Find(Villager))
+	{
+		State = MoveTemp(*Saved);
+		SavedStates.Remove(Villager);
+	}
+
+	const FString& Name = Type.Names.Num() > 0 ? Type.Names[Identity.VillagerId % Type.Names.Num()] : POVillagerCrowd::GetDefaultArchetype().Names[0];
+	NPC->ActivateFromPool(Name, Type.Personality, Type.DialogueImportance, MoveTemp(State));
+
+	EntityManager->AddTagToEntity(Villager, FPOVillagerPromotedTag::StaticStruct());
+	ActiveCharacters.Add(Villager, NPC);
+	return true;
+}
+
+bool APOVillagerCrowdManager::Demote(FMassEntityHandle Villager)
+{
+	APONPCCharacter* NPC = FindCharacter(Villager);
+
+	// 대화 중인 주민은 멀어져도 유지 (대화가 끝난 뒤 다음 판정에서 강등)
+	if (NPC && NPC->IsInConversation())
+	{
+		return false;
+	}
+
+	if (NPC)
+	{
+		FPOVillagerTransformFragment& Transform = EntityManager->GetFragmentDataChecked<FPOVillagerTransformFragment>(Villager);
+		Transform.Location = NPC->GetActorLocation() - FVector(0.0f, 0.0f, NPC->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+		Transform.Yaw      = NPC->GetActorRotation().Yaw;
+
+		FNPCPersistentState State;
+		NPC->DeactivateToPool(State);
+		if (!State.IsEmpty())
+		{
+			SavedStates.Add(Villager, MoveTemp(State));
+		}
+		PooledCharacters.Add(NPC);
+	}
+
+	ActiveCharacters.Remove(Villager);
+	EntityManager->RemoveTagFromEntity(Villager, FPOVillagerPromotedTag::StaticStruct());
+	return true;
+}
+
+void APOVillagerCrowdManager::SyncPromotedTransforms()
+{
+	TArray<FMassEntityHandle, TInlineAllocator<8>> Lost;
+
+	for (const TPair<FMassEntityHandle, TWeakObjectPtr<APONPCCharacter>>& Pair : ActiveCharacters)
+	{
+		const APONPCCharacter* NPC = Pair.Value.Get();
+		if (!NPC)
+		{
+			// 레벨 스트리밍 등으로 액터가 사라짐: 마지막 위치에서 Mass로 이어 감
+			Lost.Add(Pair.Key);
+			continue;
+		}
+
+		FPOVillagerTransformFragment& Transform = EntityManager->GetFragmentDataChecked<FPOVillagerTransformFragment>(Pair.Key);
+		Transform.Location = NPC->GetActorLocation() - FVector(0.0f, 0.0f, NPC->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+		Transform.Yaw      = NPC->GetActorRotation().Yaw;
+	}
+
+	for (const FMassEntityHandle Villager : Lost)
+	{
+		ActiveCharacters.Remove(Villager);
+		EntityManager->RemoveTagFromEntity(Villager, FPOVillagerPromotedTag::StaticStruct());
+		--NumSpawnedCharacters;
+	}
+}
+
+FVector APOVillagerCrowdManager::SnapToGround(const FVector& Location) const
+{
+	const FVector Start = Location + FVector(0.0f, 0.0f, POVillagerCrowd::GroundTraceHeight);
+	const FVector End = Location - FVector(0.0f, 0.0f, POVillagerCrowd::GroundTraceHeight);
+
+	FHitResult Hit;
+	const FCollisionQueryParams Params(SCENE_QUERY_STAT(VillagerGround), false, this);
+	if (GetWorld()->LineTraceSingleByObjectType(Hit, Start, End, FCollisionObjectQueryParams(ECC_WorldStatic), Params))
+	{
+		return Hit.ImpactPoint;
+	}
+	return Location;
+}
+
+const FPOVillagerArchetype& APOVillagerCrowdManager::GetArchetype(int32 Index) const
+{
+	return Archetypes.IsValidIndex(Index) ? Archetypes[Index] : POVillagerCrowd::GetDefaultArchetype();
+}
+
+void APOVillagerCrowdManager::HandleWeatherChanged(EWeatherType OldWeather, EWeatherType NewWeather)
+{
+	CurrentWeather = NewWeather;
+	bWeatherDirty = true;
+}
+
+#if !UE_BUILD_SHIPPING
+
+namespace POVillagerCrowdCommands
+{
+	// Villagers.Bench [Count=10000] [Frames=300] [BudgetMs=1.0]
+	// 임시 주민을 만들어 일과 이동 + LOD 판정 프로세서를 dt=1/60으로 돌려 프레임당 비용을 잰다 (액터 승격 제외)
+	static void Bench(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UMassEntitySubsystem* EntitySubsystem = World ? World->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+		if (!EntitySubsystem)
+		{
+			Ar.Logf(TEXT("[VillagerCrowd] MassEntitySubsystem 없음"));
+			return;
+		}
+
+		int32 Count = 10000;
+		int32 Frames = 300;
+		float BudgetMs = 1.0f;
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Count="), Count);
+			FParse::Value(*Arg, TEXT("Frames="), Frames);
+			FParse::Value(*Arg, TEXT("BudgetMs="), BudgetMs);
+		}
+		Count = FMath::Max(1, Count);
+		Frames = FMath::Max(1, Frames);
+
+		FMassEntityManager& EntityManager = EntitySubsystem->GetMutableEntityManager();
+
+		constexpr float Radius = 50000.0f;
+		constexpr float DeltaTime = 1.0f / 60.0f;
+
+		FRandomStream Random(1234);
+		TArray<FMassEntityHandle> Entities;
+		const FPOVillagerArchetype Archetype = POVillagerCrowd::GetDefaultArchetype();
+		POVillagerCrowd::SpawnVillagers(EntityManager, POVillagerCrowd::CreateArchetype(EntityManager), FVector::ZeroVector,
+			Radius, 3000.0f, Count, MakeArrayView(&Archetype, 1), Random, Entities);
+
+		UPOVillagerWeatherProcessor* WeatherProcessor = NewObject<UPOVillagerWeatherProcessor>(GetTransientPackage());
+		UPOVillagerScheduleProcessor* ScheduleProcessor = NewObject<UPOVillagerScheduleProcessor>(GetTransientPackage());
+		UPOVillagerLODProcessor* LODProcessor = NewObject<UPOVillagerLODProcessor>(GetTransientPackage());
+		WeatherProcessor->Initialize(*EntitySubsystem);
+		ScheduleProcessor->Initialize(*EntitySubsystem);
+		LODProcessor->Initialize(*EntitySubsystem);
+
+		// 비: 일부는 집으로 피신, 나머지는 출근 시간대 이동
+		WeatherProcessor->Weather = EWeatherType::Rainy;
+		UMassProcessor* const WeatherOnly[] = { WeatherProcessor };
+		POVillagerCrowd::RunProcessors(EntityManager, WeatherOnly, DeltaTime);
+
+		ScheduleProcessor->TimeOfDay = 10.0f;
+		UMassProcessor* const FrameProcessors[] = { ScheduleProcessor, LODProcessor };
+
+		TArray<float> Timings;
+		Timings.Reserve(Frames);
+		int64 TotalCandidates = 0;
+
+		for (int32 Frame = 0; Frame < Frames; ++Frame)
+		{
+			// 시점이 마을을 한 바퀴 돌며 승격 후보가 계속 바뀌도록
+			const float Angle = UE_TWO_PI * Frame / Frames;
+			LODProcessor->ViewLocation = FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Radius * 0.5f;
+
+			const double Start = FPlatformTime::Seconds();
+			POVillagerCrowd::RunProcessors(EntityManager, FrameProcessors, DeltaTime);
+			Timings.Add(static_cast<float>((FPlatformTime::Seconds() - Start) * 1000.0));
+
+			TotalCandidates += LODProcessor->PromoteCandidates.Num();
+		}
+
+		EntityManager.BatchDestroyEntities(Entities);
+
+		double Sum = 0.0;
+		int32 NumWithinBudget = 0;
+		for (const float Ms : Timings)
+		{
+			Sum += Ms;
+			NumWithinBudget += Ms <= BudgetMs ? 1 : 0;
+		}
+		Timings.Sort();
+
+		const double MeanMs = Sum / Frames;
+		const float P95Ms = Timings[FMath::Clamp(FMath::CeilToInt32(0.95 * Frames) - 1, 0, Frames - 1)];
+
+		Ar.Logf(TEXT("[VillagerCrowd] 주민 %d명 x %d프레임: 평균 %.3f ms, p95 %.3f ms, 최대 %.3f ms (1명당 %.1f ns)"),
+			Count, Frames, MeanMs, P95Ms, Timings.Last(), MeanMs * 1e6 / Count);
+		Ar.Logf(TEXT("[VillagerCrowd] 예산 %.2f ms 이내 %.1f%% %s, 프레임당 승격 후보 평균 %.1f명"),
+			BudgetMs, 100.0 * NumWithinBudget / Frames, P95Ms <= BudgetMs ? TEXT("(통과)") : TEXT("(초과)"),
+			static_cast<double>(TotalCandidates) / Frames);
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPOVillagerBenchCmd(
+	TEXT("Villagers.Bench"),
+	TEXT("Mass 주민 시뮬레이션 비용 측정: Villagers.Bench [Count=10000] [Frames=300] [BudgetMs=1.0]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&POVillagerCrowdCommands::Bench));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "MassEntityTypes.h"
+#include "../PONPCTypes.h"
+#include "../../Weather/WeatherTypes.h"
+#include "POVillagerCrowdManager.generated.h"
+
+class APONPCCharacter;
+class UPOVillagerWeatherProcessor;
+class UPOVillagerScheduleProcessor;
+class UPOVillagerLODProcessor;
+struct FMassEntityManager;
+
+/** 마을 주민 아키타입 (승격 시 풀 액터에 입힐 이름/성격) */
+USTRUCT(BlueprintType)
+struct FPOVillagerArchetype
+{
+	GENERATED_BODY()
+
+	// 이름 후보 (주민 번호로 돌아가며 배정). Claude 기억은 이름+성격 단위이므로 겹치지 않게 충분히 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager")
+	TArray<FString> Names;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager", meta = (MultiLine = true))
+	FString Personality = TEXT("친절하고 소박한 시골 마을 주민");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float DialogueImportance = 0.0f;
+
+	// 전체 주민 중 이 아키타입 비율 가중치 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager", meta = (ClampMin = "0.0"))
+	float Weight = 1.0f;
+
+	// 근무 시간 (시, 주민마다 ±1시간 흔들림) 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager", meta = (ClampMin = "0.0", ClampMax = "24.0"))
+	float WorkStartHour = 9.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager", meta = (ClampMin = "0.0", ClampMax = "24.0"))
+	float WorkEndHour = 18.0f;
+};
+
+/**
+ * 마을 주민 군중 매니저
+ * 먼 주민은 액터 없이 Mass 엔티티(위치/아키타입/날씨 반응/일과 조각)로만 두고 프로세서로 일괄 시뮬레이션한다.
+ * 플레이어가 PromoteRadius 안으로 다가오면 풀에서 APONPCCharacter(+ APONPCAIController)를 빌려 승격하고,
+ * DemoteRadius 밖으로 멀어지면 위치와 대화 상태(이력/요약/대화 상태/쿨다운)를 돌려받아 강등한다.
+ * 대화 중인 주민은 멀어져도 강등하지 않는다.
+ *
+ * 프로세서는 처리 단계에 자동 등록하지 않고 이 액터의 Tick에서 직접 실행한다 (MassGameplay 시뮬레이션 서브시스템 불필요).
+ * `stat Villagers`로 시뮬레이션/표현 전환 시간과 주민·액터 수를, `Villagers.Bench`로 1만 명 이상 시뮬레이션 비용을 본다.
+ */
+UCLASS()
+class PROJECT_OPENWORLD_API APOVillagerCrowdManager : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	APOVillagerCrowdManager();
+
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	// 승격 시 사용할 NPC 클래스 (AIControllerClass가 PONPCAIController 계열이어야 StateTree가 돎) 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager|Spawn")
+	TSubclassOf<APONPCCharacter> VillagerClass;
+
+	// 비어 있으면 기본 아키타입 하나 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager|Spawn")
+	TArray<FPOVillagerArchetype> Archetypes;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager|Spawn", meta = (ClampMin = "0"))
+	int32 NumVillagers = 2000;
+
+	// 집이 흩어지는 반경 (이 액터 기준, cm) 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager|Spawn", meta = (ClampMin = "0.0"))
+	float SpawnRadius = 20000.0f;
+
+	// 집에서 일터까지 최대 거리 (cm) 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager|Spawn", meta = (ClampMin = "0.0"))
+	float CommuteRadius = 3000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager|Spawn")
+	int32 RandomSeed = 1234;
+
+	// 플레이어 시점이 이 거리 안이면 액터로 승격 (cm) 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager|Representation", meta = (ClampMin = "100.0"))
+	float PromoteRadius = 3000.0f;
+
+	// 이 거리 밖이면 다시 Mass로 강등 (PromoteRadius보다 커야 경계에서 깜빡이지 않음) 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager|Representation", meta = (ClampMin = "100.0"))
+	float DemoteRadius = 4000.0f;
+
+	// 동시에 액터로 존재할 수 있는 최대 주민 수 (= 풀 최대 크기) 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager|Representation", meta = (ClampMin = "0"))
+	int32 MaxActiveCharacters = 48;
+
+	// BeginPlay에서 미리 만들어 둘 풀 액터 수 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager|Representation", meta = (ClampMin = "0"))
+	int32 PrewarmPoolSize = 16;
+
+	// 프레임당 최대 승격 수 (액터 재활성화 비용 분산) 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Villager|Representation", meta = (ClampMin = "1"))
+	int32 MaxPromotionsPerFrame = 4;
+
+	UFUNCTION(BlueprintPure, Category = "Villager")
+	int32 GetNumVillagers() const { return Villagers.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "Villager")
+	int32 GetNumPromoted() const { return ActiveCharacters.Num(); }
+
+	// 승격된 주민을 표현 중인 액터 (없으면 nullptr) 
+	APONPCCharacter* FindCharacter(FMassEntityHandle Villager) const;
+
+private:
+	UPROPERTY()
+	TObjectPtr<UPOVillagerWeatherProcessor> WeatherProcessor;
+
+	UPROPERTY()
+	TObjectPtr<UPOVillagerScheduleProcessor> ScheduleProcessor;
+
+	UPROPERTY()
+	TObjectPtr<UPOVillagerLODProcessor> LODProcessor;
+
+	// 쉬는 풀 액터 (숨김, 틱/충돌/StateTree 정지) 
+	UPROPERTY()
+	TArray<TObjectPtr<APONPCCharacter>> PooledCharacters;
+
+	FMassEntityManager* EntityManager = nullptr;
+	TArray<FMassEntityHandle> Villagers;
+
+	// 승격된 주민 → 표현 액터 
+	TMap<FMassEntityHandle, TWeakObjectPtr<APONPCCharacter>> ActiveCharacters;
+
+	// 대화한 적 있는 강등 주민의 상태 (대화하지 않은 주민은 보관하지 않음) 
+	TMap<FMassEntityHandle, FNPCPersistentState> SavedStates;
+
+	int32 NumSpawnedCharacters = 0;
+
+	EWeatherType CurrentWeather = EWeatherType::Clear;
+	bool bWeatherDirty = true;
+	FDelegateHandle WeatherChangedHandle;
+
+	APONPCCharacter* AcquireCharacter();
+	APONPCCharacter* SpawnPooledCharacter();
+
+	bool Promote(FMassEntityHandle Villager);
+	bool Demote(FMassEntityHandle Villager);
+
+	// 승격된 주민의 조각 위치를 액터 위치로 맞춤 (LOD 판정/강등 후 이어 걷기용) 
+	void SyncPromotedTransforms();
+
+	FVector SnapToGround(const FVector& Location) const;
+	const FPOVillagerArchetype& GetArchetype(int32 Index) const;
+
+	void HandleWeatherChanged(EWeatherType OldWeather, EWeatherType NewWeather);
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "POVillagerFragments.generated.h"
+
+/** 마을 주민 위치 (지면 기준, 액터로 승격되면 캡슐 반높이만큼 올려 배치) */
+USTRUCT()
+struct FPOVillagerTransformFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector Location = FVector::ZeroVector;
+	float Yaw = 0.0f;
+};
+
+/** 마을 주민 아키타입과 고유 번호 (이름/성격은 크라우드 매니저의 아키타입 표에서 찾음) */
+USTRUCT()
+struct FPOVillagerArchetypeFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	uint32 VillagerId = 0;
+	uint16 ArchetypeIndex = 0;
+};
+
+/** 현재 날씨에 대한 반응 (날씨가 바뀔 때만 다시 계산) */
+USTRUCT()
+struct FPOVillagerWeatherFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	// 걷는 속도 배율 (비 = 서두름, 눈/안개 = 조심)
+	float SpeedScale = 1.0f;
+
+	// 일과와 관계없이 집으로 피신
+	bool bSeekShelter = false;
+};
+
+/** 하루 일과 (근무 시간에는 일터, 그 밖에는 집) */
+USTRUCT()
+struct FPOVillagerScheduleFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector HomeLocation = FVector::ZeroVector;
+	FVector WorkLocation = FVector::ZeroVector;
+
+	// 근무 시작/끝 (시, 0~24)
+	float WorkStartHour = 9.0f;
+	float WorkEndHour = 18.0f;
+
+	// 걷는 속도 (cm/s)
+	float WalkSpeed = 150.0f;
+};
+
+/** 풀 액터(APONPCCharacter)가 대신 표현 중인 주민. 이동 시뮬레이션에서 제외 */
+USTRUCT()
+struct FPOVillagerPromotedTag : public FMassTag
+{
+	GENERATED_BODY()
+};
@@ -0,0 +1,181 @@
+#include "POVillagerProcessors.h"
+#include "POVillagerFragments.h"
+#include "MassExecutionContext.h"
+#include "MassEntityManager.h"
+
+namespace POVillagerProcessors
+{
+	struct FWeatherReaction
+	{
+		float SpeedScale;
+		bool bSeekShelter;
+	};
+
+	// EWeatherType 선언 순서와 같아야 함
+	static const FWeatherReaction Reactions[] = {
+		{ 1.0f, false },	// 맑음
+		{ 1.0f, false },	// 흐림
+		{ 1.3f, true },		// 비: 서둘러 집으로
+		{ 0.8f, false },	// 눈: 조심해서 걸음
+		{ 0.9f, false },	// 안개
+		{ 1.4f, true },		// 폭풍
+	};
+
+	// 피신 날씨에도 일을 계속하는 주민 비율 (1/N)
+	constexpr uint32 StubbornVillagerRatio = 4;
+}
+
+UPOVillagerWeatherProcessor::UPOVillagerWeatherProcessor()
+	: EntityQuery(*this)
+{
+	// 처리 단계에 자동 등록하지 않고 크라우드 매니저가 직접 실행
+	bAutoRegisterWithProcessingPhases = false;
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+}
+
+void UPOVillagerWeatherProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FPOVillagerWeatherFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FPOVillagerArchetypeFragment>(EMassFragmentAccess::ReadOnly);
+}
+
+void UPOVillagerWeatherProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	using namespace POVillagerProcessors;
+
+	const int32 WeatherIndex = static_cast<int32>(Weather);
+	const FWeatherReaction Reaction = Reactions[WeatherIndex < static_cast<int32>(UE_ARRAY_COUNT(Reactions)) ? WeatherIndex : 0];
+
+	EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [Reaction](FMassExecutionContext& ChunkContext)
+	{
+		const TArrayView<FPOVillagerWeatherFragment> WeatherList = ChunkContext.GetMutableFragmentView<FPOVillagerWeatherFragment>();
+		const TConstArrayView<FPOVillagerArchetypeFragment> ArchetypeList = ChunkContext.GetFragmentView<FPOVillagerArchetypeFragment>();
+
+		for (int32 i = 0; i < ChunkContext.GetNumEntities(); ++i)
+		{
+			FPOVillagerWeatherFragment& VillagerWeather = WeatherList[i];
+			VillagerWeather.SpeedScale   = Reaction.SpeedScale;
+			VillagerWeather.bSeekShelter = Reaction.bSeekShelter && (ArchetypeList[i].VillagerId % StubbornVillagerRatio) != 0;
+		}
+	});
+}
+
+UPOVillagerScheduleProcessor::UPOVillagerScheduleProcessor()
+	: EntityQuery(*this)
+{
+	// 처리 단계에 자동 등록하지 않고 크라우드 매니저가 직접 실행
+	bAutoRegisterWithProcessingPhases = false;
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+}
+
+void UPOVillagerScheduleProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FPOVillagerTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FPOVillagerScheduleFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FPOVillagerWeatherFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddTagRequirement<FPOVillagerPromotedTag>(EMassFragmentPresence::None);
+}
+
+void UPOVillagerScheduleProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	const float Hour = TimeOfDay;
+
+	EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [Hour](FMassExecutionContext& ChunkContext)
+	{
+		const float DeltaTime = ChunkContext.GetDeltaTimeSeconds();
+		const TArrayView<FPOVillagerTransformFragment> TransformList = ChunkContext.GetMutableFragmentView<FPOVillagerTransformFragment>();
+		const TConstArrayView<FPOVillagerScheduleFragment> ScheduleList = ChunkContext.GetFragmentView<FPOVillagerScheduleFragment>();
+		const TConstArrayView<FPOVillagerWeatherFragment> WeatherList = ChunkContext.GetFragmentView<FPOVillagerWeatherFragment>();
+
+		for (int32 i = 0; i < ChunkContext.GetNumEntities(); ++i)
+		{
+			FPOVillagerTransformFragment& Transform = TransformList[i];
+			const FPOVillagerScheduleFragment& Schedule = ScheduleList[i];
+			const FPOVillagerWeatherFragment& VillagerWeather = WeatherList[i];
+
+			const bool bAtWork = !VillagerWeather.bSeekShelter && Hour >= Schedule.WorkStartHour && Hour < Schedule.WorkEndHour;
+			const FVector& Target = bAtWork ? Schedule.WorkLocation : Schedule.HomeLocation;
+
+			const FVector2D ToTarget(Target.X - Transform.Location.X, Target.Y - Transform.Location.Y);
+			const float DistanceSquared = ToTarget.SizeSquared();
+			if (DistanceSquared < KINDA_SMALL_NUMBER)
+			{
+				continue;
+			}
+
+			const float Step = Schedule.WalkSpeed * VillagerWeather.SpeedScale * DeltaTime;
+			if (DistanceSquared <= Step * Step)
+			{
+				Transform.Location.X = Target.X;
+				Transform.Location.Y = Target.Y;
+				continue;
+			}
+
+			const FVector2D Move = ToTarget * (Step * FMath::InvSqrt(DistanceSquared));
+			Transform.Location.X += Move.X;
+			Transform.Location.Y += Move.Y;
+			Transform.Yaw = FMath::RadiansToDegrees(FMath::Atan2(ToTarget.Y, ToTarget.X));
+		}
+	});
+}
+
+UPOVillagerLODProcessor::UPOVillagerLODProcessor()
+	: SimulatedQuery(*this)
+	, PromotedQuery(*this)
+{
+	// 처리 단계에 자동 등록하지 않고 크라우드 매니저가 직접 실행
+	bAutoRegisterWithProcessingPhases = false;
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+
+	// 결과를 멤버 배열에 모으므로 게임 스레드에서 순차 실행
+	bRequiresGameThreadExecution = true;
+}
+
+void UPOVillagerLODProcessor::ConfigureQueries()
+{
+	SimulatedQuery.AddRequirement<FPOVillagerTransformFragment>(EMassFragmentAccess::ReadOnly);
+	SimulatedQuery.AddTagRequirement<FPOVillagerPromotedTag>(EMassFragmentPresence::None);
+
+	PromotedQuery.AddRequirement<FPOVillagerTransformFragment>(EMassFragmentAccess::ReadOnly);
+	PromotedQuery.AddTagRequirement<FPOVillagerPromotedTag>(EMassFragmentPresence::All);
+}
+
+void UPOVillagerLODProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	PromoteCandidates.Reset();
+	DemoteCandidates.Reset();
+
+	const FVector View = ViewLocation;
+	const float PromoteRadiusSquared = FMath::Square(PromoteRadius);
+	const float DemoteRadiusSquared = FMath::Square(FMath::Max(DemoteRadius, PromoteRadius));
+
+	SimulatedQuery.ForEachEntityChunk(EntityManager, Context, [this, View, PromoteRadiusSquared](FMassExecutionContext& ChunkContext)
+	{
+		const TConstArrayView<FPOVillagerTransformFragment> TransformList = ChunkContext.GetFragmentView<FPOVillagerTransformFragment>();
+		for (int32 i = 0; i < ChunkContext.GetNumEntities(); ++i)
+		{
+			const float DistanceSquared = FVector::DistSquared2D(TransformList[i].Location, View);
+			if (DistanceSquared <= PromoteRadiusSquared)
+			{
+				PromoteCandidates.Emplace(DistanceSquared, ChunkContext.GetEntity(i));
+			}
+		}
+	});
+
+	PromotedQuery.ForEachEntityChunk(EntityManager, Context, [this, View, DemoteRadiusSquared](FMassExecutionContext& ChunkContext)
+	{
+		const TConstArrayView<FPOVillagerTransformFragment> TransformList = ChunkContext.GetFragmentView<FPOVillagerTransformFragment>();
+		for (int32 i = 0; i < ChunkContext.GetNumEntities(); ++i)
+		{
+			if (FVector::DistSquared2D(TransformList[i].Location, View) > DemoteRadiusSquared)
+			{
+				DemoteCandidates.Add(ChunkContext.GetEntity(i));
+			}
+		}
+	});
+
+	PromoteCandidates.Sort([](const TPair<float, FMassEntityHandle>& A, const TPair<float, FMassEntityHandle>& B)
+	{
+		return A.Key < B.Key;
+	});
+}
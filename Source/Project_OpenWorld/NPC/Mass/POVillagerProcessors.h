@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "../../Weather/WeatherTypes.h"
+#include "POVillagerProcessors.generated.h"
+
+/**
+ * 날씨 반응 갱신: 현재 날씨 → 주민별 속도 배율/피신 여부
+ * 날씨가 바뀐 프레임에만 실행한다 (크라우드 매니저가 날씨 변경 이벤트를 받아 실행 목록에 넣음).
+ */
+UCLASS()
+class PROJECT_OPENWORLD_API UPOVillagerWeatherProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UPOVillagerWeatherProcessor();
+
+	// 실행 전에 설정 
+	EWeatherType Weather = EWeatherType::Clear;
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+/**
+ * 일과 이동: 시간대와 날씨 반응에 따라 집/일터로 직선 이동 (내비메시 없음, 먼 주민 전용)
+ * 청크 단위로 병렬 처리하며, 액터로 승격된 주민은 제외한다.
+ */
+UCLASS()
+class PROJECT_OPENWORLD_API UPOVillagerScheduleProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UPOVillagerScheduleProcessor();
+
+	// 실행 전에 설정 (0~24) 
+	float TimeOfDay = 12.0f;
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+/**
+ * 표현 LOD 판정: 플레이어 시점과의 거리로 승격/강등 후보 수집
+ * 후보만 모으고 실제 전환(액터 풀 대여/반납, 태그 변경)은 처리가 끝난 뒤 크라우드 매니저가 한다.
+ */
+UCLASS()
+class PROJECT_OPENWORLD_API UPOVillagerLODProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UPOVillagerLODProcessor();
+
+	// 실행 전에 설정 
+	FVector ViewLocation = FVector::ZeroVector;
+	float PromoteRadius = 3000.0f;
+	float DemoteRadius = 4000.0f;
+
+	// 실행 결과 (거리 제곱, 주민). 승격 후보는 가까운 순으로 정렬됨 
+	TArray<TPair<float, FMassEntityHandle>> PromoteCandidates;
+	TArray<FMassEntityHandle> DemoteCandidates;
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	// 아직 Mass로만 표현되는 주민 / 액터로 승격된 주민
+	FMassEntityQuery SimulatedQuery;
+	FMassEntityQuery PromotedQuery;
+};
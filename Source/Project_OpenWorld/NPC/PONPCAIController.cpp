@@ -1,5 +1,9 @@
 #include "PONPCAIController.h"
 #include "Components/StateTreeComponent.h"
+#include "StateTree.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "PONPCCharacter.h"
 
 APONPCAIController::APONPCAIController()
 {
@@ -31,3 +35,162 @@ void APONPCAIController::OnUnPossess()
 
 	Super::OnUnPossess();
 }
+
+#if !UE_BUILD_SHIPPING
+
+namespace PONPCAIControllerCommands
+{
+	// NPC.BenchStateTree [Count=1000] [Frames=300] [A=<StateTree 경로>] [B=<StateTree 경로>] [Class=<NPC 클래스 경로>]
+	// 임시 NPC를 Count명 만들어 트리 A, B를 차례로 걸고 StateTree 컴포넌트를 직접 Frames번 틱해 프레임당 비용을 비교한다.
+	// 같은 구조에서 BP 태스크(A)와 네이티브 태스크(B)만 다른 두 트리를 주면 대기 상태 태스크 비용 차이가 나온다.
+	static void TickAll(const TArray<UStateTreeComponent*>& Components, int32 Frames, TArray<float>& OutTimings)
+	{
+		constexpr float DeltaTime = 1.0f / 60.0f;
+
+		OutTimings.Reset(Frames);
+		for (int32 Frame = 0; Frame < Frames; ++Frame)
+		{
+			const double Start = FPlatformTime::Seconds();
+			for (UStateTreeComponent* Component : Components)
+			{
+				Component->TickComponent(DeltaTime, LEVELTICK_All, nullptr);
+			}
+			OutTimings.Add(static_cast<float>((FPlatformTime::Seconds() - Start) * 1000.0));
+		}
+	}
+
+	static void Report(const TCHAR* Label, TArray<float>& Timings, int32 NumNPCs, FOutputDevice& Ar)
+	{
+		double Sum = 0.0;
+		for (const float Ms : Timings)
+		{
+			Sum += Ms;
+		}
+		Timings.Sort();
+
+		const int32 Frames = Timings.Num();
+		const double MeanMs = Sum / Frames;
+		const float P95Ms = Timings[FMath::Clamp(FMath::CeilToInt32(0.95 * Frames) - 1, 0, Frames - 1)];
+		Ar.Logf(TEXT("[NPCAIController] %s: NPC %d명 x %d프레임, 평균 %.3f ms, p95 %.3f ms, 최대 %.3f ms (NPC당 %.2f us)"),
+			Label, NumNPCs, Frames, MeanMs, P95Ms, Timings.Last(), MeanMs * 1000.0 / FMath::Max(1, NumNPCs));
+	}
+
+	static void BenchStateTree(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		int32 Count = 1000;
+		int32 Frames = 300;
+		FString TreePaths[2];
+		FString ClassPath;
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Count="), Count);
+			FParse::Value(*Arg, TEXT("Frames="), Frames);
+			FParse::Value(*Arg, TEXT("A="), TreePaths[0]);
+			FParse::Value(*Arg, TEXT("B="), TreePaths[1]);
+			FParse::Value(*Arg, TEXT("Class="), ClassPath);
+		}
+		Count = FMath::Max(1, Count);
+		Frames = FMath::Max(1, Frames);
+
+		// 클래스 미지정 시 레벨에 있는 NPC와 같은 클래스 (AIControllerClass 설정을 그대로 쓰기 위해)
+		UClass* NPCClass = ClassPath.IsEmpty() ? nullptr : LoadObject<UClass>(nullptr, *ClassPath);
+		if (!NPCClass)
+		{
+			TActorIterator<APONPCCharacter> It(World);
+			NPCClass = It ? It->GetClass() : APONPCCharacter::StaticClass();
+		}
+
+		FVector Origin = FVector::ZeroVector;
+		if (const APawn* PlayerPawn = World->GetFirstPlayerController() ? World->GetFirstPlayerController()->GetPawn() : nullptr)
+		{
+			Origin = PlayerPawn->GetActorLocation();
+		}
+
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TArray<APONPCCharacter*> NPCs;
+		TArray<UStateTreeComponent*> Components;
+		const int32 GridSize = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Count)));
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const FVector Location = Origin + FVector((i % GridSize) * 200.0f, (i / GridSize) * 200.0f, 0.0f);
+			APONPCCharacter* NPC = World->SpawnActor<APONPCCharacter>(NPCClass, Location, FRotator::ZeroRotator, Params);
+			if (!NPC)
+			{
+				continue;
+			}
+			NPCs.Add(NPC);
+
+			if (!NPC->GetController())
+			{
+				NPC->SpawnDefaultController();
+			}
+
+			const APONPCAIController* AIController = Cast<APONPCAIController>(NPC->GetController());
+			if (AIController && AIController->StateTreeComponent)
+			{
+				Components.Add(AIController->StateTreeComponent);
+			}
+		}
+
+		if (Components.Num() == 0)
+		{
+			Ar.Logf(TEXT("[NPCAIController] StateTree 컴포넌트가 있는 NPC를 만들지 못함 (AIControllerClass 확인): %s"), *GetNameSafe(NPCClass));
+		}
+
+		TArray<float> Timings;
+		for (int32 TreeIndex = 0; TreeIndex < static_cast<int32>(UE_ARRAY_COUNT(TreePaths)) && Components.Num() > 0; ++TreeIndex)
+		{
+			FString Label = TEXT("기본 트리");
+			if (!TreePaths[TreeIndex].IsEmpty())
+			{
+				UStateTree* Tree = LoadObject<UStateTree>(nullptr, *TreePaths[TreeIndex]);
+				if (!Tree)
+				{
+					Ar.Logf(TEXT("[NPCAIController] StateTree를 찾을 수 없음: %s"), *TreePaths[TreeIndex]);
+					continue;
+				}
+
+				for (UStateTreeComponent* Component : Components)
+				{
+					Component->StopLogic(TEXT("StateTree benchmark"));
+					Component->SetStateTree(Tree);
+					Component->StartLogic();
+				}
+				Label = Tree->GetName();
+			}
+			else if (TreeIndex > 0)
+			{
+				break;
+			}
+
+			// 진입 직후 프레임(EnterState, 전이 선택)은 제외하고 정상 상태만 측정
+			TickAll(Components, 2, Timings);
+			TickAll(Components, Frames, Timings);
+			Report(*Label, Timings, Components.Num(), Ar);
+		}
+
+		for (APONPCCharacter* NPC : NPCs)
+		{
+			if (AController* Controller = NPC->GetController())
+			{
+				Controller->UnPossess();
+				Controller->Destroy();
+			}
+			NPC->Destroy();
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPONPCBenchStateTreeCmd(
+	TEXT("NPC.BenchStateTree"),
+	TEXT("임시 NPC로 StateTree 틱 비용 비교: NPC.BenchStateTree [Count=1000] [Frames=300] [A=<트리>] [B=<트리>] [Class=<NPC 클래스>]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&PONPCAIControllerCommands::BenchStateTree));
+
+#endif // !UE_BUILD_SHIPPING
@@ -2,67 +2,244 @@
 #include "Kismet/GameplayStatics.h"
 #include "TimerManager.h"
 #include "../Claude/POClaudeAPIManager.h"
-#include "../Weather/POWeatherSystemManager.h"
-#include "../Weather/WeatherTypes.h"
+#include "../Claude/POClaudePromptBuilder.h"
+#include "../World/POEnvironmentSubsystem.h"
+#include "../Weather/POWeatherTags.h"
+#include "../Bark/POBarkSubsystem.h"
+#include "PONPCAIController.h"
+#include "PONPCTags.h"
+#include "PONPCSignificanceSubsystem.h"
+#include "Components/StateTreeComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
 
 APONPCCharacter::APONPCCharacter()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// 액터 틱에서 할 일이 없음 (판단은 StateTree, 이동/애니메이션은 컴포넌트 틱)
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 void APONPCCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
+	DialogueHistory.Init(MaxDialogueHistory);
+
 	AActor* FoundClaude = UGameplayStatics::GetActorOfClass(GetWorld(), APOClaudeAPIManager::StaticClass());
 	ClaudeManager = Cast<APOClaudeAPIManager>(FoundClaude);
 	if (!ClaudeManager)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[NPCCharacter] ClaudeAPIManager를 레벨에서 찾을 수 없습니다. 대화 기능이 비활성화됩니다."));
 	}
+	else
+	{
+		ClaudeManager->RegisterNPC(this);
+	}
 
-	AActor* FoundWeather = UGameplayStatics::GetActorOfClass(GetWorld(), APOWeatherSystemManager::StaticClass());
-	WeatherManager = Cast<APOWeatherSystemManager>(FoundWeather);
-	if (!WeatherManager)
+	// 날씨는 바뀔 때만 통지받음 (NPC마다 주기 타이머로 폴링하지 않음)
+	Environment = UPOEnvironmentSubsystem::Get(this);
+	if (Environment)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[NPCCharacter] WeatherSystemManager를 레벨에서 찾을 수 없습니다. 날씨 반응이 비활성화됩니다."));
+		const FPOEnvironmentSnapshot& Env = Environment->GetSnapshot();
+		if (Env.bHasWeather)
+		{
+			CurrentWeatherName = UPOEnvironmentSubsystem::WeatherToKorean(Env.Weather);
+		}
+
+		WeatherChangedHandle = Environment->OnWeatherChanged.AddUObject(this, &APONPCCharacter::HandleWeatherChanged);
+		WeatherTransitionStartedHandle = Environment->OnWeatherTransitionStarted.AddUObject(this, &APONPCCharacter::HandleWeatherTransitionStarted);
 	}
 
-	GetWorldTimerManager().SetTimer(
-		WeatherRefreshTimerHandle,
-		this,
-		&APONPCCharacter::RefreshWeatherState,
-		WeatherRefreshInterval,
-		true  // 반복
-	);
+	// 플레이어와의 거리/가시성/대화 상태에 따라 틱·StateTree·이동·애니메이션 갱신 주기를 조절받음
+	if (UPONPCSignificanceSubsystem* Significance = UPONPCSignificanceSubsystem::Get(this))
+	{
+		Significance->RegisterNPC(this);
+	}
 
-	RefreshWeatherState();
+	SetupAmbientBarks();
 }
 
-void APONPCCharacter::Tick(float DeltaTime)
+void APONPCCharacter::SetupAmbientBarks()
 {
-	Super::Tick(DeltaTime);
+	GetWorldTimerManager().ClearTimer(AmbientBarkTimerHandle);
+	BarkArchetypeIndex = INDEX_NONE;
+
+	if (!bEnableAmbientBarks)
+	{
+		return;
+	}
+
+	const UPOBarkSubsystem* Barks = UPOBarkSubsystem::Get(this);
+	BarkArchetypeIndex = (Barks && Barks->IsLoaded()) ? Barks->FindArchetype(NPCName, NPCPersonality) : INDEX_NONE;
+	if (BarkArchetypeIndex != INDEX_NONE)
+	{
+		NextBarkSeed = GetUniqueID();
+		ScheduleAmbientBark();
+	}
+	else if (Barks && Barks->IsLoaded())
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[NPCCharacter] bark 표에 %s 아키타입이 없습니다. POBakeBarks로 다시 구우세요."), *NPCName);
+	}
+}
+
+void APONPCCharacter::ActivateFromPool(const FString& InName, const FString& InPersonality, float InImportance, FNPCPersistentState&& State)
+{
+	NPCName            = InName;
+	NPCPersonality     = InPersonality;
+	DialogueImportance = InImportance;
+
+	// 처음 승격되는 주민은 빈 이력으로 시작
+	if (State.DialogueHistory.Num() > 0)
+	{
+		DialogueHistory = MoveTemp(State.DialogueHistory);
+	}
+	else
+	{
+		DialogueHistory.Init(MaxDialogueHistory);
+	}
+	DialogueSummary = MoveTemp(State.DialogueSummary);
+	LastNPCResponse = MoveTemp(State.LastNPCResponse);
+	TalkState       = State.TalkState;
+
+	if (TalkState == ENPCTalkState::Cooldown)
+	{
+		GetWorldTimerManager().SetTimer(CooldownTimerHandle, this, &APONPCCharacter::OnCooldownFinished,
+			FMath::Max(State.CooldownRemaining, KINDA_SMALL_NUMBER), false);
+	}
+
+	if (Environment)
+	{
+		const FPOEnvironmentSnapshot& Env = Environment->GetSnapshot();
+		if (Env.bHasWeather)
+		{
+			CurrentWeatherName = UPOEnvironmentSubsystem::WeatherToKorean(Env.Weather);
+		}
+	}
+
+	// 중요도 서브시스템은 등록 시 전부 매 프레임 갱신 중이라고 보므로 먼저 모두 켬
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetMesh()->SetComponentTickEnabled(true);
+	bPooled = false;
+
+	if (ClaudeManager)
+	{
+		// 같은 액터라도 이름/성격이 바뀌었으므로 로컬 응답 페르소나를 다시 등록
+		ClaudeManager->RegisterNPC(this);
+	}
+	if (UPONPCSignificanceSubsystem* Significance = UPONPCSignificanceSubsystem::Get(this))
+	{
+		Significance->RegisterNPC(this);
+	}
+
+	const APONPCAIController* AIController = Cast<APONPCAIController>(GetController());
+	if (AIController && AIController->StateTreeComponent)
+	{
+		AIController->StateTreeComponent->StartLogic();
+	}
+
+	SetupAmbientBarks();
 }
 
+void APONPCCharacter::DeactivateToPool(FNPCPersistentState& OutState)
+{
+	// 응답은 더 이상 보여 줄 곳이 없으므로 취소
+	ActiveRequest.Cancel();
+	ActiveRequest.Reset();
+
+	OutState.DialogueHistory   = MoveTemp(DialogueHistory);
+	OutState.DialogueSummary   = MoveTemp(DialogueSummary);
+	OutState.LastNPCResponse   = MoveTemp(LastNPCResponse);
+	OutState.TalkState         = TalkState == ENPCTalkState::WaitingForAPI ? ENPCTalkState::Idle : TalkState;
+	OutState.CooldownRemaining = TalkState == ENPCTalkState::Cooldown
+		? GetWorldTimerManager().GetTimerRemaining(CooldownTimerHandle)
+		: 0.0f;
+
+	GetWorldTimerManager().ClearTimer(CooldownTimerHandle);
+	GetWorldTimerManager().ClearTimer(AmbientBarkTimerHandle);
+
+	if (ClaudeManager)
+	{
+		ClaudeManager->UnregisterNPC(this);
+	}
+	if (UPONPCSignificanceSubsystem* Significance = UPONPCSignificanceSubsystem::Get(this))
+	{
+		Significance->UnregisterNPC(this);
+	}
+
+	const APONPCAIController* AIController = Cast<APONPCAIController>(GetController());
+	if (AIController && AIController->StateTreeComponent)
+	{
+		AIController->StateTreeComponent->StopLogic(TEXT("Returned to villager pool"));
+	}
 
-void APONPCCharacter::RefreshWeatherState()
+	// 다음 주민이 받기 전까지 빈 상태로 (상태 통지는 구독자가 이미 해제되어 생략)
+	DialogueHistory.Init(MaxDialogueHistory);
+	PendingPlayerMessage.Reset();
+	TalkState = ENPCTalkState::Idle;
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+	GetMesh()->SetComponentTickEnabled(false);
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+	bPooled = true;
+}
+
+void APONPCCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (!WeatherManager)
+	// 아무도 읽지 않을 응답에 대역폭/속도 제한 예산을 쓰지 않도록 중단
+	ActiveRequest.Cancel();
+	ActiveRequest.Reset();
+
+	if (ClaudeManager)
 	{
-		return;
+		ClaudeManager->UnregisterNPC(this);
+	}
+
+	if (UPONPCSignificanceSubsystem* Significance = UPONPCSignificanceSubsystem::Get(this))
+	{
+		Significance->UnregisterNPC(this);
 	}
 
-	static const TMap<EWeatherType, FString> WeatherNames = {
-		{EWeatherType::Clear,  TEXT("맑음")},
-		{EWeatherType::Cloudy, TEXT("흐림")},
-		{EWeatherType::Rainy,  TEXT("비")},
-		{EWeatherType::Snowy,  TEXT("눈")},
-		{EWeatherType::Foggy,  TEXT("안개")},
-		{EWeatherType::Stormy, TEXT("폭풍")}
-	};
+	if (Environment)
+	{
+		Environment->OnWeatherChanged.Remove(WeatherChangedHandle);
+		Environment->OnWeatherTransitionStarted.Remove(WeatherTransitionStartedHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
 
-	const EWeatherType WT = WeatherManager->GetCurrentWeather();
-	CurrentWeatherName = WeatherNames.Contains(WT) ? WeatherNames[WT] : TEXT("맑음");
+
+void APONPCCharacter::HandleWeatherChanged(EWeatherType OldWeather, EWeatherType NewWeather)
+{
+	CurrentWeatherName = UPOEnvironmentSubsystem::WeatherToKorean(NewWeather);
+
+	FWeatherChangedPayload Payload;
+	Payload.OldWeather = OldWeather;
+	Payload.NewWeather = NewWeather;
+	SendStateTreeEvent(POWeatherTags::Changed, FConstStructView::Make(Payload));
+}
+
+void APONPCCharacter::HandleWeatherTransitionStarted(EWeatherType FromWeather, EWeatherType ToWeather, float Duration)
+{
+	FWeatherChangedPayload Payload;
+	Payload.OldWeather         = FromWeather;
+	Payload.NewWeather         = ToWeather;
+	Payload.TransitionDuration = Duration;
+	SendStateTreeEvent(POWeatherTags::TransitionStarted, FConstStructView::Make(Payload));
+}
+
+void APONPCCharacter::SendStateTreeEvent(const FGameplayTag& Tag, FConstStructView Payload) const
+{
+	// StateTree는 이 태그의 이벤트 전이/이벤트 바인딩으로 반응 (실행 중이 아니면 버려짐)
+	const APONPCAIController* AIController = Cast<APONPCAIController>(GetController());
+	if (AIController && AIController->StateTreeComponent)
+	{
+		AIController->StateTreeComponent->SendStateTreeEvent(Tag, Payload, GetFName());
+	}
 }
 
 
@@ -81,23 +258,70 @@ void APONPCCharacter::StartConversation(const FString& PlayerMessage)
 	}
 
 	// 상태 전환: WaitingForAPI
-	TalkState = ENPCTalkState::WaitingForAPI;
+	SetTalkState(ENPCTalkState::WaitingForAPI);
 
 	// UI에 "생각 중..." 표시 (bIsThinking = true)
 	OnDialogueUpdated.Broadcast(TEXT(""), true);
 
-	UE_LOG(LogTemp, Log, TEXT("[NPCCharacter] 대화 시작: \"%s\" (날씨: %s)"), *PlayerMessage, *CurrentWeatherName);
+	// 빈 메시지 = 말 걸기만 한 경우, 인사말로 요청
+	const FString& Message = PlayerMessage.IsEmpty() ? ClaudeManager->GreetingPlayerMessage : PlayerMessage;
 
-	// Claude API 호출 (날씨/시간 컨텍스트 자동 수집)
-	FOnClaudeResponse Callback;
-	Callback.BindUFunction(this, FName("OnClaudeResponseReceived"));
+	UE_LOG(LogTemp, Log, TEXT("[NPCCharacter] 대화 시작: \"%s\" (날씨: %s)"), *Message, *CurrentWeatherName);
 
-	ClaudeManager->SendMessageWithAutoContext(
-		PlayerMessage,
-		NPCName,
-		NPCPersonality,
-		Callback
-	);
+	// Claude API 호출 (날씨/시간 컨텍스트 자동 수집, 슬롯이 없으면 대기열에서 순서 대기)
+	FClaudeRequestCallbacks Callbacks;
+	Callbacks.OnResponse.BindUFunction(this, FName("OnClaudeResponseReceived"));
+	Callbacks.OnQueueStatus.BindUFunction(this, FName("OnClaudeQueueStatus"));
+	Callbacks.OnPartial.BindUFunction(this, FName("OnClaudePartialResponse"));
+	Callbacks.OnFollowUp.BindUObject(this, &APONPCCharacter::OnClaudeFollowUp);
+
+	FClaudeRequestOptions Options;
+	Options.FirstTextSLOSeconds = ResponseSLOSeconds;
+
+	FClaudeRequestContext Context = ClaudeManager->MakeAutoContext(Message, NPCName, NPCPersonality);
+
+	// 이전 대화 (토큰 예산에 맞춘 선택은 매니저가 요청 본문을 만들 때 처리)
+	Context.History.Reserve(DialogueHistory.Num());
+	for (int32 i = 0; i < DialogueHistory.Num(); ++i)
+	{
+		FClaudeDialogueTurn& Turn = Context.History.AddDefaulted_GetRef();
+		Turn.PlayerMessage = DialogueHistory[i].PlayerMessage;
+		Turn.NPCResponse   = DialogueHistory[i].NPCResponse;
+	}
+	Context.HistorySummary = DialogueSummary;
+	Context.Importance     = DialogueImportance;
+
+	PendingPlayerMessage = Message;
+
+	// 근접 프리페치로 미리 받아 둔 인사말이 있으면 API 왕복 없이 바로 응답
+	ActiveRequest = ClaudeManager->TryServePrefetchedGreeting(this, Context, Callbacks, Options);
+	if (!ActiveRequest.IsValid())
+	{
+		ActiveRequest = ClaudeManager->EnqueueRequest(Context, Callbacks, Options);
+	}
+}
+
+void APONPCCharacter::OnClaudePartialResponse(const FString& AccumulatedText)
+{
+	if (TalkState != ENPCTalkState::WaitingForAPI)
+	{
+		return;
+	}
+
+	// 스트리밍 중 누적 텍스트를 바로 UI로 전달 (첫 토큰부터 표시)
+	OnDialogueUpdated.Broadcast(AccumulatedText, false);
+}
+
+void APONPCCharacter::OnClaudeQueueStatus(int32 QueuePosition, float EstimatedWaitSeconds)
+{
+	if (TalkState != ENPCTalkState::WaitingForAPI)
+	{
+		return;
+	}
+
+	OnDialogueQueued.Broadcast(QueuePosition, EstimatedWaitSeconds);
+
+	UE_LOG(LogTemp, Verbose, TEXT("[NPCCharacter] 대기열 위치 %d (예상 %.1f초)"), QueuePosition, EstimatedWaitSeconds);
 }
 
 void APONPCCharacter::OnClaudeResponseReceived(bool bSuccess, const FString& ResponseText)
@@ -107,19 +331,16 @@ void APONPCCharacter::OnClaudeResponseReceived(bool bSuccess, const FString& Res
 		LastNPCResponse = ResponseText;
 
 		// 대화 이력 추가
-		FNPCDialogueEntry Entry;
-		Entry.NPCResponse    = ResponseText;
-		Entry.WeatherContext = CurrentWeatherName;
-
-		DialogueHistory.Add(Entry);
+		AddDialogueTurn(PendingPlayerMessage, ResponseText);
 
-		if (DialogueHistory.Num() > MaxDialogueHistory)
+		// 플레이어가 자기에 대해 한 말은 대화가 끝나도 기억
+		if (ClaudeManager)
 		{
-			DialogueHistory.RemoveAt(0);
+			ClaudeManager->RememberExchange(NPCName, NPCPersonality, PendingPlayerMessage);
 		}
 
 		// 상태 전환: Talking
-		TalkState = ENPCTalkState::Talking;
+		SetTalkState(ENPCTalkState::Talking);
 
 		// UI에 응답 전달 (bIsThinking = false)
 		OnDialogueUpdated.Broadcast(ResponseText, false);
@@ -129,13 +350,28 @@ void APONPCCharacter::OnClaudeResponseReceived(bool bSuccess, const FString& Res
 	else
 	{
 		// 오류 시 Idle로 복귀
-		TalkState = ENPCTalkState::Idle;
+		SetTalkState(ENPCTalkState::Idle);
 		OnDialogueUpdated.Broadcast(ResponseText, false);
 
 		UE_LOG(LogTemp, Error, TEXT("[NPCCharacter] Claude 응답 실패: %s"), *ResponseText);
 	}
 }
 
+void APONPCCharacter::OnClaudeFollowUp(bool bSuccess, const FString& ResponseText)
+{
+	// 폴백 대사를 보여 주는 중일 때만 실제 응답으로 교체 (대화가 끝났으면 버림)
+	if (!bSuccess || TalkState != ENPCTalkState::Talking || DialogueHistory.Num() == 0)
+	{
+		return;
+	}
+
+	LastNPCResponse = ResponseText;
+	DialogueHistory.Last().NPCResponse = ResponseText;
+	OnDialogueUpdated.Broadcast(ResponseText, false);
+
+	UE_LOG(LogTemp, Log, TEXT("[NPCCharacter] 후속 응답 수신: %s"), *ResponseText);
+}
+
 void APONPCCharacter::EndConversation()
 {
 	if (TalkState == ENPCTalkState::Idle)
@@ -143,8 +379,12 @@ void APONPCCharacter::EndConversation()
 		return;
 	}
 
+	// 아직 응답을 기다리는 중이면 요청 중단 (대기열에서 빠지거나 HTTP 요청 취소)
+	ActiveRequest.Cancel();
+	ActiveRequest.Reset();
+
 	// 쿨다운 상태로 전환
-	TalkState = ENPCTalkState::Cooldown;
+	SetTalkState(ENPCTalkState::Cooldown);
 
 	// TalkCooldown 초 후 OnCooldownFinished() 호출
 	GetWorldTimerManager().SetTimer(
@@ -160,10 +400,93 @@ void APONPCCharacter::EndConversation()
 
 void APONPCCharacter::OnCooldownFinished()
 {
-	TalkState = ENPCTalkState::Idle;
+	SetTalkState(ENPCTalkState::Idle);
 	UE_LOG(LogTemp, Log, TEXT("[NPCCharacter] 쿨다운 완료 - Idle 복귀"));
 }
 
+void APONPCCharacter::ScheduleAmbientBark()
+{
+	GetWorldTimerManager().SetTimer(
+		AmbientBarkTimerHandle,
+		this,
+		&APONPCCharacter::EmitAmbientBark,
+		FMath::FRandRange(AmbientBarkIntervalMin, FMath::Max(AmbientBarkIntervalMin, AmbientBarkIntervalMax)),
+		false  // 매번 간격을 새로 뽑음
+	);
+}
+
+void APONPCCharacter::EmitAmbientBark()
+{
+	ScheduleAmbientBark();
+
+	if (TalkState != ENPCTalkState::Idle || !Environment)
+	{
+		return;
+	}
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	if (!PlayerPawn || FVector::DistSquared(PlayerPawn->GetActorLocation(), GetActorLocation()) > FMath::Square(AmbientBarkRadius))
+	{
+		return;
+	}
+
+	const UPOBarkSubsystem* Barks = UPOBarkSubsystem::Get(this);
+	const FPOEnvironmentSnapshot& Env = Environment->GetSnapshot();
+
+	FString Line;
+	if (Barks && Barks->GetBark(BarkArchetypeIndex, Env.Weather, Env.Period, NextBarkSeed++, Line))
+	{
+		OnAmbientBark.Broadcast(Line);
+		UE_LOG(LogTemp, Verbose, TEXT("[NPCCharacter] 혼잣말: %s"), *Line);
+	}
+}
+
+void APONPCCharacter::SetTalkState(ENPCTalkState NewState)
+{
+	if (TalkState == NewState)
+	{
+		return;
+	}
+
+	FNPCTalkStateChangedPayload Payload;
+	Payload.OldState = TalkState;
+	Payload.NewState = NewState;
+
+	TalkState = NewState;
+	OnTalkStateChanged.Broadcast(this, NewState);
+
+	// 네이티브 대화 태스크는 틱 없이 이 이벤트로만 깨어남
+	SendStateTreeEvent(PONPCTags::TalkStateChanged, FConstStructView::Make(Payload));
+}
+
+void APONPCCharacter::AddDialogueTurn(const FString& PlayerMessage, const FString& NPCResponse)
+{
+	FNPCDialogueEntry Entry;
+	Entry.PlayerMessage  = PlayerMessage;
+	Entry.NPCResponse    = NPCResponse;
+	Entry.WeatherContext = CurrentWeatherName;
+
+	// 용량을 넘겨 밀려난 턴은 요약으로 접어 둠
+	FNPCDialogueEntry Evicted;
+	if (DialogueHistory.Add(MoveTemp(Entry), Evicted) && ClaudeManager)
+	{
+		FPOClaudePromptBuilder::AppendToSummary(DialogueSummary,
+			FPOClaudePromptBuilder::SummarizeTurn(Evicted.PlayerMessage, Evicted.NPCResponse),
+			ClaudeManager->HistorySummaryTokenBudget);
+	}
+}
+
+TArray<FNPCDialogueEntry> APONPCCharacter::GetDialogueHistory() const
+{
+	TArray<FNPCDialogueEntry> Result;
+	Result.Reserve(DialogueHistory.Num());
+	for (int32 i = 0; i < DialogueHistory.Num(); ++i)
+	{
+		Result.Add(DialogueHistory[i]);
+	}
+	return Result;
+}
+
 bool APONPCCharacter::IsInConversation() const
 {
 	return TalkState == ENPCTalkState::WaitingForAPI
@@ -3,12 +3,20 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "PONPCTypes.h"
+#include "../Claude/POClaudeTypes.h"
+#include "../Claude/POClaudeRequestHandle.h"
 #include "PONPCCharacter.generated.h"
 
 class APOClaudeAPIManager;
-class APOWeatherSystemManager;
+class UPOEnvironmentSubsystem;
+struct FGameplayTag;
+struct FConstStructView;
+enum class EWeatherType : uint8;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnNPCDialogueUpdated,const FString&, NPCResponse,bool, bIsThinking);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnNPCDialogueQueued, int32, QueuePosition, float, EstimatedWaitSeconds);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNPCAmbientBark, const FString&, BarkLine);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnNPCTalkStateChangedNative, APONPCCharacter* /*NPC*/, ENPCTalkState /*NewState*/);
 
 UCLASS()
 class PROJECT_OPENWORLD_API APONPCCharacter : public ACharacter
@@ -20,7 +28,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC|Identity")
@@ -30,6 +38,14 @@ public:
 		meta = (MultiLine = true))
 	FString NPCPersonality = TEXT("친절하고 소박한 시골 마을 주민");
 
+	// 인사/작별/감사/날씨·시간 질문에 API 없이 답할 문구 (비어 있는 의도는 기본 문구 사용) 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC|Identity")
+	TArray<FClaudeLocalReplyTemplates> LocalReplyTemplates;
+
+	// 대화 중요도 (0 = 엑스트라, 1 = 핵심 인물). 높을수록 큰 모델 티어로 답함 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC|Identity", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float DialogueImportance = 0.0f;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "NPC|State")
 	ENPCTalkState TalkState = ENPCTalkState::Idle;
 
@@ -39,15 +55,54 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "NPC|Dialogue")
 	FString LastNPCResponse;
 
+	// 최근 대화 턴 (고정 용량 링 버퍼) 
+	UPROPERTY(VisibleAnywhere, Category = "NPC|Dialogue")
+	FNPCDialogueHistory DialogueHistory;
+
+	// 링 버퍼에서 밀려난 턴의 누적 요약 (토큰 예산 안에서 유지) 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "NPC|Dialogue")
-	TArray<FNPCDialogueEntry> DialogueHistory;
+	FString DialogueSummary;
+
+	// 링 버퍼 용량 (턴 수) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NPC|Dialogue", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 MaxDialogueHistory = 10;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NPC|Dialogue")
 	float TalkCooldown = 2.0f;
 
+	// 첫 텍스트까지의 지연 목표 (초, 0 = 사용 안 함, 매니저가 스트리밍을 끄면 무시). 넘기면 날씨/시간대 폴백 대사로 먼저 답함 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NPC|Dialogue", meta = (ClampMin = "0.0"))
+	float ResponseSLOSeconds = 1.5f;
+
+	// 플레이어가 근처에 있고 대화 중이 아닐 때 구워 둔 bark 표에서 혼잣말 (API 호출 없음) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NPC|Bark")
+	bool bEnableAmbientBarks = true;
+
+	// 혼잣말 간격 (초, 최소~최대 사이 무작위) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NPC|Bark", meta = (ClampMin = "1.0", EditCondition = "bEnableAmbientBarks"))
+	float AmbientBarkIntervalMin = 20.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NPC|Bark", meta = (ClampMin = "1.0", EditCondition = "bEnableAmbientBarks"))
+	float AmbientBarkIntervalMax = 45.0f;
+
+	// 플레이어가 이 거리 안에 있을 때만 혼잣말 (cm) 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NPC|Bark", meta = (ClampMin = "100.0", EditCondition = "bEnableAmbientBarks"))
+	float AmbientBarkRadius = 1500.0f;
+
 	UPROPERTY(BlueprintAssignable, Category = "NPC|Events")
 	FOnNPCDialogueUpdated OnDialogueUpdated;
 
+	// 주변 혼잣말 (말풍선 등 표시용) 
+	UPROPERTY(BlueprintAssignable, Category = "NPC|Events")
+	FOnNPCAmbientBark OnAmbientBark;
+
+	// 요청이 대기열에 있는 동안 위치/예상 대기 시간 통지 (QueuePosition 0 = 전송 시작, -1 = 대기열이 가득 차 거절)
+	UPROPERTY(BlueprintAssignable, Category = "NPC|Events")
+	FOnNPCDialogueQueued OnDialogueQueued;
+
+	// 대화 상태 전환 통지 (C++ 전용, 부하 테스트/시스템 구독용)
+	FOnNPCTalkStateChangedNative OnTalkStateChanged;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "NPC|References")
 	TObjectPtr<APOClaudeAPIManager> ClaudeManager;
 
@@ -60,19 +115,69 @@ public:
 	UFUNCTION(BlueprintPure, Category = "NPC|State")
 	bool IsInConversation() const;
 
+	// 대화 이력 (오래된 것 → 최근 것) 
+	UFUNCTION(BlueprintPure, Category = "NPC|Dialogue")
+	TArray<FNPCDialogueEntry> GetDialogueHistory() const;
+
+	// 풀 액터를 다른 마을 주민으로 다시 활성화 (Mass → 액터 승격). 보관해 둔 대화 이력/상태 복원 
+	void ActivateFromPool(const FString& InName, const FString& InPersonality, float InImportance, FNPCPersistentState&& State);
+
+	// 대화 이력/상태를 꺼내 주고 숨긴 채 풀로 (액터 → Mass 강등) 
+	void DeactivateToPool(FNPCPersistentState& OutState);
+
+	bool IsPooled() const { return bPooled; }
+
 private:
 	UFUNCTION()
 	void OnClaudeResponseReceived(bool bSuccess, const FString& ResponseText);
 
-	void RefreshWeatherState();
+	UFUNCTION()
+	void OnClaudePartialResponse(const FString& AccumulatedText);
+
+	UFUNCTION()
+	void OnClaudeQueueStatus(int32 QueuePosition, float EstimatedWaitSeconds);
+
+	// 폴백 대사 뒤에 도착한 실제 응답 
+	void OnClaudeFollowUp(bool bSuccess, const FString& ResponseText);
+
+	// 날씨 이벤트 (환경 서브시스템 중계). 표시 이름 갱신 후 StateTree에 이벤트로 전달 
+	void HandleWeatherChanged(EWeatherType OldWeather, EWeatherType NewWeather);
+	void HandleWeatherTransitionStarted(EWeatherType FromWeather, EWeatherType ToWeather, float Duration);
+
+	// 컨트롤러의 StateTree에 이벤트 전달 (날씨 변경, 대화 상태 전환) 
+	void SendStateTreeEvent(const FGameplayTag& Tag, FConstStructView Payload) const;
+
+	void SetTalkState(ENPCTalkState NewState);
 
 	UFUNCTION()
 	void OnCooldownFinished();
 
-	TObjectPtr<APOWeatherSystemManager> WeatherManager;
-	FTimerHandle WeatherRefreshTimerHandle;
+	// 현재 이름/성격으로 bark 아키타입을 찾아 혼잣말 예약 (BeginPlay, 풀에서 재활성화 시) 
+	void SetupAmbientBarks();
+
+	void ScheduleAmbientBark();
+
+	void EmitAmbientBark();
+
+	UPROPERTY()
+	TObjectPtr<UPOEnvironmentSubsystem> Environment;
+	FDelegateHandle WeatherChangedHandle;
+	FDelegateHandle WeatherTransitionStartedHandle;
 	FTimerHandle CooldownTimerHandle;
+	FTimerHandle AmbientBarkTimerHandle;
+
+	// bark 표 안의 이 NPC 아키타입 번호 (INDEX_NONE = 표에 없음) 
+	int32 BarkArchetypeIndex = INDEX_NONE;
+	uint32 NextBarkSeed = 0;
+
+	// 응답을 기다리는 플레이어 메시지 (응답과 함께 이력에 저장) 
+	FString PendingPlayerMessage;
+
+	// 진행 중인 Claude 요청 (대화 종료/소멸 시 취소) 
+	FPOClaudeRequestHandle ActiveRequest;
+
+	// 풀에서 대기 중 (숨김, 틱/충돌/StateTree 정지) 
+	bool bPooled = false;
 
-	static constexpr float WeatherRefreshInterval = 2.0f;
-	static constexpr int32 MaxDialogueHistory = 10;
+	void AddDialogueTurn(const FString& PlayerMessage, const FString& NPCResponse);
 };
@@ -0,0 +1,357 @@
+#include "PONPCSignificanceSubsystem.h"
+#include "PONPCCharacter.h"
+#include "PONPCAIController.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StateTreeComponent.h"
+
+DECLARE_STATS_GROUP(TEXT("NPCSignificance"), STATGROUP_NPCSignificance, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Update"), STAT_NPCSignificanceUpdate, STATGROUP_NPCSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("NPCs: critical (talking)"), STAT_NPCSignificanceCritical, STATGROUP_NPCSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("NPCs: high"), STAT_NPCSignificanceHigh, STATGROUP_NPCSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("NPCs: medium"), STAT_NPCSignificanceMedium, STATGROUP_NPCSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("NPCs: low"), STAT_NPCSignificanceLow, STATGROUP_NPCSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("NPCs: dormant"), STAT_NPCSignificanceDormant, STATGROUP_NPCSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Evaluated per frame"), STAT_NPCSignificanceEvaluated, STATGROUP_NPCSignificance);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Est. game thread saved (ms)"), STAT_NPCSignificanceSavedMs, STATGROUP_NPCSignificance);
+
+namespace POSignificance
+{
+	// 최근 렌더 판정 여유 (초)
+	constexpr float RenderTolerance = 0.25f;
+
+	// 예산 확인 주기 (매 항목마다 시간을 재지 않도록)
+	constexpr int32 BudgetCheckMask = 15;
+
+	static void ApplyTickInterval(UActorComponent* Component, float Interval)
+	{
+		if (!Component)
+		{
+			return;
+		}
+
+		if (Interval < 0.0f)
+		{
+			Component->SetComponentTickEnabled(false);
+			return;
+		}
+
+		Component->SetComponentTickInterval(Interval);
+		Component->SetComponentTickEnabled(true);
+	}
+
+	// 주기 Interval로 틱할 때 매 프레임 틱 대비 건너뛰는 비율
+	static float GetSkippedFraction(float Interval, float DeltaTime)
+	{
+		if (Interval < 0.0f)
+		{
+			return 1.0f;
+		}
+		if (Interval <= DeltaTime)
+		{
+			return 0.0f;
+		}
+		return 1.0f - DeltaTime / Interval;
+	}
+}
+
+UPONPCSignificanceSubsystem::UPONPCSignificanceSubsystem()
+{
+	// 대화 중 / 가까움: 모두 매 프레임
+	GetLevel(ENPCSignificance::Critical).MaxDistance = 0.0f;
+	GetLevel(ENPCSignificance::High).MaxDistance     = 2000.0f;
+
+	FPONPCSignificanceLevel& Medium = GetLevel(ENPCSignificance::Medium);
+	Medium.MaxDistance               = 5000.0f;
+	Medium.StateTreeTickInterval     = 0.1f;
+	Medium.MovementTickInterval      = 0.033f;
+	Medium.MeshTickInterval          = 0.033f;
+	Medium.bOnlyTickPoseWhenRendered = true;
+
+	FPONPCSignificanceLevel& Low = GetLevel(ENPCSignificance::Low);
+	Low.MaxDistance               = 10000.0f;
+	Low.StateTreeTickInterval     = 0.25f;
+	Low.MovementTickInterval      = 0.1f;
+	Low.MeshTickInterval          = 0.1f;
+	Low.bOnlyTickPoseWhenRendered = true;
+
+	// 휴면: 화면 밖 먼 NPC. 판단(StateTree)만 드물게 돌고 나머지는 끔
+	FPONPCSignificanceLevel& Dormant = GetLevel(ENPCSignificance::Dormant);
+	Dormant.MaxDistance               = BIG_NUMBER;
+	Dormant.StateTreeTickInterval     = 1.0f;
+	Dormant.MovementTickInterval      = -1.0f;
+	Dormant.MeshTickInterval          = -1.0f;
+	Dormant.bOnlyTickPoseWhenRendered = true;
+}
+
+void UPONPCSignificanceSubsystem::Deinitialize()
+{
+	while (Entries.Num() > 0)
+	{
+		RemoveEntryAt(Entries.Num() - 1);
+	}
+
+	Super::Deinitialize();
+}
+
+TStatId UPONPCSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPONPCSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+UPONPCSignificanceSubsystem* UPONPCSignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UPONPCSignificanceSubsystem>() : nullptr;
+}
+
+void UPONPCSignificanceSubsystem::RegisterNPC(APONPCCharacter* NPC)
+{
+	if (!NPC || EntryIndices.Contains(NPC))
+	{
+		return;
+	}
+
+	// 등록 시점에는 모든 컴포넌트가 매 프레임 틱하므로 High로 두고 시간 분할 재평가에서 내림
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.NPC                   = NPC;
+	Entry.Key                   = NPC;
+	Entry.Significance          = ENPCSignificance::High;
+	Entry.DefaultAnimTickOption = NPC->GetMesh() ? NPC->GetMesh()->VisibilityBasedAnimTickOption : EVisibilityBasedAnimTickOption::AlwaysTickPose;
+	Entry.TalkStateHandle = NPC->OnTalkStateChanged.AddUObject(this, &UPONPCSignificanceSubsystem::HandleTalkStateChanged);
+
+	EntryIndices.Add(NPC, Entries.Num() - 1);
+	++NumPerLevel[static_cast<int32>(ENPCSignificance::High)];
+
+	// 풀에서 다시 꺼낸 액터 등 이전 설정이 남아 있을 수 있으므로 High를 실제로 적용
+	ApplyLevel(Entry, Levels[static_cast<int32>(ENPCSignificance::High)]);
+}
+
+void UPONPCSignificanceSubsystem::UnregisterNPC(APONPCCharacter* NPC)
+{
+	if (const int32* Index = EntryIndices.Find(NPC))
+	{
+		// 풀로 돌아갔다가 다시 등록될 수 있으므로 낮춰 둔 틱 설정을 기본(High)으로 되돌린 뒤 해제
+		const FEntry& Entry = Entries[*Index];
+		if (Entry.NPC.IsValid())
+		{
+			ApplyLevel(Entry, Levels[static_cast<int32>(ENPCSignificance::High)]);
+			if (USkeletalMeshComponent* Mesh = NPC->GetMesh())
+			{
+				Mesh->VisibilityBasedAnimTickOption = Entry.DefaultAnimTickOption;
+			}
+		}
+		RemoveEntryAt(*Index);
+	}
+}
+
+void UPONPCSignificanceSubsystem::RemoveEntryAt(int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	if (APONPCCharacter* NPC = Entry.NPC.Get())
+	{
+		NPC->OnTalkStateChanged.Remove(Entry.TalkStateHandle);
+	}
+	--NumPerLevel[static_cast<int32>(Entry.Significance)];
+	EntryIndices.Remove(Entry.Key);
+
+	Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Index < Entries.Num())
+	{
+		EntryIndices.Add(Entries[Index].Key, Index);
+	}
+}
+
+ENPCSignificance UPONPCSignificanceSubsystem::GetSignificance(const APONPCCharacter* NPC) const
+{
+	const int32* Index = EntryIndices.Find(NPC);
+	return Index ? Entries[*Index].Significance : ENPCSignificance::High;
+}
+
+bool UPONPCSignificanceSubsystem::UpdateViewLocation()
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!PlayerController)
+	{
+		return bHasViewLocation;
+	}
+
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(LastViewLocation, ViewRotation);
+	bHasViewLocation = true;
+	return true;
+}
+
+void UPONPCSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_NPCSignificanceUpdate);
+
+	int32 NumEvaluated = 0;
+	if (Entries.Num() > 0 && UpdateViewLocation())
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		const double BudgetSeconds = UpdateBudgetMs * 0.001;
+		const int32 MaxCount = FMath::Min(Entries.Num(), NPCsPerFrame);
+
+		while (NumEvaluated < MaxCount && Entries.Num() > 0)
+		{
+			if (Cursor >= Entries.Num())
+			{
+				Cursor = 0;
+			}
+
+			FEntry& Entry = Entries[Cursor];
+			if (!Entry.NPC.IsValid())
+			{
+				// 자리를 바꿔 들어온 항목이 같은 Cursor에서 다음 차례
+				RemoveEntryAt(Cursor);
+				continue;
+			}
+
+			SetSignificance(Entry, Evaluate(Entry));
+			++Cursor;
+			++NumEvaluated;
+
+			if ((NumEvaluated & POSignificance::BudgetCheckMask) == 0 && FPlatformTime::Seconds() - StartTime > BudgetSeconds)
+			{
+				break;
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_NPCSignificanceCritical, GetNumNPCs(ENPCSignificance::Critical));
+	SET_DWORD_STAT(STAT_NPCSignificanceHigh, GetNumNPCs(ENPCSignificance::High));
+	SET_DWORD_STAT(STAT_NPCSignificanceMedium, GetNumNPCs(ENPCSignificance::Medium));
+	SET_DWORD_STAT(STAT_NPCSignificanceLow, GetNumNPCs(ENPCSignificance::Low));
+	SET_DWORD_STAT(STAT_NPCSignificanceDormant, GetNumNPCs(ENPCSignificance::Dormant));
+	SET_DWORD_STAT(STAT_NPCSignificanceEvaluated, NumEvaluated);
+	SET_FLOAT_STAT(STAT_NPCSignificanceSavedMs, EstimateSavedMs(DeltaTime));
+}
+
+ENPCSignificance UPONPCSignificanceSubsystem::Evaluate(const FEntry& Entry) const
+{
+	const APONPCCharacter* NPC = Entry.NPC.Get();
+	if (NPC->IsInConversation())
+	{
+		return ENPCSignificance::Critical;
+	}
+
+	const bool bRendered = NPC->WasRecentlyRendered(POSignificance::RenderTolerance);
+	const float Distance = FVector::Dist(NPC->GetActorLocation(), LastViewLocation);
+	const float Effective = bRendered ? Distance : Distance * OffscreenDistanceScale;
+
+	// 현재 구간보다 낮은 구간으로 내려가는 경계에만 여유 거리를 더함
+	const int32 Current = static_cast<int32>(Entry.Significance);
+	for (int32 i = static_cast<int32>(ENPCSignificance::High); i < static_cast<int32>(ENPCSignificance::Dormant); ++i)
+	{
+		const float Limit = Levels[i].MaxDistance * (i >= Current ? 1.0f + DemotionHysteresis : 1.0f);
+		if (Effective <= Limit)
+		{
+			return static_cast<ENPCSignificance>(i);
+		}
+	}
+
+	// 보이는 NPC는 애니메이션이 멈춰 보이지 않도록 휴면까지 내리지 않음
+	return bRendered ? ENPCSignificance::Low : ENPCSignificance::Dormant;
+}
+
+void UPONPCSignificanceSubsystem::SetSignificance(FEntry& Entry, ENPCSignificance NewSignificance)
+{
+	if (Entry.Significance == NewSignificance)
+	{
+		return;
+	}
+
+	--NumPerLevel[static_cast<int32>(Entry.Significance)];
+	++NumPerLevel[static_cast<int32>(NewSignificance)];
+	Entry.Significance = NewSignificance;
+
+	ApplyLevel(Entry, Levels[static_cast<int32>(NewSignificance)]);
+}
+
+void UPONPCSignificanceSubsystem::ApplyLevel(const FEntry& Entry, const FPONPCSignificanceLevel& Level) const
+{
+	APONPCCharacter* NPC = Entry.NPC.Get();
+	if (const APONPCAIController* AIController = Cast<APONPCAIController>(NPC->GetController()))
+	{
+		if (AIController->StateTreeComponent)
+		{
+			AIController->StateTreeComponent->SetComponentTickInterval(FMath::Max(0.0f, Level.StateTreeTickInterval));
+		}
+	}
+
+	POSignificance::ApplyTickInterval(NPC->GetCharacterMovement(), Level.MovementTickInterval);
+
+	if (USkeletalMeshComponent* Mesh = NPC->GetMesh())
+	{
+		POSignificance::ApplyTickInterval(Mesh, Level.MeshTickInterval);
+		Mesh->VisibilityBasedAnimTickOption = Level.bOnlyTickPoseWhenRendered
+			? EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered
+			: Entry.DefaultAnimTickOption;
+	}
+}
+
+void UPONPCSignificanceSubsystem::HandleTalkStateChanged(APONPCCharacter* NPC, ENPCTalkState NewState)
+{
+	// 대화 시작/종료는 라운드 로빈 차례를 기다리지 않고 바로 반영
+	if (const int32* Index = EntryIndices.Find(NPC))
+	{
+		FEntry& Entry = Entries[*Index];
+		SetSignificance(Entry, Evaluate(Entry));
+	}
+}
+
+float UPONPCSignificanceSubsystem::EstimateSavedMs(float DeltaTime) const
+{
+	using namespace POSignificance;
+
+	double SavedMicros = 0.0;
+	for (int32 i = 0; i < static_cast<int32>(ENPCSignificance::Num); ++i)
+	{
+		const FPONPCSignificanceLevel& Level = Levels[i];
+		const double PerNPC =
+			StateTreeTickCostMicros   * GetSkippedFraction(FMath::Max(0.0f, Level.StateTreeTickInterval), DeltaTime)
+			+ MovementTickCostMicros  * GetSkippedFraction(Level.MovementTickInterval, DeltaTime)
+			+ MeshTickCostMicros      * GetSkippedFraction(Level.MeshTickInterval, DeltaTime);
+		SavedMicros += PerNPC * NumPerLevel[i];
+	}
+	return static_cast<float>(SavedMicros * 0.001);
+}
+
+#if !UE_BUILD_SHIPPING
+
+namespace POSignificanceCommands
+{
+	static void Dump(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const UPONPCSignificanceSubsystem* Significance = UPONPCSignificanceSubsystem::Get(World);
+		if (!Significance)
+		{
+			Ar.Logf(TEXT("[NPCSignificance] 서브시스템 없음"));
+			return;
+		}
+
+		const UEnum* Enum = StaticEnum<ENPCSignificance>();
+		Ar.Logf(TEXT("[NPCSignificance] 등록 NPC %d명"), Significance->GetNumRegisteredNPCs());
+		for (int32 i = 0; i < static_cast<int32>(ENPCSignificance::Num); ++i)
+		{
+			const ENPCSignificance Level = static_cast<ENPCSignificance>(i);
+			Ar.Logf(TEXT("[NPCSignificance]   %-10s %d"), *Enum->GetNameStringByIndex(i), Significance->GetNumNPCs(Level));
+		}
+
+		const float DeltaTime = World ? World->GetDeltaSeconds() : 1.0f / 60.0f;
+		Ar.Logf(TEXT("[NPCSignificance] 틱 비용 설정 기준 절감 추정: %.2f ms/프레임"), Significance->EstimateSavedMs(DeltaTime));
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPONPCSignificanceCmd(
+	TEXT("NPC.Significance"),
+	TEXT("NPC 중요도 구간별 수와 게임 스레드 절감 추정 출력"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&POSignificanceCommands::Dump));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PONPCTypes.h"
+#include "PONPCSignificanceSubsystem.generated.h"
+
+class APONPCCharacter;
+enum class EVisibilityBasedAnimTickOption : uint8;
+
+/** 중요도 구간 하나의 갱신 주기 (초, 0 = 매 프레임, 음수 = 끔) */
+struct FPONPCSignificanceLevel
+{
+	// 이 구간에 드는 최대 유효 거리 (cm). 화면 밖 NPC는 거리에 OffscreenDistanceScale을 곱해 판단
+	float MaxDistance = 0.0f;
+
+	// StateTree는 이벤트/일정 기반으로 스스로 틱을 켜고 끄므로 주기만 바꿈 (음수 불가)
+	float StateTreeTickInterval = 0.0f;
+
+	float MovementTickInterval = 0.0f;
+	float MeshTickInterval = 0.0f;
+
+	// 화면에 보일 때만 포즈 갱신 (끄면 NPC 원래 설정으로 되돌림)
+	bool bOnlyTickPoseWhenRendered = false;
+};
+
+/**
+ * NPC 중요도(significance) 기반 LOD 서비스
+ * 플레이어 시점과의 거리, 최근 렌더 여부, 대화 상태로 NPC마다 중요도 구간을 매기고
+ * 구간에 따라 StateTree 틱 주기 / CharacterMovement / 스켈레탈 메시 갱신 주기를 낮추거나 끈다.
+ *
+ * 재평가는 매 프레임 일부 NPC만 돌아가며 하고(시간 분할), 구간이 바뀐 NPC에만 설정을 다시 적용한다.
+ * 대화 상태가 바뀐 NPC는 기다리지 않고 즉시 재평가한다. `stat NPCSignificance`로 구간별 수와
+ * 설정된 틱 비용 기준 게임 스레드 절감 추정치를 본다.
+ */
+UCLASS()
+class PROJECT_OPENWORLD_API UPONPCSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UPONPCSignificanceSubsystem();
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 월드에서 서브시스템 가져오기 (없으면 nullptr) 
+	static UPONPCSignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+	// NPC 등록/해제 (NPC의 BeginPlay/EndPlay에서 호출) 
+	void RegisterNPC(APONPCCharacter* NPC);
+	void UnregisterNPC(APONPCCharacter* NPC);
+
+	ENPCSignificance GetSignificance(const APONPCCharacter* NPC) const;
+	int32 GetNumNPCs(ENPCSignificance Significance) const { return NumPerLevel[static_cast<int32>(Significance)]; }
+	int32 GetNumRegisteredNPCs() const { return Entries.Num(); }
+
+	// 구간 설정 (바꾼 뒤에는 다음 재평가부터 새로 구간이 바뀌는 NPC에 적용) 
+	FPONPCSignificanceLevel& GetLevel(ENPCSignificance Significance) { return Levels[static_cast<int32>(Significance)]; }
+
+	// 프레임당 재평가할 최대 NPC 수와 시간 예산 (ms) 
+	int32 NPCsPerFrame = 128;
+	float UpdateBudgetMs = 0.25f;
+
+	// 최근 렌더되지 않은 NPC의 거리 배율 (클수록 화면 밖 NPC가 빨리 낮은 구간으로) 
+	float OffscreenDistanceScale = 2.0f;
+
+	// 낮은 구간으로 내려갈 때만 경계 거리에 더하는 여유 비율 (경계에서 깜빡임 방지) 
+	float DemotionHysteresis = 0.1f;
+
+	// 절감 추정용 NPC 1명의 틱 1회 비용 (us) 
+	float StateTreeTickCostMicros = 12.0f;
+	float MovementTickCostMicros = 25.0f;
+	float MeshTickCostMicros = 40.0f;
+
+	// 현재 구간 분포에서 매 프레임 건너뛰는 틱 비용 추정 (ms) 
+	float EstimateSavedMs(float DeltaTime) const;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<APONPCCharacter> NPC;
+
+		// EntryIndices 키 (약참조가 끊긴 뒤에도 지울 수 있도록 주소 보관)
+		const APONPCCharacter* Key = nullptr;
+
+		ENPCSignificance Significance = ENPCSignificance::High;
+		EVisibilityBasedAnimTickOption DefaultAnimTickOption;
+		FDelegateHandle TalkStateHandle;
+	};
+
+	TArray<FEntry> Entries;
+	TMap<const APONPCCharacter*, int32> EntryIndices;
+
+	FPONPCSignificanceLevel Levels[static_cast<int32>(ENPCSignificance::Num)];
+	int32 NumPerLevel[static_cast<int32>(ENPCSignificance::Num)] = {};
+
+	// 다음 재평가할 항목 (라운드 로빈) 
+	int32 Cursor = 0;
+
+	FVector LastViewLocation = FVector::ZeroVector;
+	bool bHasViewLocation = false;
+
+	bool UpdateViewLocation();
+	ENPCSignificance Evaluate(const FEntry& Entry) const;
+	void SetSignificance(FEntry& Entry, ENPCSignificance NewSignificance);
+	void ApplyLevel(const FEntry& Entry, const FPONPCSignificanceLevel& Level) const;
+	void RemoveEntryAt(int32 Index);
+	void HandleTalkStateChanged(APONPCCharacter* NPC, ENPCTalkState NewState);
+};
@@ -0,0 +1,6 @@
+#include "PONPCTags.h"
+
+namespace PONPCTags
+{
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(TalkStateChanged, "NPC.TalkState.Changed", "NPC 대화 상태가 바뀜 (대기/API 응답 대기/대화 중/쿨다운)");
+}
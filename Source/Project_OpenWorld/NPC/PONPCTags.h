@@ -0,0 +1,11 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+
+// NPC StateTree 이벤트 태그
+namespace PONPCTags
+{
+	// 대화 상태 전환 (페이로드: FNPCTalkStateChangedPayload)
+	PROJECT_OPENWORLD_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(TalkStateChanged);
+}
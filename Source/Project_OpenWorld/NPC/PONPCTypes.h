@@ -12,6 +12,19 @@ enum class ENPCTalkState : uint8
 	Cooldown      UMETA(DisplayName = "쿨다운")
 };
 
+/** 플레이어 기준 NPC 중요도 구간 (위에 있을수록 자주 갱신) */
+UENUM(BlueprintType)
+enum class ENPCSignificance : uint8
+{
+	Critical UMETA(DisplayName = "대화 중"),
+	High     UMETA(DisplayName = "가까움"),
+	Medium   UMETA(DisplayName = "중간"),
+	Low      UMETA(DisplayName = "멂"),
+	Dormant  UMETA(DisplayName = "휴면"),
+
+	Num      UMETA(Hidden)
+};
+
 USTRUCT(BlueprintType)
 struct FNPCDialogueEntry
 {
@@ -26,3 +39,114 @@ struct FNPCDialogueEntry
 	UPROPERTY(BlueprintReadOnly, Category = "NPC|Dialogue")
 	FString WeatherContext;
 };
+
+/**
+ * 고정 용량 대화 이력 링 버퍼
+ * 가득 차면 가장 오래된 턴 자리에 덮어써 배열 이동이 없다. 인덱스 0 = 가장 오래된 턴.
+ */
+USTRUCT(BlueprintType)
+struct FNPCDialogueHistory
+{
+	GENERATED_BODY()
+
+	void Init(int32 InCapacity)
+	{
+		Capacity = FMath::Max(1, InCapacity);
+		Entries.Reset();
+		Entries.Reserve(Capacity);
+		Head = 0;
+	}
+
+	// 턴 추가. 가득 차서 밀려난 턴이 있으면 OutEvicted로 돌려주고 true
+	bool Add(FNPCDialogueEntry&& Entry, FNPCDialogueEntry& OutEvicted)
+	{
+		if (Entries.Num() < Capacity)
+		{
+			Entries.Add(MoveTemp(Entry));
+			return false;
+		}
+
+		OutEvicted = MoveTemp(Entries[Head]);
+		Entries[Head] = MoveTemp(Entry);
+		Head = (Head + 1) % Capacity;
+		return true;
+	}
+
+	int32 Num() const { return Entries.Num(); }
+
+	const FNPCDialogueEntry& operator[](int32 Index) const
+	{
+		return Entries[(Head + Index) % Entries.Num()];
+	}
+
+	// 가장 최근 턴 (Num() > 0일 때만)
+	FNPCDialogueEntry& Last()
+	{
+		return Entries[(Head + Entries.Num() - 1) % Entries.Num()];
+	}
+
+	void Reset()
+	{
+		Entries.Reset();
+		Head = 0;
+	}
+
+private:
+	UPROPERTY(VisibleAnywhere, Category = "NPC|Dialogue")
+	TArray<FNPCDialogueEntry> Entries;
+
+	// 가장 오래된 턴 위치 (가득 찼을 때만 0이 아님)
+	UPROPERTY()
+	int32 Head = 0;
+
+	UPROPERTY()
+	int32 Capacity = 10;
+};
+
+/**
+ * 액터를 풀로 돌려보낼 때(Mass 마을 주민으로 강등) 보관하는 대화 상태
+ * 다시 승격되면 어느 풀 액터가 맡든 그대로 복원한다.
+ */
+USTRUCT()
+struct FNPCPersistentState
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FNPCDialogueHistory DialogueHistory;
+
+	UPROPERTY()
+	FString DialogueSummary;
+
+	UPROPERTY()
+	FString LastNPCResponse;
+
+	// 응답 대기 중에 강등되면 요청이 취소되므로 Idle로 보관
+	UPROPERTY()
+	ENPCTalkState TalkState = ENPCTalkState::Idle;
+
+	// TalkState == Cooldown일 때 남은 시간 (초)
+	UPROPERTY()
+	float CooldownRemaining = 0.0f;
+
+	// 보관할 필요가 없는 상태 (대화한 적 없음)
+	bool IsEmpty() const
+	{
+		return DialogueHistory.Num() == 0 && DialogueSummary.IsEmpty() && TalkState == ENPCTalkState::Idle;
+	}
+};
+
+/** 대화 상태 전환 StateTree 이벤트 페이로드 (NPC.TalkState.Changed 태그와 함께 전달) */
+USTRUCT(BlueprintType)
+struct FNPCTalkStateChangedPayload
+{
+	GENERATED_BODY()
+
+	/** 이전 대화 상태 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC")
+	ENPCTalkState OldState = ENPCTalkState::Idle;
+
+	/** 새 대화 상태 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC")
+	ENPCTalkState NewState = ENPCTalkState::Idle;
+};
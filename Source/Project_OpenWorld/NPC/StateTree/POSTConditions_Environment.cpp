@@ -0,0 +1,39 @@
+#include "POSTConditions_Environment.h"
+#include "StateTreeExecutionContext.h"
+#include "StateTreeLinker.h"
+#include "../../World/POEnvironmentSubsystem.h"
+
+bool FPOSTCondition_EnvironmentBase::Link(FStateTreeLinker& Linker)
+{
+	Linker.LinkExternalData(EnvironmentHandle);
+	return true;
+}
+
+const FPOEnvironmentSnapshot& FPOSTCondition_EnvironmentBase::GetSnapshot(FStateTreeExecutionContext& Context) const
+{
+	return Context.GetExternalData(EnvironmentHandle).GetSnapshot();
+}
+
+bool FPOSTCondition_IsRaining::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	const FPOEnvironmentSnapshot& Env = GetSnapshot(Context);
+	const bool bRaining = Env.IsRaining() || (bIncludeIncoming && Env.IsRainIncoming());
+	return bRaining ^ bInvert;
+}
+
+bool FPOSTCondition_IsNight::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	return GetSnapshot(Context).IsNight() ^ bInvert;
+}
+
+bool FPOSTCondition_FogAbove::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	return (GetSnapshot(Context).FogDensity > InstanceData.Threshold) ^ bInvert;
+}
+
+bool FPOSTCondition_WindAbove::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	return (GetSnapshot(Context).WindStrength > InstanceData.Threshold) ^ bInvert;
+}
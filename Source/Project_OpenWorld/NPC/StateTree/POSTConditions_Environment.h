@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StateTreeConditionBase.h"
+#include "StateTreeExecutionTypes.h"
+#include "POSTConditions_Environment.generated.h"
+
+class UPOEnvironmentSubsystem;
+struct FPOEnvironmentSnapshot;
+
+/**
+ * 환경 스냅샷 조건 공통 부모
+ * 서브시스템은 StateTree 외부 데이터로 트리 시작 시 한 번 연결되므로, 평가마다 액터/서브시스템 탐색 없이 스냅샷 필드 몇 개만 읽는다.
+ */
+USTRUCT(meta = (Hidden))
+struct PROJECT_OPENWORLD_API FPOSTCondition_EnvironmentBase : public FStateTreeConditionCommonBase
+{
+	GENERATED_BODY()
+
+	virtual bool Link(FStateTreeLinker& Linker) override;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	bool bInvert = false;
+
+protected:
+	const FPOEnvironmentSnapshot& GetSnapshot(FStateTreeExecutionContext& Context) const;
+
+private:
+	TStateTreeExternalDataHandle<UPOEnvironmentSubsystem> EnvironmentHandle;
+};
+
+/** 비/폭풍이 오는 중인지 */
+USTRUCT(meta = (DisplayName = "Is Raining", Category = "Environment"))
+struct PROJECT_OPENWORLD_API FPOSTCondition_IsRaining : public FPOSTCondition_EnvironmentBase
+{
+	GENERATED_BODY()
+
+	// 비로 전환되는 중이면 (아직 맑아도) 참 
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	bool bIncludeIncoming = false;
+
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+};
+
+/** 밤(18~06시)인지 */
+USTRUCT(meta = (DisplayName = "Is Night", Category = "Environment"))
+struct PROJECT_OPENWORLD_API FPOSTCondition_IsNight : public FPOSTCondition_EnvironmentBase
+{
+	GENERATED_BODY()
+
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+};
+
+USTRUCT()
+struct PROJECT_OPENWORLD_API FPOSTCondition_ThresholdInstanceData
+{
+	GENERATED_BODY()
+
+	// 0.0 ~ 1.0 (바인딩 가능) 
+	UPROPERTY(EditAnywhere, Category = "Parameter", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Threshold = 0.5f;
+};
+
+/** 안개 농도가 기준보다 짙은지 */
+USTRUCT(meta = (DisplayName = "Fog Above", Category = "Environment"))
+struct PROJECT_OPENWORLD_API FPOSTCondition_FogAbove : public FPOSTCondition_EnvironmentBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FPOSTCondition_ThresholdInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+};
+
+/** 바람 세기가 기준보다 강한지 */
+USTRUCT(meta = (DisplayName = "Wind Above", Category = "Environment"))
+struct PROJECT_OPENWORLD_API FPOSTCondition_WindAbove : public FPOSTCondition_EnvironmentBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FPOSTCondition_ThresholdInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+};
@@ -0,0 +1,48 @@
+#include "POSTEvaluator_Environment.h"
+#include "StateTreeExecutionContext.h"
+#include "StateTreeLinker.h"
+#include "../../World/POEnvironmentSubsystem.h"
+
+bool FPOSTEvaluator_Environment::Link(FStateTreeLinker& Linker)
+{
+	Linker.LinkExternalData(EnvironmentHandle);
+	return true;
+}
+
+void FPOSTEvaluator_Environment::TreeStart(FStateTreeExecutionContext& Context) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	InstanceData.LastSerial = 0;
+	CopySnapshot(Context);
+}
+
+void FPOSTEvaluator_Environment::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	CopySnapshot(Context);
+}
+
+void FPOSTEvaluator_Environment::CopySnapshot(FStateTreeExecutionContext& Context) const
+{
+	const UPOEnvironmentSubsystem& Environment = Context.GetExternalData(EnvironmentHandle);
+	const FPOEnvironmentSnapshot& Env = Environment.GetSnapshot();
+
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	if (Env.Serial == InstanceData.LastSerial)
+	{
+		return;
+	}
+
+	InstanceData.LastSerial       = Env.Serial;
+	InstanceData.Weather          = Env.Weather;
+	InstanceData.TargetWeather    = Env.bIsTransitioning ? Env.TargetWeather : Env.Weather;
+	InstanceData.bIsTransitioning = Env.bIsTransitioning;
+	InstanceData.bIsRaining       = Env.IsRaining();
+	InstanceData.bIsNight         = Env.IsNight();
+	InstanceData.TimeOfDay        = Env.TimeOfDay;
+	InstanceData.Period           = Env.Period;
+	InstanceData.RainIntensity    = Env.RainIntensity;
+	InstanceData.FogDensity       = Env.FogDensity;
+	InstanceData.WindStrength     = Env.WindStrength;
+	InstanceData.Wetness          = Env.Wetness;
+	InstanceData.SnowCoverage     = Env.SnowCoverage;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StateTreeEvaluatorBase.h"
+#include "StateTreeExecutionTypes.h"
+#include "../../World/POEnvironmentTypes.h"
+#include "POSTEvaluator_Environment.generated.h"
+
+class UPOEnvironmentSubsystem;
+
+USTRUCT()
+struct PROJECT_OPENWORLD_API FPOSTEvaluator_EnvironmentInstanceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Output")
+	EWeatherType Weather = EWeatherType::Clear;
+
+	// 전환 중이면 목표 날씨, 아니면 현재 날씨 
+	UPROPERTY(EditAnywhere, Category = "Output")
+	EWeatherType TargetWeather = EWeatherType::Clear;
+
+	UPROPERTY(EditAnywhere, Category = "Output")
+	bool bIsTransitioning = false;
+
+	UPROPERTY(EditAnywhere, Category = "Output")
+	bool bIsRaining = false;
+
+	UPROPERTY(EditAnywhere, Category = "Output")
+	bool bIsNight = false;
+
+	UPROPERTY(EditAnywhere, Category = "Output")
+	float TimeOfDay = 12.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Output")
+	EPOTimePeriod Period = EPOTimePeriod::Noon;
+
+	// RVT 날씨 수치 (0.0 ~ 1.0) 
+	UPROPERTY(EditAnywhere, Category = "Output")
+	float RainIntensity = 0.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Output")
+	float FogDensity = 0.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Output")
+	float WindStrength = 0.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Output")
+	float Wetness = 0.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Output")
+	float SnowCoverage = 0.0f;
+
+	// 마지막으로 복사한 스냅샷 일련번호 (같으면 복사 생략) 
+	UPROPERTY()
+	int32 LastSerial = 0;
+};
+
+/**
+ * 날씨/시간 평가자
+ * 환경 서브시스템이 프레임마다 한 번 발행하는 스냅샷을 출력 값으로 풀어 두어, 디자이너가 상태 선택/전이 조건/태스크 입력에 바인딩한다.
+ * 서브시스템은 StateTree 외부 데이터로 트리 시작 시 한 번 연결되고, 틱마다 일련번호를 비교해 바뀐 프레임에만 값을 복사한다.
+ */
+USTRUCT(meta = (DisplayName = "Environment (Weather/Time)", Category = "Environment"))
+struct PROJECT_OPENWORLD_API FPOSTEvaluator_Environment : public FStateTreeEvaluatorCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FPOSTEvaluator_EnvironmentInstanceData;
+
+	virtual bool Link(FStateTreeLinker& Linker) override;
+
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	virtual void TreeStart(FStateTreeExecutionContext& Context) const override;
+
+	virtual void Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+
+private:
+	TStateTreeExternalDataHandle<UPOEnvironmentSubsystem> EnvironmentHandle;
+
+	void CopySnapshot(FStateTreeExecutionContext& Context) const;
+};
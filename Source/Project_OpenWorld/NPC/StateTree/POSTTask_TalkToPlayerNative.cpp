@@ -0,0 +1,49 @@
+#include "POSTTask_TalkToPlayerNative.h"
+#include "StateTreeExecutionContext.h"
+#include "AIController.h"
+#include "../PONPCCharacter.h"
+#include "../PONPCTypes.h"
+
+FPOSTTask_TalkToPlayerNative::FPOSTTask_TalkToPlayerNative()
+{
+	// 대화 상태 전환 이벤트가 있는 프레임에만 Tick
+	bShouldCallTick = false;
+	bShouldCallTickOnlyOnEvents = true;
+}
+
+EStateTreeRunStatus FPOSTTask_TalkToPlayerNative::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	const AAIController* AIC = Cast<AAIController>(Context.GetOwner());
+	InstanceData.NPC = AIC ? Cast<APONPCCharacter>(AIC->GetPawn()) : nullptr;
+	if (!InstanceData.NPC)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	// 진입 전에 이미 대화가 끝났으면 이벤트가 다시 오지 않으므로 바로 성공
+	return InstanceData.NPC->TalkState == ENPCTalkState::Idle ? EStateTreeRunStatus::Succeeded : EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FPOSTTask_TalkToPlayerNative::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	if (!InstanceData.NPC)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	// 이벤트 페이로드 대신 NPC 상태를 직접 읽음 (한 프레임에 전환이 여러 번 있어도 마지막 상태 기준)
+	return InstanceData.NPC->TalkState == ENPCTalkState::Idle ? EStateTreeRunStatus::Succeeded : EStateTreeRunStatus::Running;
+}
+
+void FPOSTTask_TalkToPlayerNative::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	if (InstanceData.NPC && InstanceData.NPC->TalkState != ENPCTalkState::Idle)
+	{
+		InstanceData.NPC->EndConversation();
+	}
+	InstanceData.NPC = nullptr;
+}
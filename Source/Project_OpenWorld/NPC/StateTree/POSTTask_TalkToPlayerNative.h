@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StateTreeTaskBase.h"
+#include "POSTTask_TalkToPlayerNative.generated.h"
+
+class APONPCCharacter;
+
+USTRUCT()
+struct PROJECT_OPENWORLD_API FPOSTTask_TalkToPlayerNativeInstanceData
+{
+	GENERATED_BODY()
+
+	// 진입 시 한 번 찾아 둔 NPC 
+	UPROPERTY()
+	TObjectPtr<APONPCCharacter> NPC = nullptr;
+};
+
+/**
+ * UPOSTTask_TalkToPlayer의 네이티브 버전
+ * 인스턴스 데이터가 USTRUCT라 NPC마다 UObject를 만들지 않고, 매 프레임 틱하지 않는다.
+ * NPC가 대화 상태를 바꿀 때 보내는 NPC.TalkState.Changed 이벤트가 있을 때만 깨어나 Idle이면 성공으로 끝난다.
+ */
+USTRUCT(meta = (DisplayName = "NPC Talk To Player (Native)", Category = "NPC"))
+struct PROJECT_OPENWORLD_API FPOSTTask_TalkToPlayerNative : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FPOSTTask_TalkToPlayerNativeInstanceData;
+
+	FPOSTTask_TalkToPlayerNative();
+
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context,
+		const FStateTreeTransitionResult& Transition) const override;
+
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context,
+		const float DeltaTime) const override;
+
+	virtual void ExitState(FStateTreeExecutionContext& Context,
+		const FStateTreeTransitionResult& Transition) const override;
+};
@@ -0,0 +1,57 @@
+#include "POSTTask_WeatherIdleNative.h"
+#include "StateTreeExecutionContext.h"
+#include "AIController.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "../PONPCCharacter.h"
+
+FPOSTTask_WeatherIdleNative::FPOSTTask_WeatherIdleNative()
+{
+	bShouldCallTick = false;
+}
+
+EStateTreeRunStatus FPOSTTask_WeatherIdleNative::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	InstanceData.CurrentPlayingMontage = nullptr;
+
+	const AAIController* AIC = Cast<AAIController>(Context.GetOwner());
+	InstanceData.NPC = AIC ? Cast<APONPCCharacter>(AIC->GetPawn()) : nullptr;
+	if (!InstanceData.NPC || !InstanceData.MontageToPlay)
+	{
+		return EStateTreeRunStatus::Running;
+	}
+
+	UAnimInstance* AnimInstance = InstanceData.NPC->GetMesh() ? InstanceData.NPC->GetMesh()->GetAnimInstance() : nullptr;
+	if (AnimInstance)
+	{
+		AnimInstance->Montage_Play(InstanceData.MontageToPlay, InstanceData.PlayRate, EMontagePlayReturnType::MontageLength, 0.0f);
+
+		if (InstanceData.LoopSectionName != NAME_None)
+		{
+			AnimInstance->Montage_JumpToSection(InstanceData.LoopSectionName, InstanceData.MontageToPlay);
+		}
+
+		InstanceData.CurrentPlayingMontage = InstanceData.MontageToPlay;
+	}
+
+	return EStateTreeRunStatus::Running;
+}
+
+void FPOSTTask_WeatherIdleNative::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	if (InstanceData.CurrentPlayingMontage && InstanceData.NPC)
+	{
+		UAnimInstance* AnimInstance = InstanceData.NPC->GetMesh() ? InstanceData.NPC->GetMesh()->GetAnimInstance() : nullptr;
+		if (AnimInstance)
+		{
+			AnimInstance->Montage_Stop(0.25f, InstanceData.CurrentPlayingMontage);
+		}
+	}
+
+	InstanceData.CurrentPlayingMontage = nullptr;
+	InstanceData.NPC = nullptr;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StateTreeTaskBase.h"
+#include "POSTTask_WeatherIdleNative.generated.h"
+
+class APONPCCharacter;
+class UAnimMontage;
+
+USTRUCT()
+struct PROJECT_OPENWORLD_API FPOSTTask_WeatherIdleNativeInstanceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	TObjectPtr<UAnimMontage> MontageToPlay = nullptr;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter", meta = (ClampMin = "0.1", ClampMax = "3.0"))
+	float PlayRate = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	FName LoopSectionName = NAME_None;
+
+	// 진입 시 한 번 찾아 둔 NPC 
+	UPROPERTY()
+	TObjectPtr<APONPCCharacter> NPC = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UAnimMontage> CurrentPlayingMontage = nullptr;
+};
+
+/**
+ * UPOSTTask_WeatherIdle의 네이티브 버전
+ * 몽타주를 틀어 두고 상태를 나갈 때까지 틱하지 않는다. 날씨가 바뀌면 트리의 Weather.Changed 이벤트 전이로 빠져나간다.
+ */
+USTRUCT(meta = (DisplayName = "NPC Weather Idle (Native)", Category = "NPC"))
+struct PROJECT_OPENWORLD_API FPOSTTask_WeatherIdleNative : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FPOSTTask_WeatherIdleNativeInstanceData;
+
+	FPOSTTask_WeatherIdleNative();
+
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context,
+		const FStateTreeTransitionResult& Transition) const override;
+
+	virtual void ExitState(FStateTreeExecutionContext& Context,
+		const FStateTreeTransitionResult& Transition) const override;
+};
@@ -1,3 +1,4 @@
+using System.IO;
 using UnrealBuildTool;
 
 public class Project_OpenWorld : ModuleRules
@@ -16,6 +17,7 @@ public class Project_OpenWorld : ModuleRules
 			"WorldPartitionEditor",
 			"PCG",
 			"AIModule",
+			"GameplayTags",
             "StateTreeModule",
 			"GameplayStateTreeModule",
 			"StructUtils",
@@ -23,10 +25,42 @@ public class Project_OpenWorld : ModuleRules
 			"Json",
 			"JsonUtilities",
 			"NavigationSystem",
+			"MassEntity",
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[] {
 			"RenderCore", "Renderer", "Slate", "SlateCore",
+			"AssetRegistry",
 		});
+
+		// Claude 루프백 모의 서버 (비배포 빌드 전용)
+		if (Target.Configuration != UnrealTargetConfiguration.Shipping)
+		{
+			PrivateDependencyModuleNames.Add("HTTPServer");
+		}
+
+		// 오프라인 NPC 대화용 llama.cpp (선택). ThirdParty/llama/include/llama.h와
+		// lib/<플랫폼>/ 정적 라이브러리(-DBUILD_SHARED_LIBS=OFF -DGGML_OPENMP=OFF 빌드)가 있을 때만 로컬 CPU 백엔드를 켠다
+		string LlamaDir = Path.Combine(ModuleDirectory, "..", "..", "ThirdParty", "llama");
+		string LlamaLibDir = Path.Combine(LlamaDir, "lib", Target.Platform.ToString());
+		string LibPrefix = Target.Platform == UnrealTargetPlatform.Win64 ? "" : "lib";
+		string LibExtension = Target.Platform == UnrealTargetPlatform.Win64 ? ".lib" : ".a";
+		string[] LlamaLibs = { "llama", "ggml", "ggml-base", "ggml-cpu" };
+
+		bool bHasLlama = File.Exists(Path.Combine(LlamaDir, "include", "llama.h"));
+		foreach (string Lib in LlamaLibs)
+		{
+			bHasLlama = bHasLlama && File.Exists(Path.Combine(LlamaLibDir, LibPrefix + Lib + LibExtension));
+		}
+
+		if (bHasLlama)
+		{
+			PrivateIncludePaths.Add(Path.Combine(LlamaDir, "include"));
+			foreach (string Lib in LlamaLibs)
+			{
+				PublicAdditionalLibraries.Add(Path.Combine(LlamaLibDir, LibPrefix + Lib + LibExtension));
+			}
+		}
+		PublicDefinitions.Add("WITH_PO_LLAMA=" + (bHasLlama ? "1" : "0"));
 	}
 }
@@ -3,6 +3,7 @@
 #include "Materials/MaterialParameterCollectionInstance.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "../World/POEnvironmentSubsystem.h"
 
 const FName APORVTManager::ParamName_Wetness        = TEXT("Wetness");
 const FName APORVTManager::ParamName_SnowCoverage   = TEXT("SnowCoverage");
@@ -42,6 +43,12 @@ void APORVTManager::BeginPlay()
 
 	// 초기 파라미터 적용
 	FlushMPCParameters();
+
+	// 환경 스냅샷 발행 대상으로 등록
+	if (UPOEnvironmentSubsystem* Environment = UPOEnvironmentSubsystem::Get(this))
+	{
+		Environment->RegisterRVTManager(this);
+	}
 }
 
 void APORVTManager::Tick(float DeltaTime)
@@ -8,6 +8,7 @@
 #include "Components/SkyAtmosphereComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Curves/CurveLinearColor.h"
+#include "../World/POEnvironmentSubsystem.h"
 
 APOTimeOfDayManager::APOTimeOfDayManager()
 {
@@ -31,6 +32,12 @@ void APOTimeOfDayManager::BeginPlay()
 	// 초기 시간 적용
 	UpdateSkySystem();
 	UpdateMaterialParameters();
+
+	// 환경 스냅샷 발행 대상으로 등록
+	if (UPOEnvironmentSubsystem* Environment = UPOEnvironmentSubsystem::Get(this))
+	{
+		Environment->RegisterTimeOfDayManager(this);
+	}
 }
 
 void APOTimeOfDayManager::Tick(float DeltaTime)
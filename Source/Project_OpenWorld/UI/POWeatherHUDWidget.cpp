@@ -4,7 +4,7 @@
 #include "../TimeOfDay/POTimeOfDayManager.h"
 #include "../Weather/POWeatherSystemManager.h"
 #include "../Weather/WeatherTypes.h"
-#include "Kismet/GameplayStatics.h"
+#include "../World/POEnvironmentSubsystem.h"
 
 void UPOWeatherHUDWidget::NativeConstruct()
 {
@@ -13,6 +13,19 @@ void UPOWeatherHUDWidget::NativeConstruct()
 	FindManagers();
 }
 
+void UPOWeatherHUDWidget::NativeDestruct()
+{
+	if (Environment)
+	{
+		Environment->OnWeatherChanged.Remove(WeatherChangedHandle);
+		Environment->OnWeatherTransitionStarted.Remove(WeatherTransitionStartedHandle);
+		WeatherChangedHandle.Reset();
+		WeatherTransitionStartedHandle.Reset();
+	}
+
+	Super::NativeDestruct();
+}
+
 void UPOWeatherHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
@@ -25,39 +38,69 @@ void UPOWeatherHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaT
 
 void UPOWeatherHUDWidget::FindManagers()
 {
+	// 액터 탐색 없이 환경 서브시스템에 등록된 매니저를 그대로 사용
+	if (!Environment)
+	{
+		Environment = UPOEnvironmentSubsystem::Get(this);
+		if (!Environment)
+		{
+			return;
+		}
+	}
+
+	// 날씨 변경은 폴링하지 않고 서브시스템 중계 이벤트로 받음
+	if (!WeatherChangedHandle.IsValid())
+	{
+		WeatherChangedHandle = Environment->OnWeatherChanged.AddUObject(this, &UPOWeatherHUDWidget::HandleWeatherChanged);
+		WeatherTransitionStartedHandle = Environment->OnWeatherTransitionStarted.AddUObject(this, &UPOWeatherHUDWidget::HandleWeatherTransitionStarted);
+	}
+
 	if (!TimeOfDayManager)
 	{
-		TimeOfDayManager = Cast<APOTimeOfDayManager>(
-			UGameplayStatics::GetActorOfClass(GetWorld(), APOTimeOfDayManager::StaticClass())
-		);
+		TimeOfDayManager = Environment->GetTimeOfDayManager();
 	}
 
 	if (!WeatherSystemManager)
 	{
-		WeatherSystemManager = Cast<APOWeatherSystemManager>(
-			UGameplayStatics::GetActorOfClass(GetWorld(), APOWeatherSystemManager::StaticClass())
-		);
+		WeatherSystemManager = Environment->GetWeatherManager();
 	}
 }
 
+void UPOWeatherHUDWidget::HandleWeatherChanged(EWeatherType OldWeather, EWeatherType NewWeather)
+{
+	ReceiveWeatherChanged(OldWeather, NewWeather);
+}
+
+void UPOWeatherHUDWidget::HandleWeatherTransitionStarted(EWeatherType FromWeather, EWeatherType ToWeather, float Duration)
+{
+	ReceiveWeatherTransitionStarted(FromWeather, ToWeather, Duration);
+}
+
+const FPOEnvironmentSnapshot* UPOWeatherHUDWidget::GetEnvironmentSnapshot() const
+{
+	return Environment ? &Environment->GetSnapshot() : nullptr;
+}
+
 float UPOWeatherHUDWidget::GetCurrentTime() const
 {
-	if (TimeOfDayManager)
+	const FPOEnvironmentSnapshot* Env = GetEnvironmentSnapshot();
+	if (Env && Env->bHasTimeOfDay)
 	{
-		return TimeOfDayManager->GetCurrentTime();
+		return Env->TimeOfDay;
 	}
 	return 12.0f; // 기본값: 정오
 }
 
 FText UPOWeatherHUDWidget::GetFormattedTimeText() const
 {
-	if (!TimeOfDayManager)
+	const FPOEnvironmentSnapshot* Env = GetEnvironmentSnapshot();
+	if (!Env || !Env->bHasTimeOfDay)
 	{
 		return FText::FromString(TEXT("--:--"));
 	}
 
-	int32 Hours, Minutes;
-	TimeOfDayManager->GetFormattedTime(Hours, Minutes);
+	const int32 Hours = static_cast<int32>(Env->TimeOfDay);
+	const int32 Minutes = static_cast<int32>((Env->TimeOfDay - Hours) * 60.0f);
 
 	return FText::FromString(FString::Printf(TEXT("%02d:%02d"), Hours, Minutes));
 }
@@ -90,52 +133,50 @@ FText UPOWeatherHUDWidget::GetTimeOfDayText() const
 
 bool UPOWeatherHUDWidget::IsDaytime() const
 {
-	if (TimeOfDayManager)
+	const FPOEnvironmentSnapshot* Env = GetEnvironmentSnapshot();
+	if (Env && Env->bHasTimeOfDay)
 	{
-		return TimeOfDayManager->IsDaytime();
+		return Env->bIsDaytime;
 	}
 	return true;
 }
 
 FText UPOWeatherHUDWidget::GetCurrentWeatherText() const
 {
-	if (!WeatherSystemManager)
+	const FPOEnvironmentSnapshot* Env = GetEnvironmentSnapshot();
+	if (!Env || !Env->bHasWeather)
 	{
 		return FText::FromString(TEXT("날씨 정보 없음"));
 	}
 
-	EWeatherType CurrentWeather = WeatherSystemManager->GetCurrentWeather();
-	return WeatherTypeToText(CurrentWeather);
+	return WeatherTypeToText(Env->Weather);
 }
 
 bool UPOWeatherHUDWidget::IsWeatherTransitioning() const
 {
-	if (WeatherSystemManager)
-	{
-		return WeatherSystemManager->IsTransitioning();
-	}
-	return false;
+	const FPOEnvironmentSnapshot* Env = GetEnvironmentSnapshot();
+	return Env && Env->bIsTransitioning;
 }
 
 float UPOWeatherHUDWidget::GetWeatherTransitionProgress() const
 {
-	if (WeatherSystemManager && WeatherSystemManager->IsTransitioning())
+	const FPOEnvironmentSnapshot* Env = GetEnvironmentSnapshot();
+	if (Env && Env->bIsTransitioning)
 	{
-		return WeatherSystemManager->TransitionInfo.TransitionProgress;
+		return Env->TransitionProgress;
 	}
 	return 0.0f;
 }
 
 FLinearColor UPOWeatherHUDWidget::GetWeatherColor() const
 {
-	if (!WeatherSystemManager)
+	const FPOEnvironmentSnapshot* Env = GetEnvironmentSnapshot();
+	if (!Env || !Env->bHasWeather)
 	{
 		return FLinearColor::White;
 	}
 
-	EWeatherType CurrentWeather = WeatherSystemManager->GetCurrentWeather();
-
-	switch (CurrentWeather)
+	switch (Env->Weather)
 	{
 	case EWeatherType::Clear:
 		return FLinearColor(1.0f, 1.0f, 0.3f); // 노란색
@@ -156,21 +197,5 @@ FLinearColor UPOWeatherHUDWidget::GetWeatherColor() const
 
 FText UPOWeatherHUDWidget::WeatherTypeToText(EWeatherType WeatherType) const
 {
-	switch (WeatherType)
-	{
-	case EWeatherType::Clear:
-		return FText::FromString(TEXT("맑음"));
-	case EWeatherType::Cloudy:
-		return FText::FromString(TEXT("흐림"));
-	case EWeatherType::Rainy:
-		return FText::FromString(TEXT("비"));
-	case EWeatherType::Snowy:
-		return FText::FromString(TEXT("눈"));
-	case EWeatherType::Foggy:
-		return FText::FromString(TEXT("안개"));
-	case EWeatherType::Stormy:
-		return FText::FromString(TEXT("폭풍"));
-	default:
-		return FText::FromString(TEXT("알 수 없음"));
-	}
+	return FText::FromString(UPOEnvironmentSubsystem::WeatherToKorean(WeatherType));
 }
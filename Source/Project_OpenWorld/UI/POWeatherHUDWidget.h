@@ -2,11 +2,13 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "../Weather/WeatherTypes.h"
 #include "POWeatherHUDWidget.generated.h"
 
 class APOTimeOfDayManager;
 class APOWeatherSystemManager;
-enum class EWeatherType : uint8;
+class UPOEnvironmentSubsystem;
+struct FPOEnvironmentSnapshot;
 
 UCLASS()
 class PROJECT_OPENWORLD_API UPOWeatherHUDWidget : public UUserWidget
@@ -15,6 +17,7 @@ class PROJECT_OPENWORLD_API UPOWeatherHUDWidget : public UUserWidget
 
 public:
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 
 protected:
@@ -24,6 +27,18 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Weather HUD")
 	TObjectPtr<APOWeatherSystemManager> WeatherSystemManager;
 
+	// 표시 값은 모두 환경 스냅샷에서 읽음 (매니저 참조는 블루프린트 호환용)
+	UPROPERTY(BlueprintReadOnly, Category = "Weather HUD")
+	TObjectPtr<UPOEnvironmentSubsystem> Environment;
+
+	// 날씨가 바뀌었을 때 (아이콘/색 갱신 등은 매 프레임 바인딩 대신 여기서) 
+	UFUNCTION(BlueprintImplementableEvent, Category = "Weather HUD|Weather", meta = (DisplayName = "On Weather Changed"))
+	void ReceiveWeatherChanged(EWeatherType OldWeather, EWeatherType NewWeather);
+
+	// 날씨 전환이 시작됐을 때 (진행 막대 표시 등) 
+	UFUNCTION(BlueprintImplementableEvent, Category = "Weather HUD|Weather", meta = (DisplayName = "On Weather Transition Started"))
+	void ReceiveWeatherTransitionStarted(EWeatherType FromWeather, EWeatherType ToWeather, float Duration);
+
 public:
 	UFUNCTION(BlueprintPure, Category = "Weather HUD|Time")
 	float GetCurrentTime() const;
@@ -51,5 +66,11 @@ public:
 
 private:
 	void FindManagers();
+	void HandleWeatherChanged(EWeatherType OldWeather, EWeatherType NewWeather);
+	void HandleWeatherTransitionStarted(EWeatherType FromWeather, EWeatherType ToWeather, float Duration);
+
+	FDelegateHandle WeatherChangedHandle;
+	FDelegateHandle WeatherTransitionStartedHandle;
+	const FPOEnvironmentSnapshot* GetEnvironmentSnapshot() const;
 	FText WeatherTypeToText(EWeatherType WeatherType) const;
 };
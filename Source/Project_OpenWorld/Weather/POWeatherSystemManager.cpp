@@ -4,6 +4,7 @@
 #include "Materials/MaterialParameterCollectionInstance.h"
 #include "Kismet/GameplayStatics.h"
 #include "../RVT/PORVTManager.h"
+#include "../World/POEnvironmentSubsystem.h"
 
 APOWeatherSystemManager::APOWeatherSystemManager()
 {
@@ -32,6 +33,12 @@ void APOWeatherSystemManager::BeginPlay()
 	// 초기 날씨 적용
 	SetWeatherImmediate(CurrentWeather);
 
+	// 환경 스냅샷 발행 대상으로 등록
+	if (UPOEnvironmentSubsystem* Environment = UPOEnvironmentSubsystem::Get(this))
+	{
+		Environment->RegisterWeatherManager(this);
+	}
+
 	// 자동 날씨 변경 타이머 초기화
 	if (bEnableAutoWeatherChange)
 	{
@@ -58,6 +65,8 @@ void APOWeatherSystemManager::Tick(float DeltaTime)
 
 void APOWeatherSystemManager::SetWeatherImmediate(EWeatherType NewWeather)
 {
+	const EWeatherType OldWeather = CurrentWeather;
+
 	CurrentWeather = NewWeather;
 	TransitionInfo.bIsTransitioning = false;
 	TransitionInfo.TransitionProgress = 1.0f;
@@ -67,6 +76,11 @@ void APOWeatherSystemManager::SetWeatherImmediate(EWeatherType NewWeather)
 	UpdateMaterialParameters();
 
 	UE_LOG(LogTemp, Log, TEXT("[WeatherSystem] Weather changed immediately to: %d"), (int32)NewWeather);
+
+	if (OldWeather != NewWeather)
+	{
+		BroadcastWeatherChanged(OldWeather, NewWeather);
+	}
 }
 
 void APOWeatherSystemManager::TransitionToWeather(EWeatherType NewWeather, float Duration)
@@ -88,6 +102,9 @@ void APOWeatherSystemManager::TransitionToWeather(EWeatherType NewWeather, float
 
 	UE_LOG(LogTemp, Log, TEXT("[WeatherSystem] Starting transition from %d to %d (Duration: %.2f)"),
 		(int32)CurrentWeather, (int32)NewWeather, Duration);
+
+	OnWeatherTransitionStartedNative.Broadcast(CurrentWeather, NewWeather, TransitionInfo.TransitionDuration);
+	OnWeatherTransitionStarted.Broadcast(CurrentWeather, NewWeather, TransitionInfo.TransitionDuration);
 }
 
 void APOWeatherSystemManager::TransitionToRandomWeather(float Duration)
@@ -245,4 +262,20 @@ void APOWeatherSystemManager::OnTransitionComplete()
 	TransitionInfo.TransitionProgress = 1.0f;
 
 	UE_LOG(LogTemp, Log, TEXT("[WeatherSystem] Transition complete. Current weather: %d"), (int32)CurrentWeather);
+
+	const EWeatherType FromWeather = TransitionInfo.PreviousWeather;
+	OnWeatherTransitionCompletedNative.Broadcast(FromWeather, CurrentWeather);
+	OnWeatherTransitionCompleted.Broadcast(FromWeather, CurrentWeather);
+
+	if (FromWeather != CurrentWeather)
+	{
+		BroadcastWeatherChanged(FromWeather, CurrentWeather);
+	}
+}
+
+void APOWeatherSystemManager::BroadcastWeatherChanged(EWeatherType OldWeather, EWeatherType NewWeather)
+{
+	// 네이티브 구독자(환경 서브시스템 → NPC/HUD/StateTree)를 먼저 갱신해 블루프린트가 최신 스냅샷을 읽게 함
+	OnWeatherChangedNative.Broadcast(OldWeather, NewWeather);
+	OnWeatherChanged.Broadcast(OldWeather, NewWeather);
 }
@@ -74,6 +74,23 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Weather")
 	bool IsTransitioning() const { return TransitionInfo.bIsTransitioning; }
 
+	// 날씨 변경 통지 (즉시 변경 또는 전환 완료). 폴링 대신 구독 
+	UPROPERTY(BlueprintAssignable, Category = "Weather|Events")
+	FOnWeatherChanged OnWeatherChanged;
+
+	// 날씨 전환 시작 통지 
+	UPROPERTY(BlueprintAssignable, Category = "Weather|Events")
+	FOnWeatherTransitionStarted OnWeatherTransitionStarted;
+
+	// 날씨 전환 완료 통지 
+	UPROPERTY(BlueprintAssignable, Category = "Weather|Events")
+	FOnWeatherTransitionCompleted OnWeatherTransitionCompleted;
+
+	// C++ 구독용 (환경 서브시스템이 중계) 
+	FOnWeatherChangedNative OnWeatherChangedNative;
+	FOnWeatherTransitionStartedNative OnWeatherTransitionStartedNative;
+	FOnWeatherTransitionCompletedNative OnWeatherTransitionCompletedNative;
+
 protected:
 	// 날씨 전환 업데이트 
 	void UpdateWeatherTransition(float DeltaTime);
@@ -90,6 +107,9 @@ protected:
 	// 전환 완료 처리 
 	void OnTransitionComplete();
 
+	// 네이티브/다이내믹 날씨 변경 이벤트 발행 
+	void BroadcastWeatherChanged(EWeatherType OldWeather, EWeatherType NewWeather);
+
 private:
 	// 전환 시작 시간 
 	float TransitionStartTime = 0.0f;
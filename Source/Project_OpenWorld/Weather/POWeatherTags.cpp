@@ -0,0 +1,7 @@
+#include "POWeatherTags.h"
+
+namespace POWeatherTags
+{
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Changed, "Weather.Changed", "날씨가 바뀜 (즉시 변경 또는 전환 완료)");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(TransitionStarted, "Weather.TransitionStarted", "날씨 전환 시작 (NewWeather = 목표 날씨)");
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+
+// 날씨 StateTree 이벤트 태그 (페이로드: FWeatherChangedPayload)
+namespace POWeatherTags
+{
+	PROJECT_OPENWORLD_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Changed);
+	PROJECT_OPENWORLD_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(TransitionStarted);
+}
@@ -39,3 +39,32 @@ struct FWeatherTransitionInfo
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weather")
 	EWeatherType TargetWeather = EWeatherType::Clear;
 };
+
+/** 날씨 변경 StateTree 이벤트 페이로드 (Weather.Changed / Weather.TransitionStarted 태그와 함께 전달) */
+USTRUCT(BlueprintType)
+struct FWeatherChangedPayload
+{
+	GENERATED_BODY()
+
+	/** 이전 날씨 상태 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weather")
+	EWeatherType OldWeather = EWeatherType::Clear;
+
+	/** 새 날씨 상태 (전환 시작 이벤트에서는 목표 날씨) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weather")
+	EWeatherType NewWeather = EWeatherType::Clear;
+
+	/** 전환에 걸리는 시간 (초, 즉시 변경이면 0) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weather")
+	float TransitionDuration = 0.0f;
+};
+
+// 날씨 변경 (즉시 변경 또는 전환 완료 시점에 한 번) 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnWeatherChanged, EWeatherType, OldWeather, EWeatherType, NewWeather);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWeatherChangedNative, EWeatherType /*OldWeather*/, EWeatherType /*NewWeather*/);
+
+// 날씨 전환 시작 / 완료 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnWeatherTransitionStarted, EWeatherType, FromWeather, EWeatherType, ToWeather, float, Duration);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnWeatherTransitionStartedNative, EWeatherType /*FromWeather*/, EWeatherType /*ToWeather*/, float /*Duration*/);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnWeatherTransitionCompleted, EWeatherType, FromWeather, EWeatherType, ToWeather);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWeatherTransitionCompletedNative, EWeatherType /*FromWeather*/, EWeatherType /*ToWeather*/);
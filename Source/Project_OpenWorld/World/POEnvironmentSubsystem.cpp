@@ -0,0 +1,217 @@
+#include "POEnvironmentSubsystem.h"
+#include "Engine/World.h"
+#include "../Weather/POWeatherSystemManager.h"
+#include "../TimeOfDay/POTimeOfDayManager.h"
+#include "../RVT/PORVTManager.h"
+
+void UPOEnvironmentSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// 매니저 등록 전에도 기본값 스냅샷을 읽을 수 있도록 한 번 발행
+	Publish();
+}
+
+void UPOEnvironmentSubsystem::Deinitialize()
+{
+	UnbindWeatherManager();
+	WeatherManager.Reset();
+	TimeOfDayManager.Reset();
+	RVTManager.Reset();
+
+	Super::Deinitialize();
+}
+
+void UPOEnvironmentSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	Publish();
+}
+
+TStatId UPOEnvironmentSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPOEnvironmentSubsystem, STATGROUP_Tickables);
+}
+
+UPOEnvironmentSubsystem* UPOEnvironmentSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UPOEnvironmentSubsystem>() : nullptr;
+}
+
+void UPOEnvironmentSubsystem::RegisterWeatherManager(APOWeatherSystemManager* Manager)
+{
+	// 등록 전 구독자가 보던 날씨 (매니저가 없었다면 기본값)
+	const EWeatherType OldWeather = GetSnapshot().Weather;
+
+	UnbindWeatherManager();
+	WeatherManager = Manager;
+
+	if (Manager)
+	{
+		WeatherChangedHandle = Manager->OnWeatherChangedNative.AddUObject(this, &UPOEnvironmentSubsystem::HandleWeatherChanged);
+		WeatherTransitionStartedHandle = Manager->OnWeatherTransitionStartedNative.AddUObject(this, &UPOEnvironmentSubsystem::HandleWeatherTransitionStarted);
+		WeatherTransitionCompletedHandle = Manager->OnWeatherTransitionCompletedNative.AddUObject(this, &UPOEnvironmentSubsystem::HandleWeatherTransitionCompleted);
+	}
+
+	Publish();
+
+	if (Manager && Manager->GetCurrentWeather() != OldWeather)
+	{
+		OnWeatherChanged.Broadcast(OldWeather, Manager->GetCurrentWeather());
+	}
+}
+
+void UPOEnvironmentSubsystem::UnbindWeatherManager()
+{
+	if (APOWeatherSystemManager* Manager = WeatherManager.Get())
+	{
+		Manager->OnWeatherChangedNative.Remove(WeatherChangedHandle);
+		Manager->OnWeatherTransitionStartedNative.Remove(WeatherTransitionStartedHandle);
+		Manager->OnWeatherTransitionCompletedNative.Remove(WeatherTransitionCompletedHandle);
+	}
+
+	WeatherChangedHandle.Reset();
+	WeatherTransitionStartedHandle.Reset();
+	WeatherTransitionCompletedHandle.Reset();
+}
+
+void UPOEnvironmentSubsystem::HandleWeatherChanged(EWeatherType OldWeather, EWeatherType NewWeather)
+{
+	Publish();
+	OnWeatherChanged.Broadcast(OldWeather, NewWeather);
+}
+
+void UPOEnvironmentSubsystem::HandleWeatherTransitionStarted(EWeatherType FromWeather, EWeatherType ToWeather, float Duration)
+{
+	Publish();
+	OnWeatherTransitionStarted.Broadcast(FromWeather, ToWeather, Duration);
+}
+
+void UPOEnvironmentSubsystem::HandleWeatherTransitionCompleted(EWeatherType FromWeather, EWeatherType ToWeather)
+{
+	Publish();
+	OnWeatherTransitionCompleted.Broadcast(FromWeather, ToWeather);
+}
+
+void UPOEnvironmentSubsystem::RegisterTimeOfDayManager(APOTimeOfDayManager* Manager)
+{
+	TimeOfDayManager = Manager;
+	Publish();
+}
+
+void UPOEnvironmentSubsystem::RegisterRVTManager(APORVTManager* Manager)
+{
+	RVTManager = Manager;
+	Publish();
+}
+
+const FPOEnvironmentSnapshot& UPOEnvironmentSubsystem::GetSnapshot() const
+{
+	// 쓰는 쪽도 게임 스레드이므로 앞 버퍼를 그대로 참조해도 안전
+	check(IsInGameThread());
+	return Buffers[FrontIndex.load(std::memory_order_relaxed)];
+}
+
+FPOEnvironmentSnapshot UPOEnvironmentSubsystem::ReadSnapshot() const
+{
+	FPOEnvironmentSnapshot Result;
+
+	for (;;)
+	{
+		const int32 Index = FrontIndex.load(std::memory_order_acquire);
+		const uint32 SeqBefore = BufferSequence[Index].load(std::memory_order_acquire);
+		if (SeqBefore & 1)
+		{
+			// 복사하려는 사이 게임 스레드가 두 번 발행해 이 버퍼를 다시 쓰는 중
+			FPlatformProcess::Yield();
+			continue;
+		}
+
+		Result = Buffers[Index];
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (BufferSequence[Index].load(std::memory_order_relaxed) == SeqBefore)
+		{
+			return Result;
+		}
+	}
+}
+
+void UPOEnvironmentSubsystem::Publish()
+{
+	const int32 BackIndex = FrontIndex.load(std::memory_order_relaxed) ^ 1;
+	FPOEnvironmentSnapshot& Back = Buffers[BackIndex];
+
+	BufferSequence[BackIndex].fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	Back = FPOEnvironmentSnapshot();
+	Back.Serial = NextSerial++;
+
+	if (const APOWeatherSystemManager* WM = WeatherManager.Get())
+	{
+		Back.bHasWeather        = true;
+		Back.Weather            = WM->GetCurrentWeather();
+		Back.bIsTransitioning   = WM->TransitionInfo.bIsTransitioning;
+		Back.TransitionProgress = WM->TransitionInfo.TransitionProgress;
+		Back.PreviousWeather    = WM->TransitionInfo.PreviousWeather;
+		Back.TargetWeather      = WM->TransitionInfo.TargetWeather;
+	}
+
+	if (const APORVTManager* RVT = RVTManager.Get())
+	{
+		Back.bHasRVT       = true;
+		Back.Wetness       = RVT->Wetness;
+		Back.SnowCoverage  = RVT->SnowCoverage;
+		Back.RainIntensity = RVT->RainIntensity;
+		Back.FogDensity    = RVT->FogDensity;
+		Back.WindStrength  = RVT->WindStrength;
+		Back.WindDirection = RVT->WindDirection;
+	}
+
+	if (const APOTimeOfDayManager* TM = TimeOfDayManager.Get())
+	{
+		Back.bHasTimeOfDay = true;
+		Back.TimeOfDay     = TM->GetCurrentTime();
+		Back.bIsDaytime    = TM->IsDaytime();
+	}
+	Back.Period = GetTimePeriod(Back.TimeOfDay);
+
+	BufferSequence[BackIndex].fetch_add(1, std::memory_order_release);
+	FrontIndex.store(BackIndex, std::memory_order_release);
+}
+
+EPOTimePeriod UPOEnvironmentSubsystem::GetTimePeriod(float TimeOfDay)
+{
+	if (TimeOfDay >= 5.0f && TimeOfDay < 9.0f)   return EPOTimePeriod::EarlyMorning;
+	if (TimeOfDay >= 9.0f && TimeOfDay < 12.0f)  return EPOTimePeriod::Morning;
+	if (TimeOfDay >= 12.0f && TimeOfDay < 14.0f) return EPOTimePeriod::Noon;
+	if (TimeOfDay >= 14.0f && TimeOfDay < 18.0f) return EPOTimePeriod::Afternoon;
+	if (TimeOfDay >= 18.0f && TimeOfDay < 21.0f) return EPOTimePeriod::Evening;
+	if (TimeOfDay >= 21.0f && TimeOfDay < 24.0f) return EPOTimePeriod::Night;
+	return EPOTimePeriod::Dawn;
+}
+
+const FString& UPOEnvironmentSubsystem::WeatherToKorean(EWeatherType Weather)
+{
+	// EWeatherType 선언 순서와 같아야 함
+	static const FString Names[] = {
+		TEXT("맑음"), TEXT("흐림"), TEXT("비"), TEXT("눈"), TEXT("안개"), TEXT("폭풍")
+	};
+
+	const int32 Index = static_cast<int32>(Weather);
+	return Names[Index < static_cast<int32>(UE_ARRAY_COUNT(Names)) ? Index : 0];
+}
+
+const FString& UPOEnvironmentSubsystem::TimePeriodToKorean(EPOTimePeriod Period)
+{
+	// EPOTimePeriod 선언 순서와 같아야 함
+	static const FString Names[] = {
+		TEXT("새벽"), TEXT("이른 아침"), TEXT("오전"), TEXT("정오"), TEXT("오후"), TEXT("저녁"), TEXT("밤")
+	};
+
+	const int32 Index = static_cast<int32>(Period);
+	return Names[Index < static_cast<int32>(UE_ARRAY_COUNT(Names)) ? Index : 0];
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "POEnvironmentTypes.h"
+#include <atomic>
+#include "POEnvironmentSubsystem.generated.h"
+
+class APOWeatherSystemManager;
+class APOTimeOfDayManager;
+class APORVTManager;
+
+/**
+ * 환경 스냅샷 서비스
+ * 날씨/RVT/시간 매니저가 BeginPlay에서 스스로 등록하고, 이 서브시스템이 매 프레임 한 번
+ * 값을 모아 FPOEnvironmentSnapshot으로 발행한다. 소비자는 액터 탐색 없이 O(1)로 읽는다.
+ *
+ * 발행은 이중 버퍼 + 버퍼별 시퀀스 카운터(seqlock)로 한다. 게임 스레드는 뒤 버퍼를 채운 뒤
+ * 앞/뒤를 뒤집고, 워커 스레드는 ReadSnapshot으로 복사하면서 복사 도중 덮어쓰였으면 다시 읽는다.
+ *
+ * 날씨 매니저의 변경/전환 이벤트도 여기서 중계한다. 구독자는 매니저 생성 순서와 관계없이 BeginPlay에서
+ * 서브시스템에 붙으면 되고, 중계 직전에 스냅샷을 다시 발행하므로 핸들러 안에서 읽는 값도 최신이다.
+ */
+UCLASS()
+class PROJECT_OPENWORLD_API UPOEnvironmentSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 월드에서 서브시스템 가져오기 (없으면 nullptr) 
+	static UPOEnvironmentSubsystem* Get(const UObject* WorldContextObject);
+
+	// 매니저 등록 (각 매니저의 BeginPlay에서 호출, 파괴되면 약참조로 자동 해제) 
+	void RegisterWeatherManager(APOWeatherSystemManager* Manager);
+	void RegisterTimeOfDayManager(APOTimeOfDayManager* Manager);
+	void RegisterRVTManager(APORVTManager* Manager);
+
+	APOWeatherSystemManager* GetWeatherManager() const { return WeatherManager.Get(); }
+	APOTimeOfDayManager* GetTimeOfDayManager() const { return TimeOfDayManager.Get(); }
+	APORVTManager* GetRVTManager() const { return RVTManager.Get(); }
+
+	// 최신 스냅샷 (게임 스레드 전용, 복사 없음) 
+	const FPOEnvironmentSnapshot& GetSnapshot() const;
+
+	// 최신 스냅샷 복사본 (아무 스레드에서나 호출 가능) 
+	FPOEnvironmentSnapshot ReadSnapshot() const;
+
+	// 최신 스냅샷 (블루프린트용) 
+	UFUNCTION(BlueprintPure, Category = "Environment", meta = (DisplayName = "Get Environment Snapshot"))
+	FPOEnvironmentSnapshot K2_GetSnapshot() const { return GetSnapshot(); }
+
+	// 시간 → 시간대 
+	UFUNCTION(BlueprintPure, Category = "Environment")
+	static EPOTimePeriod GetTimePeriod(float TimeOfDay);
+
+	// 날씨/시간대 한국어 이름 (정적 테이블, 할당 없음) 
+	static const FString& WeatherToKorean(EWeatherType Weather);
+	static const FString& TimePeriodToKorean(EPOTimePeriod Period);
+
+	// 날씨 이벤트 중계 (매니저가 나중에 등록되면 기본값 → 현재 날씨로 변경 통지) 
+	FOnWeatherChangedNative OnWeatherChanged;
+	FOnWeatherTransitionStartedNative OnWeatherTransitionStarted;
+	FOnWeatherTransitionCompletedNative OnWeatherTransitionCompleted;
+
+private:
+	TWeakObjectPtr<APOWeatherSystemManager> WeatherManager;
+	TWeakObjectPtr<APOTimeOfDayManager> TimeOfDayManager;
+	TWeakObjectPtr<APORVTManager> RVTManager;
+
+	FPOEnvironmentSnapshot Buffers[2];
+
+	// 버퍼별 시퀀스 (홀수 = 쓰는 중) 
+	std::atomic<uint32> BufferSequence[2] = { {0}, {0} };
+
+	// 읽기용 앞 버퍼 인덱스 
+	std::atomic<int32> FrontIndex = 0;
+
+	int32 NextSerial = 1;
+
+	// 등록된 매니저에서 값을 모아 뒤 버퍼에 쓰고 앞/뒤 교체 
+	void Publish();
+
+	FDelegateHandle WeatherChangedHandle;
+	FDelegateHandle WeatherTransitionStartedHandle;
+	FDelegateHandle WeatherTransitionCompletedHandle;
+
+	void UnbindWeatherManager();
+	void HandleWeatherChanged(EWeatherType OldWeather, EWeatherType NewWeather);
+	void HandleWeatherTransitionStarted(EWeatherType FromWeather, EWeatherType ToWeather, float Duration);
+	void HandleWeatherTransitionCompleted(EWeatherType FromWeather, EWeatherType ToWeather);
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../Weather/WeatherTypes.h"
+#include "POEnvironmentTypes.generated.h"
+
+/** 대화/표시용 시간대 구분 (TimeOfDay 0~24 기준) */
+UENUM(BlueprintType)
+enum class EPOTimePeriod : uint8
+{
+	Dawn			UMETA(DisplayName = "새벽 (00~05)"),
+	EarlyMorning	UMETA(DisplayName = "이른 아침 (05~09)"),
+	Morning			UMETA(DisplayName = "오전 (09~12)"),
+	Noon			UMETA(DisplayName = "정오 (12~14)"),
+	Afternoon		UMETA(DisplayName = "오후 (14~18)"),
+	Evening			UMETA(DisplayName = "저녁 (18~21)"),
+	Night			UMETA(DisplayName = "밤 (21~24)")
+};
+
+/**
+ * 한 프레임의 환경 상태 (날씨/RVT/시간)
+ * UPOEnvironmentSubsystem이 프레임마다 한 번 채워 발행하며, 발행된 값은 바뀌지 않는다.
+ * 문자열 없이 값 타입만 담아 워커 스레드에서도 통째로 복사해 읽을 수 있다.
+ */
+USTRUCT(BlueprintType)
+struct FPOEnvironmentSnapshot
+{
+	GENERATED_BODY()
+
+	/** 발행 일련번호 (0 = 아직 발행 전) */
+	UPROPERTY(BlueprintReadOnly, Category = "Environment")
+	int32 Serial = 0;
+
+	/** 각 매니저가 등록되어 값이 유효한지 */
+	UPROPERTY(BlueprintReadOnly, Category = "Environment")
+	bool bHasWeather = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Environment")
+	bool bHasRVT = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Environment")
+	bool bHasTimeOfDay = false;
+
+	/** 현재 날씨 */
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|Weather")
+	EWeatherType Weather = EWeatherType::Clear;
+
+	/** 날씨 전환 중인지, 진행도 (0.0 ~ 1.0), 이전/목표 날씨 */
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|Weather")
+	bool bIsTransitioning = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|Weather")
+	float TransitionProgress = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|Weather")
+	EWeatherType PreviousWeather = EWeatherType::Clear;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|Weather")
+	EWeatherType TargetWeather = EWeatherType::Clear;
+
+	/** RVT 날씨 수치 (0.0 ~ 1.0, 풍향은 0 ~ 360도) */
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|RVT")
+	float Wetness = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|RVT")
+	float SnowCoverage = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|RVT")
+	float RainIntensity = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|RVT")
+	float FogDensity = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|RVT")
+	float WindStrength = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|RVT")
+	float WindDirection = 0.0f;
+
+	/** 현재 시간 (0.0 ~ 24.0) */
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|Time")
+	float TimeOfDay = 12.0f;
+
+	/** 시간대 구분 */
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|Time")
+	EPOTimePeriod Period = EPOTimePeriod::Noon;
+
+	/** 낮(06~18시)인지 */
+	UPROPERTY(BlueprintReadOnly, Category = "Environment|Time")
+	bool bIsDaytime = true;
+
+	/** 비가 오는지 (비/폭풍, 날씨 매니저가 없으면 false) */
+	bool IsRaining() const
+	{
+		return bHasWeather && (Weather == EWeatherType::Rainy || Weather == EWeatherType::Stormy);
+	}
+
+	/** 비로 전환되는 중인지 (아직 비가 아니어도 목표가 비/폭풍) */
+	bool IsRainIncoming() const
+	{
+		return bHasWeather && bIsTransitioning && (TargetWeather == EWeatherType::Rainy || TargetWeather == EWeatherType::Stormy);
+	}
+
+	/** 밤인지 (시간 매니저가 없으면 false) */
+	bool IsNight() const
+	{
+		return bHasTimeOfDay && !bIsDaytime;
+	}
+};